@@ -0,0 +1,362 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include "LegacyArchive.h"
+#include <Core/Archive.h>
+#include <Core/ArchiveFile.h>
+#include <Core/Compression.h>
+#include <atomic>
+#include <span>
+#include <filesystem>
+
+namespace
+{
+	constexpr std::size_t PrimitiveCount = 100000;
+	constexpr std::size_t StringCount = 10000;
+	constexpr std::size_t VectorElementCount = 100000;
+	constexpr std::size_t PacketCount = 10000;
+	constexpr std::size_t PacketSize = 256;
+	constexpr std::size_t Iterations = 20;
+	constexpr std::size_t FileElementCount = 4 * 1024 * 1024;
+	constexpr std::size_t FileIterations = 5;
+
+	/*
+	* Keeps the work from being optimized out.
+	*/
+	std::atomic<std::uint64_t> Sink = 0;
+
+	/*
+	* bool is left out, it used to be written as int and read back as bool.
+	* Templated so the legacy writer runs the same sequence.
+	*/
+	template <typename ArchiveType>
+	void EncodePrimitives(ArchiveType& Archive)
+	{
+		for (std::size_t i = 0; i < PrimitiveCount; i++)
+		{
+			Archive << (int)i;
+			Archive << (float)i;
+			Archive << (double)i;
+			Archive << (std::uint64_t)i;
+			Archive << (char)(i & 0x7F);
+		}
+	}
+
+	std::vector<std::string> MakeStrings()
+	{
+		std::vector<std::string> Strings(StringCount);
+		for (std::size_t i = 0; i < StringCount; i++)
+			Strings[i] = "sActor_Replicated_Property_" + std::to_string(i);
+		return Strings;
+	}
+
+	/*
+	* What WSServer/WSClient write per packet: a date, three names and the RPC params in a 256 byte slot.
+	*/
+	template <typename ArchiveType>
+	void EncodePacket(ArchiveType& Archive, std::size_t Index)
+	{
+		Archive.ResizeData(PacketSize);
+		for (std::int32_t i = 0; i < 8; i++)
+			Archive << i;
+		Archive << std::string("12");
+		Archive << (std::uint8_t)2;
+		Archive << std::string("GPlayerCharacter");
+		Archive << std::string("OnBindKey_RightMovementKey_Released");
+		Archive << (int)Index;
+		Archive << (std::uint32_t)Index;
+	}
+
+	void RunPrimitives()
+	{
+		sBenchmark::Get().Run("Archive/Encode/Primitives", Iterations, PrimitiveCount, [&]()
+		{
+			sArchive Archive;
+			EncodePrimitives(Archive);
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Legacy/Primitives", Iterations, PrimitiveCount, [&]()
+		{
+			sLegacyArchiveWriter Archive;
+			EncodePrimitives(Archive);
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Reserved/Primitives", Iterations, PrimitiveCount, [&]()
+		{
+			sArchive Archive;
+			Archive.Reserve(PrimitiveCount * (sizeof(int) + sizeof(float) + sizeof(double) + sizeof(std::uint64_t) + sizeof(char)));
+			EncodePrimitives(Archive);
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sArchive Encoded;
+		EncodePrimitives(Encoded);
+
+		sBenchmark::Get().Run("Archive/Decode/Primitives", Iterations, PrimitiveCount, [&]()
+		{
+			Encoded.ResetPos();
+			std::uint64_t Sum = 0;
+			for (std::size_t i = 0; i < PrimitiveCount; i++)
+			{
+				int I = 0;
+				float F = 0.0f;
+				double D = 0.0;
+				std::uint64_t U = 0;
+				char C = 0;
+				Encoded >> I;
+				Encoded >> F;
+				Encoded >> D;
+				Encoded >> U;
+				Encoded >> C;
+				Sum += I + (std::uint64_t)F + (std::uint64_t)D + U + C;
+			}
+			Sink.fetch_add(Sum, std::memory_order_relaxed);
+		});
+	}
+
+	void RunStrings()
+	{
+		const std::vector<std::string> Strings = MakeStrings();
+
+		sBenchmark::Get().Run("Archive/Encode/Strings", Iterations, StringCount, [&]()
+		{
+			sArchive Archive;
+			for (const auto& STR : Strings)
+				Archive << STR;
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Legacy/Strings", Iterations, StringCount, [&]()
+		{
+			sLegacyArchiveWriter Archive;
+			for (const auto& STR : Strings)
+				Archive << STR;
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sArchive Encoded;
+		for (const auto& STR : Strings)
+			Encoded << STR;
+
+		sBenchmark::Get().Run("Archive/Decode/Strings", Iterations, StringCount, [&]()
+		{
+			Encoded.ResetPos();
+			std::uint64_t Length = 0;
+			for (std::size_t i = 0; i < StringCount; i++)
+			{
+				std::string STR;
+				Encoded >> STR;
+				Length += STR.size();
+			}
+			Sink.fetch_add(Length, std::memory_order_relaxed);
+		});
+	}
+
+	void RunVectors()
+	{
+		std::vector<float> Floats(VectorElementCount);
+		std::vector<FVector> Vectors(VectorElementCount);
+		for (std::size_t i = 0; i < VectorElementCount; i++)
+		{
+			Floats[i] = (float)i;
+			Vectors[i] = FVector((float)i, (float)i * 2.0f, (float)i * 3.0f);
+		}
+
+		sBenchmark::Get().Run("Archive/Encode/Vector/Float", Iterations, VectorElementCount, [&]()
+		{
+			sArchive Archive;
+			Archive << Floats;
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Vector/FVector", Iterations, VectorElementCount, [&]()
+		{
+			sArchive Archive;
+			Archive << Vectors;
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Legacy/Vector/Float", Iterations, VectorElementCount, [&]()
+		{
+			sLegacyArchiveWriter Archive;
+			Archive << Floats;
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Legacy/Vector/FVector", Iterations, VectorElementCount, [&]()
+		{
+			sLegacyArchiveWriter Archive;
+			Archive << Vectors;
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Span/Float", Iterations, VectorElementCount, [&]()
+		{
+			sArchive Archive;
+			Archive << std::span<const float>(Floats.data(), Floats.size());
+			Sink.fetch_add(Archive.GetSize(), std::memory_order_relaxed);
+		});
+
+		sArchive EncodedFloats;
+		EncodedFloats << Floats;
+		sArchive EncodedVectors;
+		EncodedVectors << Vectors;
+
+		sBenchmark::Get().Run("Archive/Decode/Vector/Float", Iterations, VectorElementCount, [&]()
+		{
+			EncodedFloats.ResetPos();
+			std::vector<float> Out;
+			EncodedFloats >> Out;
+			Sink.fetch_add(Out.size(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Decode/Vector/FVector", Iterations, VectorElementCount, [&]()
+		{
+			EncodedVectors.ResetPos();
+			std::vector<FVector> Out;
+			EncodedVectors >> Out;
+			Sink.fetch_add(Out.size(), std::memory_order_relaxed);
+		});
+	}
+
+	void RunPackets()
+	{
+		sBenchmark::Get().Run("Archive/Encode/Packet", Iterations, PacketCount, [&]()
+		{
+			std::size_t Size = 0;
+			for (std::size_t i = 0; i < PacketCount; i++)
+			{
+				sArchive Archive;
+				EncodePacket(Archive, i);
+				Size += Archive.GetSize();
+			}
+			Sink.fetch_add(Size, std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/Encode/Legacy/Packet", Iterations, PacketCount, [&]()
+		{
+			std::size_t Size = 0;
+			for (std::size_t i = 0; i < PacketCount; i++)
+			{
+				sLegacyArchiveWriter Archive;
+				EncodePacket(Archive, i);
+				Size += Archive.GetSize();
+			}
+			Sink.fetch_add(Size, std::memory_order_relaxed);
+		});
+	}
+
+	/*
+	* A 16 MB snapshot, written through one in-memory archive or in chunks, and read back through iostreams or a mapping.
+	*/
+	void RunFiles()
+	{
+		const std::filesystem::path Path = std::filesystem::temp_directory_path() / "DNGE_ArchiveBenchmark.bin";
+		std::vector<float> Values(FileElementCount);
+		for (std::size_t i = 0; i < FileElementCount; i++)
+			Values[i] = (float)i;
+
+		sBenchmark::Get().Run("Archive/File/Write/Archive", FileIterations, FileElementCount, [&]()
+		{
+			sArchive Archive;
+			Archive << Values;
+			Sink.fetch_add(Archive.SaveToFile(Path.string()) ? Archive.GetSize() : 0, std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/File/Write/Chunked", FileIterations, FileElementCount, [&]()
+		{
+			sArchiveFileWriter Writer;
+			Writer.Open(Path);
+			Writer << Values;
+			const std::uint64_t Size = Writer.GetBytesWritten();
+			Sink.fetch_add(Writer.Close() ? Size : 0, std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/File/Read/Stream", FileIterations, FileElementCount, [&]()
+		{
+			std::ifstream File(Path, std::ios::binary | std::ios::ate);
+			std::vector<std::uint8_t> Bytes((std::size_t)File.tellg());
+			File.seekg(0, std::ios::beg);
+			File.read(reinterpret_cast<char*>(Bytes.data()), (std::streamsize)Bytes.size());
+			sArchive Archive(Bytes);
+			std::vector<float> Read;
+			Archive >> Read;
+			Sink.fetch_add(Read.size(), std::memory_order_relaxed);
+		});
+
+		sBenchmark::Get().Run("Archive/File/Read/Mapped", FileIterations, FileElementCount, [&]()
+		{
+			sMappedFile File(Path);
+			std::vector<float> Read;
+			File.GetView() >> Read;
+			Sink.fetch_add(Read.size(), std::memory_order_relaxed);
+		});
+
+		std::error_code Error;
+		std::filesystem::remove(Path, Error);
+	}
+
+	/*
+	* LZ over the primitive archive, items are input bytes. The ratio is printed once after the runs.
+	*/
+	void RunCompression()
+	{
+		sArchive Archive;
+		EncodePrimitives(Archive);
+
+		sCompressionStats Stats;
+		std::vector<std::uint8_t> Frame;
+		sBenchmark::Get().Run("Archive/Compression/LZ/Compress", Iterations, Archive.GetSize(), [&]()
+		{
+			Frame.clear();
+			Compression::Compress(Archive.GetData().data(), Archive.GetSize(), Frame, eCompressionCodec::LZ, nullptr, &Stats);
+			Sink.fetch_add(Frame.size(), std::memory_order_relaxed);
+		});
+
+		std::vector<std::uint8_t> Raw;
+		sBenchmark::Get().Run("Archive/Compression/LZ/Decompress", Iterations, Archive.GetSize(), [&]()
+		{
+			Compression::Decompress(sArchiveView(Frame), Raw, nullptr, &Stats);
+			Sink.fetch_add(Raw.size(), std::memory_order_relaxed);
+		});
+
+		if (sBenchmark::Get().ShouldRun("Archive/Compression"))
+			std::cout << "Archive/Compression/LZ ratio: " << Stats.GetRatio() << std::endl;
+	}
+}
+
+void RunArchiveBenchmarks()
+{
+	RunPrimitives();
+	RunStrings();
+	RunVectors();
+	RunPackets();
+	RunFiles();
+	RunCompression();
+}
@@ -0,0 +1,176 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/*
+* Result of a single scenario, times are in milliseconds.
+* Items is the amount of work done by one iteration (particles, bodies, bytes...), 0 if not meaningful.
+*/
+struct sBenchmarkResult
+{
+	std::string Name;
+	std::size_t Iterations = 0;
+	std::size_t Items = 0;
+	double MinMS = 0.0;
+	double AvgMS = 0.0;
+	double MaxMS = 0.0;
+
+	double ItemsPerSecond() const { return Items > 0 && AvgMS > 0.0 ? (double)Items / (AvgMS / 1000.0) : 0.0; }
+};
+
+class sBenchmark
+{
+public:
+	static sBenchmark& Get()
+	{
+		static sBenchmark instance;
+		return instance;
+	}
+
+	/*
+	* Only scenarios whose name contains the filter are run, empty filter runs everything.
+	*/
+	void SetFilter(const std::string& InFilter) { Filter = InFilter; }
+	bool ShouldRun(const std::string& Name) const { return Filter.empty() || Name.find(Filter) != std::string::npos; }
+
+	/*
+	* Runs the scenario once for warm up and Iterations times for measurement.
+	*/
+	sBenchmarkResult Run(const std::string& Name, std::size_t Iterations, const std::function<void()>& Scenario)
+	{
+		return Run(Name, Iterations, 0, Scenario);
+	}
+
+	sBenchmarkResult Run(const std::string& Name, std::size_t Iterations, std::size_t Items, const std::function<void()>& Scenario)
+	{
+		if (!ShouldRun(Name))
+			return sBenchmarkResult();
+
+		Scenario();
+
+		sBenchmarkResult Result;
+		Result.Name = Name;
+		Result.Iterations = Iterations;
+		Result.Items = Items;
+		Result.MinMS = std::numeric_limits<double>::max();
+
+		double Total = 0.0;
+		for (std::size_t i = 0; i < Iterations; i++)
+		{
+			const auto Begin = std::chrono::high_resolution_clock::now();
+			Scenario();
+			const auto End = std::chrono::high_resolution_clock::now();
+
+			const double MS = std::chrono::duration<double, std::milli>(End - Begin).count();
+			Result.MinMS = std::min(Result.MinMS, MS);
+			Result.MaxMS = std::max(Result.MaxMS, MS);
+			Total += MS;
+		}
+		Result.AvgMS = Iterations > 0 ? Total / (double)Iterations : 0.0;
+
+		std::cout << Result.Name << " min: " << Result.MinMS << "ms avg: " << Result.AvgMS << "ms max: " << Result.MaxMS << "ms";
+		if (Result.Items > 0)
+			std::cout << " items/s: " << Result.ItemsPerSecond();
+		std::cout << std::endl;
+
+		Results.push_back(Result);
+		return Result;
+	}
+
+	const std::vector<sBenchmarkResult>& GetResults() const { return Results; }
+
+	/*
+	* Writes every result as JSON. Scenario names are stable across engine versions, compare runs by "name".
+	*/
+	bool WriteJSON(const std::string& Path) const
+	{
+		std::ofstream File(Path, std::ios::out | std::ios::trunc);
+		if (!File.is_open())
+			return false;
+
+		auto Escape = [](const std::string& STR) -> std::string
+		{
+			std::string Out;
+			Out.reserve(STR.size());
+			for (const char Char : STR)
+			{
+				if (Char == '"' || Char == '\\')
+					Out.push_back('\\');
+				Out.push_back(Char);
+			}
+			return Out;
+		};
+
+		File << "{\n";
+		File << "  \"schema\": 1,\n";
+#if _DEBUG
+		File << "  \"configuration\": \"Debug\",\n";
+#else
+		File << "  \"configuration\": \"Release\",\n";
+#endif
+		File << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+		File << "  \"results\": [\n";
+		for (std::size_t i = 0; i < Results.size(); i++)
+		{
+			const auto& Result = Results[i];
+			File << "    { \"name\": \"" << Escape(Result.Name) << "\""
+				<< ", \"iterations\": " << Result.Iterations
+				<< ", \"items\": " << Result.Items
+				<< ", \"min_ms\": " << Result.MinMS
+				<< ", \"avg_ms\": " << Result.AvgMS
+				<< ", \"max_ms\": " << Result.MaxMS
+				<< ", \"items_per_second\": " << Result.ItemsPerSecond()
+				<< " }" << (i + 1 < Results.size() ? "," : "") << "\n";
+		}
+		File << "  ]\n";
+		File << "}\n";
+		return true;
+	}
+
+private:
+	sBenchmark() = default;
+
+	std::string Filter;
+	std::vector<sBenchmarkResult> Results;
+};
+
+void RunThreadPoolBenchmarks();
+void RunArchiveBenchmarks();
+void RunNetworkBenchmarks();
+void RunGameplayBenchmarks();
+void RunPhysicsBenchmarks();
+void RunImportBenchmarks();
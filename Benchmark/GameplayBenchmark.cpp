@@ -0,0 +1,239 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include <Gameplay/Actor.h>
+#include <Gameplay/ILevel.h>
+#include <Gameplay/ParticleSystem.h>
+#include <Gameplay/PrimitiveComponent.h>
+#include <Core/MeshPrimitives.h>
+#include <atomic>
+
+namespace
+{
+	constexpr std::size_t Iterations = 20;
+
+	/*
+	* Keeps the work from being optimized out.
+	*/
+	std::atomic<std::uint64_t> Sink = 0;
+
+	inline void Consume(const FVector& V)
+	{
+		Sink.fetch_add((std::uint64_t)(V.X + V.Y + V.Z), std::memory_order_relaxed);
+	}
+
+	/*
+	* Minimal level that stores actors per layer the same way the sample level does.
+	*/
+	class sBenchmarkLevel : public ILevel
+	{
+		sClassBody(sClassConstructor, sBenchmarkLevel, ILevel)
+	public:
+		sBenchmarkLevel(std::size_t InLayerCount = 1)
+			: Layers(std::max<std::size_t>(InLayerCount, 1))
+		{}
+		virtual ~sBenchmarkLevel() = default;
+
+		virtual std::string GetName() const override { return "BenchmarkLevel"; }
+
+		virtual void InitLevel() override {}
+		virtual void BeginPlay() override {}
+		virtual void Tick(const double DeltaTime) override {}
+		virtual void FixedUpdate(const double DeltaTime) override {}
+
+		virtual FBoundingBox GetLevelBounds() const override { return FBoundingBox(); }
+		virtual IWorld* GetWorld() const override { return nullptr; }
+		virtual void Serialize() override {}
+		virtual sObjectSpawnNode GetSpawnNode(std::string Name, std::int32_t PlayerIndex = -1) const override { return sObjectSpawnNode(); }
+
+		virtual void AddMesh(const std::shared_ptr<sMesh>& Object, std::size_t LayerIndex = 0) override {}
+		virtual void RemoveMesh(sMesh* Object, std::size_t LayerIndex = 0) override {}
+		virtual void AddActor(const std::shared_ptr<sActor>& Object, std::size_t LayerIndex = 0) override
+		{
+			if (LayerIndex < Layers.size())
+				Layers[LayerIndex].push_back(Object);
+		}
+		virtual void RemoveActor(sActor* Object, std::size_t LayerIndex = 0, bool bDeferredRemove = true) override
+		{
+			if (LayerIndex >= Layers.size())
+				return;
+			auto& Actors = Layers[LayerIndex];
+			Actors.erase(std::remove_if(Actors.begin(), Actors.end(), [&](const std::shared_ptr<sActor>& Actor) { return Actor.get() == Object; }), Actors.end());
+		}
+		virtual void AddEmitter(const std::shared_ptr<sEmitter>& Object, std::size_t LayerIndex = 0) override {}
+		virtual void RemoveEmitter(sEmitter* Object, std::size_t LayerIndex = 0, bool bDeferredRemove = true) override {}
+
+		virtual size_t LayerCount() const override { return Layers.size(); }
+
+		virtual size_t MeshCount(std::size_t LayerIndex = 0) const override { return 0; }
+		virtual std::vector<std::shared_ptr<sMesh>> GetAllMeshes(std::size_t LayerIndex = 0) const override { return std::vector<std::shared_ptr<sMesh>>(); }
+		virtual sMesh* GetMesh(const std::size_t Index, std::size_t LayerIndex = 0) const override { return nullptr; }
+		virtual size_t ActorCount(std::size_t LayerIndex = 0) const override
+		{
+			return LayerIndex < Layers.size() ? Layers[LayerIndex].size() : 0;
+		}
+		virtual std::vector<std::shared_ptr<sActor>> GetAllActors(std::size_t LayerIndex = 0) const override
+		{
+			return LayerIndex < Layers.size() ? Layers[LayerIndex] : std::vector<std::shared_ptr<sActor>>();
+		}
+		virtual sActor* GetActor(const std::size_t Index, std::size_t LayerIndex = 0) const override
+		{
+			return LayerIndex < Layers.size() && Index < Layers[LayerIndex].size() ? Layers[LayerIndex][Index].get() : nullptr;
+		}
+		virtual size_t EmitterCount(std::size_t LayerIndex = 0) const override { return 0; }
+		virtual std::vector<std::shared_ptr<sEmitter>> GetAllEmitters(std::size_t LayerIndex = 0) const override { return std::vector<std::shared_ptr<sEmitter>>(); }
+		virtual sEmitter* GetEmitter(const std::size_t Index, std::size_t LayerIndex = 0) const override { return nullptr; }
+
+		virtual void OnResizeWindow(const std::size_t Width, const std::size_t Height) override {}
+		virtual void InputProcess(const GMouseInput& MouseInput, const GKeyboardChar& KeyboardChar) override {}
+
+	private:
+		std::vector<std::vector<std::shared_ptr<sActor>>> Layers;
+	};
+
+	std::string CountSuffix(std::size_t Count)
+	{
+		if (Count >= 1000000 && Count % 1000000 == 0)
+			return std::to_string(Count / 1000000) + "M";
+		if (Count >= 1000 && Count % 1000 == 0)
+			return std::to_string(Count / 1000) + "k";
+		return std::to_string(Count);
+	}
+
+	/*
+	* Update spawns at most one particle per call, the pool is filled with a burst before timing.
+	* The cost is the pool walk plus rebuilding the instance data of the live particles, items are the live particles.
+	*/
+	void RunMeshParticle(std::size_t PoolSize)
+	{
+		const std::string Name = "Particles/MeshParticle/Update/" + CountSuffix(PoolSize);
+		if (!sBenchmark::Get().ShouldRun(Name))
+			return;
+
+		constexpr float LifeTime = 100.0f;
+		constexpr float DeltaTime = 1.0f / 60.0f;
+		constexpr std::size_t WarmUpUpdates = 8;
+
+		sMeshParticleDesc Desc;
+		Desc.SetLifeTime(LifeTime);
+		Desc.SpawnRate = (std::uint32_t)(PoolSize / (std::size_t)LifeTime);
+		Desc.MinVelocity = FVector(-10.0f, -10.0f, 0.0f);
+		Desc.MaxVelocity = FVector(10.0f, 10.0f, 0.0f);
+		Desc.StartColor = FColor(1.0f, 1.0f, 0.0f, 1.0f);
+		Desc.EndColor = FColor(1.0f, 0.0f, 0.0f, 1.0f);
+		{
+			sParticleShape Shape;
+			auto Plane = MeshPrimitives::Create2DPlaneVerticesFromDimension(FDimension2D(8, 8));
+			const std::vector<FVector2> TC = MeshPrimitives::GeneratePlaneTextureCoordinate();
+			Shape.ShapeIndexes = MeshPrimitives::GeneratePlaneIndices();
+			for (std::size_t i = 0; i < 4; i++)
+				Shape.Shape.push_back(sParticleVertexLayout(FVector(Plane[i]), TC[i]));
+			Desc.Shape = Shape;
+		}
+
+		MeshParticle::SharedPtr Particle = MeshParticle::Create(Desc);
+		Particle->SpawnBurst(PoolSize);
+		for (std::size_t i = 0; i < WarmUpUpdates; i++)
+			Particle->Update(DeltaTime);
+
+		// Nothing dies within the run, the lifetime is far longer than the timed updates.
+		sBenchmark::Get().Run(Name, Iterations, Particle->GetActiveParticleCount(), [&]()
+		{
+			Particle->Update(DeltaTime);
+			Sink.fetch_add(Particle->ParticleBufferVertexes.size(), std::memory_order_relaxed);
+		});
+	}
+
+	void RunActorIteration(std::size_t ActorCount)
+	{
+		const std::string GetActorName = "Level/ActorIteration/GetActor/" + CountSuffix(ActorCount);
+		const std::string GetAllActorsName = "Level/ActorIteration/GetAllActors/" + CountSuffix(ActorCount);
+		if (!sBenchmark::Get().ShouldRun(GetActorName) && !sBenchmark::Get().ShouldRun(GetAllActorsName))
+			return;
+
+		sBenchmarkLevel::SharedPtr Level = sBenchmarkLevel::Create();
+		for (std::size_t i = 0; i < ActorCount; i++)
+		{
+			sActor::SharedPtr Actor = sActor::Create("Actor_" + std::to_string(i));
+			Actor->SetLocation(FVector((float)(i % 1024), (float)(i / 1024), 0.0f));
+			Level->AddActor(Actor);
+		}
+
+		ILevel* pLevel = Level.get();
+
+		sBenchmark::Get().Run(GetActorName, Iterations, ActorCount, [&]()
+		{
+			const std::size_t Count = pLevel->ActorCount();
+			for (std::size_t i = 0; i < Count; i++)
+				Consume(pLevel->GetActor(i)->GetLocation());
+		});
+
+		sBenchmark::Get().Run(GetAllActorsName, Iterations, ActorCount, [&]()
+		{
+			for (const auto& Actor : pLevel->GetAllActors())
+				Consume(Actor->GetLocation());
+		});
+	}
+
+	/*
+	* GetRelativeLocation walks up to the root on every call.
+	*/
+	void RunComponentHierarchy(std::size_t Depth)
+	{
+		constexpr std::size_t QueryCount = 1000;
+
+		std::vector<sPrimitiveComponent::SharedPtr> Chain;
+		Chain.reserve(Depth);
+		Chain.push_back(sPrimitiveComponent::Create("Component_0"));
+		for (std::size_t i = 1; i < Depth; i++)
+		{
+			sPrimitiveComponent::SharedPtr Component = sPrimitiveComponent::Create("Component_" + std::to_string(i));
+			Component->AttachToComponent(Chain.back().get());
+			Component->SetRelativeLocation(FVector(1.0f, 0.0f, 0.0f));
+			Chain.push_back(Component);
+		}
+
+		sPrimitiveComponent* Leaf = Chain.back().get();
+		sBenchmark::Get().Run("Component/GetRelativeLocation/Depth" + std::to_string(Depth), Iterations, QueryCount, [&]()
+		{
+			for (std::size_t i = 0; i < QueryCount; i++)
+				Consume(Leaf->GetRelativeLocation());
+		});
+	}
+}
+
+void RunGameplayBenchmarks()
+{
+	for (const std::size_t PoolSize : { 10000, 100000, 1000000 })
+		RunMeshParticle(PoolSize);
+
+	for (const std::size_t ActorCount : { 1000, 10000, 100000 })
+		RunActorIteration(ActorCount);
+
+	for (const std::size_t Depth : { 1, 8, 64, 256 })
+		RunComponentHierarchy(Depth);
+}
@@ -0,0 +1,168 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include <Utilities/OBJImporter.h>
+#include <Utilities/tinyxml2.h>
+#include <filesystem>
+#include <sstream>
+#include <atomic>
+
+namespace
+{
+	constexpr std::size_t Iterations = 10;
+	const std::string TMXPath = "..//Content//Pixel Adventure 1.tmx";
+
+	/*
+	* Keeps the work from being optimized out.
+	*/
+	std::atomic<std::uint64_t> Sink = 0;
+
+	/*
+	* There is no OBJ in Content, a generated grid keeps the input identical across machines.
+	*/
+	std::string WriteGridOBJ(std::size_t GridSize)
+	{
+		const std::filesystem::path Path = std::filesystem::temp_directory_path() / ("DNGE_Benchmark_Grid" + std::to_string(GridSize) + ".obj");
+		std::ofstream File(Path, std::ios::out | std::ios::trunc);
+		if (!File.is_open())
+			return "";
+
+		File << "# DNGE benchmark grid\n";
+		File << "o Grid\n";
+		for (std::size_t Y = 0; Y <= GridSize; Y++)
+		{
+			for (std::size_t X = 0; X <= GridSize; X++)
+			{
+				File << "v " << (float)X << " " << (float)Y << " " << (float)((X * 7 + Y * 13) % 17) * 0.1f << "\n";
+				File << "vt " << (float)X / (float)GridSize << " " << (float)Y / (float)GridSize << "\n";
+			}
+		}
+		File << "vn 0 0 1\n";
+		File << "s off\n";
+
+		const std::size_t Stride = GridSize + 1;
+		for (std::size_t Y = 0; Y < GridSize; Y++)
+		{
+			for (std::size_t X = 0; X < GridSize; X++)
+			{
+				const std::size_t A = Y * Stride + X + 1;
+				const std::size_t B = A + 1;
+				const std::size_t C = A + Stride;
+				const std::size_t D = C + 1;
+				File << "f " << A << "/" << A << "/1 " << B << "/" << B << "/1 " << D << "/" << D << "/1\n";
+				File << "f " << A << "/" << A << "/1 " << D << "/" << D << "/1 " << C << "/" << C << "/1\n";
+			}
+		}
+		return Path.string();
+	}
+
+	void RunOBJ(std::size_t GridSize)
+	{
+		const std::string Name = "Import/OBJ/Grid" + std::to_string(GridSize);
+		if (!sBenchmark::Get().ShouldRun(Name))
+			return;
+
+		const std::string Path = WriteGridOBJ(GridSize);
+		if (Path.empty())
+		{
+			std::cout << Name << " skipped, could not write the temporary OBJ file." << std::endl;
+			return;
+		}
+
+		sBenchmark::Get().Run(Name, Iterations, GridSize * GridSize * 2, [&]()
+		{
+			OBJImporter Importer;
+			Importer.Import(Path);
+			Sink.fetch_add(Importer.obj.Faces.size(), std::memory_order_relaxed);
+		});
+
+		std::error_code Error;
+		std::filesystem::remove(Path, Error);
+	}
+
+	/*
+	* Same steps the sample level takes: load the document, decode every CSV tile layer and walk every object group.
+	*/
+	void RunTMX()
+	{
+		const std::string Name = "Import/TMX/PixelAdventure1";
+		if (!sBenchmark::Get().ShouldRun(Name))
+			return;
+
+		if (!std::filesystem::exists(TMXPath))
+		{
+			std::cout << Name << " skipped, " << TMXPath << " not found." << std::endl;
+			return;
+		}
+
+		sBenchmark::Get().Run(Name, Iterations, [&]()
+		{
+			tinyxml2::XMLDocument Doc;
+			if (Doc.LoadFile(TMXPath.c_str()) != tinyxml2::XML_SUCCESS)
+				return;
+
+			tinyxml2::XMLElement* Map = Doc.FirstChildElement("map");
+			if (!Map)
+				return;
+
+			std::vector<int> Tiles;
+			for (auto Layer = Map->FirstChildElement("layer"); Layer; Layer = Layer->NextSiblingElement("layer"))
+			{
+				tinyxml2::XMLElement* Data = Layer->FirstChildElement("data");
+				if (!Data || !Data->GetText())
+					continue;
+
+				std::istringstream ss(Data->GetText());
+				int Value;
+				char Comma;
+				while (ss >> Value)
+				{
+					Tiles.push_back(Value);
+					ss >> Comma;
+				}
+			}
+
+			std::uint64_t ObjectCount = 0;
+			for (auto Group = Map->FirstChildElement("objectgroup"); Group; Group = Group->NextSiblingElement("objectgroup"))
+			{
+				for (auto Object = Group->FirstChildElement("object"); Object; Object = Object->NextSiblingElement("object"))
+				{
+					ObjectCount += (std::uint64_t)(Object->IntAttribute("x") + Object->IntAttribute("y") + Object->IntAttribute("width") + Object->IntAttribute("height")) > 0;
+				}
+			}
+
+			Sink.fetch_add(Tiles.size() + ObjectCount, std::memory_order_relaxed);
+		});
+	}
+}
+
+void RunImportBenchmarks()
+{
+	RunOBJ(64);
+	RunOBJ(256);
+	RunTMX();
+}
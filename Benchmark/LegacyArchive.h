@@ -0,0 +1,93 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+* sArchive write path before geometric growth and the bulk copies:
+* every write resizes by its own size, strings go char by char and vectors element by element.
+* Kept as the baseline for the archive benchmarks, the bytes written are the same as sArchive.
+*/
+class sLegacyArchiveWriter
+{
+public:
+	sLegacyArchiveWriter() = default;
+
+	void ResizeData(std::size_t Size) { Data.resize(Size); }
+	std::size_t GetSize() const { return Data.size(); }
+
+	template <typename T>
+	sLegacyArchiveWriter& operator<<(const T& data)
+	{
+		Serialize(data);
+		return *this;
+	}
+
+	template <typename T>
+	sLegacyArchiveWriter& operator<<(const std::vector<T>& data)
+	{
+		std::size_t Size = data.size();
+		(*this) << Size;
+		for (std::size_t i = 0; i < Size; i++)
+			(*this) << data.at(i);
+		return *this;
+	}
+
+	sLegacyArchiveWriter& operator<<(const std::string& STR)
+	{
+		for (const auto& pchar : STR)
+			(*this) << pchar;
+
+		std::size_t found = STR.find('\0');
+		if (found == std::string::npos)
+			(*this) << '\0';
+
+		return *this;
+	}
+
+private:
+	template <typename T>
+	void Serialize(const T& data)
+	{
+		const std::size_t dataSize = sizeof(data);
+		const std::size_t reqSize = pos + dataSize;
+		if (reqSize > Data.size())
+			Data.resize(Data.size() + dataSize);
+
+		if (reqSize <= Data.size())
+		{
+			memcpy(&Data[pos], &data, dataSize);
+			pos = reqSize;
+		}
+	}
+
+	std::size_t pos = 0;
+	std::vector<std::uint8_t> Data;
+};
@@ -0,0 +1,110 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+#include <functional>
+
+/*
+* Single mutex ThreadPool the engine used before the work-stealing job system.
+* Kept as the baseline for the thread pool benchmarks.
+*/
+class sLegacyThreadPool
+{
+public:
+	sLegacyThreadPool() = default;
+
+	~sLegacyThreadPool()
+	{
+		Stop();
+	}
+
+	void Start(std::size_t num_threads)
+	{
+		should_terminate = false;
+		for (std::size_t ii = 0; ii < num_threads; ++ii)
+		{
+			threads.emplace_back(std::thread(&sLegacyThreadPool::ThreadLoop, this));
+		}
+	}
+
+	void QueueJob(const std::function<void()>& job)
+	{
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex);
+			jobs.push(job);
+		}
+		mutex_condition.notify_one();
+	}
+
+	void Stop()
+	{
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex);
+			should_terminate = true;
+		}
+		mutex_condition.notify_all();
+		for (std::thread& active_thread : threads)
+		{
+			active_thread.join();
+		}
+		threads.clear();
+	}
+
+private:
+	void ThreadLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(queue_mutex);
+				mutex_condition.wait(lock, [this] {
+					return !jobs.empty() || should_terminate;
+					});
+				if (should_terminate)
+				{
+					return;
+				}
+				job = jobs.front();
+				jobs.pop();
+			}
+			job();
+		}
+	}
+
+	std::atomic<bool> should_terminate = false;
+	std::mutex queue_mutex;
+	std::condition_variable mutex_condition;
+	std::vector<std::thread> threads;
+	std::queue<std::function<void()>> jobs;
+};
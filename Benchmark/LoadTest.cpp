@@ -0,0 +1,710 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+
+#include "LoadTest.h"
+#include "Benchmark.h"
+#include <Engine/AbstractEngine.h>
+#include <Engine/Network.h>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace
+{
+	/*
+	* WSServer and WSClient pad every packet to one slot.
+	*/
+	constexpr std::size_t FrameSize = 256;
+
+	/*
+	* Shared by every client, rates come from two snapshots taken around the measured window.
+	*/
+	struct sLoadTestCounters
+	{
+		std::atomic<std::uint64_t> BytesSent = 0;
+		std::atomic<std::uint64_t> BytesReceived = 0;
+		std::atomic<std::uint64_t> RPCsSent = 0;
+		std::atomic<std::uint64_t> RPCsReceived = 0;
+		std::atomic<std::uint64_t> SkippedBytes = 0;
+		std::atomic<std::uint32_t> Joined = 0;
+		std::atomic<std::uint32_t> Failed = 0;
+		std::atomic<std::uint32_t> Dropped = 0;
+	};
+
+	struct sCounterSnapshot
+	{
+		std::uint64_t BytesSent = 0;
+		std::uint64_t BytesReceived = 0;
+		std::uint64_t RPCsSent = 0;
+		std::uint64_t RPCsReceived = 0;
+
+		static sCounterSnapshot Take(const sLoadTestCounters& Counters)
+		{
+			sCounterSnapshot Snapshot;
+			Snapshot.BytesSent = Counters.BytesSent.load(std::memory_order_relaxed);
+			Snapshot.BytesReceived = Counters.BytesReceived.load(std::memory_order_relaxed);
+			Snapshot.RPCsSent = Counters.RPCsSent.load(std::memory_order_relaxed);
+			Snapshot.RPCsReceived = Counters.RPCsReceived.load(std::memory_order_relaxed);
+			return Snapshot;
+		}
+	};
+
+	/*
+	* Payload of the "OnServerStats" direct call, see WSServer::RequestServerStats.
+	*/
+	struct sServerStatsReply
+	{
+		sNetworkTrafficStats Traffic;
+		std::uint64_t ConnectedPlayers = 0;
+		double TickP50 = 0.0;
+		double TickP95 = 0.0;
+		double TickP99 = 0.0;
+		double TickMax = 0.0;
+		double FrameP50 = 0.0;
+		double FrameP95 = 0.0;
+		double FrameP99 = 0.0;
+		double FrameMax = 0.0;
+
+		friend void operator>>(const sArchiveView& Archive, sServerStatsReply& data)
+		{
+			Archive >> data.Traffic;
+			Archive >> data.ConnectedPlayers;
+			Archive >> data.TickP50;
+			Archive >> data.TickP95;
+			Archive >> data.TickP99;
+			Archive >> data.TickMax;
+			Archive >> data.FrameP50;
+			Archive >> data.FrameP95;
+			Archive >> data.FrameP99;
+			Archive >> data.FrameMax;
+		}
+	};
+
+	/*
+	* The same RPCs GPlayerCharacter sends from a remote client, a press is always followed by its release.
+	*/
+	struct sScriptedInput
+	{
+		const char* FunctionName;
+		bool bIsRelease;
+		bool bSendsFrameCount;
+	};
+	constexpr sScriptedInput InputScript[] =
+	{
+		{ "OnBindKey_RightMovementKey", false, false },
+		{ "OnBindKey_RightMovementKey_Released", true, true },
+		{ "OnBindKey_LeftMovementKey", false, false },
+		{ "OnBindKey_LeftMovementKey_Released", true, true },
+		{ "OnBindKey_JumpMovementKey", false, false },
+		{ "OnBindKey_JumpMovementKey_Released", true, false },
+	};
+
+	enum class ELoadTestClientState : std::uint8_t
+	{
+		eIdle,
+		eValidating,
+		/*
+		* OnClientSuccessfullyConnected is sent, joined once the ping sent after it comes back.
+		*/
+		eJoining,
+		eJoined,
+		eFailed,
+	};
+
+	/*
+	* Checks that a frame starts with a packet header, strings must be terminated inside the frame.
+	* Headers with an RPC handle only have the date and the type byte to check, bundles have empty names.
+	*/
+	bool IsPacketHeader(const std::uint8_t* Frame)
+	{
+		std::int32_t Date[8];
+		std::memcpy(Date, Frame, sizeof(Date));
+		if (Date[0] < 2000 || Date[0] > 2200 || Date[1] < 1 || Date[1] > 12 || Date[2] < 1 || Date[2] > 31 || Date[3] < 0 || Date[3] > 6
+			|| Date[4] < 0 || Date[4] > 23 || Date[5] < 0 || Date[5] > 59 || Date[6] < 0 || Date[6] > 60 || Date[7] < 0 || Date[7] > 999)
+			return false;
+
+		std::size_t Pos = sizeof(Date);
+		auto SkipString = [&]() -> bool
+		{
+			const std::size_t Begin = Pos;
+			while (Pos < FrameSize && Frame[Pos] != 0)
+			{
+				if (Frame[Pos] < 0x20 || Frame[Pos] > 0x7E)
+					return false;
+				Pos++;
+			}
+			if (Pos == Begin || Pos == FrameSize)
+				return false;
+			Pos++;
+			return true;
+		};
+
+		const std::uint8_t Type = Frame[Pos++];
+		if (Type == (std::uint8_t)eNetworkPacketType::Bundle)
+			return Frame[Pos] == 0 && Frame[Pos + 1] == 0 && Frame[Pos + 2] == 0;
+		if ((Type & ~sPacket::HandleFlag) > (std::uint8_t)eNetworkPacketType::DirectCall)
+			return false;
+		if (Type & sPacket::HandleFlag)
+			return Pos + sizeof(sRPCHandle) <= FrameSize;
+		return SkipString() && SkipString() && SkipString();
+	}
+
+	/*
+	* The server sends handles unless Network::SetSendRPCNames is on.
+	*/
+	bool IsCall(const sPacket& Packet, std::string_view ClassName, std::string_view FunctionName)
+	{
+		if (Packet.Handle.IsValid())
+			return Packet.Handle.Member == sRPCHandle::Hash(ClassName, FunctionName);
+		return Packet.ClassName == ClassName && Packet.FunctionName == FunctionName;
+	}
+
+	class sLoadTestClient
+	{
+	public:
+		sLoadTestClient(std::uint32_t InIndex, sLoadTestCounters& InCounters)
+			: Index(InIndex)
+			, Counters(InCounters)
+			, Socket(INVALID_SOCKET)
+			, State(ELoadTestClientState::eIdle)
+			, ScriptStep(0)
+			, LastPingMS(0)
+		{}
+
+		~sLoadTestClient()
+		{
+			Close();
+		}
+
+		ELoadTestClientState GetState() const { return State.load(std::memory_order_acquire); }
+
+		bool Connect(const std::string& Host, std::uint16_t Port)
+		{
+			struct addrinfo* Result = NULL;
+			struct addrinfo Hints;
+			ZeroMemory(&Hints, sizeof(Hints));
+			Hints.ai_family = AF_UNSPEC;
+			Hints.ai_socktype = SOCK_STREAM;
+			Hints.ai_protocol = IPPROTO_TCP;
+
+			if (getaddrinfo(Host.c_str(), std::to_string(Port).c_str(), &Hints, &Result) != 0)
+				return Fail();
+
+			for (auto Ptr = Result; Ptr != NULL; Ptr = Ptr->ai_next)
+			{
+				Socket = socket(Ptr->ai_family, Ptr->ai_socktype, Ptr->ai_protocol);
+				if (Socket == INVALID_SOCKET)
+					continue;
+				if (connect(Socket, Ptr->ai_addr, (int)Ptr->ai_addrlen) != SOCKET_ERROR)
+					break;
+				closesocket(Socket);
+				Socket = INVALID_SOCKET;
+			}
+			freeaddrinfo(Result);
+
+			if (Socket == INVALID_SOCKET)
+				return Fail();
+
+			// One thread polls many clients.
+			u_long NonBlocking = 1;
+			ioctlsocket(Socket, FIONBIO, &NonBlocking);
+
+			// WSClient validates right after connect as well.
+			Send(sPacket(Engine::GetUTCTimeNow(), eNetworkPacketType::Validation, "Global", "WSServer", "ValidateClient", "Some Encrypted Code"));
+			State.store(ELoadTestClientState::eValidating, std::memory_order_release);
+			return true;
+		}
+
+		void Close()
+		{
+			if (Socket == INVALID_SOCKET)
+				return;
+			shutdown(Socket, SD_SEND);
+			closesocket(Socket);
+			Socket = INVALID_SOCKET;
+		}
+
+		/*
+		* Owning thread only. Samples is null outside of the measured window.
+		*/
+		void Tick(const sLoadTestDesc& Desc, std::vector<std::uint32_t>* Samples)
+		{
+			if (Socket == INVALID_SOCKET)
+				return;
+
+			Receive(Samples);
+
+			if (GetState() == ELoadTestClientState::eJoined)
+			{
+				const auto Now = std::chrono::steady_clock::now();
+				if (Now >= NextInputTime)
+				{
+					SendScriptedInput(Now);
+					const double StepSeconds = Desc.InputsPerSecond > 0.0 ? 0.5 / Desc.InputsPerSecond : 1.0;
+					NextInputTime = Now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(StepSeconds));
+				}
+
+				if (Engine::GetUTCTimeNow().GetTotalMillisecond() - LastPingMS >= Desc.PingIntervalMS)
+					Ping();
+
+				if (bStatsRequested.exchange(false, std::memory_order_acq_rel))
+					DirectCall("RequestServerStats", sArchive());
+			}
+
+			Flush();
+		}
+
+		/*
+		* Any thread, sent on the next tick of the owning thread.
+		*/
+		void RequestServerStats()
+		{
+			std::lock_guard<std::mutex> Lock(StatsMutex);
+			ServerStats = std::nullopt;
+			bStatsRequested.store(true, std::memory_order_release);
+		}
+
+		std::optional<sServerStatsReply> GetServerStats()
+		{
+			std::lock_guard<std::mutex> Lock(StatsMutex);
+			return ServerStats;
+		}
+
+	private:
+		bool Fail()
+		{
+			Close();
+			State.store(ELoadTestClientState::eFailed, std::memory_order_release);
+			Counters.Failed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		void Drop()
+		{
+			if (GetState() != ELoadTestClientState::eJoined)
+			{
+				Fail();
+				return;
+			}
+			Close();
+			State.store(ELoadTestClientState::eFailed, std::memory_order_release);
+			Counters.Dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void Send(sPacket Packet)
+		{
+			Packet.Handle = sRPCHandle(Packet.Address, Packet.ClassName, Packet.FunctionName);
+			sArchive Archive;
+			Archive.ResizeData(FrameSize);
+			Archive << Packet;
+			const auto& Data = Archive.GetData();
+			Outgoing.insert(Outgoing.end(), Data.begin(), Data.end());
+		}
+
+		void DirectCall(const std::string& FunctionName, const sArchive& Params)
+		{
+			Send(sPacket(Engine::GetUTCTimeNow(), eNetworkPacketType::DirectCall, "Global", "WSServer", FunctionName, Params.GetDataAsString()));
+		}
+
+		void Ping()
+		{
+			LastPingMS = Engine::GetUTCTimeNow().GetTotalMillisecond();
+			DirectCall("PingFromClient", sArchive(LastPingMS));
+		}
+
+		void SendScriptedInput(std::chrono::steady_clock::time_point Now)
+		{
+			const auto& Input = InputScript[ScriptStep];
+			ScriptStep = (ScriptStep + 1) % std::size(InputScript);
+
+			const int Key = 0;
+			std::string Params;
+			if (Input.bSendsFrameCount)
+			{
+				// Held frames at 60 fps, GNetInputManager replays the press for that long.
+				const auto HeldMS = std::chrono::duration_cast<std::chrono::milliseconds>(Now - PressTime).count();
+				Params = sArchive(Key, (std::uint32_t)(HeldMS * 60 / 1000)).GetDataAsString();
+			}
+			else
+			{
+				Params = sArchive(Key).GetDataAsString();
+			}
+			if (!Input.bIsRelease)
+				PressTime = Now;
+
+			Send(sPacket(Engine::GetUTCTimeNow(), eNetworkPacketType::RPC, PlayerAddress, "GPlayerCharacter", Input.FunctionName, Params));
+			Counters.RPCsSent.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void Flush()
+		{
+			std::size_t Offset = 0;
+			while (Offset < Outgoing.size())
+			{
+				const int Sent = send(Socket, (const char*)Outgoing.data() + Offset, (int)(Outgoing.size() - Offset), 0);
+				if (Sent == SOCKET_ERROR)
+				{
+					if (WSAGetLastError() == WSAEWOULDBLOCK)
+						break;
+					Drop();
+					return;
+				}
+				Offset += Sent;
+				Counters.BytesSent.fetch_add(Sent, std::memory_order_relaxed);
+			}
+			Outgoing.erase(Outgoing.begin(), Outgoing.begin() + Offset);
+		}
+
+		void Receive(std::vector<std::uint32_t>* Samples)
+		{
+			std::uint8_t Buffer[FrameSize * 16];
+			while (true)
+			{
+				const int Received = recv(Socket, (char*)Buffer, (int)sizeof(Buffer), 0);
+				if (Received > 0)
+				{
+					Incoming.insert(Incoming.end(), Buffer, Buffer + Received);
+					Counters.BytesReceived.fetch_add(Received, std::memory_order_relaxed);
+					continue;
+				}
+				if (Received == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK)
+					break;
+				// Closed by the server (kicked or full) or a socket error.
+				Drop();
+				return;
+			}
+
+			// Packets larger than a slot go out unpadded, the following ones no longer start on a slot boundary.
+			// Skip forward until a header shows up again, the tail of the large packet is lost either way.
+			std::size_t Offset = 0;
+			while (Incoming.size() - Offset >= FrameSize)
+			{
+				if (!IsPacketHeader(Incoming.data() + Offset))
+				{
+					Offset++;
+					Counters.SkippedBytes.fetch_add(1, std::memory_order_relaxed);
+					continue;
+				}
+				HandleFrame(Incoming.data() + Offset, Samples);
+				Offset += FrameSize;
+			}
+			Incoming.erase(Incoming.begin(), Incoming.begin() + Offset);
+		}
+
+		void HandleFrame(const std::uint8_t* Frame, std::vector<std::uint32_t>* Samples)
+		{
+			const sArchiveView Archive(Frame, FrameSize);
+			sPacket Packet;
+			Archive >> Packet;
+
+			if (Packet.Type != eNetworkPacketType::Bundle)
+			{
+				HandlePacket(Packet, Samples);
+				return;
+			}
+
+			// The server bundles what it sends in a tick, [std::uint16_t Size][encoded packet] each.
+			const sArchiveView Entries(Packet.Data);
+			while (Entries.GetRemainingSize() >= sizeof(std::uint16_t))
+			{
+				std::uint16_t Size = 0;
+				Entries.ReadBytes(&Size, sizeof(Size));
+				if (Size == 0 || Size > Entries.GetRemainingSize())
+					break;
+				sPacket Inner;
+				Entries.Consume(Size) >> Inner;
+				HandlePacket(Inner, Samples);
+			}
+		}
+
+		void HandlePacket(const sPacket& Packet, std::vector<std::uint32_t>* Samples)
+		{
+			const sArchiveView Params(Packet.Data);
+
+			if (Packet.Type == eNetworkPacketType::RPC)
+			{
+				Counters.RPCsReceived.fetch_add(1, std::memory_order_relaxed);
+
+				if (IsCall(Packet, "WSClient", "OnConnected") && GetState() == ELoadTestClientState::eValidating)
+				{
+					sServerInfo::sConnectedPlayerInfo Info;
+					Params >> Info;
+					PlayerAddress = Info.NetworkAddress;
+
+					sClientInfo ClientInfo;
+					ClientInfo.PlayerName = "LoadTest_" + std::to_string(Index);
+					DirectCall("OnClientSuccessfullyConnected", sArchive(ClientInfo));
+					Ping();
+					State.store(ELoadTestClientState::eJoining, std::memory_order_release);
+				}
+			}
+			else if (Packet.Type == eNetworkPacketType::DirectCall)
+			{
+				if (IsCall(Packet, "WSClient", "PingFromServer"))
+				{
+					std::uint64_t SentMS = 0;
+					Params >> SentMS;
+					const std::uint64_t NowMS = Engine::GetUTCTimeNow().GetTotalMillisecond();
+
+					if (GetState() == ELoadTestClientState::eJoining)
+					{
+						// Handled in order, the server has spawned the character by now.
+						State.store(ELoadTestClientState::eJoined, std::memory_order_release);
+						Counters.Joined.fetch_add(1, std::memory_order_relaxed);
+						NextInputTime = std::chrono::steady_clock::now();
+					}
+					else if (Samples && NowMS >= SentMS)
+					{
+						Samples->push_back((std::uint32_t)(NowMS - SentMS));
+					}
+				}
+				else if (IsCall(Packet, "WSClient", "OnServerStats"))
+				{
+					sServerStatsReply Reply;
+					Params >> Reply;
+					std::lock_guard<std::mutex> Lock(StatsMutex);
+					ServerStats = Reply;
+				}
+			}
+		}
+
+		std::uint32_t Index;
+		sLoadTestCounters& Counters;
+		SOCKET Socket;
+		std::atomic<ELoadTestClientState> State;
+
+		std::string PlayerAddress;
+		std::vector<std::uint8_t> Incoming;
+		std::vector<std::uint8_t> Outgoing;
+
+		std::size_t ScriptStep;
+		std::chrono::steady_clock::time_point NextInputTime;
+		std::chrono::steady_clock::time_point PressTime;
+		std::uint64_t LastPingMS;
+
+		std::atomic<bool> bStatsRequested = false;
+		std::mutex StatsMutex;
+		std::optional<sServerStatsReply> ServerStats;
+	};
+
+	double Percentile(const std::vector<std::uint32_t>& Sorted, double P)
+	{
+		if (Sorted.empty())
+			return 0.0;
+		const std::size_t Rank = (std::size_t)std::ceil(P * (double)Sorted.size());
+		return (double)Sorted[std::min(Sorted.size() - 1, Rank > 0 ? Rank - 1 : 0)];
+	}
+
+	/*
+	* Asks the first joined client for the server counters and waits for the answer.
+	*/
+	std::optional<sServerStatsReply> QueryServerStats(const std::vector<std::unique_ptr<sLoadTestClient>>& Clients)
+	{
+		for (const auto& Client : Clients)
+		{
+			if (Client->GetState() != ELoadTestClientState::eJoined)
+				continue;
+
+			Client->RequestServerStats();
+			const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+			while (std::chrono::steady_clock::now() < Deadline)
+			{
+				if (auto Reply = Client->GetServerStats())
+					return Reply;
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			}
+			return std::nullopt;
+		}
+		return std::nullopt;
+	}
+}
+
+bool RunLoadTest(const sLoadTestDesc& Desc, const std::string& JSONPath)
+{
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+	{
+		std::cout << "LoadTest : WSAStartup failed" << std::endl;
+		return false;
+	}
+
+	sLoadTestCounters Counters;
+	std::vector<std::unique_ptr<sLoadTestClient>> Clients;
+	Clients.reserve(Desc.Clients);
+	for (std::uint32_t i = 0; i < Desc.Clients; i++)
+		Clients.push_back(std::make_unique<sLoadTestClient>(i, Counters));
+
+	const std::uint32_t ThreadCount = std::max<std::uint32_t>(1, std::min(Desc.Threads, Desc.Clients));
+	std::atomic<bool> bRunning = true;
+	std::atomic<bool> bMeasuring = false;
+	std::vector<std::vector<std::uint32_t>> Samples(ThreadCount);
+	std::vector<std::thread> Threads;
+
+	std::cout << "LoadTest : " << Desc.Clients << " clients on " << ThreadCount << " threads -> " << Desc.Host << ":" << Desc.Port << std::endl;
+
+	const auto RampStart = std::chrono::steady_clock::now();
+	for (std::uint32_t t = 0; t < ThreadCount; t++)
+	{
+		Threads.emplace_back([&, t]()
+		{
+			// Client i belongs to thread i % ThreadCount, connects are spread over the ramp in index order.
+			std::uint32_t NextConnect = t;
+			while (bRunning.load(std::memory_order_acquire))
+			{
+				const double Elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - RampStart).count();
+				while (NextConnect < Desc.Clients && (Desc.ConnectsPerSecond == 0 || NextConnect <= Elapsed * Desc.ConnectsPerSecond))
+				{
+					Clients[NextConnect]->Connect(Desc.Host, Desc.Port);
+					NextConnect += ThreadCount;
+				}
+
+				auto* ThreadSamples = bMeasuring.load(std::memory_order_acquire) ? &Samples[t] : nullptr;
+				for (std::uint32_t i = t; i < Desc.Clients; i += ThreadCount)
+					Clients[i]->Tick(Desc, ThreadSamples);
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		});
+	}
+
+	// Ramp up, a client that neither joins nor fails within the timeout is counted as stuck.
+	const double RampSeconds = (Desc.ConnectsPerSecond > 0 ? (double)Desc.Clients / Desc.ConnectsPerSecond : 0.0) + 10.0;
+	while (Counters.Joined.load() + Counters.Failed.load() < Desc.Clients
+		&& std::chrono::duration<double>(std::chrono::steady_clock::now() - RampStart).count() < RampSeconds)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+	const double RampTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - RampStart).count();
+	const std::uint32_t JoinedAtStart = Counters.Joined.load();
+	std::cout << "LoadTest : " << JoinedAtStart << " joined, " << Counters.Failed.load() << " failed in " << RampTime << "s" << std::endl;
+
+	std::optional<sServerStatsReply> ServerBegin = QueryServerStats(Clients);
+
+	const sCounterSnapshot Begin = sCounterSnapshot::Take(Counters);
+	const auto MeasureStart = std::chrono::steady_clock::now();
+	bMeasuring.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::duration<double>(Desc.Seconds));
+	bMeasuring.store(false, std::memory_order_release);
+	const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - MeasureStart).count();
+	const sCounterSnapshot End = sCounterSnapshot::Take(Counters);
+
+	std::optional<sServerStatsReply> ServerEnd = QueryServerStats(Clients);
+
+	bRunning.store(false, std::memory_order_release);
+	for (auto& Thread : Threads)
+		Thread.join();
+	Clients.clear();
+	WSACleanup();
+
+	std::vector<std::uint32_t> Latency;
+	for (const auto& ThreadSamples : Samples)
+		Latency.insert(Latency.end(), ThreadSamples.begin(), ThreadSamples.end());
+	std::sort(Latency.begin(), Latency.end());
+
+	const double ClientSeconds = std::max(1.0, (double)JoinedAtStart) * Seconds;
+	const double BytesSentPerClient = (double)(End.BytesSent - Begin.BytesSent) / ClientSeconds;
+	const double BytesReceivedPerClient = (double)(End.BytesReceived - Begin.BytesReceived) / ClientSeconds;
+	const double RPCsSentPerSecond = (double)(End.RPCsSent - Begin.RPCsSent) / Seconds;
+	const double RPCsReceivedPerSecond = (double)(End.RPCsReceived - Begin.RPCsReceived) / Seconds;
+
+	std::cout << "LoadTest : per client " << BytesSentPerClient << " B/s up, " << BytesReceivedPerClient << " B/s down" << std::endl;
+	std::cout << "LoadTest : RPCs " << RPCsSentPerSecond << "/s sent, " << RPCsReceivedPerSecond << "/s received" << std::endl;
+	std::cout << "LoadTest : latency p50: " << Percentile(Latency, 0.50) << "ms p95: " << Percentile(Latency, 0.95) << "ms p99: " << Percentile(Latency, 0.99)
+		<< "ms (" << Latency.size() << " samples)" << std::endl;
+	std::cout << "LoadTest : " << Counters.Dropped.load() << " dropped, " << Counters.SkippedBytes.load() << " bytes skipped to resync" << std::endl;
+
+	const bool bHasServerStats = ServerBegin.has_value() && ServerEnd.has_value();
+	double ServerTickAvgMS = 0.0;
+	if (bHasServerStats)
+	{
+		const auto& B = ServerBegin->Traffic;
+		const auto& E = ServerEnd->Traffic;
+		const std::uint64_t Ticks = E.TickCount - B.TickCount;
+		ServerTickAvgMS = Ticks > 0 ? (E.TickTimeTotalMS - B.TickTimeTotalMS) / (double)Ticks : 0.0;
+		std::cout << "LoadTest : server network tick avg: " << ServerTickAvgMS << "ms, engine tick p50: " << ServerEnd->TickP50
+			<< "ms p99: " << ServerEnd->TickP99 << "ms max: " << ServerEnd->TickMax << "ms, RPCs handled "
+			<< (double)(E.RPCsHandled - B.RPCsHandled) / Seconds << "/s" << std::endl;
+	}
+	else
+	{
+		std::cout << "LoadTest : no answer to RequestServerStats, server counters are missing" << std::endl;
+	}
+
+	std::ofstream File(JSONPath, std::ios::out | std::ios::trunc);
+	if (!File.is_open())
+	{
+		std::cout << "Failed to write " << JSONPath << std::endl;
+		return false;
+	}
+
+	File << "{\n";
+	File << "  \"schema\": 1,\n";
+	File << "  \"clients\": " << Desc.Clients << ",\n";
+	File << "  \"threads\": " << ThreadCount << ",\n";
+	File << "  \"inputs_per_second\": " << Desc.InputsPerSecond << ",\n";
+	File << "  \"ramp_seconds\": " << RampTime << ",\n";
+	File << "  \"seconds\": " << Seconds << ",\n";
+	File << "  \"joined\": " << JoinedAtStart << ",\n";
+	File << "  \"failed\": " << Counters.Failed.load() << ",\n";
+	File << "  \"dropped\": " << Counters.Dropped.load() << ",\n";
+	File << "  \"skipped_bytes\": " << Counters.SkippedBytes.load() << ",\n";
+	File << "  \"bytes_sent_per_client_per_second\": " << BytesSentPerClient << ",\n";
+	File << "  \"bytes_received_per_client_per_second\": " << BytesReceivedPerClient << ",\n";
+	File << "  \"rpcs_sent_per_second\": " << RPCsSentPerSecond << ",\n";
+	File << "  \"rpcs_received_per_second\": " << RPCsReceivedPerSecond << ",\n";
+	File << "  \"latency_ms\": { \"samples\": " << Latency.size()
+		<< ", \"p50\": " << Percentile(Latency, 0.50)
+		<< ", \"p95\": " << Percentile(Latency, 0.95)
+		<< ", \"p99\": " << Percentile(Latency, 0.99)
+		<< ", \"max\": " << (Latency.empty() ? 0.0 : (double)Latency.back()) << " }";
+	if (bHasServerStats)
+	{
+		const auto& B = ServerBegin->Traffic;
+		const auto& E = ServerEnd->Traffic;
+		File << ",\n  \"server\": {\n";
+		File << "    \"connected_players\": " << ServerEnd->ConnectedPlayers << ",\n";
+		File << "    \"bytes_received_per_second\": " << (double)(E.BytesReceived - B.BytesReceived) / Seconds << ",\n";
+		File << "    \"bytes_sent_per_second\": " << (double)(E.BytesSent - B.BytesSent) / Seconds << ",\n";
+		File << "    \"packets_received_per_second\": " << (double)(E.PacketsReceived - B.PacketsReceived) / Seconds << ",\n";
+		File << "    \"packets_sent_per_second\": " << (double)(E.PacketsSent - B.PacketsSent) / Seconds << ",\n";
+		File << "    \"rpcs_handled_per_second\": " << (double)(E.RPCsHandled - B.RPCsHandled) / Seconds << ",\n";
+		File << "    \"network_tick_avg_ms\": " << ServerTickAvgMS << ",\n";
+		File << "    \"network_tick_max_ms\": " << E.TickTimeMaxMS << ",\n";
+		File << "    \"engine_tick_ms\": { \"p50\": " << ServerEnd->TickP50 << ", \"p95\": " << ServerEnd->TickP95 << ", \"p99\": " << ServerEnd->TickP99 << ", \"max\": " << ServerEnd->TickMax << " },\n";
+		File << "    \"frame_ms\": { \"p50\": " << ServerEnd->FrameP50 << ", \"p95\": " << ServerEnd->FrameP95 << ", \"p99\": " << ServerEnd->FrameP99 << ", \"max\": " << ServerEnd->FrameMax << " }\n";
+		File << "  }";
+	}
+	File << "\n}\n";
+
+	std::cout << "Results written to " << JSONPath << std::endl;
+	return JoinedAtStart > 0;
+}
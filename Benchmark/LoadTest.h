@@ -0,0 +1,69 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/*
+* Simulated clients for a running WSServer (a Sample1 host or dedicated server).
+* Clients speak the Winsock wire protocol directly, they don't create a game instance or register RPCs,
+* so hundreds of them fit in one process. Each one connects, validates, joins the level and then
+* drives the GPlayerCharacter key RPCs and pings like a real client.
+* The server has to be started with a player limit at least as high as Clients.
+*/
+struct sLoadTestDesc
+{
+	std::string Host = "127.0.0.1";
+	std::uint16_t Port = 27020;
+	std::uint32_t Clients = 100;
+	/*
+	* Clients are spread over the threads, each thread polls its own sockets.
+	*/
+	std::uint32_t Threads = 4;
+	/*
+	* Measured window, starts once every client joined or failed.
+	*/
+	double Seconds = 30.0;
+	/*
+	* Key presses per client per second, each press is followed by its release RPC.
+	*/
+	double InputsPerSecond = 10.0;
+	/*
+	* Same interval as WSClient.
+	*/
+	std::uint32_t PingIntervalMS = 60;
+	/*
+	* Connect rate while ramping up, the accept thread drops nothing but a burst skews the first seconds.
+	*/
+	std::uint32_t ConnectsPerSecond = 50;
+};
+
+/*
+* Returns false if no client could join or the report couldn't be written.
+*/
+bool RunLoadTest(const sLoadTestDesc& Desc, const std::string& JSONPath);
@@ -0,0 +1,149 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include <Engine/RemoteProcedureCall.h>
+#include <atomic>
+
+namespace
+{
+	constexpr std::size_t ClassesPerAddress = 4;
+	constexpr std::size_t RPCsPerClass = 16;
+	constexpr std::size_t LookupCount = 10000;
+	constexpr std::size_t Iterations = 20;
+
+	/*
+	* Keeps the work from being optimized out.
+	*/
+	std::atomic<std::uint64_t> Sink = 0;
+
+	std::string AddressName(std::size_t Index) { return "BenchmarkActor_" + std::to_string(Index); }
+	std::string ClassName(std::size_t Index) { return "Component_" + std::to_string(Index); }
+	std::string RPCName(std::size_t Index) { return "OnReplicated_" + std::to_string(Index); }
+
+	void Register(std::size_t AddressCount)
+	{
+		auto& Manager = RemoteProcedureCallManager::Get();
+		for (std::size_t Address = 0; Address < AddressCount; Address++)
+		{
+			for (std::size_t Class = 0; Class < ClassesPerAddress; Class++)
+			{
+				for (std::size_t RPC = 0; RPC < RPCsPerClass; RPC++)
+				{
+					std::function<void(int, float)> Fn = [](int I, float F)
+					{
+						Sink.fetch_add(I + (std::uint64_t)F, std::memory_order_relaxed);
+					};
+					Manager.Register(AddressName(Address), ClassName(Class), new RemoteProcedureCall<int, float>(eRPCType::ServerAndClient, RPCName(RPC), true, false, Fn));
+				}
+			}
+		}
+	}
+
+	void Unregister(std::size_t AddressCount)
+	{
+		auto& Manager = RemoteProcedureCallManager::Get();
+		for (std::size_t Address = 0; Address < AddressCount; Address++)
+			Manager.Unregister(AddressName(Address));
+	}
+
+	/*
+	* Lookups are precomputed so the scenarios measure the manager, not std::to_string.
+	*/
+	struct sLookup
+	{
+		std::string Address;
+		std::string Class;
+		std::string Name;
+		sRPCHandle Handle;
+	};
+
+	std::vector<sLookup> MakeLookups(std::size_t AddressCount)
+	{
+		std::vector<sLookup> Lookups(LookupCount);
+		std::uint64_t Seed = 0x9E3779B97F4A7C15ull;
+		for (auto& Lookup : Lookups)
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			Lookup.Address = AddressName((Seed >> 33) % AddressCount);
+			Lookup.Class = ClassName((Seed >> 17) % ClassesPerAddress);
+			Lookup.Name = RPCName((Seed >> 7) % RPCsPerClass);
+			Lookup.Handle = sRPCHandle(Lookup.Address, Lookup.Class, Lookup.Name);
+		}
+		return Lookups;
+	}
+
+	void RunRPC(std::size_t AddressCount)
+	{
+		Register(AddressCount);
+		const std::vector<sLookup> Lookups = MakeLookups(AddressCount);
+		const std::string Suffix = "/Addresses" + std::to_string(AddressCount);
+
+		sBenchmark::Get().Run("Network/RPC/GetRPC" + Suffix, Iterations, LookupCount, [&]()
+		{
+			auto& Manager = RemoteProcedureCallManager::Get();
+			std::uint64_t Found = 0;
+			for (const auto& Lookup : Lookups)
+				Found += Manager.GetRPC(Lookup.Address, Lookup.Class, Lookup.Name) != nullptr;
+			Sink.fetch_add(Found, std::memory_order_relaxed);
+		});
+
+		/*
+		* Receive side lookup of a packet that carries the handle instead of the names.
+		*/
+		sBenchmark::Get().Run("Network/RPC/GetRPCByHandle" + Suffix, Iterations, LookupCount, [&]()
+		{
+			auto& Manager = RemoteProcedureCallManager::Get();
+			std::uint64_t Found = 0;
+			for (const auto& Lookup : Lookups)
+				Found += Manager.GetRPC(Lookup.Handle) != nullptr;
+			Sink.fetch_add(Found, std::memory_order_relaxed);
+		});
+
+		/*
+		* Lookup plus parameter decode and call, the receive path of a single RPC packet.
+		*/
+		const sArchive Params(42, 1.5f);
+		sBenchmark::Get().Run("Network/RPC/Dispatch" + Suffix, Iterations, LookupCount, [&]()
+		{
+			auto& Manager = RemoteProcedureCallManager::Get();
+			for (const auto& Lookup : Lookups)
+			{
+				if (auto RPC = Manager.GetRPC(Lookup.Handle))
+					RPC->Call(Params);
+			}
+		});
+
+		Unregister(AddressCount);
+	}
+}
+
+void RunNetworkBenchmarks()
+{
+	RunRPC(16);
+	RunRPC(256);
+	RunRPC(1024);
+}
@@ -0,0 +1,86 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include <Engine/World2D.h>
+
+namespace
+{
+	constexpr std::size_t Iterations = 60;
+	constexpr double DeltaTime = 1.0 / 60.0;
+
+	/*
+	* Dynamic boxes dropped in a grid onto a static ground, the pile keeps generating contacts while the scenario runs.
+	*/
+	void RunWorld2DTick(std::size_t BodyCount)
+	{
+		const std::string Name = "Physics/World2D/Tick/Bodies" + std::to_string(BodyCount);
+		if (!sBenchmark::Get().ShouldRun(Name))
+			return;
+
+		constexpr float BoxSize = 16.0f;
+		const std::size_t Columns = 64;
+		const float GroundY = (float)((BodyCount / Columns) + 4) * BoxSize * 1.5f;
+
+		sWorld2D::SharedPtr World = sWorld2D::Create();
+		std::vector<IRigidBody::SharedPtr> Bodies;
+		Bodies.reserve(BodyCount + 1);
+
+		{
+			sRigidBodyDesc Desc;
+			Desc.RigidBodyType = ERigidBodyType::Static;
+			Desc.Friction = 1.0f;
+			const float Width = Columns * BoxSize * 2.0f;
+			Bodies.push_back(World->Create2DBoxBody(nullptr, Desc, FBounds2D(FVector2(0.0f, GroundY), FVector2(Width, GroundY + BoxSize))));
+		}
+
+		for (std::size_t i = 0; i < BodyCount; i++)
+		{
+			sRigidBodyDesc Desc;
+			Desc.RigidBodyType = ERigidBodyType::Dynamic;
+			Desc.Mass = 1.0f;
+			Desc.Friction = 0.5f;
+			Desc.Restitution = 0.1f;
+
+			const float X = (float)(i % Columns) * BoxSize * 1.5f + BoxSize;
+			const float Y = (float)(i / Columns) * BoxSize * 1.5f;
+			Bodies.push_back(World->Create2DBoxBody(nullptr, Desc, FBounds2D(FVector2(X, Y), FVector2(X + BoxSize, Y + BoxSize))));
+		}
+
+		sBenchmark::Get().Run(Name, Iterations, BodyCount, [&]()
+		{
+			World->Tick(DeltaTime);
+		});
+
+		Bodies.clear();
+	}
+}
+
+void RunPhysicsBenchmarks()
+{
+	for (const std::size_t BodyCount : { 100, 1000, 5000 })
+		RunWorld2DTick(BodyCount);
+}
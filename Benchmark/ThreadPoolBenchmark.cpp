@@ -0,0 +1,181 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include "LegacyThreadPool.h"
+#include <Core/ThreadPool.h>
+#include <cmath>
+
+namespace
+{
+	/*
+	* Fits the submitting thread's deque, more would spill into the locked injection queue and measure that instead.
+	*/
+	constexpr std::size_t SmallJobCount = (std::size_t)sJobDeque::Capacity;
+	constexpr std::size_t ElementCount = 1000000;
+	constexpr std::size_t BatchSize = 1024;
+	constexpr std::size_t Iterations = 10;
+
+	/*
+	* Keeps the work from being optimized out.
+	*/
+	std::atomic<std::uint64_t> Sink = 0;
+
+	inline std::uint64_t SmallWork(std::size_t Index)
+	{
+		std::uint64_t Value = Index;
+		for (std::uint32_t i = 0; i < 64; i++)
+			Value = Value * 6364136223846793005ull + 1442695040888963407ull;
+		return Value;
+	}
+
+	/*
+	* Both pools run ThreadCount workers and get one job per item or batch.
+	* The calling thread only submits and waits, it never runs jobs on either pool.
+	*/
+	void WaitForCounter(const std::atomic<std::size_t>& Counter, std::size_t Expected)
+	{
+		while (Counter.load(std::memory_order_acquire) < Expected)
+			std::this_thread::yield();
+	}
+
+	void RunLegacy(std::size_t ThreadCount, const std::vector<float>& Elements)
+	{
+		sLegacyThreadPool Pool;
+		Pool.Start(ThreadCount);
+
+		const std::string Suffix = "/Legacy/T" + std::to_string(ThreadCount);
+
+		sBenchmark::Get().Run("ThreadPool/SmallJobs" + Suffix, Iterations, [&]()
+		{
+			std::atomic<std::size_t> Counter = 0;
+			for (std::size_t i = 0; i < SmallJobCount; i++)
+			{
+				Pool.QueueJob([&Counter, i]()
+				{
+					Sink.fetch_add(SmallWork(i), std::memory_order_relaxed);
+					Counter.fetch_add(1, std::memory_order_release);
+				});
+			}
+			WaitForCounter(Counter, SmallJobCount);
+		});
+
+		sBenchmark::Get().Run("ThreadPool/ParallelFor" + Suffix, Iterations, [&]()
+		{
+			const std::size_t BatchCount = (Elements.size() + BatchSize - 1) / BatchSize;
+			std::atomic<std::size_t> Counter = 0;
+			for (std::size_t Batch = 0; Batch < BatchCount; Batch++)
+			{
+				Pool.QueueJob([&Counter, &Elements, Batch]()
+				{
+					const std::size_t End = std::min(Elements.size(), (Batch + 1) * BatchSize);
+					double Sum = 0.0;
+					for (std::size_t i = Batch * BatchSize; i < End; i++)
+						Sum += std::sqrt(Elements[i]);
+					Sink.fetch_add((std::uint64_t)Sum, std::memory_order_relaxed);
+					Counter.fetch_add(1, std::memory_order_release);
+				});
+			}
+			WaitForCounter(Counter, BatchCount);
+		});
+
+		Pool.Stop();
+	}
+
+	void RunWorkStealing(std::size_t ThreadCount, const std::vector<float>& Elements)
+	{
+		ThreadPool Pool;
+		Pool.Start(ThreadCount);
+
+		const std::string Suffix = "/WorkStealing/T" + std::to_string(ThreadCount);
+
+		sBenchmark::Get().Run("ThreadPool/SmallJobs" + Suffix, Iterations, [&]()
+		{
+			std::atomic<std::size_t> Counter = 0;
+			for (std::size_t i = 0; i < SmallJobCount; i++)
+			{
+				Pool.Schedule([&Counter, i]()
+				{
+					Sink.fetch_add(SmallWork(i), std::memory_order_relaxed);
+					Counter.fetch_add(1, std::memory_order_release);
+				});
+			}
+			WaitForCounter(Counter, SmallJobCount);
+		});
+
+		sBenchmark::Get().Run("ThreadPool/ParallelFor" + Suffix, Iterations, [&]()
+		{
+			const std::size_t BatchCount = (Elements.size() + BatchSize - 1) / BatchSize;
+			std::atomic<std::size_t> Counter = 0;
+			for (std::size_t Batch = 0; Batch < BatchCount; Batch++)
+			{
+				Pool.Schedule([&Counter, &Elements, Batch]()
+				{
+					const std::size_t End = std::min(Elements.size(), (Batch + 1) * BatchSize);
+					double Sum = 0.0;
+					for (std::size_t i = Batch * BatchSize; i < End; i++)
+						Sum += std::sqrt(Elements[i]);
+					Sink.fetch_add((std::uint64_t)Sum, std::memory_order_relaxed);
+					Counter.fetch_add(1, std::memory_order_release);
+				});
+			}
+			WaitForCounter(Counter, BatchCount);
+		});
+
+		/*
+		* No legacy counterpart, the legacy pool cannot wait inside a job.
+		* Jobs waiting on their own child jobs, waiting threads keep executing jobs instead of blocking.
+		*/
+		sBenchmark::Get().Run("ThreadPool/NestedJobs" + Suffix, Iterations, [&]()
+		{
+			const sJobHandle Handle = Pool.ParallelFor(64, 1, [&Pool](std::size_t i)
+			{
+				Pool.Wait(Pool.ParallelFor(64, 1, [i](std::size_t j)
+				{
+					Sink.fetch_add(SmallWork(i * 64 + j), std::memory_order_relaxed);
+				}));
+			});
+			while (!Handle.IsCompleted())
+				std::this_thread::yield();
+		});
+
+		Pool.Stop();
+	}
+}
+
+void RunThreadPoolBenchmarks()
+{
+	std::vector<float> Elements(ElementCount);
+	for (std::size_t i = 0; i < Elements.size(); i++)
+		Elements[i] = (float)i;
+
+	const std::size_t MaxThreadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	for (std::size_t ThreadCount = 1; ThreadCount <= MaxThreadCount; ThreadCount = ThreadCount < MaxThreadCount ? std::min(ThreadCount * 2, MaxThreadCount) : ThreadCount + 1)
+	{
+		RunLegacy(ThreadCount, Elements);
+		RunWorkStealing(ThreadCount, Elements);
+	}
+}
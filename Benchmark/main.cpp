@@ -0,0 +1,94 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "Benchmark.h"
+#include "LoadTest.h"
+#include <optional>
+
+#pragma comment(lib, "Engine.lib")
+#pragma comment(lib, "CBGUI.lib")
+#pragma comment(lib, "freetype.lib")
+#pragma comment(lib, "Pdh.lib")
+#pragma comment(lib, "dxcompiler.lib")
+#pragma comment(lib, "box2d.lib")
+
+/*
+* Benchmark.exe [--filter <text>] [--json <path>]
+* --filter runs only the scenarios whose name contains the text.
+* --json sets the output path, results are written to BenchmarkResults.json by default.
+*
+* Benchmark.exe --loadtest [--host <ip>] [--port <port>] [--clients <n>] [--threads <n>] [--seconds <s>] [--inputs <per second>] [--json <path>]
+* Runs simulated clients against a running server instead of the scenarios, see LoadTest.h.
+* Results are written to LoadTestResults.json by default.
+*/
+int main(int argc, char* argv[])
+{
+	bool bLoadTest = false;
+	sLoadTestDesc LoadTestDesc;
+	std::optional<std::string> JSONArg;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string Arg = argv[i];
+		if (Arg == "--filter" && i + 1 < argc)
+			sBenchmark::Get().SetFilter(argv[++i]);
+		else if (Arg == "--json" && i + 1 < argc)
+			JSONArg = argv[++i];
+		else if (Arg == "--loadtest")
+			bLoadTest = true;
+		else if (Arg == "--host" && i + 1 < argc)
+			LoadTestDesc.Host = argv[++i];
+		else if (Arg == "--port" && i + 1 < argc)
+			LoadTestDesc.Port = (std::uint16_t)std::stoul(argv[++i]);
+		else if (Arg == "--clients" && i + 1 < argc)
+			LoadTestDesc.Clients = (std::uint32_t)std::stoul(argv[++i]);
+		else if (Arg == "--threads" && i + 1 < argc)
+			LoadTestDesc.Threads = (std::uint32_t)std::stoul(argv[++i]);
+		else if (Arg == "--seconds" && i + 1 < argc)
+			LoadTestDesc.Seconds = std::stod(argv[++i]);
+		else if (Arg == "--inputs" && i + 1 < argc)
+			LoadTestDesc.InputsPerSecond = std::stod(argv[++i]);
+	}
+
+	if (bLoadTest)
+		return RunLoadTest(LoadTestDesc, JSONArg.value_or("LoadTestResults.json")) ? 0 : 1;
+
+	const std::string JSONPath = JSONArg.value_or("BenchmarkResults.json");
+
+	RunThreadPoolBenchmarks();
+	RunArchiveBenchmarks();
+	RunNetworkBenchmarks();
+	RunGameplayBenchmarks();
+	RunPhysicsBenchmarks();
+	RunImportBenchmarks();
+
+	if (!sBenchmark::Get().WriteJSON(JSONPath))
+	{
+		std::cout << "Failed to write " << JSONPath << std::endl;
+		return 1;
+	}
+	std::cout << "Results written to " << JSONPath << std::endl;
+	return 0;
+}
@@ -26,6 +26,7 @@
 
 #include "pch.h"
 #include "Core/Archive.h"
+#include "Core/ArchiveFile.h"
 
 #include <fstream>
 #include <sstream>
@@ -57,18 +58,12 @@ void sArchive::OpenFile(std::string FilePath)
 		std::size_t found = str.find_last_of("//\\");
 		FileName = std::string(str.begin() + found + 1, str.end());
 
-		std::ifstream file(FilePath, std::ios::binary | std::ios::ate);
-		if (file.is_open())
+		// One copy out of the mapping, the bytes are kept exactly as they are on disk.
+		sMappedFile File(FilePath);
+		if (File.IsOpen())
 		{
-			//file.seekg(0, std::ios::end);
-			//uint64_t size = file.tellg();
-			file.seekg(0, std::ios::beg);
-
-			std::string line;
-			while (std::getline(file, line)) 
-			{
-				Data.insert(Data.end(), line.begin(), line.end());
-			}
+			ResetPos();
+			Data.assign(File.GetData(), File.GetData() + File.GetSize());
 		}
 	}
 }
@@ -79,7 +74,7 @@ bool sArchive::SaveToFile(const std::string& fileName)
 	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
 	if (file.is_open())
 	{
-		file.write((char*)Data.data(), (std::streamsize)pos);
+		file.write((char*)Data.data(), (std::streamsize)Data.size());
 		file.close();
 		return true;
 	}
@@ -0,0 +1,291 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/ArchiveFile.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+sMappedFile::sMappedFile()
+	: Bytes(nullptr)
+	, Size(0)
+	, bIsOpen(false)
+#ifdef _WIN32
+	, FileHandle(INVALID_HANDLE_VALUE)
+	, MappingHandle(nullptr)
+#else
+	, FileDescriptor(-1)
+#endif
+{}
+
+sMappedFile::sMappedFile(const std::filesystem::path& Path)
+	: sMappedFile()
+{
+	Open(Path);
+}
+
+sMappedFile::~sMappedFile()
+{
+	Close();
+}
+
+sMappedFile::sMappedFile(sMappedFile&& Other) noexcept
+	: sMappedFile()
+{
+	*this = std::move(Other);
+}
+
+sMappedFile& sMappedFile::operator=(sMappedFile&& Other) noexcept
+{
+	if (this != &Other)
+	{
+		Close();
+		std::swap(Bytes, Other.Bytes);
+		std::swap(Size, Other.Size);
+		std::swap(bIsOpen, Other.bIsOpen);
+#ifdef _WIN32
+		std::swap(FileHandle, Other.FileHandle);
+		std::swap(MappingHandle, Other.MappingHandle);
+#else
+		std::swap(FileDescriptor, Other.FileDescriptor);
+#endif
+	}
+	return *this;
+}
+
+bool sMappedFile::Open(const std::filesystem::path& Path)
+{
+	Close();
+
+#ifdef _WIN32
+	FileHandle = CreateFileW(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (FileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER FileSize = {};
+	if (!GetFileSizeEx(FileHandle, &FileSize) || (std::uint64_t)FileSize.QuadPart > (std::uint64_t)SIZE_MAX)
+	{
+		Close();
+		return false;
+	}
+
+	Size = (std::size_t)FileSize.QuadPart;
+	bIsOpen = true;
+	// A zero length file can't be mapped.
+	if (Size == 0)
+		return true;
+
+	MappingHandle = CreateFileMappingW(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!MappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	Bytes = static_cast<const std::uint8_t*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (!Bytes)
+	{
+		Close();
+		return false;
+	}
+#else
+	FileDescriptor = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (FileDescriptor < 0)
+		return false;
+
+	struct stat FileStat = {};
+	if (fstat(FileDescriptor, &FileStat) != 0 || !S_ISREG(FileStat.st_mode))
+	{
+		Close();
+		return false;
+	}
+
+	Size = (std::size_t)FileStat.st_size;
+	bIsOpen = true;
+	// A zero length file can't be mapped.
+	if (Size == 0)
+		return true;
+
+	void* Mapping = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+	if (Mapping == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+	madvise(Mapping, Size, MADV_SEQUENTIAL);
+	Bytes = static_cast<const std::uint8_t*>(Mapping);
+#endif
+
+	return true;
+}
+
+void sMappedFile::Close()
+{
+#ifdef _WIN32
+	if (Bytes)
+		UnmapViewOfFile(Bytes);
+	if (MappingHandle)
+		CloseHandle(MappingHandle);
+	if (FileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(FileHandle);
+	MappingHandle = nullptr;
+	FileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (Bytes)
+		munmap(const_cast<std::uint8_t*>(Bytes), Size);
+	if (FileDescriptor >= 0)
+		close(FileDescriptor);
+	FileDescriptor = -1;
+#endif
+	Bytes = nullptr;
+	Size = 0;
+	bIsOpen = false;
+}
+
+sArchiveFileWriter::sArchiveFileWriter(std::size_t InChunkSize)
+	: ChunkSize(InChunkSize > 0 ? InChunkSize : DefaultChunkSize)
+	, BytesWritten(0)
+	, bFailed(false)
+{
+	Chunk.Reserve(ChunkSize);
+}
+
+sArchiveFileWriter::~sArchiveFileWriter()
+{
+	if (IsOpen())
+		Close();
+}
+
+bool sArchiveFileWriter::Open(const std::filesystem::path& InPath)
+{
+	if (IsOpen())
+		Close();
+
+	Path = InPath;
+	TempPath = InPath;
+	TempPath += ".tmp";
+	BytesWritten = 0;
+	bFailed = false;
+	Chunk.ResetPos();
+
+	// Chunks are already the write unit, the stream buffer would only add a copy.
+	File.rdbuf()->pubsetbuf(nullptr, 0);
+	File.open(TempPath, std::ios::binary | std::ios::trunc);
+	return File.is_open();
+}
+
+void sArchiveFileWriter::Flush()
+{
+	const std::size_t Pending = Chunk.GetPosition();
+	if (Pending == 0)
+		return;
+
+	Chunk.ResetPos();
+	if (!File.is_open() || bFailed)
+	{
+		bFailed = true;
+		return;
+	}
+
+	File.write(reinterpret_cast<const char*>(Chunk.GetData().data()), (std::streamsize)Pending);
+	if (!File.good())
+		bFailed = true;
+	BytesWritten += Pending;
+}
+
+void sArchiveFileWriter::WriteBytes(const void* Bytes, std::size_t Size)
+{
+	if (Size == 0)
+		return;
+
+	if (Chunk.GetPosition() + Size <= ChunkSize)
+	{
+		Chunk.WriteBytes(Bytes, Size);
+		if (Chunk.GetPosition() >= ChunkSize)
+			Flush();
+		return;
+	}
+
+	Flush();
+	if (Size < ChunkSize)
+	{
+		Chunk.WriteBytes(Bytes, Size);
+		return;
+	}
+
+	if (!File.is_open() || bFailed)
+	{
+		bFailed = true;
+		return;
+	}
+
+	File.write(static_cast<const char*>(Bytes), (std::streamsize)Size);
+	if (!File.good())
+		bFailed = true;
+	BytesWritten += Size;
+}
+
+bool sArchiveFileWriter::Close()
+{
+	if (!IsOpen())
+		return false;
+
+	Flush();
+	File.close();
+	if (File.fail())
+		bFailed = true;
+
+	std::error_code Error;
+	if (bFailed)
+	{
+		std::filesystem::remove(TempPath, Error);
+		return false;
+	}
+
+	std::filesystem::rename(TempPath, Path, Error);
+	if (Error)
+	{
+		bFailed = true;
+		std::filesystem::remove(TempPath, Error);
+		return false;
+	}
+	return true;
+}
+
+void sArchiveFileWriter::Abort()
+{
+	Chunk.ResetPos();
+	if (File.is_open())
+		File.close();
+
+	std::error_code Error;
+	std::filesystem::remove(TempPath, Error);
+}
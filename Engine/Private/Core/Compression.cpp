@@ -0,0 +1,503 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/Compression.h"
+#include "Core/ArchiveFile.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+	constexpr std::size_t MinMatch = 4;
+	constexpr std::size_t MaxOffset = 65535;
+	/*
+	* Windows above this are released after use, a large frame doesn't pin its memory on the thread.
+	*/
+	constexpr std::size_t MaxRetainedWindow = 256 * 1024;
+
+	inline void ReleaseLargeWindow(std::vector<std::uint8_t>& Window)
+	{
+		if (Window.capacity() > MaxRetainedWindow)
+		{
+			Window.clear();
+			Window.shrink_to_fit();
+		}
+	}
+
+	inline std::uint32_t Read32(const std::uint8_t* Bytes)
+	{
+		std::uint32_t Value;
+		memcpy(&Value, Bytes, sizeof(Value));
+		return Value;
+	}
+
+	inline std::uint32_t Hash(const std::uint8_t* Bytes, std::uint32_t HashLog)
+	{
+		return (Read32(Bytes) * 2654435761u) >> (32 - HashLog);
+	}
+
+	/*
+	* Length nibble overflow, 255 per byte until the remainder.
+	*/
+	inline bool WriteLength(std::uint8_t*& Out, const std::uint8_t* OutEnd, std::size_t Length)
+	{
+		while (Length >= 255)
+		{
+			if (Out >= OutEnd)
+				return false;
+			*Out++ = 255;
+			Length -= 255;
+		}
+		if (Out >= OutEnd)
+			return false;
+		*Out++ = (std::uint8_t)Length;
+		return true;
+	}
+
+	inline bool ReadLength(const std::uint8_t*& In, const std::uint8_t* InEnd, std::size_t& Length)
+	{
+		std::uint8_t Byte = 0;
+		do
+		{
+			if (In >= InEnd)
+				return false;
+			Byte = *In++;
+			Length += Byte;
+		} while (Byte == 255);
+		return true;
+	}
+
+	inline bool WriteSequence(std::uint8_t*& Out, const std::uint8_t* OutEnd, const std::uint8_t* Literals, std::size_t LiteralCount, std::size_t Offset, std::size_t MatchLength)
+	{
+		if (Out >= OutEnd)
+			return false;
+
+		std::uint8_t& Token = *Out++;
+		Token = (std::uint8_t)((LiteralCount < 15 ? LiteralCount : 15) << 4);
+		if (LiteralCount >= 15 && !WriteLength(Out, OutEnd, LiteralCount - 15))
+			return false;
+
+		if ((std::size_t)(OutEnd - Out) < LiteralCount)
+			return false;
+		if (LiteralCount > 0)
+			memcpy(Out, Literals, LiteralCount);
+		Out += LiteralCount;
+
+		// The last sequence is literals only.
+		if (MatchLength == 0)
+			return true;
+
+		if (OutEnd - Out < 2)
+			return false;
+		*Out++ = (std::uint8_t)(Offset & 0xFF);
+		*Out++ = (std::uint8_t)(Offset >> 8);
+
+		const std::size_t Length = MatchLength - MinMatch;
+		Token |= (std::uint8_t)(Length < 15 ? Length : 15);
+		if (Length >= 15 && !WriteLength(Out, OutEnd, Length - 15))
+			return false;
+		return true;
+	}
+
+	/*
+	* Window holds Prefix bytes of history (the dictionary) followed by the Size bytes to compress.
+	*/
+	std::size_t EncodeBlock(const std::uint8_t* Window, std::size_t Prefix, std::size_t Size, std::uint8_t* Dest, std::size_t Capacity)
+	{
+		const std::size_t End = Prefix + Size;
+
+		std::uint32_t HashLog = 10;
+		while ((1ull << HashLog) < End && HashLog < 16)
+			HashLog++;
+
+		thread_local std::vector<std::uint32_t> Table;
+		Table.assign(std::size_t(1) << HashLog, 0);
+
+		// Entries are position + 1, 0 is empty.
+		for (std::size_t p = Prefix > MaxOffset ? Prefix - MaxOffset : 0; p + MinMatch <= Prefix; p++)
+			Table[Hash(Window + p, HashLog)] = (std::uint32_t)(p + 1);
+
+		std::uint8_t* Out = Dest;
+		const std::uint8_t* OutEnd = Dest + Capacity;
+
+		std::size_t ip = Prefix;
+		std::size_t Anchor = Prefix;
+		while (ip + MinMatch <= End)
+		{
+			const std::uint32_t h = Hash(Window + ip, HashLog);
+			const std::size_t Candidate = Table[h];
+			Table[h] = (std::uint32_t)(ip + 1);
+
+			if (Candidate != 0 && ip - (Candidate - 1) <= MaxOffset && Read32(Window + Candidate - 1) == Read32(Window + ip))
+			{
+				std::size_t Match = Candidate - 1;
+				std::size_t Length = MinMatch;
+				while (ip + Length < End && Window[Match + Length] == Window[ip + Length])
+					Length++;
+
+				while (ip > Anchor && Match > 0 && Window[ip - 1] == Window[Match - 1])
+				{
+					ip--;
+					Match--;
+					Length++;
+				}
+
+				if (!WriteSequence(Out, OutEnd, Window + Anchor, ip - Anchor, ip - Match, Length))
+					return 0;
+
+				ip += Length;
+				Anchor = ip;
+
+				if (ip >= 2 && ip - 2 + MinMatch <= End)
+					Table[Hash(Window + ip - 2, HashLog)] = (std::uint32_t)(ip - 2 + 1);
+			}
+			else
+			{
+				// Skips faster through data that doesn't match.
+				ip += 1 + ((ip - Anchor) >> 6);
+			}
+		}
+
+		if (!WriteSequence(Out, OutEnd, Window + Anchor, End - Anchor, 0, 0))
+			return 0;
+		return (std::size_t)(Out - Dest);
+	}
+
+	/*
+	* Window holds Prefix bytes of history followed by room for RawSize bytes.
+	*/
+	bool DecodeBlock(const std::uint8_t* Source, std::size_t Size, std::uint8_t* Window, std::size_t Prefix, std::size_t RawSize)
+	{
+		const std::uint8_t* In = Source;
+		const std::uint8_t* InEnd = Source + Size;
+		std::size_t op = Prefix;
+		const std::size_t OutEnd = Prefix + RawSize;
+
+		while (In < InEnd)
+		{
+			const std::uint8_t Token = *In++;
+
+			std::size_t LiteralCount = Token >> 4;
+			if (LiteralCount == 15 && !ReadLength(In, InEnd, LiteralCount))
+				return false;
+			if (LiteralCount > (std::size_t)(InEnd - In) || LiteralCount > OutEnd - op)
+				return false;
+			if (LiteralCount > 0)
+				memcpy(Window + op, In, LiteralCount);
+			In += LiteralCount;
+			op += LiteralCount;
+
+			if (In == InEnd)
+				break;
+
+			if (InEnd - In < 2)
+				return false;
+			const std::size_t Offset = (std::size_t)In[0] | ((std::size_t)In[1] << 8);
+			In += 2;
+			if (Offset == 0 || Offset > op)
+				return false;
+
+			std::size_t Length = Token & 15;
+			if (Length == 15 && !ReadLength(In, InEnd, Length))
+				return false;
+			Length += MinMatch;
+			if (Length > OutEnd - op)
+				return false;
+
+			const std::uint8_t* Match = Window + op - Offset;
+			if (Offset >= Length)
+			{
+				memcpy(Window + op, Match, Length);
+			}
+			else
+			{
+				// Overlapping copy repeats the last Offset bytes.
+				for (std::size_t i = 0; i < Length; i++)
+					Window[op + i] = Match[i];
+			}
+			op += Length;
+		}
+
+		return op == OutEnd;
+	}
+
+	std::array<std::shared_ptr<ICompressionCodec>, (std::size_t)eCompressionCodec::Max>& GetCodecs()
+	{
+		static std::array<std::shared_ptr<ICompressionCodec>, (std::size_t)eCompressionCodec::Max> Codecs = []()
+		{
+			std::array<std::shared_ptr<ICompressionCodec>, (std::size_t)eCompressionCodec::Max> Result;
+			Result[(std::size_t)eCompressionCodec::LZ] = sLZCodec::Create();
+			return Result;
+		}();
+		return Codecs;
+	}
+
+	inline double ElapsedMS(const std::chrono::steady_clock::time_point& Start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+	}
+}
+
+sCompressionDictionary::sCompressionDictionary(std::vector<std::uint8_t> InBytes)
+	: Bytes(std::move(InBytes))
+	, ID(0)
+{
+	if (Bytes.empty())
+		return;
+
+	// FNV-1a, 0 is kept for "no dictionary".
+	std::uint32_t Hash = 2166136261u;
+	for (const auto Byte : Bytes)
+	{
+		Hash ^= Byte;
+		Hash *= 16777619u;
+	}
+	ID = Hash != 0 ? Hash : 1;
+}
+
+sCompressionDictionary::sCompressionDictionary(const std::vector<std::string>& Strings)
+	: sCompressionDictionary([&Strings]()
+		{
+			std::vector<std::uint8_t> Result;
+			for (const auto& String : Strings)
+				Result.insert(Result.end(), String.begin(), String.end());
+			return Result;
+		}())
+{}
+
+std::size_t sLZCodec::GetMaxCompressedSize(std::size_t Size) const
+{
+	return Size + Size / 255 + 16;
+}
+
+std::size_t sLZCodec::GetMaxDecompressedSize(std::size_t Size) const
+{
+	// A length byte adds at most 255 bytes, a token with its offset at most 19.
+	return Size * 255;
+}
+
+std::size_t sLZCodec::Compress(const void* Source, std::size_t Size, void* Dest, std::size_t Capacity, const sCompressionDictionary* Dictionary) const
+{
+	const std::uint8_t* Bytes = static_cast<const std::uint8_t*>(Source);
+	if (!Dictionary || Dictionary->GetSize() == 0)
+		return EncodeBlock(Bytes, 0, Size, static_cast<std::uint8_t*>(Dest), Capacity);
+
+	// Only the last window of the dictionary is reachable.
+	const std::size_t Prefix = Dictionary->GetSize() < MaxOffset ? Dictionary->GetSize() : MaxOffset;
+	thread_local std::vector<std::uint8_t> Window;
+	Window.resize(Prefix + Size);
+	memcpy(Window.data(), Dictionary->GetData() + Dictionary->GetSize() - Prefix, Prefix);
+	if (Size > 0)
+		memcpy(Window.data() + Prefix, Bytes, Size);
+	const std::size_t Result = EncodeBlock(Window.data(), Prefix, Size, static_cast<std::uint8_t*>(Dest), Capacity);
+	ReleaseLargeWindow(Window);
+	return Result;
+}
+
+bool sLZCodec::Decompress(const void* Source, std::size_t Size, void* Dest, std::size_t RawSize, const sCompressionDictionary* Dictionary) const
+{
+	const std::uint8_t* Bytes = static_cast<const std::uint8_t*>(Source);
+	if (!Dictionary || Dictionary->GetSize() == 0)
+		return DecodeBlock(Bytes, Size, static_cast<std::uint8_t*>(Dest), 0, RawSize);
+
+	const std::size_t Prefix = Dictionary->GetSize() < MaxOffset ? Dictionary->GetSize() : MaxOffset;
+	thread_local std::vector<std::uint8_t> Window;
+	Window.resize(Prefix + RawSize);
+	memcpy(Window.data(), Dictionary->GetData() + Dictionary->GetSize() - Prefix, Prefix);
+	const bool bResult = DecodeBlock(Bytes, Size, Window.data(), Prefix, RawSize);
+	if (bResult && RawSize > 0)
+		memcpy(Dest, Window.data() + Prefix, RawSize);
+	ReleaseLargeWindow(Window);
+	return bResult;
+}
+
+namespace Compression
+{
+	void RegisterCodec(eCompressionCodec ID, std::shared_ptr<ICompressionCodec> Codec)
+	{
+		if (ID == eCompressionCodec::None || ID >= eCompressionCodec::Max)
+			return;
+		GetCodecs()[(std::size_t)ID] = Codec;
+	}
+
+	ICompressionCodec* GetCodec(eCompressionCodec ID)
+	{
+		if (ID == eCompressionCodec::None || ID >= eCompressionCodec::Max)
+			return nullptr;
+		return GetCodecs()[(std::size_t)ID].get();
+	}
+
+	bool Compress(const void* Source, std::size_t Size, std::vector<std::uint8_t>& Out, eCompressionCodec Codec, const sCompressionDictionary* Dictionary, sCompressionStats* Stats)
+	{
+		ICompressionCodec* pCodec = GetCodec(Codec);
+		if (!pCodec || Size > MaxRawSize)
+			return false;
+
+		const auto Start = std::chrono::steady_clock::now();
+
+		const std::size_t Begin = Out.size();
+		Out.resize(Begin + FrameHeaderSize + pCodec->GetMaxCompressedSize(Size));
+
+		// A frame that isn't smaller than the input is not worth the decode.
+		const std::size_t Capacity = Size > FrameHeaderSize ? Size - FrameHeaderSize : 0;
+		const std::size_t CompressedSize = pCodec->Compress(Source, Size, Out.data() + Begin + FrameHeaderSize, Capacity, Dictionary);
+
+		if (Stats)
+			Stats->CompressTimeMS += ElapsedMS(Start);
+
+		if (CompressedSize == 0)
+		{
+			Out.resize(Begin);
+			if (Stats)
+				Stats->SkippedCount++;
+			return false;
+		}
+
+		std::uint8_t* Header = Out.data() + Begin;
+		const std::uint32_t DictionaryID = Dictionary ? Dictionary->GetID() : 0;
+		const std::uint32_t RawSize = (std::uint32_t)Size;
+		const std::uint32_t PayloadSize = (std::uint32_t)CompressedSize;
+		Header[0] = (std::uint8_t)Codec;
+		memcpy(Header + 1, &DictionaryID, sizeof(DictionaryID));
+		memcpy(Header + 5, &RawSize, sizeof(RawSize));
+		memcpy(Header + 9, &PayloadSize, sizeof(PayloadSize));
+		Out.resize(Begin + FrameHeaderSize + CompressedSize);
+
+		if (Stats)
+		{
+			Stats->CompressedCount++;
+			Stats->BytesIn += Size;
+			Stats->BytesOut += FrameHeaderSize + CompressedSize;
+		}
+		return true;
+	}
+
+	bool Decompress(const sArchiveView& Frame, std::vector<std::uint8_t>& Out, const sCompressionDictionary* Dictionary, sCompressionStats* Stats, std::size_t MaxSize)
+	{
+		const auto Start = std::chrono::steady_clock::now();
+
+		auto Fail = [&]()
+		{
+			Frame.SetFailed();
+			if (Stats)
+				Stats->FailedCount++;
+			return false;
+		};
+
+		std::uint8_t Codec = 0;
+		std::uint32_t DictionaryID = 0;
+		std::uint32_t RawSize = 0;
+		std::uint32_t PayloadSize = 0;
+		Frame >> Codec;
+		Frame >> DictionaryID;
+		Frame >> RawSize;
+		Frame >> PayloadSize;
+		if (Frame.IsFailed() || RawSize > std::min(MaxSize, MaxRawSize) || PayloadSize > Frame.GetRemainingSize())
+			return Fail();
+
+		const sArchiveView Payload = Frame.Consume(PayloadSize);
+
+		// Stored frame, written by CompressArchive when compressing didn't help.
+		if ((eCompressionCodec)Codec == eCompressionCodec::None)
+		{
+			if (Payload.GetSize() != RawSize)
+				return Fail();
+			Out.assign(Payload.GetData(), Payload.GetData() + Payload.GetSize());
+			return true;
+		}
+
+		ICompressionCodec* pCodec = GetCodec((eCompressionCodec)Codec);
+		const std::uint32_t ExpectedID = Dictionary ? Dictionary->GetID() : 0;
+		if (!pCodec || DictionaryID != ExpectedID || RawSize > pCodec->GetMaxDecompressedSize(PayloadSize))
+			return Fail();
+
+		Out.resize(RawSize);
+		if (!pCodec->Decompress(Payload.GetData(), Payload.GetSize(), Out.data(), RawSize, Dictionary))
+		{
+			Out.clear();
+			return Fail();
+		}
+
+		if (Stats)
+		{
+			Stats->DecompressedCount++;
+			Stats->DecompressTimeMS += ElapsedMS(Start);
+		}
+		return true;
+	}
+
+	void CompressArchive(const sArchive& Archive, sArchive& Out, eCompressionCodec Codec, sCompressionStats* Stats)
+	{
+		std::vector<std::uint8_t> Frame;
+		if (!Compress(Archive.GetData().data(), Archive.GetSize(), Frame, Codec, nullptr, Stats))
+		{
+			const std::uint32_t DictionaryID = 0;
+			const std::uint32_t RawSize = (std::uint32_t)Archive.GetSize();
+			const std::uint32_t PayloadSize = RawSize;
+			Frame.reserve(FrameHeaderSize + Archive.GetSize());
+			Frame.push_back((std::uint8_t)eCompressionCodec::None);
+			Frame.insert(Frame.end(), (const std::uint8_t*)&DictionaryID, (const std::uint8_t*)&DictionaryID + sizeof(DictionaryID));
+			Frame.insert(Frame.end(), (const std::uint8_t*)&RawSize, (const std::uint8_t*)&RawSize + sizeof(RawSize));
+			Frame.insert(Frame.end(), (const std::uint8_t*)&PayloadSize, (const std::uint8_t*)&PayloadSize + sizeof(PayloadSize));
+			Frame.insert(Frame.end(), Archive.GetData().begin(), Archive.GetData().end());
+		}
+		Out.WriteBytes(Frame.data(), Frame.size());
+	}
+
+	bool DecompressArchive(const sArchiveView& Archive, sArchive& Out, sCompressionStats* Stats)
+	{
+		std::vector<std::uint8_t> Raw;
+		if (!Decompress(Archive, Raw, nullptr, Stats))
+			return false;
+		Out.WriteBytes(Raw.data(), Raw.size());
+		Out.ResetPos();
+		return true;
+	}
+
+	bool SaveCompressedFile(const std::filesystem::path& Path, const sArchive& Archive, eCompressionCodec Codec, sCompressionStats* Stats)
+	{
+		sArchive Compressed;
+		CompressArchive(Archive, Compressed, Codec, Stats);
+
+		sArchiveFileWriter Writer;
+		if (!Writer.Open(Path))
+			return false;
+		Writer.WriteBytes(Compressed.GetData().data(), Compressed.GetSize());
+		return Writer.Close();
+	}
+
+	bool LoadCompressedFile(const std::filesystem::path& Path, sArchive& Out, sCompressionStats* Stats)
+	{
+		sMappedFile File(Path);
+		if (!File.IsOpen())
+			return false;
+		return DecompressArchive(File.GetView(), Out, Stats);
+	}
+}
@@ -0,0 +1,188 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/Coroutine.h"
+
+void sCoroutineScheduler::Initialize(ThreadPool* InPool, ThreadPool* InBlockingPool)
+{
+	std::unique_lock<std::mutex> lock(Mutex);
+	Pool = InPool;
+	BlockingPool = InBlockingPool;
+	GameThreadID = std::this_thread::get_id();
+}
+
+void sCoroutineScheduler::Destroy()
+{
+	std::vector<sSuspended> Suspended;
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		Suspended.swap(GameThreadQueue);
+		Suspended.insert(Suspended.end(), NextFrameQueue.begin(), NextFrameQueue.end());
+		for (const auto& Delayed : DelayedQueue)
+			Suspended.push_back(Delayed.Coroutine);
+		for (const auto& Waiting : JobQueue)
+			Suspended.push_back(Waiting.Coroutine);
+		NextFrameQueue.clear();
+		DelayedQueue.clear();
+		JobQueue.clear();
+		Pool = nullptr;
+		BlockingPool = nullptr;
+	}
+
+	/*
+	* Destroying a frame can drop sTasks of other cancelled coroutines, the lock is not held.
+	*/
+	for (const auto& Coroutine : Suspended)
+		Cancel(Coroutine.Handle, Coroutine.Promise);
+}
+
+void sCoroutineScheduler::Cancel(std::coroutine_handle<> Handle, CoroutineDetail::sPromiseBase* Promise)
+{
+	/*
+	* Other coroutine types are owned by the caller.
+	*/
+	if (!Promise)
+		return;
+
+	CoroutineDetail::sPromiseBase* AwaitingPromise = Promise->AwaitingPromise;
+	const std::uintptr_t Previous = Promise->State.exchange(CoroutineDetail::eCancelled, std::memory_order_acq_rel);
+	if (Previous == CoroutineDetail::eDetached)
+	{
+		Handle.destroy();
+	}
+	else if (Previous > CoroutineDetail::eCancelled)
+	{
+		/*
+		* The awaiting coroutine never resumes either, its frame owns the task of this one.
+		*/
+		Cancel(std::coroutine_handle<>::from_address(reinterpret_cast<void*>(Previous)), AwaitingPromise);
+	}
+}
+
+void sCoroutineScheduler::Tick()
+{
+	std::vector<sSuspended> Ready;
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		Ready.swap(GameThreadQueue);
+		Ready.insert(Ready.end(), NextFrameQueue.begin(), NextFrameQueue.end());
+		NextFrameQueue.clear();
+
+		const auto Now = std::chrono::steady_clock::now();
+		for (auto it = DelayedQueue.begin(); it != DelayedQueue.end();)
+		{
+			if (it->Deadline <= Now)
+			{
+				Ready.push_back(it->Coroutine);
+				it = DelayedQueue.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+
+		for (auto it = JobQueue.begin(); it != JobQueue.end();)
+		{
+			if (it->Job.IsCompleted())
+			{
+				Ready.push_back(it->Coroutine);
+				it = JobQueue.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+	}
+
+	/*
+	* Coroutines posted while resuming are resumed on the next Tick.
+	*/
+	for (const auto& Coroutine : Ready)
+		Coroutine.Handle.resume();
+}
+
+void sCoroutineScheduler::PostToGameThread(std::coroutine_handle<> Handle, CoroutineDetail::sPromiseBase* Promise)
+{
+	std::unique_lock<std::mutex> lock(Mutex);
+	GameThreadQueue.push_back(sSuspended{ Handle, Promise });
+}
+
+void sCoroutineScheduler::PostNextFrame(std::coroutine_handle<> Handle, CoroutineDetail::sPromiseBase* Promise)
+{
+	std::unique_lock<std::mutex> lock(Mutex);
+	NextFrameQueue.push_back(sSuspended{ Handle, Promise });
+}
+
+void sCoroutineScheduler::PostDelayed(std::coroutine_handle<> Handle, double Seconds, CoroutineDetail::sPromiseBase* Promise)
+{
+	sDelayed Delayed;
+	Delayed.Deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(Seconds));
+	Delayed.Coroutine = sSuspended{ Handle, Promise };
+
+	std::unique_lock<std::mutex> lock(Mutex);
+	DelayedQueue.push_back(Delayed);
+}
+
+void sCoroutineScheduler::PostOnJobCompleted(std::coroutine_handle<> Handle, const sJobHandle& Job, CoroutineDetail::sPromiseBase* Promise)
+{
+	sWaitingForJob Waiting;
+	Waiting.Job = Job;
+	Waiting.Coroutine = sSuspended{ Handle, Promise };
+
+	std::unique_lock<std::mutex> lock(Mutex);
+	JobQueue.push_back(Waiting);
+}
+
+void sCoroutineScheduler::PostToBackground(std::coroutine_handle<> Handle)
+{
+	ScheduleBlocking([Handle]() { Handle.resume(); });
+}
+
+sJobHandle sCoroutineScheduler::Schedule(const std::function<void()>& Function)
+{
+	if (!Pool)
+	{
+		Function();
+		return sJobHandle();
+	}
+	return Pool->Schedule(Function);
+}
+
+sJobHandle sCoroutineScheduler::ScheduleBlocking(const std::function<void()>& Function)
+{
+	if (!BlockingPool)
+		return Schedule(Function);
+	return BlockingPool->Schedule(Function);
+}
+
+std::size_t sCoroutineScheduler::GetPendingCount()
+{
+	std::unique_lock<std::mutex> lock(Mutex);
+	return GameThreadQueue.size() + NextFrameQueue.size() + DelayedQueue.size() + JobQueue.size();
+}
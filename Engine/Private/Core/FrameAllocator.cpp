@@ -0,0 +1,196 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/FrameAllocator.h"
+#include "Engine/MemoryManager.h"
+#include <atomic>
+#include <mutex>
+
+namespace
+{
+	std::atomic<std::uint64_t> CurrentFrameIndex = 0;
+
+	std::atomic<std::uint64_t> FrameArenaBytes = 0;
+	std::atomic<std::uint64_t> FrameArenaBlockAllocations = 0;
+
+	std::mutex StatsMutex;
+	sFrameMemoryStats LastFrameStats;
+	std::uint64_t FrameStartHeapAllocations = 0;
+	std::uint64_t FrameStartHeapAllocatedBytes = 0;
+
+	inline std::uintptr_t AlignUp(std::uintptr_t Value, std::size_t Alignment)
+	{
+		return (Value + (Alignment - 1)) & ~(std::uintptr_t)(Alignment - 1);
+	}
+}
+
+sFrameAllocator::sFrameAllocator()
+{
+}
+
+sFrameAllocator::~sFrameAllocator()
+{
+	for (auto& Arena : Arenas)
+	{
+		for (auto& Block : Arena.Blocks)
+			::operator delete(Block.Memory);
+		Arena.Blocks.clear();
+	}
+}
+
+sFrameAllocator& sFrameAllocator::Get()
+{
+	static thread_local sFrameAllocator Allocator;
+	return Allocator;
+}
+
+void sFrameAllocator::BeginFrame()
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	LastFrameStats = GetCurrentFrameStats();
+
+	FrameStartHeapAllocations = MemoryManager::GetTotalAllocationCount();
+	FrameStartHeapAllocatedBytes = MemoryManager::GetTotalAllocatedBytes();
+	FrameArenaBytes.store(0, std::memory_order_relaxed);
+	FrameArenaBlockAllocations.store(0, std::memory_order_relaxed);
+
+	CurrentFrameIndex.fetch_add(1, std::memory_order_release);
+}
+
+std::uint64_t sFrameAllocator::GetFrameIndex()
+{
+	return CurrentFrameIndex.load(std::memory_order_acquire);
+}
+
+sFrameMemoryStats sFrameAllocator::GetLastFrameStats()
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	return LastFrameStats;
+}
+
+sFrameMemoryStats sFrameAllocator::GetCurrentFrameStats()
+{
+	sFrameMemoryStats Stats;
+	Stats.FrameIndex = CurrentFrameIndex.load(std::memory_order_relaxed);
+	Stats.HeapAllocations = MemoryManager::GetTotalAllocationCount() - FrameStartHeapAllocations;
+	Stats.HeapAllocatedBytes = MemoryManager::GetTotalAllocatedBytes() - FrameStartHeapAllocatedBytes;
+	Stats.FrameArenaBytes = FrameArenaBytes.load(std::memory_order_relaxed);
+	Stats.FrameArenaBlockAllocations = FrameArenaBlockAllocations.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+sFrameAllocator::sArena& sFrameAllocator::GetArena()
+{
+	const std::uint64_t FrameIndex = CurrentFrameIndex.load(std::memory_order_acquire);
+	sArena& Arena = Arenas[FrameIndex & 1];
+	if (Arena.FrameIndex != FrameIndex)
+	{
+		Rewind(Arena);
+		Arena.FrameIndex = FrameIndex;
+	}
+	return Arena;
+}
+
+void sFrameAllocator::Rewind(sArena& Arena)
+{
+	if (Arena.Blocks.size() > 1)
+	{
+		// The arena overflowed last time, replace the blocks with one block that fits all of them.
+		std::size_t TotalSize = 0;
+		for (auto& Block : Arena.Blocks)
+		{
+			TotalSize += Block.Size;
+			::operator delete(Block.Memory);
+		}
+		Arena.Blocks.clear();
+		AddBlock(Arena, TotalSize);
+	}
+	Arena.BlockIndex = 0;
+	Arena.Offset = 0;
+	Arena.LastAllocation = nullptr;
+}
+
+void sFrameAllocator::AddBlock(sArena& Arena, std::size_t MinSize)
+{
+	sBlock Block;
+	Block.Size = MinSize > DefaultBlockSize ? MinSize : DefaultBlockSize;
+	Block.Memory = static_cast<std::uint8_t*>(::operator new(Block.Size));
+	Arena.Blocks.push_back(Block);
+	FrameArenaBlockAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* sFrameAllocator::Allocate(std::size_t Size, std::size_t Alignment)
+{
+	if (Size == 0)
+		Size = 1;
+
+	sArena& Arena = GetArena();
+	for (;;)
+	{
+		if (Arena.BlockIndex < Arena.Blocks.size())
+		{
+			const sBlock& Block = Arena.Blocks[Arena.BlockIndex];
+			const std::uintptr_t Begin = (std::uintptr_t)Block.Memory;
+			const std::uintptr_t Aligned = AlignUp(Begin + Arena.Offset, Alignment);
+			if (Aligned + Size <= Begin + Block.Size)
+			{
+				Arena.Offset = (Aligned + Size) - Begin;
+				Arena.LastAllocation = (std::uint8_t*)Aligned;
+				FrameArenaBytes.fetch_add(Size, std::memory_order_relaxed);
+				return Arena.LastAllocation;
+			}
+			if (Arena.BlockIndex + 1 < Arena.Blocks.size())
+			{
+				Arena.BlockIndex++;
+				Arena.Offset = 0;
+				continue;
+			}
+		}
+		AddBlock(Arena, Size + Alignment);
+		Arena.BlockIndex = Arena.Blocks.size() - 1;
+		Arena.Offset = 0;
+	}
+}
+
+void sFrameAllocator::Deallocate(void* Ptr, std::size_t Size)
+{
+	if (!Ptr)
+		return;
+
+	const std::uint64_t FrameIndex = CurrentFrameIndex.load(std::memory_order_acquire);
+	sArena& Arena = Arenas[FrameIndex & 1];
+	if (Arena.FrameIndex != FrameIndex || Ptr != Arena.LastAllocation || Arena.BlockIndex >= Arena.Blocks.size())
+		return;
+
+	const sBlock& Block = Arena.Blocks[Arena.BlockIndex];
+	const std::uintptr_t Begin = (std::uintptr_t)Block.Memory;
+	if ((std::uintptr_t)Ptr + Size == Begin + Arena.Offset)
+	{
+		Arena.Offset = (std::uintptr_t)Ptr - Begin;
+		Arena.LastAllocation = nullptr;
+	}
+}
@@ -0,0 +1,153 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/ObjectPool.h"
+#include <algorithm>
+#include <new>
+
+sObjectPool::sObjectPool(const std::string& InName, std::size_t InSlotSize, std::size_t InAlignment, std::size_t InSlotsPerChunk)
+	: Name(InName)
+	, Alignment(std::max(InAlignment, alignof(sFreeSlot)))
+	, SlotsPerChunk(std::max<std::size_t>(InSlotsPerChunk, 1))
+	, FreeList(nullptr)
+	, LiveCount(0)
+	, PeakLiveCount(0)
+	, TotalAllocations(0)
+{
+	// Every slot has to hold a free list link and keep the next slot aligned.
+	SlotSize = std::max(InSlotSize, sizeof(sFreeSlot));
+	SlotSize = (SlotSize + Alignment - 1) & ~(Alignment - 1);
+
+	sObjectPoolRegistry::Get().Register(this);
+}
+
+sObjectPool::~sObjectPool()
+{
+	sObjectPoolRegistry::Get().Unregister(this);
+
+	for (auto& Chunk : Chunks)
+		::operator delete(Chunk, std::align_val_t(Alignment));
+	Chunks.clear();
+	FreeList = nullptr;
+}
+
+void sObjectPool::AddChunk()
+{
+	std::uint8_t* Chunk = static_cast<std::uint8_t*>(::operator new(SlotSize * SlotsPerChunk, std::align_val_t(Alignment)));
+	Chunks.push_back(Chunk);
+
+	// Link back to front so slots are handed out in address order.
+	for (std::size_t i = SlotsPerChunk; i > 0; i--)
+	{
+		sFreeSlot* Slot = reinterpret_cast<sFreeSlot*>(Chunk + ((i - 1) * SlotSize));
+		Slot->Next = FreeList;
+		FreeList = Slot;
+	}
+}
+
+void* sObjectPool::Allocate()
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+
+	if (!FreeList)
+		AddChunk();
+
+	sFreeSlot* Slot = FreeList;
+	FreeList = Slot->Next;
+
+	LiveCount++;
+	PeakLiveCount = std::max(PeakLiveCount, LiveCount);
+	TotalAllocations++;
+	return Slot;
+}
+
+void sObjectPool::Deallocate(void* Ptr)
+{
+	if (!Ptr)
+		return;
+
+	std::lock_guard<std::mutex> Lock(Mutex);
+
+	sFreeSlot* Slot = static_cast<sFreeSlot*>(Ptr);
+	Slot->Next = FreeList;
+	FreeList = Slot;
+	LiveCount--;
+}
+
+void sObjectPool::Reserve(std::size_t Count)
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+
+	while ((Chunks.size() * SlotsPerChunk) - LiveCount < Count)
+		AddChunk();
+}
+
+sObjectPoolStats sObjectPool::GetStats() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+
+	sObjectPoolStats Stats;
+	Stats.Name = Name;
+	Stats.SlotSize = SlotSize;
+	Stats.SlotsPerChunk = SlotsPerChunk;
+	Stats.ChunkCount = Chunks.size();
+	Stats.Capacity = Chunks.size() * SlotsPerChunk;
+	Stats.LiveCount = LiveCount;
+	Stats.PeakLiveCount = PeakLiveCount;
+	Stats.TotalAllocations = TotalAllocations;
+	return Stats;
+}
+
+sObjectPoolRegistry& sObjectPoolRegistry::Get()
+{
+	// Leaked for the same reason as the class pools.
+	static sObjectPoolRegistry* Registry = new sObjectPoolRegistry();
+	return *Registry;
+}
+
+void sObjectPoolRegistry::Register(sObjectPool* Pool)
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	Pools.push_back(Pool);
+}
+
+void sObjectPoolRegistry::Unregister(sObjectPool* Pool)
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	Pools.erase(std::remove(Pools.begin(), Pools.end(), Pool), Pools.end());
+}
+
+std::vector<sObjectPoolStats> sObjectPoolRegistry::GetStats() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+
+	std::vector<sObjectPoolStats> Stats;
+	Stats.reserve(Pools.size());
+	for (const auto& Pool : Pools)
+		Stats.push_back(Pool->GetStats());
+	return Stats;
+}
@@ -0,0 +1,419 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+std::atomic<bool> sProfiler::bEnabled = true;
+
+namespace
+{
+	const std::chrono::steady_clock::time_point ProfilerEpoch = std::chrono::steady_clock::now();
+
+	void WriteJSONString(std::ostringstream& Stream, const char* Str)
+	{
+		Stream << '"';
+		for (const char* C = Str; *C; C++)
+		{
+			switch (*C)
+			{
+			case '"': Stream << "\\\""; break;
+			case '\\': Stream << "\\\\"; break;
+			case '\n': Stream << "\\n"; break;
+			case '\t': Stream << "\\t"; break;
+			default:
+				if ((unsigned char)*C < 0x20)
+				{
+					char Escaped[8];
+					std::snprintf(Escaped, sizeof(Escaped), "\\u%04x", (unsigned)*C);
+					Stream << Escaped;
+				}
+				else
+				{
+					Stream << *C;
+				}
+				break;
+			}
+		}
+		Stream << '"';
+	}
+
+	void WriteMicroseconds(std::ostringstream& Stream, std::uint64_t NS)
+	{
+		char Buffer[32];
+		std::snprintf(Buffer, sizeof(Buffer), "%llu.%03llu", (unsigned long long)(NS / 1000), (unsigned long long)(NS % 1000));
+		Stream << Buffer;
+	}
+}
+
+sProfiler& sProfiler::Get()
+{
+	// Leaked so zones recorded by threads that outlive static destruction stay valid.
+	static sProfiler* Profiler = new sProfiler();
+	return *Profiler;
+}
+
+sProfiler::sProfiler()
+	: FrameIndex(0)
+	, StatsReportInterval(0)
+{
+	FrameMarkers.resize(FrameMarkerCount);
+}
+
+void sProfiler::SetEnabled(bool bEnable)
+{
+	bEnabled.store(bEnable, std::memory_order_relaxed);
+}
+
+std::uint64_t sProfiler::Now()
+{
+	return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ProfilerEpoch).count();
+}
+
+sProfiler::sThreadBuffer& sProfiler::GetThreadBuffer()
+{
+	thread_local sThreadBuffer* tBuffer = nullptr;
+	if (tBuffer)
+		return *tBuffer;
+
+	std::unique_ptr<sThreadBuffer> Buffer = std::make_unique<sThreadBuffer>();
+	Buffer->ThreadID = (std::uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+	Buffer->Events = std::make_unique<sEventSlot[]>(EventsPerThread);
+
+	// Buffers are kept after the thread exits, the trace still references their events.
+	std::lock_guard<std::mutex> Lock(ThreadMutex);
+	Buffer->ThreadIndex = (std::uint32_t)Threads.size() + 1;
+	Buffer->Name = "Thread " + std::to_string(Buffer->ThreadIndex);
+	tBuffer = Buffer.get();
+	Threads.push_back(std::move(Buffer));
+	return *tBuffer;
+}
+
+void sProfiler::SetThreadName(const std::string& Name)
+{
+	sThreadBuffer& Buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> Lock(ThreadMutex);
+	Buffer.Name = Name;
+}
+
+const char* sProfiler::InternName(const std::string& Name)
+{
+	std::lock_guard<std::mutex> Lock(NameMutex);
+	return Names.insert(Name).first->c_str();
+}
+
+void sProfiler::BeginZone()
+{
+	GetThreadBuffer().Depth++;
+}
+
+void sProfiler::EndZone(const char* Name, std::uint64_t StartNS, std::uint64_t EndNS)
+{
+	sThreadBuffer& Buffer = GetThreadBuffer();
+	if (Buffer.Depth > 0)
+		Buffer.Depth--;
+
+	const std::uint64_t Index = Buffer.WriteIndex.load(std::memory_order_relaxed);
+
+	sEventSlot& Slot = Buffer.Events[Index % EventsPerThread];
+	Slot.Name.store(Name, std::memory_order_relaxed);
+	Slot.StartNS.store(StartNS, std::memory_order_relaxed);
+	Slot.EndNS.store(EndNS, std::memory_order_relaxed);
+	Slot.FrameIndex.store(FrameIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	Slot.Depth.store(Buffer.Depth, std::memory_order_relaxed);
+
+	Buffer.WriteIndex.store(Index + 1, std::memory_order_release);
+}
+
+std::vector<sProfileEvent> sProfiler::ReadEvents(const sThreadBuffer& Buffer, std::uint64_t From, std::uint64_t& Next, std::uint64_t& Dropped) const
+{
+	std::vector<sProfileEvent> Events;
+	Dropped = 0;
+
+	const std::uint64_t End = Buffer.WriteIndex.load(std::memory_order_acquire);
+	std::uint64_t Begin = End > EventsPerThread ? std::max(From, End - EventsPerThread) : From;
+	if (Begin > From)
+		Dropped += Begin - From;
+
+	Events.reserve((std::size_t)(End - Begin));
+	for (std::uint64_t i = Begin; i < End; i++)
+	{
+		const sEventSlot& Slot = Buffer.Events[i % EventsPerThread];
+		sProfileEvent Event;
+		Event.Name = Slot.Name.load(std::memory_order_relaxed);
+		Event.StartNS = Slot.StartNS.load(std::memory_order_relaxed);
+		Event.EndNS = Slot.EndNS.load(std::memory_order_relaxed);
+		Event.FrameIndex = Slot.FrameIndex.load(std::memory_order_relaxed);
+		Event.Depth = Slot.Depth.load(std::memory_order_relaxed);
+		Events.push_back(Event);
+	}
+
+	// The writer may have lapped the copied range while it was read, those slots hold newer events.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const std::uint64_t After = Buffer.WriteIndex.load(std::memory_order_relaxed);
+	if (After > EventsPerThread && After - EventsPerThread > Begin)
+	{
+		const std::uint64_t Overwritten = std::min(After - EventsPerThread, End) - Begin;
+		Events.erase(Events.begin(), Events.begin() + (std::ptrdiff_t)Overwritten);
+		Dropped += Overwritten;
+	}
+
+	Next = End;
+	return Events;
+}
+
+void sProfiler::BeginFrame()
+{
+	const std::uint64_t Frame = FrameIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	std::vector<sThreadBuffer*> Buffers;
+	{
+		std::lock_guard<std::mutex> Lock(ThreadMutex);
+		Buffers.reserve(Threads.size());
+		for (const auto& Buffer : Threads)
+			Buffers.push_back(Buffer.get());
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(StatsMutex);
+
+		sFrameMarker& Marker = FrameMarkers[Frame % FrameMarkerCount];
+		Marker.FrameIndex = Frame;
+		Marker.TimeNS = Now();
+
+		for (auto& Zone : Zones)
+		{
+			Zone.second.FrameNS = 0;
+			Zone.second.FrameCalls = 0;
+		}
+
+		for (sThreadBuffer* Buffer : Buffers)
+		{
+			std::uint64_t Dropped = 0;
+			const std::vector<sProfileEvent> Events = ReadEvents(*Buffer, Buffer->ReadIndex, Buffer->ReadIndex, Dropped);
+			Buffer->DroppedEvents += Dropped;
+
+			for (const sProfileEvent& Event : Events)
+			{
+				sZoneAccumulator& Zone = Zones[std::string_view(Event.Name)];
+				const std::uint64_t Duration = Event.EndNS - Event.StartNS;
+				Zone.CallCount++;
+				Zone.TotalNS += Duration;
+				Zone.MinNS = std::min(Zone.MinNS, Duration);
+				Zone.MaxNS = std::max(Zone.MaxNS, Duration);
+				Zone.FrameNS += Duration;
+				Zone.FrameCalls++;
+			}
+		}
+	}
+
+	const std::uint32_t Interval = StatsReportInterval.load(std::memory_order_relaxed);
+	if (Interval > 0 && Frame % Interval == 0)
+		WriteZoneStatsToConsole();
+}
+
+std::vector<sProfileZoneStats> sProfiler::GetZoneStats() const
+{
+	std::vector<sProfileZoneStats> Result;
+	std::vector<std::uint64_t> TotalNS;
+	{
+		std::lock_guard<std::mutex> Lock(StatsMutex);
+		Result.reserve(Zones.size());
+		for (const auto& Zone : Zones)
+		{
+			if (Zone.second.CallCount == 0)
+				continue;
+
+			sProfileZoneStats Stats;
+			Stats.Name = std::string(Zone.first);
+			Stats.CallCount = Zone.second.CallCount;
+			Stats.MinMS = (double)Zone.second.MinNS / 1000000.0;
+			Stats.MaxMS = (double)Zone.second.MaxNS / 1000000.0;
+			Stats.AvgMS = (double)Zone.second.TotalNS / (double)Zone.second.CallCount / 1000000.0;
+			Stats.LastFrameMS = (double)Zone.second.FrameNS / 1000000.0;
+			Stats.LastFrameCalls = Zone.second.FrameCalls;
+			Result.push_back(Stats);
+		}
+	}
+
+	std::sort(Result.begin(), Result.end(), [](const sProfileZoneStats& A, const sProfileZoneStats& B)
+		{
+			return A.AvgMS * (double)A.CallCount > B.AvgMS * (double)B.CallCount;
+		});
+	return Result;
+}
+
+void sProfiler::ResetZoneStats()
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	Zones.clear();
+}
+
+std::vector<sProfileThreadInfo> sProfiler::GetThreadInfo() const
+{
+	std::vector<sProfileThreadInfo> Result;
+	std::lock_guard<std::mutex> Lock(ThreadMutex);
+	for (const auto& Buffer : Threads)
+	{
+		sProfileThreadInfo Info;
+		Info.ThreadIndex = Buffer->ThreadIndex;
+		Info.ThreadID = Buffer->ThreadID;
+		Info.Name = Buffer->Name;
+		Info.RecordedEvents = Buffer->WriteIndex.load(std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> StatsLock(StatsMutex);
+			Info.DroppedEvents = Buffer->DroppedEvents;
+		}
+		Result.push_back(Info);
+	}
+	return Result;
+}
+
+void sProfiler::SetStatsReportInterval(std::uint32_t Frames)
+{
+	StatsReportInterval.store(Frames, std::memory_order_relaxed);
+}
+
+void sProfiler::WriteZoneStatsToConsole() const
+{
+	const std::vector<sProfileZoneStats> Stats = GetZoneStats();
+
+	std::ostringstream Stream;
+	Stream << "Profiler : frame " << GetFrameIndex() << "\n";
+	char Line[256];
+	std::snprintf(Line, sizeof(Line), "%-40s %10s %10s %10s %10s %10s\n", "Zone", "Calls", "Min ms", "Avg ms", "Max ms", "Frame ms");
+	Stream << Line;
+	for (const auto& Zone : Stats)
+	{
+		std::snprintf(Line, sizeof(Line), "%-40.40s %10llu %10.3f %10.3f %10.3f %10.3f\n", Zone.Name.c_str(), (unsigned long long)Zone.CallCount, Zone.MinMS, Zone.AvgMS, Zone.MaxMS, Zone.LastFrameMS);
+		Stream << Line;
+	}
+	std::cout << Stream.str() << std::flush;
+}
+
+sProfileTrace sProfiler::CaptureTrace(std::uint64_t LastFrames) const
+{
+	const std::uint64_t CurrentFrame = GetFrameIndex();
+	const std::uint64_t FirstFrame = (LastFrames > 0 && CurrentFrame >= LastFrames) ? CurrentFrame - LastFrames + 1 : 0;
+
+	sProfileTrace Trace;
+	{
+		std::lock_guard<std::mutex> Lock(ThreadMutex);
+		for (const auto& Buffer : Threads)
+		{
+			sProfileTrace::sThread Thread;
+			Thread.ThreadIndex = Buffer->ThreadIndex;
+			Thread.Name = Buffer->Name;
+			std::uint64_t Next = 0;
+			std::uint64_t Dropped = 0;
+			Thread.Events = ReadEvents(*Buffer, 0, Next, Dropped);
+			std::erase_if(Thread.Events, [FirstFrame](const sProfileEvent& Event) { return !Event.Name || Event.FrameIndex < FirstFrame; });
+			Trace.Threads.push_back(std::move(Thread));
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(StatsMutex);
+		for (const auto& Marker : FrameMarkers)
+		{
+			if (Marker.FrameIndex != 0 && Marker.FrameIndex >= FirstFrame)
+				Trace.Frames.push_back({ Marker.FrameIndex, Marker.TimeNS });
+		}
+	}
+	std::sort(Trace.Frames.begin(), Trace.Frames.end(), [](const sProfileTrace::sFrame& A, const sProfileTrace::sFrame& B) { return A.FrameIndex < B.FrameIndex; });
+	return Trace;
+}
+
+std::string sProfiler::GetChromeTrace(std::uint64_t LastFrames) const
+{
+	return GetChromeTrace(CaptureTrace(LastFrames));
+}
+
+std::string sProfiler::GetChromeTrace(const sProfileTrace& Trace)
+{
+	std::ostringstream Stream;
+	Stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool bFirst = true;
+	auto Separator = [&]()
+	{
+		if (!bFirst)
+			Stream << ",\n";
+		bFirst = false;
+	};
+
+	for (const auto& Thread : Trace.Threads)
+	{
+		Separator();
+		Stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << Thread.ThreadIndex << ",\"args\":{\"name\":";
+		WriteJSONString(Stream, Thread.Name.c_str());
+		Stream << "}}";
+	}
+
+	for (const auto& Marker : Trace.Frames)
+	{
+		Separator();
+		Stream << "{\"name\":\"Frame " << Marker.FrameIndex << "\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":";
+		WriteMicroseconds(Stream, Marker.TimeNS);
+		Stream << "}";
+	}
+
+	for (const auto& Thread : Trace.Threads)
+	{
+		for (const auto& Event : Thread.Events)
+		{
+			Separator();
+			Stream << "{\"name\":";
+			WriteJSONString(Stream, Event.Name);
+			Stream << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << Thread.ThreadIndex << ",\"ts\":";
+			WriteMicroseconds(Stream, Event.StartNS);
+			Stream << ",\"dur\":";
+			WriteMicroseconds(Stream, Event.EndNS - Event.StartNS);
+			Stream << ",\"args\":{\"frame\":" << Event.FrameIndex << ",\"depth\":" << Event.Depth << "}}";
+		}
+	}
+
+	Stream << "\n]}\n";
+	return Stream.str();
+}
+
+bool sProfiler::ExportChromeTrace(const std::string& Path, std::uint64_t LastFrames) const
+{
+	std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+	if (!File.is_open())
+		return false;
+
+	const std::string Trace = GetChromeTrace(LastFrames);
+	File.write(Trace.data(), (std::streamsize)Trace.size());
+	return File.good();
+}
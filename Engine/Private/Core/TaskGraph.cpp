@@ -0,0 +1,220 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Core/TaskGraph.h"
+#include "Core/Profiler.h"
+
+struct sTaskGraph::sFrameState
+{
+	std::unique_ptr<std::atomic<std::int32_t>[]> PendingDependencies;
+	std::unique_ptr<std::atomic<bool>[]> Completed;
+};
+
+sTaskGraph::sTaskGraph(ThreadPool* InPool)
+	: Pool(InPool)
+	, bCompiled(false)
+{
+}
+
+sTaskGraph::~sTaskGraph()
+{
+	Join();
+	Tasks.clear();
+	Pool = nullptr;
+}
+
+std::size_t sTaskGraph::AddTask(const std::string& Name, std::uint32_t Reads, std::uint32_t Writes, ETaskThread Thread, const std::function<void(double DeltaTime)>& Function, bool bOverlapNextFrame)
+{
+	/*
+	* Overlapped tasks reference the task list.
+	*/
+	Join();
+
+	sTask Task;
+	Task.Name = Name;
+	Task.ProfileName = sProfiler::Get().InternName(Name);
+	Task.Reads = Reads;
+	Task.Writes = Writes;
+	Task.Thread = Thread;
+	Task.Function = Function;
+	Task.bOverlapNextFrame = bOverlapNextFrame;
+	Tasks.push_back(Task);
+
+	bCompiled = false;
+	return Tasks.size() - 1;
+}
+
+void sTaskGraph::Clear()
+{
+	Join();
+	Tasks.clear();
+	bCompiled = false;
+}
+
+bool sTaskGraph::Conflicts(std::uint32_t ReadsA, std::uint32_t WritesA, std::uint32_t ReadsB, std::uint32_t WritesB)
+{
+	return (WritesA & (ReadsB | WritesB)) != 0 || (ReadsA & WritesB) != 0;
+}
+
+void sTaskGraph::Compile()
+{
+	for (auto& Task : Tasks)
+	{
+		Task.Dependencies.clear();
+		Task.Dependents.clear();
+	}
+
+	for (std::size_t i = 0; i < Tasks.size(); i++)
+	{
+		for (std::size_t j = 0; j < i; j++)
+		{
+			if (Conflicts(Tasks[j].Reads, Tasks[j].Writes, Tasks[i].Reads, Tasks[i].Writes))
+			{
+				Tasks[i].Dependencies.push_back(j);
+				Tasks[j].Dependents.push_back(i);
+			}
+		}
+	}
+
+	bCompiled = true;
+}
+
+void sTaskGraph::Execute(double DeltaTime)
+{
+	if (!bCompiled)
+		Compile();
+
+	const std::size_t Count = Tasks.size();
+	if (Count == 0)
+		return;
+
+	std::erase_if(InFlight, [](const sInFlightTask& Task) { return Task.Handle.IsCompleted(); });
+
+	std::shared_ptr<sFrameState> State = std::make_shared<sFrameState>();
+	State->PendingDependencies = std::make_unique<std::atomic<std::int32_t>[]>(Count);
+	State->Completed = std::make_unique<std::atomic<bool>[]>(Count);
+
+	/*
+	* Overlapped tasks of the previous frames that has to be completed before the task can start.
+	*/
+	std::vector<std::vector<std::size_t>> Blockers(Count);
+	for (std::size_t i = 0; i < Count; i++)
+	{
+		State->PendingDependencies[i].store((std::int32_t)Tasks[i].Dependencies.size(), std::memory_order_relaxed);
+		State->Completed[i].store(false, std::memory_order_relaxed);
+
+		for (std::size_t j = 0; j < InFlight.size(); j++)
+		{
+			if (Conflicts(InFlight[j].Reads, InFlight[j].Writes, Tasks[i].Reads, Tasks[i].Writes))
+				Blockers[i].push_back(j);
+		}
+	}
+
+	// DeltaTime is copied into every job, an overlapped task never sees the next frame's value.
+	auto Run = [this, DeltaTime](std::size_t Index, sFrameState* pState)
+	{
+		sProfileScope(Tasks[Index].ProfileName);
+		Tasks[Index].Function(DeltaTime);
+		for (const std::size_t Dependent : Tasks[Index].Dependents)
+			pState->PendingDependencies[Dependent].fetch_sub(1, std::memory_order_acq_rel);
+		pState->Completed[Index].store(true, std::memory_order_release);
+	};
+
+	std::vector<bool> Dispatched(Count, false);
+	std::vector<sInFlightTask> Overlapped;
+	std::size_t Remaining = Count;
+
+	while (true)
+	{
+		bool bDispatched = false;
+		for (std::size_t i = 0; i < Count; i++)
+		{
+			if (Dispatched[i])
+				continue;
+			if (State->PendingDependencies[i].load(std::memory_order_acquire) > 0)
+				continue;
+			if (std::any_of(Blockers[i].begin(), Blockers[i].end(), [&](std::size_t j) { return !InFlight[j].Handle.IsCompleted(); }))
+				continue;
+
+			Dispatched[i] = true;
+			Remaining--;
+			bDispatched = true;
+
+			const sTask& Task = Tasks[i];
+			if (Task.Thread == ETaskThread::eGameThread)
+			{
+				Run(i, State.get());
+			}
+			else
+			{
+				sJobHandle Handle = Pool->Schedule([Run, State, i]() { Run(i, State.get()); });
+				if (Task.bOverlapNextFrame)
+				{
+					sInFlightTask InFlightTask;
+					InFlightTask.Reads = Task.Reads;
+					InFlightTask.Writes = Task.Writes;
+					InFlightTask.Handle = Handle;
+					Overlapped.push_back(InFlightTask);
+				}
+			}
+		}
+
+		if (Remaining == 0)
+		{
+			bool bFinished = true;
+			for (std::size_t i = 0; i < Count; i++)
+			{
+				if (!Tasks[i].bOverlapNextFrame && !State->Completed[i].load(std::memory_order_acquire))
+				{
+					bFinished = false;
+					break;
+				}
+			}
+			if (bFinished)
+				break;
+		}
+
+		if (!bDispatched && !Pool->TryExecuteJob())
+			std::this_thread::yield();
+	}
+
+	for (auto& Task : Overlapped)
+	{
+		if (!Task.Handle.IsCompleted())
+			InFlight.push_back(Task);
+	}
+}
+
+void sTaskGraph::Join(std::uint32_t Resources)
+{
+	for (const auto& Task : InFlight)
+	{
+		if (Conflicts(Task.Reads, Task.Writes, Resources, Resources))
+			Pool->Wait(Task.Handle);
+	}
+	std::erase_if(InFlight, [](const sInFlightTask& Task) { return Task.Handle.IsCompleted(); });
+}
@@ -26,69 +26,520 @@
 
 #include "pch.h"
 #include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
+#include <cassert>
 
-void ThreadPool::Start()
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    thread_local const ThreadPool* tPool = nullptr;
+    thread_local std::int32_t tQueueIndex = -1;
+    /*
+    * Spins before a worker goes to sleep, most fixed tick jobs are queued in bursts.
+    */
+    constexpr std::uint32_t IdleSpinCount = 64;
+
+    void SetupCurrentThread(const std::string& Name, std::uint64_t AffinityMask)
+    {
+        if (!Name.empty())
+            sProfiler::Get().SetThreadName(Name);
+#if defined(_WIN32)
+        if (!Name.empty())
+        {
+            const std::wstring WName(Name.begin(), Name.end());
+            SetThreadDescription(GetCurrentThread(), WName.c_str());
+        }
+        if (AffinityMask != 0)
+            SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)AffinityMask);
+#else
+        if (!Name.empty())
+        {
+            // Linux limits thread names to 15 characters.
+            pthread_setname_np(pthread_self(), Name.substr(0, 15).c_str());
+        }
+        if (AffinityMask != 0)
+        {
+            cpu_set_t CPUSet;
+            CPU_ZERO(&CPUSet);
+            for (std::uint32_t Bit = 0; Bit < 64 && Bit < CPU_SETSIZE; ++Bit)
+            {
+                if (AffinityMask & (1ull << Bit))
+                    CPU_SET(Bit, &CPUSet);
+            }
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &CPUSet);
+        }
+#endif
+    }
+
+    /*
+    * Worker i gets the i-th processor of the mask, wrapping when there are more workers than processors.
+    */
+    std::uint64_t GetWorkerAffinity(std::uint64_t AffinityMask, std::size_t WorkerIndex)
+    {
+        std::size_t Count = 0;
+        for (std::uint32_t Bit = 0; Bit < 64; ++Bit)
+        {
+            if (AffinityMask & (1ull << Bit))
+                Count++;
+        }
+        if (Count == 0)
+            return 0;
+
+        std::size_t Target = WorkerIndex % Count;
+        for (std::uint32_t Bit = 0; Bit < 64; ++Bit)
+        {
+            if ((AffinityMask & (1ull << Bit)) && Target-- == 0)
+                return 1ull << Bit;
+        }
+        return 0;
+    }
+
+    template<typename T>
+    void AtomicMax(std::atomic<T>& Target, T Value)
+    {
+        T Current = Target.load(std::memory_order_relaxed);
+        while (Current < Value && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+void sJobHandle::Reset()
+{
+    if (Job)
+    {
+        if (Job->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete Job;
+        Job = nullptr;
+    }
+}
+
+bool sJobDeque::Push(sJob* Job)
+{
+    const std::int64_t b = Bottom.load(std::memory_order_relaxed);
+    const std::int64_t t = Top.load(std::memory_order_acquire);
+    if (b - t >= Capacity)
+        return false;
+
+    Buffer[b & (Capacity - 1)].store(Job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+sJob* sJobDeque::Pop()
 {
-    const uint32_t num_threads = std::thread::hardware_concurrency(); // Max # of threads the system supports
-    for (uint32_t ii = 0; ii < num_threads; ++ii)
+    const std::int64_t b = Bottom.load(std::memory_order_relaxed) - 1;
+    Bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = Top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        Bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    sJob* Job = Buffer[b & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (t == b)
     {
-        threads.emplace_back(std::thread(&ThreadPool::ThreadLoop, this));
+        // Last job, race against stealers.
+        if (!Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            Job = nullptr;
+        Bottom.store(b + 1, std::memory_order_relaxed);
     }
+    return Job;
+}
+
+sJob* sJobDeque::Steal()
+{
+    std::int64_t t = Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = Bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+        return nullptr;
+
+    sJob* Job = Buffer[t & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (!Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return Job;
+}
+
+std::int32_t ThreadPool::GetCurrentThreadQueueIndex() const
+{
+    if (tPool == this)
+        return tQueueIndex;
+    // Queue 0 belongs to the thread that started the pool, a thread can own queue 0 of several pools.
+    return (threads.size() > 0 && std::this_thread::get_id() == OwnerThreadID) ? 0 : -1;
+}
+
+void ThreadPool::Start(std::optional<std::size_t> ThreadCount)
+{
+    sThreadPoolDesc Desc;
+    Desc.Name = Name.empty() ? "Compute" : Name;
+    Desc.ThreadCount = ThreadCount;
+    Desc.AffinityMask = AffinityMask;
+    Start(Desc);
 }
 
-void ThreadPool::QueueJob(const std::function<void()>& job)
+void ThreadPool::Start(const sThreadPoolDesc& Desc)
 {
-    if (threads.size() == 0)
-        Start();
+    if (threads.size() > 0)
+        return;
+
+    const std::size_t HardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2);
+    const std::size_t num_threads = std::max<std::size_t>(Desc.ThreadCount.has_value() ? *Desc.ThreadCount : HardwareThreads - 1, 1);
+
+    Name = Desc.Name;
+    AffinityMask = Desc.AffinityMask;
+    should_terminate = false;
+    ResetStats();
+
+    // Queue 0 belongs to the thread that starts the pool.
+    Queues.clear();
+    for (std::size_t ii = 0; ii < (num_threads + 1) * QueuesPerThread; ++ii)
+        Queues.push_back(std::make_unique<sJobDeque>());
+    OwnerThreadID = std::this_thread::get_id();
 
+    for (std::size_t ii = 0; ii < num_threads; ++ii)
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        jobs.push(job);
+        threads.emplace_back(std::thread(&ThreadPool::ThreadLoop, this, ii + 1));
     }
-    mutex_condition.notify_one();
 }
 
 void ThreadPool::Stop()
 {
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
+        std::unique_lock<std::mutex> lock(SleepMutex);
         should_terminate = true;
     }
-    mutex_condition.notify_all();
-    for (std::thread& active_thread : threads) 
+    SleepCondition.notify_all();
+    for (std::thread& active_thread : threads)
     {
         active_thread.join();
     }
     threads.clear();
+
+    // Jobs that never ran are dropped but still finished, so waiting handles and their parents complete.
+    for (auto& Queue : Queues)
+    {
+        while (sJob* Job = Queue->Steal())
+            Finish(Job);
+    }
+    Queues.clear();
+    {
+        std::unique_lock<std::mutex> lock(InjectionMutex);
+        for (auto& Lane : InjectionQueue)
+        {
+            for (sJob* Job : Lane)
+                Finish(Job);
+            Lane.clear();
+        }
+        InjectionSize = 0;
+    }
+    QueuedJobs = 0;
+    for (auto& LaneCounter : QueuedJobsPerLane)
+        LaneCounter = 0;
+    OwnerThreadID = std::thread::id();
 }
 
 bool ThreadPool::busy()
 {
-    bool poolbusy;
+    return QueuedJobs.load(std::memory_order_acquire) > 0;
+}
+
+void ThreadPool::QueueJob(const std::function<void()>& job, EJobPriority Priority)
+{
+    assert(threads.size() > 0 && "ThreadPool::Start has to be called before submitting jobs");
+
+    sJob* Job = new sJob();
+    Job->Function = job;
+    Job->Priority = Priority;
+    Submit(Job, true);
+}
+
+sJobHandle ThreadPool::Schedule(const std::function<void()>& job, const sJobHandle& Parent, EJobPriority Priority)
+{
+    assert(threads.size() > 0 && "ThreadPool::Start has to be called before submitting jobs");
+
+    sJob* Job = new sJob();
+    Job->Function = job;
+    Job->Priority = Priority;
+    if (sJob* ParentJob = Parent.Get())
+    {
+        ParentJob->UnfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+        Job->Parent = ParentJob;
+    }
+
+    sJobHandle Handle(Job);
+    Submit(Job);
+    return Handle;
+}
+
+sJobHandle ThreadPool::ParallelFor(std::size_t Count, std::size_t BatchSize, const std::function<void(std::size_t)>& Function)
+{
+    assert(threads.size() > 0 && "ThreadPool::Start has to be called before submitting jobs");
+
+    /*
+    * Root is submitted after the range is attached, otherwise it could finish before its children.
+    */
+    sJob* Root = new sJob();
+    sJobHandle Handle(Root);
+    if (Count > 0)
+        ScheduleRange(Handle, 0, Count, BatchSize == 0 ? 1 : BatchSize, std::make_shared<const std::function<void(std::size_t)>>(Function));
+    Submit(Root);
+    return Handle;
+}
+
+void ThreadPool::ScheduleRange(const sJobHandle& Root, std::size_t Begin, std::size_t End, std::size_t BatchSize, const std::shared_ptr<const std::function<void(std::size_t)>>& Function)
+{
+    /*
+    * Split in halves so idle workers steal large ranges instead of single batches.
+    */
+    Schedule([this, Root, Begin, End, BatchSize, Function]()
+        {
+            std::size_t RangeEnd = End;
+            while (RangeEnd - Begin > BatchSize)
+            {
+                const std::size_t Middle = Begin + ((RangeEnd - Begin) / 2);
+                ScheduleRange(Root, Middle, RangeEnd, BatchSize, Function);
+                RangeEnd = Middle;
+            }
+            for (std::size_t Index = Begin; Index < RangeEnd; ++Index)
+                (*Function)(Index);
+        }, Root, Root.Get()->Priority);
+}
+
+void ThreadPool::Wait(const sJobHandle& Handle)
+{
+    while (!Handle.IsCompleted())
+    {
+        if (sJob* Job = FindJob(GetCurrentThreadQueueIndex(), false))
+            Execute(Job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool ThreadPool::TryExecuteJob()
+{
+    if (sJob* Job = FindJob(GetCurrentThreadQueueIndex(), false))
+    {
+        Execute(Job);
+        return true;
+    }
+    return false;
+}
+
+sThreadPoolStats ThreadPool::GetStats() const
+{
+    sThreadPoolStats Stats;
+    Stats.Name = Name;
+    Stats.ThreadCount = threads.size();
+    for (std::size_t Lane = 0; Lane < LaneCount; ++Lane)
+        Stats.QueueDepth[Lane] = QueuedJobsPerLane[Lane].load(std::memory_order_relaxed);
+    Stats.PeakQueueDepth = PeakQueueDepth.load(std::memory_order_relaxed);
+    Stats.ExecutedJobs = ExecutedJobs.load(std::memory_order_relaxed);
+    if (Stats.ExecutedJobs > 0)
+        Stats.AverageLatencyMS = (double)TotalLatencyNS.load(std::memory_order_relaxed) / (double)Stats.ExecutedJobs / 1000000.0;
+    Stats.MaxLatencyMS = (double)MaxLatencyNS.load(std::memory_order_relaxed) / 1000000.0;
+    return Stats;
+}
+
+void ThreadPool::ResetStats()
+{
+    PeakQueueDepth = QueuedJobs.load(std::memory_order_relaxed);
+    ExecutedJobs = 0;
+    TotalLatencyNS = 0;
+    MaxLatencyNS = 0;
+}
+
+void ThreadPool::Submit(sJob* Job, bool bMayBlock)
+{
+    const std::size_t Lane = (std::size_t)Job->Priority;
+    Job->QueuedTime = std::chrono::steady_clock::now();
+
+    QueuedJobsPerLane[Lane].fetch_add(1, std::memory_order_relaxed);
+    const std::size_t Depth = QueuedJobs.fetch_add(1, std::memory_order_seq_cst) + 1;
+    AtomicMax(PeakQueueDepth, Depth);
+
+    const std::int32_t QueueIndex = GetCurrentThreadQueueIndex();
+    if (QueueIndex < 0 || (std::size_t)QueueIndex >= GetQueueCount() || !GetQueue(QueueIndex, Lane, bMayBlock)->Push(Job))
+    {
+        std::unique_lock<std::mutex> lock(InjectionMutex);
+        InjectionQueue[Lane].push_back(Job);
+        InjectionSize.fetch_add(1, std::memory_order_release);
+    }
+
+    WakeWorkers();
+}
+
+void ThreadPool::WakeWorkers()
+{
+    if (SleepingWorkers.load(std::memory_order_seq_cst) > 0)
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        poolbusy = !jobs.empty();
+        {
+            std::unique_lock<std::mutex> lock(SleepMutex);
+        }
+        SleepCondition.notify_one();
     }
-    return poolbusy;
 }
 
-void ThreadPool::ThreadLoop()
+sJob* ThreadPool::PickUp(sJob* Job)
+{
+    QueuedJobsPerLane[(std::size_t)Job->Priority].fetch_sub(1, std::memory_order_relaxed);
+    QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    return Job;
+}
+
+sJob* ThreadPool::FindJob(std::int32_t QueueIndex, bool bIncludeBlocking)
 {
-    while (true) 
+    const std::size_t QueueCount = GetQueueCount();
+    const bool bOwnsQueue = QueueIndex >= 0 && (std::size_t)QueueIndex < QueueCount;
+
+    /*
+    * Lanes are scanned high to low, a low priority job only runs when no higher lane has work anywhere.
+    */
+    for (std::size_t Lane = 0; Lane < LaneCount; ++Lane)
     {
-        std::function<void()> job;
+        if (QueuedJobsPerLane[Lane].load(std::memory_order_relaxed) == 0)
+            continue;
+
+        if (bOwnsQueue)
+        {
+            if (sJob* Job = GetQueue(QueueIndex, Lane)->Pop())
+                return PickUp(Job);
+            if (bIncludeBlocking)
+            {
+                if (sJob* Job = GetQueue(QueueIndex, Lane, true)->Pop())
+                    return PickUp(Job);
+            }
+        }
+
+        // The injection queue also holds QueueJob jobs from threads outside the pool.
+        if (bIncludeBlocking && InjectionSize.load(std::memory_order_acquire) > 0)
+        {
+            std::unique_lock<std::mutex> lock(InjectionMutex);
+            if (!InjectionQueue[Lane].empty())
+            {
+                sJob* Job = InjectionQueue[Lane].front();
+                InjectionQueue[Lane].pop_front();
+                InjectionSize.fetch_sub(1, std::memory_order_release);
+                return PickUp(Job);
+            }
+        }
+
+        const std::size_t Start = QueueIndex >= 0 ? (std::size_t)QueueIndex + 1 : 0;
+        for (std::size_t ii = 0; ii < QueueCount; ++ii)
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            mutex_condition.wait(lock, [this] {
-                return !jobs.empty() || should_terminate;
-                });
-            if (should_terminate)
+            const std::size_t Victim = (Start + ii) % QueueCount;
+            if ((std::int32_t)Victim == QueueIndex)
+                continue;
+            if (sJob* Job = GetQueue(Victim, Lane)->Steal())
+                return PickUp(Job);
+            if (bIncludeBlocking)
             {
-                return;
+                if (sJob* Job = GetQueue(Victim, Lane, true)->Steal())
+                    return PickUp(Job);
             }
-            job = jobs.front();
-            jobs.pop();
         }
-        job();
     }
+    return nullptr;
+}
+
+void ThreadPool::Execute(sJob* Job)
+{
+    const std::uint64_t LatencyNS = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Job->QueuedTime).count();
+    TotalLatencyNS.fetch_add(LatencyNS, std::memory_order_relaxed);
+    AtomicMax(MaxLatencyNS, LatencyNS);
+    ExecutedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    if (Job->Function)
+        Job->Function();
+    Finish(Job);
+}
+
+void ThreadPool::Finish(sJob* Job)
+{
+    if (Job->UnfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    sJob* Parent = Job->Parent;
+    if (Job->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete Job;
+
+    if (Parent)
+        Finish(Parent);
+}
+
+void ThreadPool::ThreadLoop(std::size_t QueueIndex)
+{
+    tPool = this;
+    tQueueIndex = (std::int32_t)QueueIndex;
+    SetupCurrentThread(Name + " " + std::to_string(QueueIndex), GetWorkerAffinity(AffinityMask, QueueIndex));
+
+    std::uint32_t IdleCounter = 0;
+    while (!should_terminate)
+    {
+        if (sJob* Job = FindJob((std::int32_t)QueueIndex, true))
+        {
+            IdleCounter = 0;
+            Execute(Job);
+            continue;
+        }
+
+        if (++IdleCounter < IdleSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(SleepMutex);
+        SleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        SleepCondition.wait(lock, [this] {
+            return QueuedJobs.load(std::memory_order_seq_cst) > 0 || should_terminate;
+            });
+        SleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+        IdleCounter = 0;
+    }
+
+    tPool = nullptr;
+    tQueueIndex = -1;
+}
+
+sServiceThread::sServiceThread(const std::string& InName, const std::function<void()>& Function, std::uint64_t AffinityMask)
+    : Name(InName)
+    , bRunning(std::make_shared<std::atomic<bool>>(true))
+{
+    // The thread may outlive this object when it detaches itself, so it doesn't touch 'this'.
+    Thread = std::thread([Running = bRunning, ThreadName = Name, Function, AffinityMask]()
+        {
+            SetupCurrentThread(ThreadName, AffinityMask);
+            Function();
+            Running->store(false, std::memory_order_release);
+        });
+}
+
+sServiceThread::~sServiceThread()
+{
+    Join();
+}
+
+void sServiceThread::Join()
+{
+    if (!Thread.joinable())
+        return;
+
+    // A service loop that tears its own session down can't join itself.
+    if (Thread.get_id() == std::this_thread::get_id())
+        Thread.detach();
+    else
+        Thread.join();
 }
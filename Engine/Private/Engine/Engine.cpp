@@ -26,23 +26,35 @@
 
 #include "pch.h"
 #include "Engine/Engine.h"
+#if defined(_WIN32)
 #include "GI/D3D11/D3D11Device.h"
 #include "GI/D3D12/D3D12Device.h"
 #include "GI/Vulkan/VulkanDevice.h"
+#endif
+#include "GI/Null/NullDevice.h"
+#if defined(_WIN32)
 #include "GI/Renderer/Renderer.h"
+#endif
 #include "GI/AbstractGI/AbstractGIDevice.h"
 #include "Engine/AbstractEngine.h"
 #include "AbstractGI/PostProcess.h"
 #include "Engine/IPhysicalWorld.h"
-#include "Engine/World2D.h"
 #include "AbstractGI/MaterialManager.h"
 #include "AbstractGI/TextureManager.h"
 #include "AbstractGI/ShaderManager.h"
+#if defined(_WIN32)
 #include "Engine/InputController.h"
 #include "Engine/Audio.h"
+#endif
 #include "Core/ThreadPool.h"
+#include "Core/TaskGraph.h"
+#include "Core/Coroutine.h"
+#include "Core/FrameAllocator.h"
+#include "Engine/MemoryManager.h"
+#include "Core/Profiler.h"
 #include "Network.h"
 #include "RemoteProcedureCall.h"
+#include "Replication.h"
 #include "Utilities/ConfigManager.h"
 
 #define Renderdoc_Enabled 0
@@ -50,6 +62,71 @@
 #include <renderdoc_app.h>
 #endif
 
+#if !defined(_WIN32)
+/*
+* The dedicated server build leaves out the renderer, input and audio sources.
+* These stand-ins are never created, they only let the shared call sites compile against null pointers.
+*/
+class sRenderer
+{
+public:
+	template<typename... Args> void SetGBufferClearMode(Args&&...) {}
+	EGBufferClear GetGBufferClearMode() const { return EGBufferClear::Disabled; }
+	template<typename... Args> void SetTonemapper(Args&&...) {}
+	int GetTonemapperIndex() const { return 0; }
+	template<typename... Args> void AddPostProcess(Args&&...) {}
+	template<typename... Args> void RemovePostProcess(Args&&...) {}
+	template<typename... Args> void DrawLine(Args&&...) {}
+	template<typename... Args> void DrawBound(Args&&...) {}
+	sScreenDimension GetInternalBaseRenderResolution() const { return sScreenDimension(); }
+	template<typename... Args> void SetInternalBaseRenderResolution(Args&&...) {}
+	template<typename... Args> void AddViewportInstance(Args&&...) {}
+	template<typename... Args> void RemoveViewportInstance(Args&&...) {}
+	template<typename... Args> void SetViewportInstancePriority(Args&&...) {}
+	template<typename... Args> void SetMetaWorld(Args&&...) {}
+	template<typename... Args> void OnResizeWindow(Args&&...) {}
+	template<typename... Args> void OnInputProcess(Args&&...) {}
+	IRenderTarget* GetFinalRenderTarget() const { return nullptr; }
+	void RemoveWorld() {}
+	void BeginPlay() {}
+	void Tick(const double) {}
+	void BeginFrame() {}
+	void Render() {}
+};
+
+class sInputController
+{
+public:
+	void BeginPlay() {}
+	void FixedUpdate(const double) {}
+	void Poll() {}
+	void InputProcess(const GMouseInput&, const GKeyboardChar&) {}
+};
+
+class XAudio
+{
+public:
+	template<typename... Args> void AddToPlayList(Args&&...) {}
+	template<typename... Args> void Play(Args&&...) {}
+	template<typename... Args> void Stop(Args&&...) {}
+	template<typename... Args> void Remove(Args&&...) {}
+	template<typename... Args> void DestroyAllVoice(Args&&...) {}
+	template<typename... Args> void SetVolume(Args&&...) {}
+	template<typename... Args> void SetPlayListState(Args&&...) {}
+	template<typename... Args> void BindFunctionOnVoiceStart(Args&&...) {}
+	template<typename... Args> void BindFunctionOnVoiceStop(Args&&...) {}
+	void Next() {}
+	void Resume() {}
+	void Pause() {}
+	bool IsLooped() const { return false; }
+	float GetVolume() const { return 0.0f; }
+	std::size_t GetPlayListCount(bool = false) const { return 0; }
+	std::size_t GetCurrentAudioIndex() const { return 0; }
+	void BeginPlay() {}
+	void Tick(const double) {}
+};
+#endif
+
 namespace
 {
 	static std::unique_ptr<IAbstractGIDevice> Device = nullptr;
@@ -58,14 +135,126 @@ namespace
 	static std::unique_ptr<sInputController> InputController = nullptr;
 	static std::unique_ptr<XAudio> pAudio = nullptr;
 	static ThreadPool mThreadPool;
+	static ThreadPool mBlockingIOPool;
+	static ThreadPool mStreamingPool;
+	static std::array<sThreadPoolDesc, 3> ThreadPoolDescs = {
+		sThreadPoolDesc{ "Compute", std::nullopt, 0 },
+		sThreadPoolDesc{ "BlockingIO", 2, 0 },
+		sThreadPoolDesc{ "Streaming", 1, 0 },
+	};
+
+	ThreadPool& GetThreadPool(EThreadPoolType Type)
+	{
+		switch (Type)
+		{
+		case EThreadPoolType::eBlockingIO:
+			return mBlockingIOPool;
+		case EThreadPoolType::eStreaming:
+			return mStreamingPool;
+		case EThreadPoolType::eCompute:
+		default:
+			return mThreadPool;
+		}
+	}
 	static IServer::UniquePtr Server = nullptr;
 	static IClient::UniquePtr Client = nullptr;
 	static sDateTime AppStartTime = sDateTime();
+	static sFrameStats FrameStats;
+	static bool bHeadless = false;
 
 	static bool bPauseInput = false;
 	static bool bPausePhysics = false;
 	static bool bPauseTick = false;
 
+	/*
+	* Receive runs on a worker next to the gameplay stages, creating or ending a session waits for it.
+	*/
+	static std::recursive_mutex NetworkMutex;
+
+	/*
+	* XAudio is ticked on a worker thread, the Audio facade and the tick are serialized.
+	* Voice callbacks are deferred and dispatched on the game thread.
+	*/
+	static std::recursive_mutex AudioMutex;
+	static std::mutex AudioEventMutex;
+	static std::vector<std::function<void()>> AudioEvents;
+
+	void DispatchAudioEvents()
+	{
+		std::vector<std::function<void()>> Events;
+		{
+			std::lock_guard<std::mutex> lock(AudioEventMutex);
+			Events.swap(AudioEvents);
+		}
+		for (const auto& Event : Events)
+			Event();
+	}
+
+	std::function<void(std::string)> DeferAudioEvent(const std::function<void(std::string)>& Function)
+	{
+		if (!Function)
+			return nullptr;
+
+		return [Function](std::string Name)
+			{
+				std::lock_guard<std::mutex> lock(AudioEventMutex);
+				AudioEvents.push_back([Function, Name]() { Function(Name); });
+			};
+	}
+
+	/*
+	* Resources of the frame graph stages.
+	*/
+	enum EFrameResource : std::uint32_t
+	{
+		eFrameResource_Network = 1 << 0,
+		eFrameResource_World = 1 << 1,
+		eFrameResource_Physics = 1 << 2,
+		eFrameResource_Input = 1 << 3,
+		eFrameResource_Audio = 1 << 4,
+		eFrameResource_Renderer = 1 << 5,
+		eFrameResource_Device = 1 << 6,
+	};
+
+#if !defined(_WIN32)
+	/*
+	* SYSTEMTIME layout for the dedicated server build.
+	*/
+	struct sSystemTime
+	{
+		std::int32_t wYear = 0;
+		std::int32_t wMonth = 0;
+		std::int32_t wDayOfWeek = 0;
+		std::int32_t wDay = 0;
+		std::int32_t wHour = 0;
+		std::int32_t wMinute = 0;
+		std::int32_t wSecond = 0;
+		std::int32_t wMilliseconds = 0;
+	};
+
+	sSystemTime GetSystemTimeNow(bool bLocal)
+	{
+		const auto Now = std::chrono::system_clock::now();
+		const std::time_t Seconds = std::chrono::system_clock::to_time_t(Now);
+		std::tm Time = {};
+		if (bLocal)
+			localtime_r(&Seconds, &Time);
+		else
+			gmtime_r(&Seconds, &Time);
+
+		sSystemTime Result;
+		Result.wYear = Time.tm_year + 1900;
+		Result.wMonth = Time.tm_mon + 1;
+		Result.wDayOfWeek = Time.tm_wday;
+		Result.wDay = Time.tm_mday;
+		Result.wHour = Time.tm_hour;
+		Result.wMinute = Time.tm_min;
+		Result.wSecond = Time.tm_sec;
+		Result.wMilliseconds = (std::int32_t)(std::chrono::duration_cast<std::chrono::milliseconds>(Now.time_since_epoch()).count() % 1000);
+		return Result;
+	}
+#endif
+
 #if Renderdoc_Enabled && _DEBUG
 	RENDERDOC_API_1_6_0* rdoc_api = nullptr;
 
@@ -95,27 +284,27 @@ namespace GPU
 {
 	sGPUInfo GetGPUInfo()
 	{
-		return Device->GetGPUInfo();
+		return Device ? Device->GetGPUInfo() : sGPUInfo();
 	}
 
 	EGITypes GetGIType()
 	{
-		return Device->GetGIType();
+		return Device ? Device->GetGIType() : EGITypes::eUndefined;
 	}
 
 	sViewport GetViewport()
 	{
-		return Device->GetViewport();
+		return Device ? Device->GetViewport() : sViewport();
 	}
 
 	sScreenDimension GetBackBufferDimension()
 	{
-		return Device->GetBackBufferDimension();
+		return Device ? Device->GetBackBufferDimension() : sScreenDimension();
 	}
 
 	EFormat GetBackBufferFormat()
 	{
-		return Device->GetBackBufferFormat();
+		return Device ? Device->GetBackBufferFormat() : EFormat::UNKNOWN;
 	}
 
 	EFormat GetDefaultDepthFormat()
@@ -125,12 +314,13 @@ namespace GPU
 
 	void SetGBufferClearMode(EGBufferClear Mode)
 	{
-		Renderer->SetGBufferClearMode(Mode);
+		if (Renderer)
+			Renderer->SetGBufferClearMode(Mode);
 	}
 
 	EGBufferClear GetGBufferClearMode()
 	{
-		return Renderer->GetGBufferClearMode();
+		return Renderer ? Renderer->GetGBufferClearMode() : EGBufferClear::Disabled;
 	}
 
 	std::uint32_t GetGBufferTextureEntryPoint()
@@ -145,174 +335,230 @@ namespace GPU
 
 	void* GetInternalDevice()
 	{
-		return Device->GetInternalDevice();
+		return Device ? Device->GetInternalDevice() : nullptr;
 	}
 
 	void SetTonemapper(const int Val)
 	{
-		Renderer->SetTonemapper(Val);
+		if (Renderer)
+			Renderer->SetTonemapper(Val);
 	}
 
 	int GetTonemapperIndex()
 	{
-		return Renderer->GetTonemapperIndex();
+		return Renderer ? Renderer->GetTonemapperIndex() : 0;
 	}
 
 	void AddPostProcess(const EPostProcessRenderOrder Order, const std::shared_ptr<sPostProcess>& PostProcess)
 	{
-		Renderer->AddPostProcess(Order, PostProcess);
+		if (Renderer)
+			Renderer->AddPostProcess(Order, PostProcess);
 	}
 
 	void RemovePostProcess(const EPostProcessRenderOrder Order, const int Val)
 	{
-		Renderer->RemovePostProcess(Order, Val);
+		if (Renderer)
+			Renderer->RemovePostProcess(Order, Val);
 	}
 
 	void DrawLine(const FVector& Start, const FVector& End, std::optional<float> Time)
 	{
-		Renderer->DrawLine(Start, End, FColor::White(), Time);
+		if (Renderer)
+			Renderer->DrawLine(Start, End, FColor::White(), Time);
 	}
 
 	void DrawBound(const FBoundingBox& Box, std::optional<float> Time)
 	{
-		Renderer->DrawBound(Box, FColor::White(), Time);
+		if (Renderer)
+			Renderer->DrawBound(Box, FColor::White(), Time);
 	}
 
 	void DrawLine(const FVector& Start, const FVector& End, const FColor& Color, std::optional<float> Time)
 	{
-		Renderer->DrawLine(Start, End, Color, Time);
+		if (Renderer)
+			Renderer->DrawLine(Start, End, Color, Time);
 	}
 
 	void DrawBound(const FBoundingBox& Box, const FColor& Color, std::optional<float> Time)
 	{
-		Renderer->DrawBound(Box, Color, Time);
+		if (Renderer)
+			Renderer->DrawBound(Box, Color, Time);
 	}
 
 	sScreenDimension GetInternalBaseRenderResolution()
 	{
-		return Renderer->GetInternalBaseRenderResolution();
+		return Renderer ? Renderer->GetInternalBaseRenderResolution() : sScreenDimension();
 	}
 
 	void SetInternalBaseRenderResolution(std::size_t Width, std::size_t Height)
 	{
-		Renderer->SetInternalBaseRenderResolution(Width, Height);
+		if (Renderer)
+			Renderer->SetInternalBaseRenderResolution(Width, Height);
 	}
 
 	void AddViewportInstance(sViewportInstance* ViewportInstance, std::optional<std::size_t> Priority)
 	{
-		Renderer->AddViewportInstance(ViewportInstance, Priority);
+		if (Renderer)
+			Renderer->AddViewportInstance(ViewportInstance, Priority);
 	}
 
 	void RemoveViewportInstance(sViewportInstance* ViewportInstance)
 	{
-		Renderer->RemoveViewportInstance(ViewportInstance);
+		if (Renderer)
+			Renderer->RemoveViewportInstance(ViewportInstance);
 	}
 
 	void RemoveViewportInstance(std::size_t Index)
 	{
-		Renderer->RemoveViewportInstance(Index);
+		if (Renderer)
+			Renderer->RemoveViewportInstance(Index);
 	}
 
-	void GPU::SetViewportInstancePriority(sViewportInstance* ViewportInstance, std::size_t Priority)
+	void SetViewportInstancePriority(sViewportInstance* ViewportInstance, std::size_t Priority)
 	{
-		Renderer->SetViewportInstancePriority(ViewportInstance, Priority);
+		if (Renderer)
+			Renderer->SetViewportInstancePriority(ViewportInstance, Priority);
 	}
 	bool IsBindlessRendererEnabled()
 	{
 		return false;
 	}
+
+	sGICommandStats GetCommandStats()
+	{
+		if (Device && Device->GetGIType() == EGITypes::eNull)
+			return static_cast<NullDevice*>(Device.get())->GetCommandStats();
+		return sGICommandStats();
+	}
+
+	void ResetCommandStats()
+	{
+		if (Device && Device->GetGIType() == EGITypes::eNull)
+			static_cast<NullDevice*>(Device.get())->ResetCommandStats();
+	}
 }
 
 namespace Audio
 {
 	void AddToPlayList(std::string Name, std::string path, bool loop, bool RunOnce)
 	{
-		pAudio->AddToPlayList(Name, path, loop, RunOnce);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->AddToPlayList(Name, path, loop, RunOnce);
 	}
 
 	void Play(std::string Name, std::string path, bool loop, bool PlayAsOverlap)
 	{
-		pAudio->Play(Name, path, loop, PlayAsOverlap);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Play(Name, path, loop, PlayAsOverlap);
 	}
 
 	void Stop(bool immediate)
 	{
-		pAudio->Stop(immediate);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Stop(immediate);
 	}
 
 	void Next()
 	{
-		pAudio->Next();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Next();
 	}
 
 	void Resume()
 	{
-		pAudio->Resume();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Resume();
 	}
 
 	void Pause()
 	{
-		pAudio->Pause();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Pause();
 	}
 
 	void Remove(std::size_t index)
 	{
-		pAudio->Remove(index);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Remove(index);
 	}
 
 	void Remove(std::string Name)
 	{
-		pAudio->Remove(Name);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->Remove(Name);
 	}
 
 	void DestroyAllVoice(bool IsOverlapSoundOnly)
 	{
-		pAudio->DestroyAllVoice(IsOverlapSoundOnly);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->DestroyAllVoice(IsOverlapSoundOnly);
 	}
 
 	bool IsLooped()
 	{
-		return pAudio->IsLooped();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		return pAudio ? pAudio->IsLooped() : false;
 	}
 
 	float GetVolume()
 	{
-		return pAudio->GetVolume();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		return pAudio ? pAudio->GetVolume() : 0.0f;
 	}
 
 	void SetVolume(float volume)
 	{
-		pAudio->SetVolume(volume);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->SetVolume(volume);
 	}
 
 	std::size_t GetPlayListCount(bool IsOverlapSoundOnly)
 	{
-		return pAudio->GetPlayListCount(IsOverlapSoundOnly);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		return pAudio ? pAudio->GetPlayListCount(IsOverlapSoundOnly) : 0;
 	}
 
 	std::size_t GetCurrentAudioIndex()
 	{
-		return pAudio->GetCurrentAudioIndex();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		return pAudio ? pAudio->GetCurrentAudioIndex() : 0;
 	}
 
 	std::size_t GetNextAudioIndex()
 	{
-		return pAudio->GetCurrentAudioIndex();
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		return pAudio ? pAudio->GetCurrentAudioIndex() : 0;
 	}
 
 	void SetPlayListState(bool State)
 	{
-		return pAudio->SetPlayListState(State);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->SetPlayListState(State);
 	}
 
 	void BindFunctionOnVoiceStart(std::function<void(std::string)> fOnVoiceStart)
 	{
-		return pAudio->BindFunctionOnVoiceStart(fOnVoiceStart);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->BindFunctionOnVoiceStart(DeferAudioEvent(fOnVoiceStart));
 	}
 
 	void BindFunctionOnVoiceStop(std::function<void(std::string)> fOnVoiceStop)
 	{
-		return pAudio->BindFunctionOnVoiceStop(fOnVoiceStop);
+		std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+		if (pAudio)
+			pAudio->BindFunctionOnVoiceStop(DeferAudioEvent(fOnVoiceStop));
 	}
 }
 
@@ -325,6 +571,8 @@ namespace Network
 		if (Instance->GetPlayerCount() == 0)
 			return false;
 
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
+
 		if (Client)
 		{
 			if (Client->IsConnected())
@@ -367,6 +615,7 @@ namespace Network
 
 	void DestroySession()
 	{
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
 		if (!Server)
 			return;
 		Server->DestroySession();
@@ -417,6 +666,7 @@ namespace Network
 
 	void SetServerMaximumMessagePerTick(std::size_t Size)
 	{
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
 		if (!Server)
 			return;
 		return Server->SetMaximumMessagePerTick(Size);
@@ -431,6 +681,7 @@ namespace Network
 
 	void SetClientMaximumMessagePerTick(std::size_t Size)
 	{
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
 		if (!Client)
 			return;
 		return Client->SetMaximumMessagePerTick(Size);
@@ -443,6 +694,55 @@ namespace Network
 		return Client->GetMaximumMessagePerTick();
 	}
 
+	sMPSCQueueStats GetServerIncomingQueueStats()
+	{
+		if (!Server)
+			return sMPSCQueueStats();
+		return Server->GetIncomingQueueStats();
+	}
+
+	sMPSCQueueStats GetClientIncomingQueueStats()
+	{
+		if (!Client)
+			return sMPSCQueueStats();
+		return Client->GetIncomingQueueStats();
+	}
+
+	sNetworkTrafficStats GetServerTrafficStats()
+	{
+		if (!Server)
+			return sNetworkTrafficStats();
+		return Server->GetTrafficStats();
+	}
+
+	void SetServerCompressionThreshold(std::size_t Bytes)
+	{
+		if (!Server)
+			return;
+		Server->SetCompressionThreshold(Bytes);
+	}
+
+	void SetClientCompressionThreshold(std::size_t Bytes)
+	{
+		if (!Client)
+			return;
+		Client->SetCompressionThreshold(Bytes);
+	}
+
+	sCompressionStats GetServerCompressionStats()
+	{
+		if (!Server)
+			return sCompressionStats();
+		return Server->GetCompressionStats();
+	}
+
+	sCompressionStats GetClientCompressionStats()
+	{
+		if (!Client)
+			return sCompressionStats();
+		return Client->GetCompressionStats();
+	}
+
 	std::string GetServerLevel()
 	{
 		if (!Server)
@@ -452,6 +752,7 @@ namespace Network
 
 	bool Connect(sGameInstance* Instance)
 	{
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
 		if (Server)
 		{
 			if (Server->IsServerRunning())
@@ -476,6 +777,7 @@ namespace Network
 
 	bool Connect(sGameInstance* Instance, std::string ip, std::uint16_t Port)
 	{
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
 		if (Server)
 		{
 			if (Server->IsServerRunning())
@@ -497,6 +799,7 @@ namespace Network
 
 	bool Disconnect()
 	{
+		std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
 		if (!Client)
 			return false;
 		return Client->Disconnect();
@@ -528,6 +831,36 @@ namespace Network
 	{
 		RemoteProcedureCallManager::Get().Unregister(Address, ClassName, rpcName);
 	}
+
+	void SetSendRPCNames(bool bEnable)
+	{
+		RemoteProcedureCallManager::Get().SetSendRPCNames(bEnable);
+	}
+
+	void SetReplicationRate(std::uint32_t UpdatesPerSecond)
+	{
+		ReplicationManager::Get().SetRate(UpdatesPerSecond);
+	}
+
+	std::uint32_t GetReplicationRate()
+	{
+		return ReplicationManager::Get().GetRate();
+	}
+
+	void SetRelevancyDistance(float Distance)
+	{
+		ReplicationManager::Get().SetRelevancyDistance(Distance);
+	}
+
+	float GetRelevancyDistance()
+	{
+		return ReplicationManager::Get().GetRelevancyDistance();
+	}
+
+	void SetViewBounds(std::size_t PlayerIndex, std::optional<FBoundingBox> Bounds)
+	{
+		ReplicationManager::Get().SetLocalView(PlayerIndex, Bounds);
+	}
 	
 	void CallRPC(std::string Address, std::string ClassName, std::string Name, std::optional<bool> reliable)
 	{
@@ -580,8 +913,12 @@ namespace Engine
 
 	void LocalUTCTimeNow(std::int32_t& Year, int32_t& Month, int32_t& DayOfWeek, int32_t& Day, int32_t& Hour, int32_t& Min, int32_t& Sec, int32_t& MSec)
 	{
+#if defined(_WIN32)
 		SYSTEMTIME st;
 		GetLocalTime(&st);
+#else
+		const sSystemTime st = GetSystemTimeNow(true);
+#endif
 
 		Year = st.wYear;
 		Month = st.wMonth;
@@ -595,8 +932,12 @@ namespace Engine
 
 	void UTCTimeNow(std::int32_t& Year, std::int32_t& Month, std::int32_t& DayOfWeek, std::int32_t& Day, std::int32_t& Hour, std::int32_t& Min, std::int32_t& Sec, std::int32_t& MSec)
 	{
+#if defined(_WIN32)
 		SYSTEMTIME st;
 		GetSystemTime(&st);
+#else
+		const sSystemTime st = GetSystemTimeNow(false);
+#endif
 
 		Year = st.wYear;
 		Month = st.wMonth;
@@ -647,11 +988,82 @@ namespace Engine
 		mThreadPool.QueueJob(job);
 	}
 
+	void QueueJob(EThreadPoolType Pool, const std::function<void()>& job, EJobPriority Priority)
+	{
+		GetThreadPool(Pool).QueueJob(job, Priority);
+	}
+
+	sJobHandle ScheduleJob(const std::function<void()>& job, const sJobHandle& Parent)
+	{
+		return mThreadPool.Schedule(job, Parent);
+	}
+
+	void WaitForJob(const sJobHandle& Handle)
+	{
+		mThreadPool.Wait(Handle);
+	}
+
+	sJobHandle ParallelFor(std::size_t Count, std::size_t BatchSize, const std::function<void(std::size_t)>& Function)
+	{
+		return mThreadPool.ParallelFor(Count, BatchSize, Function);
+	}
+
 	std::size_t AvailableThreadCount()
 	{
 		return mThreadPool.AvailableThreadCount();
 	}
 
+	void SetThreadPoolDesc(EThreadPoolType Pool, const sThreadPoolDesc& Desc)
+	{
+		ThreadPoolDescs[(std::size_t)Pool] = Desc;
+		ThreadPool& mPool = GetThreadPool(Pool);
+		// The frame graph and the coroutine scheduler keep handles into the compute pool, it is only configured before the engine starts.
+		if (mPool.AvailableThreadCount() == 0 || Pool == EThreadPoolType::eCompute)
+			return;
+		mPool.Stop();
+		mPool.Start(Desc);
+	}
+
+	sThreadPoolStats GetThreadPoolStats(EThreadPoolType Pool)
+	{
+		return GetThreadPool(Pool).GetStats();
+	}
+
+	sServiceThread::UniquePtr StartServiceThread(const std::string& Name, const std::function<void()>& Function)
+	{
+		return sServiceThread::CreateUnique(Name, Function);
+	}
+
+	void SetFrameStatsDesc(const sFrameStatsDesc& Desc)
+	{
+		FrameStats.SetDesc(Desc);
+	}
+
+	sFrameStatsDesc GetFrameStatsDesc()
+	{
+		return FrameStats.GetDesc();
+	}
+
+	sFrameStatSummary GetFrameStats(EFrameStat Stat)
+	{
+		return FrameStats.GetSummary(Stat);
+	}
+
+	std::vector<sFrameStatSummary> GetAllFrameStats()
+	{
+		return FrameStats.GetSummaries();
+	}
+
+	std::optional<sHitchRecord> GetLastHitch()
+	{
+		return FrameStats.GetLastHitch();
+	}
+
+	void ResetFrameStats()
+	{
+		FrameStats.Reset();
+	}
+
 	sInputController* GetInputController()
 	{
 		return InputController.get();
@@ -676,7 +1088,12 @@ namespace Engine
 
 	sScreenDimension GetScreenDimension()
 	{
-		return Device->GetBackBufferDimension();
+		return Device ? Device->GetBackBufferDimension() : sScreenDimension();
+	}
+
+	bool IsHeadless()
+	{
+		return bHeadless;
 	}
 }
 
@@ -723,12 +1140,12 @@ namespace Physics
 	{
 		return PhysicalWorld ? PhysicalWorld->LineTraceToViewPort(InOrigin, InDirection) : nullptr;
 	}
-	std::vector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds)
+	sFrameVector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds)
 	{
-		return PhysicalWorld ? PhysicalWorld->QueryAABB(Bounds) : std::vector<sPhysicalComponent*>();
+		return PhysicalWorld ? PhysicalWorld->QueryAABB(Bounds) : sFrameVector<sPhysicalComponent*>();
 	}
 
-	float Physics::GetPhysicalWorldScale()
+	float GetPhysicalWorldScale()
 	{
 		return PhysicalWorld ? PhysicalWorld->GetPhysicalWorldScale() : -1.0f;
 	}
@@ -736,62 +1153,62 @@ namespace Physics
 
 IGraphicsCommandContext::SharedPtr IGraphicsCommandContext::Create()
 {
-	return Device->CreateGraphicsCommandContext();
+	return Device ? Device->CreateGraphicsCommandContext() : nullptr;
 }
 
 IGraphicsCommandContext::UniquePtr IGraphicsCommandContext::CreateUnique()
 {
-	return Device->CreateUniqueGraphicsCommandContext();
+	return Device ? Device->CreateUniqueGraphicsCommandContext() : nullptr;
 }
 
 IComputeCommandContext::SharedPtr IComputeCommandContext::Create()
 {
-	return Device->CreateComputeCommandContext();
+	return Device ? Device->CreateComputeCommandContext() : nullptr;
 }
 
 IComputeCommandContext::UniquePtr IComputeCommandContext::CreateUnique()
 {
-	return Device->CreateUniqueComputeCommandContext();
+	return Device ? Device->CreateUniqueComputeCommandContext() : nullptr;
 }
 
 ICopyCommandContext::SharedPtr ICopyCommandContext::Create()
 {
-	return Device->CreateCopyCommandContext();
+	return Device ? Device->CreateCopyCommandContext() : nullptr;
 }
 
 ICopyCommandContext::UniquePtr ICopyCommandContext::CreateUnique()
 {
-	return Device->CreateUniqueCopyCommandContext();
+	return Device ? Device->CreateUniqueCopyCommandContext() : nullptr;
 }
 
 IConstantBuffer::SharedPtr IConstantBuffer::Create(std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex)
 {
-	return Device->CreateConstantBuffer(InName, InDesc, InRootParameterIndex);
+	return Device ? Device->CreateConstantBuffer(InName, InDesc, InRootParameterIndex) : nullptr;
 }
 
 IConstantBuffer::UniquePtr IConstantBuffer::CreateUnique(std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex)
 {
-	return Device->CreateUniqueConstantBuffer(InName, InDesc, InRootParameterIndex);
+	return Device ? Device->CreateUniqueConstantBuffer(InName, InDesc, InRootParameterIndex) : nullptr;
 }
 
 IVertexBuffer::SharedPtr IVertexBuffer::Create(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
 {
-	return Device->CreateVertexBuffer(InName, InDesc, InSubresource);
+	return Device ? Device->CreateVertexBuffer(InName, InDesc, InSubresource) : nullptr;
 }
 
 IVertexBuffer::UniquePtr IVertexBuffer::CreateUnique(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
 {
-	return Device->CreateUniqueVertexBuffer(InName, InDesc, InSubresource);
+	return Device ? Device->CreateUniqueVertexBuffer(InName, InDesc, InSubresource) : nullptr;
 }
 
 IIndexBuffer::SharedPtr IIndexBuffer::Create(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
 {
-	return Device->CreateIndexBuffer(InName, InDesc, InSubresource);
+	return Device ? Device->CreateIndexBuffer(InName, InDesc, InSubresource) : nullptr;
 }
 
 IIndexBuffer::UniquePtr IIndexBuffer::CreateUnique(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
 {
-	return Device->CreateUniqueIndexBuffer(InName, InDesc, InSubresource);
+	return Device ? Device->CreateUniqueIndexBuffer(InName, InDesc, InSubresource) : nullptr;
 }
 
 IUnorderedAccessBuffer::SharedPtr IUnorderedAccessBuffer::Create(std::string InName, const BufferLayout& InDesc, bool bSRVAllowed)
@@ -816,52 +1233,52 @@ IIndirectBuffer::UniquePtr IIndirectBuffer::CreateUnique(std::string InName)
 
 IRenderTarget::SharedPtr IRenderTarget::Create(const std::string InName, const EFormat Format, const sFBODesc& Desc)
 {
-	return Device->CreateRenderTarget(InName, Format, Desc);
+	return Device ? Device->CreateRenderTarget(InName, Format, Desc) : nullptr;
 }
 
 IRenderTarget::UniquePtr IRenderTarget::CreateUnique(const std::string InName, const EFormat Format, const sFBODesc& Desc)
 {
-	return Device->CreateUniqueRenderTarget(InName, Format, Desc);
+	return Device ? Device->CreateUniqueRenderTarget(InName, Format, Desc) : nullptr;
 }
 
 IDepthTarget::SharedPtr IDepthTarget::Create(const std::string InName, const EFormat Format, const sFBODesc& Desc)
 {
-	return Device->CreateDepthTarget(InName, Format, Desc);
+	return Device ? Device->CreateDepthTarget(InName, Format, Desc) : nullptr;
 }
 
 IDepthTarget::UniquePtr IDepthTarget::CreateUnique(const std::string InName, const EFormat Format, const sFBODesc& Desc)
 {
-	return Device->CreateUniqueDepthTarget(InName, Format, Desc);
+	return Device ? Device->CreateUniqueDepthTarget(InName, Format, Desc) : nullptr;
 }
 
 IUnorderedAccessTarget::SharedPtr IUnorderedAccessTarget::Create(const std::string InName, const EFormat Format, const sFBODesc& Desc, bool InEnableSRV)
 {
-	return Device->CreateUnorderedAccessTarget(InName, Format, Desc, InEnableSRV);
+	return Device ? Device->CreateUnorderedAccessTarget(InName, Format, Desc, InEnableSRV) : nullptr;
 }
 
 IUnorderedAccessTarget::UniquePtr IUnorderedAccessTarget::CreateUnique(const std::string InName, const EFormat Format, const sFBODesc& Desc, bool InEnableSRV)
 {
-	return Device->CreateUniqueUnorderedAccessTarget(InName, Format, Desc, InEnableSRV);
+	return Device ? Device->CreateUniqueUnorderedAccessTarget(InName, Format, Desc, InEnableSRV) : nullptr;
 }
 
 IFrameBuffer::SharedPtr IFrameBuffer::Create(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments)
 {
-	return Device->CreateFrameBuffer(InName, InAttachments);
+	return Device ? Device->CreateFrameBuffer(InName, InAttachments) : nullptr;
 }
 
 IFrameBuffer::UniquePtr IFrameBuffer::CreateUnique(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments)
 {
-	return Device->CreateUniqueFrameBuffer(InName, InAttachments);
+	return Device ? Device->CreateUniqueFrameBuffer(InName, InAttachments) : nullptr;
 }
 
 IPipeline::SharedPtr IPipeline::Create(const std::string& InName, const sPipelineDesc& InDesc)
 {
-	return Device->CreatePipeline(InName, InDesc);
+	return Device ? Device->CreatePipeline(InName, InDesc) : nullptr;
 }
 
 IPipeline::UniquePtr IPipeline::CreateUnique(const std::string& InName, const sPipelineDesc& InDesc)
 {
-	return Device->CreateUniquePipeline(InName, InDesc);
+	return Device ? Device->CreateUniquePipeline(InName, InDesc) : nullptr;
 }
 
 IShader::SharedPtr IShader::Create(const sShaderAttachment& Attachment)
@@ -881,12 +1298,12 @@ IShader::SharedPtr IShader::Create(const void* InCode, std::size_t Size, std::st
 
 IComputePipeline::SharedPtr IComputePipeline::Create(const std::string& InName, const sComputePipelineDesc& InDesc)
 {
-	return Device->CreateComputePipeline(InName, InDesc);
+	return Device ? Device->CreateComputePipeline(InName, InDesc) : nullptr;
 }
 
 IComputePipeline::UniquePtr IComputePipeline::CreateUnique(const std::string& InName, const sComputePipelineDesc& InDesc)
 {
-	return Device->CreateUniqueComputePipeline(InName, InDesc);
+	return Device ? Device->CreateUniqueComputePipeline(InName, InDesc) : nullptr;
 }
 
 ITexture2D::SharedPtr ITexture2D::Create(const std::wstring FilePath, const std::string InName, std::uint32_t DefaultRootParameterIndex)
@@ -902,27 +1319,27 @@ ITexture2D::SharedPtr ITexture2D::Create(const std::wstring FilePath, const std:
 
 ITexture2D::UniquePtr ITexture2D::CreateUnique(const std::wstring FilePath, const std::string InName, std::uint32_t DefaultRootParameterIndex)
 {
-	return Device->CreateUniqueTexture2D(FilePath, InName, DefaultRootParameterIndex);
+	return Device ? Device->CreateUniqueTexture2D(FilePath, InName, DefaultRootParameterIndex) : nullptr;
 }
 
 ITexture2D::SharedPtr ITexture2D::Create(const std::string InName, void* InBuffer, const std::size_t InSize, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
 {
-	return Device->CreateTexture2D(InName, InBuffer, InSize, InDesc, DefaultRootParameterIndex);
+	return Device ? Device->CreateTexture2D(InName, InBuffer, InSize, InDesc, DefaultRootParameterIndex) : nullptr;
 }
 
 ITexture2D::UniquePtr ITexture2D::CreateUnique(const std::string InName, void* InBuffer, const std::size_t InSize, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
 {
-	return Device->CreateUniqueTexture2D(InName, InBuffer, InSize, InDesc, DefaultRootParameterIndex);
+	return Device ? Device->CreateUniqueTexture2D(InName, InBuffer, InSize, InDesc, DefaultRootParameterIndex) : nullptr;
 }
 
 ITexture2D::SharedPtr ITexture2D::CreateEmpty(const std::string InName, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
 {
-	return Device->CreateEmptyTexture2D(InName, InDesc, DefaultRootParameterIndex);
+	return Device ? Device->CreateEmptyTexture2D(InName, InDesc, DefaultRootParameterIndex) : nullptr;
 }
 
 ITexture2D::UniquePtr ITexture2D::CreateUniqueEmpty(const std::string InName, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
 {
-	return Device->CreateUniqueEmptyTexture2D(InName, InDesc, DefaultRootParameterIndex);
+	return Device ? Device->CreateUniqueEmptyTexture2D(InName, InDesc, DefaultRootParameterIndex) : nullptr;
 }
 
 //ITiledTexture::SharedPtr ITiledTexture::Create(const std::string InName, const std::uint32_t InTileX, const std::uint32_t InTileY, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
@@ -998,21 +1415,22 @@ sEngine::sEngine(const GPUDeviceCreateInfo& CreateInfo, const IPhysicalWorld::Sh
 	: MetaWorld(nullptr)
 	, ScreenDimension(sScreenDimension())
 	, bWindowInitialized(false)
+	, FrameGraph(nullptr)
+	, bFrameOverlap(false)
 {
 #if Renderdoc_Enabled && _DEBUG
 	InitializeRenderDoc();
 #endif
 
-	AppStartTime = Engine::GetUTCTimeNow();
-
-	mThreadPool.Start();
+	bHeadless = false;
+	InitializeCore();
+#if defined(_WIN32)
 	pAudio = std::make_unique<XAudio>();
-
-	FixedStepTimer.SetFixedTimeStep(true);
-	FixedStepTimer.SetTargetElapsedSeconds(1.0 / 60.0);
+#endif
 
 	switch (CreateInfo.Type)
 	{
+#if defined(_WIN32)
 	case EGITypes::eD3D11:
 		Device = D3D11Device::CreateUnique(CreateInfo);
 		break;
@@ -1022,10 +1440,18 @@ sEngine::sEngine(const GPUDeviceCreateInfo& CreateInfo, const IPhysicalWorld::Sh
 	case EGITypes::eVulkan:
 		Device = VulkanDevice::CreateUnique(CreateInfo);
 		break;
+#endif
+	case EGITypes::eNull:
+		Device = NullDevice::CreateUnique(CreateInfo);
+		break;
 		//case EGITypes::eOpenGL46:
 		//	break;
 	default:
+#if defined(_WIN32)
 		Device = D3D11Device::CreateUnique(CreateInfo);
+#else
+		Device = NullDevice::CreateUnique(CreateInfo);
+#endif
 		break;
 	}
 
@@ -1036,8 +1462,52 @@ sEngine::sEngine(const GPUDeviceCreateInfo& CreateInfo, const IPhysicalWorld::Sh
 	ScreenDimension.Width = (std::size_t)CreateInfo.Width;
 	ScreenDimension.Height = (std::size_t)CreateInfo.Height;
 
+#if defined(_WIN32)
 	InputController = sInputController::CreateUnique((HWND)CreateInfo.pHWND);
 	Renderer = sRenderer::CreateUnique(ScreenDimension.Width, ScreenDimension.Height);
+#endif
+
+	FrameGraph = sTaskGraph::CreateUnique(&mThreadPool);
+	BuildFrameGraph();
+}
+
+sEngine::sEngine(const sHeadlessCreateInfo& CreateInfo, const IPhysicalWorld::SharedPtr& InPhysicalWorld)
+	: MetaWorld(nullptr)
+	, ScreenDimension(sScreenDimension())
+	, bWindowInitialized(false)
+	, FrameGraph(nullptr)
+	, bFrameOverlap(false)
+{
+	bHeadless = true;
+	InitializeCore();
+
+	FixedStepTimer.SetTargetElapsedSeconds(1.0 / std::max(CreateInfo.FixedTickRate, 1.0));
+	mStepTimer.SetFixedTimeStep(true);
+	mStepTimer.SetTargetElapsedSeconds(1.0 / std::max(CreateInfo.TickRate, 1.0));
+
+	PhysicalWorld = InPhysicalWorld;
+
+	FrameGraph = sTaskGraph::CreateUnique(&mThreadPool);
+	BuildFrameGraph();
+}
+
+void sEngine::InitializeCore()
+{
+	AppStartTime = Engine::GetUTCTimeNow();
+	sProfiler::Get().SetThreadName("Game Thread");
+
+	mThreadPool.Start(ThreadPoolDescs[(std::size_t)EThreadPoolType::eCompute]);
+	mBlockingIOPool.Start(ThreadPoolDescs[(std::size_t)EThreadPoolType::eBlockingIO]);
+	mStreamingPool.Start(ThreadPoolDescs[(std::size_t)EThreadPoolType::eStreaming]);
+	sCoroutineScheduler::Get().Initialize(&mThreadPool, &mBlockingIOPool);
+
+	FixedStepTimer.SetFixedTimeStep(true);
+	FixedStepTimer.SetTargetElapsedSeconds(1.0 / 60.0);
+}
+
+bool sEngine::IsHeadless() const
+{
+	return bHeadless;
 }
 
 //sEngine::sEngine(const EGITypes GIType, const IPhysicalWorld::SharedPtr& InPhysicalWorld, std::optional<short> GPUIndex, void* InHWND)
@@ -1075,6 +1545,8 @@ sEngine::sEngine(const GPUDeviceCreateInfo& CreateInfo, const IPhysicalWorld::Sh
 
 sEngine::~sEngine()
 {
+	FrameGraph->Join();
+
 	if (Server)
 		Server->DestroySession();
 
@@ -1088,6 +1560,10 @@ sEngine::~sEngine()
 	PhysicalWorld = nullptr;
 	Renderer = nullptr;
 	pAudio = nullptr;
+	FrameGraph = nullptr;
+	sCoroutineScheduler::Get().Destroy();
+	mStreamingPool.Stop();
+	mBlockingIOPool.Stop();
 	mThreadPool.Stop();
 	RemoteProcedureCallManager::Get().Destroy();
 	Device = nullptr;
@@ -1123,19 +1599,159 @@ void sEngine::SetFixedTargetElapsedSeconds(double DeltaTime)
 
 void sEngine::EngineInternalTick()
 {
-	BeginFrame();
+	mStepTimer.Tick([&]()
+		{
+			sProfiler::Get().BeginFrame();
+			{
+				sProfileScope("sEngine::Frame");
+				FrameGraph->Execute(mStepTimer.GetElapsedSeconds());
+			}
+			FrameStats.EndFrame();
+		});
+
+	if (bHeadless)
+	{
+		// Nothing blocks on vsync without a device, sleep until the next tick is due.
+		// The last millisecond is yielded, sleeps overshoot by about the scheduler granularity.
+		const double WaitSeconds = mStepTimer.GetSecondsUntilNextUpdate();
+		if (WaitSeconds > 0.002)
+			std::this_thread::sleep_for(std::chrono::duration<double>(WaitSeconds - 0.001));
+		else if (WaitSeconds > 0.0)
+			std::this_thread::yield();
+	}
+}
+
+void sEngine::BuildFrameGraph()
+{
+	FrameGraph->Clear();
 
-	FixedStepTimer.Tick([&]()
+	// Added first so the workers pick them up while the game thread stages run.
+	if (!bHeadless)
+	{
+		FrameGraph->AddTask("Audio", 0, eFrameResource_Audio, ETaskThread::eWorker, [&](double DeltaTime)
+			{
+				MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eAudio);
+				std::lock_guard<std::recursive_mutex> lock(AudioMutex);
+				if (pAudio && !bPauseTick)
+					pAudio->Tick(DeltaTime);
+			}, true);
+		// Reads the devices, the callbacks fire from the polled state in FixedStep.
+		FrameGraph->AddTask("Input", 0, eFrameResource_Input, ETaskThread::eWorker, [&](double)
+			{
+				MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eGameplay);
+				if (InputController && !bPauseTick)
+					InputController->Poll();
+			});
+	}
+	// Drains, decompresses and unbundles the received packets, the Network stage handles them.
+	FrameGraph->AddTask("NetworkReceive", 0, eFrameResource_Network, ETaskThread::eWorker, [&](double)
 		{
-			PhysicsTick(FixedStepTimer.GetElapsedSeconds());
-			FixedTick(FixedStepTimer.GetElapsedSeconds());
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eNetwork);
+			std::lock_guard<std::recursive_mutex> lock(NetworkMutex);
+			if (bPauseTick)
+				return;
+			if (Server)
+				Server->Receive();
+			if (Client)
+				Client->Receive();
 		});
-	mStepTimer.Tick([&]()
+
+	// Without a device the render BeginFrame stage is never added, the per frame arenas are reset here.
+	if (bHeadless)
+	{
+		FrameGraph->AddTask("BeginFrame", 0, eFrameResource_World, ETaskThread::eGameThread, [&](double)
+			{
+				MemoryManager::BeginFrame();
+				sFrameAllocator::BeginFrame();
+			});
+	}
+
+	// Catches up on the physics and fixed updates due since the last frame. Contact and input callbacks run gameplay code.
+	FrameGraph->AddTask("FixedStep", 0, eFrameResource_Physics | eFrameResource_World | eFrameResource_Input, ETaskThread::eGameThread, [&](double)
+		{
+			FixedStepTimer.Tick([&]()
+				{
+					sProfileScope("sEngine::FixedStep");
+					FrameStats.AddFixedSteps(1);
+					PhysicsTick(FixedStepTimer.GetElapsedSeconds());
+					FixedTick(FixedStepTimer.GetElapsedSeconds());
+				});
+		});
+	FrameGraph->AddTask("Coroutines", 0, eFrameResource_World, ETaskThread::eGameThread, [&](double)
 		{
-			Tick(mStepTimer.GetElapsedSeconds());
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eGameplay);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eTick);
+			if (!bPauseTick)
+				sCoroutineScheduler::Get().Tick();
+		});
+	// RPC handlers and replication updates run gameplay code.
+	FrameGraph->AddTask("Network", 0, eFrameResource_Network | eFrameResource_World, ETaskThread::eGameThread, [&](double DeltaTime)
+		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eNetwork);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eTick);
+			if (bPauseTick)
+				return;
+			if (Server)
+				Server->Tick(DeltaTime);
+			if (Client)
+				Client->Tick(DeltaTime);
+		});
+	// Actors move their bodies, audio callbacks run gameplay code.
+	FrameGraph->AddTask("World", 0, eFrameResource_World | eFrameResource_Physics, ETaskThread::eGameThread, [&](double DeltaTime)
+		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eGameplay);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eTick);
+			DispatchAudioEvents();
+			if (MetaWorld && !bPauseTick)
+				MetaWorld->Tick(DeltaTime);
+		});
+
+	// A headless engine has no audio or render stages.
+	if (bHeadless)
+		return;
+
+	// Renderer::BeginFrame keeps no state, only the device begins its frame here.
+	FrameGraph->AddTask("BeginFrame", 0, eFrameResource_Device, ETaskThread::eGameThread, [&](double)
+		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eRender);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eRender);
+			BeginFrame();
+		});
+	// Expires lines and advances the renderer clock next to BeginFrame, Render uploads the changes.
+	FrameGraph->AddTask("RendererTick", eFrameResource_World, eFrameResource_Renderer, ETaskThread::eWorker, [&](double DeltaTime)
+		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eRender);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eRender);
+			if (!bPauseTick)
+				Renderer->Tick(DeltaTime);
+		});
+	FrameGraph->AddTask("Render", eFrameResource_World, eFrameResource_Renderer | eFrameResource_Device, ETaskThread::eGameThread, [&](double)
+		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eRender);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eRender);
 			Render();
-			Present();
 		});
+	FrameGraph->AddTask("Present", eFrameResource_Renderer, eFrameResource_Device, bFrameOverlap ? ETaskThread::eWorker : ETaskThread::eGameThread, [&](double)
+		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eRender);
+			sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::ePresent);
+			Present();
+		}, bFrameOverlap);
+}
+
+void sEngine::SetFrameOverlap(bool Enable)
+{
+	if (bFrameOverlap == Enable)
+		return;
+
+	FrameGraph->Join();
+	bFrameOverlap = Enable;
+	BuildFrameGraph();
+}
+
+bool sEngine::IsFrameOverlapEnabled() const
+{
+	return bFrameOverlap;
 }
 
 void sEngine::BeginPlay()
@@ -1149,11 +1765,15 @@ void sEngine::BeginPlay()
 	if (pAudio)
 		pAudio->BeginPlay();
 
-	Renderer->BeginPlay();
+	if (Renderer)
+		Renderer->BeginPlay();
 }
 
 void sEngine::PhysicsTick(const double DeltaTime)
 {
+	sProfileFunction;
+	MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::ePhysics);
+	sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::ePhysics);
 	if (PhysicalWorld && !bPausePhysics)
 		PhysicalWorld->Tick(DeltaTime);
 }
@@ -1163,32 +1783,16 @@ void sEngine::FixedTick(const double DeltaTime)
 	if (bPauseTick)
 		return;
 
+	sProfileFunction;
+	MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eGameplay);
+	sFrameStats::sScopedTime StatTime(FrameStats, EFrameStat::eTick);
+
 	if (MetaWorld)
 		MetaWorld->FixedUpdate(DeltaTime);
 	if (InputController)
 		InputController->FixedUpdate(DeltaTime);
 }
 
-void sEngine::Tick(const double DeltaTime)
-{
-	if (bPauseTick)
-		return;
-
-	if (Server)
-		Server->Tick(DeltaTime);
-	if (Client)
-		Client->Tick(DeltaTime);
-
-	if (MetaWorld && !bPauseTick)
-		MetaWorld->Tick(DeltaTime);
-	if (InputController)
-		InputController->Tick(DeltaTime);
-	if (pAudio)
-		pAudio->Tick(DeltaTime);
-
-	Renderer->Tick(DeltaTime);
-}
-
 void sEngine::BeginFrame()
 {
 #if Renderdoc_Enabled && _DEBUG
@@ -1197,18 +1801,28 @@ void sEngine::BeginFrame()
 	}
 #endif
 
-	Device->BeginFrame();
-	Renderer->BeginFrame();
+	sProfileFunction;
+	MemoryManager::BeginFrame();
+	sFrameAllocator::BeginFrame();
+	if (Device && Renderer)
+	{
+		Device->BeginFrame();
+		Renderer->BeginFrame();
+	}
 }
 
 void sEngine::Render()
 {
-	Renderer->Render();
+	sProfileFunction;
+	if (Renderer)
+		Renderer->Render();
 }
 
 void sEngine::Present()
 {
-	Device->Present(Renderer->GetFinalRenderTarget());
+	sProfileFunction;
+	if (Device && Renderer)
+		Device->Present(Renderer->GetFinalRenderTarget());
 
 #if Renderdoc_Enabled && _DEBUG
 	if (rdoc_api) {
@@ -1219,22 +1833,27 @@ void sEngine::Present()
 
 bool sEngine::SetMetaWorld(const std::shared_ptr<IMetaWorld>& pMetaWorld)
 {
-	if (!pMetaWorld || !Renderer)
+	if (!pMetaWorld || (!Renderer && !bHeadless))
 		return false;
 
+	FrameGraph->Join(eFrameResource_Device);
+
 	if (MetaWorld)
 		DestroyWorld();
 
 	MetaWorld = pMetaWorld;
-	Renderer->SetMetaWorld(MetaWorld.get());
+	if (Renderer)
+		Renderer->SetMetaWorld(MetaWorld.get());
 
 	return true;
 }
 
 void sEngine::DestroyWorld()
 {
+	FrameGraph->Join(eFrameResource_Device);
 	MetaWorld = nullptr;
-	Renderer->RemoveWorld();
+	if (Renderer)
+		Renderer->RemoveWorld();
 }
 
 IMetaWorld* sEngine::GetMetaWorld() const
@@ -1244,42 +1863,48 @@ IMetaWorld* sEngine::GetMetaWorld() const
 
 void sEngine::FullScreen(const bool value)
 {
-	Device->FullScreen(value);
+	FrameGraph->Join(eFrameResource_Device);
+	if (Device)
+		Device->FullScreen(value);
 }
 
 bool sEngine::IsFullScreen() const
 {
-	return Device->IsFullScreen();
+	return Device ? Device->IsFullScreen() : false;
 }
 
 bool sEngine::IsVsyncEnabled() const
 {
-	return Device->IsVsyncEnabled();
+	return Device ? Device->IsVsyncEnabled() : false;
 }
 
 void sEngine::Vsync(const bool value)
 {
-	Device->Vsync(value);
+	FrameGraph->Join(eFrameResource_Device);
+	if (Device)
+		Device->Vsync(value);
 }
 
 void sEngine::VsyncInterval(const std::uint32_t value)
 {
-	Device->VsyncInterval(value);
+	FrameGraph->Join(eFrameResource_Device);
+	if (Device)
+		Device->VsyncInterval(value);
 }
 
 std::uint32_t sEngine::GetVsyncInterval() const
 {
-	return Device->GetVsyncInterval();
+	return Device ? Device->GetVsyncInterval() : 0;
 }
 
 sGPUInfo sEngine::GetGPUInfo() const
 {
-	return Device->GetGPUInfo();
+	return Device ? Device->GetGPUInfo() : sGPUInfo();
 }
 
 std::vector<sDisplayMode> sEngine::GetAllSupportedResolutions() const
 {
-	return Device->GetAllSupportedResolutions();
+	return Device ? Device->GetAllSupportedResolutions() : std::vector<sDisplayMode>();
 }
 
 sScreenDimension sEngine::GetScreenDimension() const
@@ -1289,32 +1914,39 @@ sScreenDimension sEngine::GetScreenDimension() const
 
 void sEngine::ResizeWindow(std::size_t InWidth, std::size_t InHeight)
 {
+	FrameGraph->Join(eFrameResource_Device);
+
 	ScreenDimension.Width = InWidth;
 	ScreenDimension.Height = InHeight;
 
-	Device->ResizeWindow(ScreenDimension.Width, ScreenDimension.Height);
+	if (Device)
+		Device->ResizeWindow(ScreenDimension.Width, ScreenDimension.Height);
 	MetaWorld->OnResizeWindow(ScreenDimension.Width, ScreenDimension.Height);
-	Renderer->OnResizeWindow(ScreenDimension.Width, ScreenDimension.Height);
+	if (Renderer)
+		Renderer->OnResizeWindow(ScreenDimension.Width, ScreenDimension.Height);
 }
 
 sScreenDimension sEngine::GetInternalBaseRenderResolution() const
 {
-	return Renderer->GetInternalBaseRenderResolution();
+	return Renderer ? Renderer->GetInternalBaseRenderResolution() : sScreenDimension();
 }
 
 void sEngine::SetInternalBaseRenderResolution(std::size_t Width, std::size_t Height)
 {
-	Renderer->SetInternalBaseRenderResolution(Width, Height);
+	FrameGraph->Join(eFrameResource_Device);
+	if (Renderer)
+		Renderer->SetInternalBaseRenderResolution(Width, Height);
 }
 
 void sEngine::SetGBufferClearMode(EGBufferClear Mode)
 {
-	return Renderer->SetGBufferClearMode(Mode);
+	if (Renderer)
+		Renderer->SetGBufferClearMode(Mode);
 }
 
 EGBufferClear sEngine::GetGBufferClearMode() const
 {
-	return Renderer->GetGBufferClearMode();
+	return Renderer ? Renderer->GetGBufferClearMode() : EGBufferClear::Disabled;
 }
 
 void sEngine::InputProcess(const GMouseInput& MouseInput, const GKeyboardChar& KeyboardChar)
@@ -1334,5 +1966,6 @@ void sEngine::InputProcess(const GMouseInput& MouseInput, const GKeyboardChar& K
 	if (InputController)
 		InputController->InputProcess(MouseInput, KeyboardChar);
 
-	Renderer->OnInputProcess(MouseInput, KeyboardChar);
+	if (Renderer)
+		Renderer->OnInputProcess(MouseInput, KeyboardChar);
 }
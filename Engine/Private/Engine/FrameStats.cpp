@@ -0,0 +1,248 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Engine/FrameStats.h"
+#include "Engine/AbstractEngine.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+sFrameStats::sFrameStats()
+	: WriteIndex(0)
+	, SampleCount(0)
+	, LastFrameEnd(std::nullopt)
+	, FrameCount(0)
+	, LastDumpFrame(0)
+	, HitchCount(0)
+	, LastHitch(std::nullopt)
+{
+	for (auto& Value : CurrentFrame)
+		Value.store(0, std::memory_order_relaxed);
+	SetDesc(sFrameStatsDesc());
+}
+
+void sFrameStats::SetDesc(const sFrameStatsDesc& InDesc)
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	Desc = InDesc;
+	Desc.WindowSize = std::max<std::uint32_t>(Desc.WindowSize, 1);
+	for (auto& Stat : Samples)
+		Stat.assign(Desc.WindowSize, 0.0);
+	WriteIndex = 0;
+	SampleCount = 0;
+}
+
+sFrameStatsDesc sFrameStats::GetDesc() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	return Desc;
+}
+
+void sFrameStats::AddTime(EFrameStat Stat, std::uint64_t NS)
+{
+	CurrentFrame[(std::size_t)Stat].fetch_add(NS, std::memory_order_relaxed);
+}
+
+void sFrameStats::AddFixedSteps(std::uint32_t Count)
+{
+	CurrentFrame[(std::size_t)EFrameStat::eFixedSteps].fetch_add(Count, std::memory_order_relaxed);
+}
+
+void sFrameStats::EndFrame()
+{
+	const auto Now = std::chrono::steady_clock::now();
+
+	std::optional<double> HitchMS;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+
+		// The first frame has no previous frame to measure against.
+		const bool bHasFrameTime = LastFrameEnd.has_value();
+		const double FrameMS = bHasFrameTime ? std::chrono::duration<double, std::milli>(Now - *LastFrameEnd).count() : 0.0;
+		LastFrameEnd = Now;
+		FrameCount++;
+
+		for (std::size_t i = 0; i < StatCount; i++)
+		{
+			const std::uint64_t Value = CurrentFrame[i].exchange(0, std::memory_order_relaxed);
+			if ((EFrameStat)i == EFrameStat::eFrame)
+				Samples[i][WriteIndex] = FrameMS;
+			else if ((EFrameStat)i == EFrameStat::eFixedSteps)
+				Samples[i][WriteIndex] = (double)Value;
+			else
+				Samples[i][WriteIndex] = (double)Value / 1000000.0;
+		}
+
+		if (!bHasFrameTime)
+			return;
+
+		WriteIndex = (WriteIndex + 1) % Desc.WindowSize;
+		SampleCount = std::min<std::size_t>(SampleCount + 1, Desc.WindowSize);
+
+		if (Desc.HitchBudgetMS.has_value() && FrameMS > *Desc.HitchBudgetMS)
+		{
+			HitchCount++;
+			sHitchRecord Record;
+			Record.FrameIndex = FrameCount;
+			Record.FrameMS = FrameMS;
+			LastHitch = Record;
+
+			if (LastDumpFrame == 0 || FrameCount - LastDumpFrame >= Desc.HitchCooldownFrames)
+			{
+				LastDumpFrame = FrameCount;
+				HitchMS = FrameMS;
+			}
+		}
+	}
+
+	if (HitchMS.has_value())
+		DumpHitch(*HitchMS);
+}
+
+void sFrameStats::DumpHitch(double FrameMS)
+{
+	std::uint32_t DumpFrames = 0;
+	std::string Directory;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		DumpFrames = Desc.HitchDumpFrames;
+		Directory = Desc.HitchDumpDirectory;
+	}
+
+	const std::uint64_t ProfilerFrame = sProfiler::Get().GetFrameIndex();
+	const std::string Path = Directory + "/Hitch_Frame" + std::to_string(ProfilerFrame) + "_" + std::to_string((std::uint64_t)std::lround(FrameMS)) + "ms.json";
+
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		if (LastHitch.has_value())
+			LastHitch->DumpPath = Path;
+	}
+
+	Engine::WriteToConsole("Hitch : " + std::to_string(FrameMS) + "ms, profiler trace written to " + Path);
+
+	// Only the ring buffers are copied here, the JSON and the disk write are moved off the game thread.
+	std::shared_ptr<sProfileTrace> Trace = std::make_shared<sProfileTrace>(sProfiler::Get().CaptureTrace(DumpFrames));
+	Engine::QueueJob(EThreadPoolType::eBlockingIO, [Trace, Directory, Path]()
+		{
+			const std::string JSON = sProfiler::GetChromeTrace(*Trace);
+			std::error_code Error;
+			std::filesystem::create_directories(Directory, Error);
+			std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+			if (File.is_open())
+				File.write(JSON.data(), (std::streamsize)JSON.size());
+		}, EJobPriority::eLow);
+}
+
+sFrameStatSummary sFrameStats::GetSummary(EFrameStat Stat) const
+{
+	sFrameStatSummary Summary;
+	Summary.Stat = Stat;
+	Summary.Name = GetStatName(Stat);
+	if (Stat == EFrameStat::eCount)
+		return Summary;
+
+	std::vector<double> Values;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		const auto& Window = Samples[(std::size_t)Stat];
+		Values.reserve(SampleCount);
+		// Until the window is full only the first SampleCount slots are written.
+		for (std::size_t i = 0; i < SampleCount; i++)
+			Values.push_back(Window[i]);
+	}
+
+	if (Values.empty())
+		return Summary;
+
+	std::sort(Values.begin(), Values.end());
+	auto Percentile = [&](double P) -> double
+	{
+		const std::size_t Rank = (std::size_t)std::ceil(P * (double)Values.size());
+		return Values[std::min(Values.size() - 1, Rank > 0 ? Rank - 1 : 0)];
+	};
+
+	double Total = 0.0;
+	for (const double Value : Values)
+		Total += Value;
+
+	Summary.SampleCount = (std::uint32_t)Values.size();
+	Summary.Avg = Total / (double)Values.size();
+	Summary.P50 = Percentile(0.50);
+	Summary.P95 = Percentile(0.95);
+	Summary.P99 = Percentile(0.99);
+	Summary.Max = Values.back();
+	return Summary;
+}
+
+std::vector<sFrameStatSummary> sFrameStats::GetSummaries() const
+{
+	std::vector<sFrameStatSummary> Summaries;
+	for (std::size_t i = 0; i < StatCount; i++)
+		Summaries.push_back(GetSummary((EFrameStat)i));
+	return Summaries;
+}
+
+std::uint64_t sFrameStats::GetHitchCount() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	return HitchCount;
+}
+
+std::optional<sHitchRecord> sFrameStats::GetLastHitch() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	return LastHitch;
+}
+
+void sFrameStats::Reset()
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	for (auto& Stat : Samples)
+		std::fill(Stat.begin(), Stat.end(), 0.0);
+	WriteIndex = 0;
+	SampleCount = 0;
+	LastFrameEnd = std::nullopt;
+	HitchCount = 0;
+	LastHitch = std::nullopt;
+}
+
+const char* sFrameStats::GetStatName(EFrameStat Stat)
+{
+	switch (Stat)
+	{
+	case EFrameStat::eFrame: return "Frame";
+	case EFrameStat::eFixedSteps: return "FixedSteps";
+	case EFrameStat::ePhysics: return "Physics";
+	case EFrameStat::eTick: return "Tick";
+	case EFrameStat::eRender: return "Render";
+	case EFrameStat::ePresent: return "Present";
+	default: break;
+	}
+	return "Unknown";
+}
@@ -69,11 +69,41 @@ void sInputController::Tick(const double DeltaTime)
 
 void sInputController::FixedUpdate(const double DeltaTime)
 {
-	if (pHWND != GetForegroundWindow())
+	if (!Polled.bIsForeground)
 		return;
 	Update();
 }
 
+void sInputController::Poll()
+{
+	Polled.bIsForeground = pHWND == GetForegroundWindow();
+	if (!Polled.bIsForeground)
+		return;
+
+	if (bIsGamepadEnabled && pGamePad)
+	{
+		for (const auto& InputMap : GamePadInputMap)
+		{
+			if (InputMap.first >= DirectX::GamePad::MAX_PLAYER_COUNT)
+				break;
+			Polled.GamePads[InputMap.first] = pGamePad->GetState(InputMap.first);
+		}
+	}
+
+	if (bUpdateOnTick)
+	{
+		if (bIsMouseEnabled)
+			Polled.MouseLocation = WinGetMouseLocation((HWND)pHWND);
+
+		// GetAsyncKeyState reads the global key state, unlike GetKeyboardState it works on threads without a message queue.
+		if (bIsKeyboardEnabled)
+		{
+			for (std::size_t Key = 1; Key < Polled.Keys.size(); Key++)
+				Polled.Keys[Key] = (GetAsyncKeyState((int)Key) & 0x8000) != 0;
+		}
+	}
+}
+
 void sInputController::Update()
 {
 	if (bIsGamepadEnabled)
@@ -83,7 +113,7 @@ void sInputController::Update()
 			if (InputMap.first >= DirectX::GamePad::MAX_PLAYER_COUNT)
 				break;
 
-			auto state = pGamePad->GetState(InputMap.first);
+			const auto& state = Polled.GamePads[InputMap.first];
 
 			if (state.IsConnected())
 			{
@@ -531,7 +561,7 @@ void sInputController::Update()
 	{
 		if (bIsMouseEnabled)
 		{
-			FVector2 CurrentMouseLocation = WinGetMouseLocation((HWND)pHWND);
+			const FVector2 CurrentMouseLocation = Polled.MouseLocation;
 			if (MouseAxisInput.fOnXAxis)
 			{
 				MouseAxisInput.fOnXAxis(MouseLocation.X == CurrentMouseLocation.X ? 0.0f : MouseLocation.X > CurrentMouseLocation.X ? 1.0f : -1.0f, CurrentMouseLocation.X);
@@ -554,13 +584,13 @@ void sInputController::Update()
 
 		if (bIsKeyboardEnabled)
 		{
-			const bool bIsLControlPressed = (GetAsyncKeyState(VK_LCONTROL) & 0x8000);
-			const bool bIsRControlPressed = (GetAsyncKeyState(VK_RCONTROL) & 0x8000);
-			const bool bIsLShiftPressed = (GetAsyncKeyState(VK_LSHIFT) & 0x8000);
-			const bool bIsRShiftPressed = (GetAsyncKeyState(VK_RSHIFT) & 0x8000);
-			const bool bIsLAltPressed = (GetAsyncKeyState(VK_LMENU) & 0x8000);
-			const bool bIsRAltPressed = (GetAsyncKeyState(VK_RMENU) & 0x8000);
-			const bool bIsCapitalPressed = (GetAsyncKeyState(VK_CAPITAL) & 0x8000);
+			const bool bIsLControlPressed = Polled.Keys[VK_LCONTROL];
+			const bool bIsRControlPressed = Polled.Keys[VK_RCONTROL];
+			const bool bIsLShiftPressed = Polled.Keys[VK_LSHIFT];
+			const bool bIsRShiftPressed = Polled.Keys[VK_RSHIFT];
+			const bool bIsLAltPressed = Polled.Keys[VK_LMENU];
+			const bool bIsRAltPressed = Polled.Keys[VK_RMENU];
+			const bool bIsCapitalPressed = Polled.Keys[VK_CAPITAL];
 
 			for (auto& Input : InputMap)
 			{
@@ -584,7 +614,7 @@ void sInputController::Update()
 						continue;
 					}
 
-					const bool bIsPressed = (GetAsyncKeyState(InputDesc.Key) & 0x8000);
+					const bool bIsPressed = InputDesc.Key > 0 && InputDesc.Key < (int)Polled.Keys.size() && Polled.Keys[InputDesc.Key];
 
 					if (bIsPressed && KeyboardInput.State != InputState::PRESSED)
 					{
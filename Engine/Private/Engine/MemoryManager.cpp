@@ -26,48 +26,416 @@
 
 #include "pch.h"
 #include "Engine/MemoryManager.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
 
-namespace MemoryManager
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
 {
+	constexpr std::size_t TagCount = (std::size_t)EMemoryTag::eCount;
+
+	struct alignas(64) sTagCounters
+	{
+		std::atomic<std::int64_t> LiveBytes;
+		std::atomic<std::int64_t> PeakBytes;
+		std::atomic<std::int64_t> LiveAllocations;
+		std::atomic<std::uint64_t> TotalAllocations;
+		std::atomic<std::uint64_t> TotalBytes;
+	};
+	sTagCounters TagCounters[TagCount];
+
+	struct sFrameSnapshot
+	{
+		std::int64_t LiveBytes = 0;
+		std::uint64_t TotalAllocations = 0;
+	};
+	std::mutex FrameMutex;
+	std::array<sFrameSnapshot, TagCount> FrameStart;
+	std::array<sFrameSnapshot, TagCount> LastFrameDelta;
+
+	thread_local EMemoryTag tCurrentTag = EMemoryTag::eUntagged;
+
+	/*
+	* Keeps the returned pointer 16 byte aligned, same as malloc.
+	*/
+	struct sAllocationHeader
+	{
+		std::uint64_t Size;
+		std::uint64_t Tag;
+	};
+	static_assert(sizeof(sAllocationHeader) == 16, "Allocation header must keep 16 byte alignment");
+
+	/*
+	* Every thread gathers its counter changes here and adds them to TagCounters in batches,
+	* an allocation only touches memory of its own thread. Readers can miss up to one batch per thread
+	* and PeakBytes is sampled when a batch is added.
+	*/
+	struct sTagBatch
+	{
+		std::int64_t LiveBytes;
+		std::int64_t LiveAllocations;
+		std::uint64_t TotalAllocations;
+		std::uint64_t TotalBytes;
+		std::uint32_t PendingCount;
+	};
+	constexpr std::int64_t BatchFlushBytes = 64 * 1024;
+	constexpr std::uint32_t BatchFlushCount = 256;
+
+	thread_local sTagBatch tTagBatches[TagCount];
+	/*
+	* Set once the thread's batches are flushed on exit, later allocations go straight to TagCounters.
+	*/
+	thread_local bool tIsExiting = false;
+	thread_local bool tIsExitFlushRegistered = false;
+
+	void FlushTagBatch(std::size_t Index)
+	{
+		sTagBatch& Batch = tTagBatches[Index];
+		if (Batch.PendingCount == 0)
+			return;
+
+		sTagCounters& Counters = TagCounters[Index];
+		const std::int64_t Live = Counters.LiveBytes.fetch_add(Batch.LiveBytes, std::memory_order_relaxed) + Batch.LiveBytes;
+		Counters.LiveAllocations.fetch_add(Batch.LiveAllocations, std::memory_order_relaxed);
+		if (Batch.TotalAllocations > 0)
+		{
+			Counters.TotalAllocations.fetch_add(Batch.TotalAllocations, std::memory_order_relaxed);
+			Counters.TotalBytes.fetch_add(Batch.TotalBytes, std::memory_order_relaxed);
+		}
+		Batch = sTagBatch();
+
+		std::int64_t Peak = Counters.PeakBytes.load(std::memory_order_relaxed);
+		while (Peak < Live && !Counters.PeakBytes.compare_exchange_weak(Peak, Live, std::memory_order_relaxed))
+		{
+		}
+	}
 
-#if MemoryLeakDetector
+	void FlushTagBatches()
+	{
+		for (std::size_t i = 0; i < TagCount; i++)
+			FlushTagBatch(i);
+	}
 
-	void* operator new(std::size_t sz)
+	struct sExitFlush
 	{
-		std::printf("global op new called, size = %zu\n", sz);
-		if (sz == 0)
-			++sz; // avoid std::malloc(0) which may return nullptr on success
+		~sExitFlush()
+		{
+			FlushTagBatches();
+			tIsExiting = true;
+		}
+	};
+	thread_local sExitFlush tExitFlush;
 
-		if (void* ptr = std::malloc(sz))
+	inline sTagBatch& GetTagBatch(std::size_t Index)
+	{
+		if (!tIsExitFlushRegistered)
 		{
-			return ptr;
+			// The first use constructs it and registers its destructor for this thread.
+			tIsExitFlushRegistered = true;
+			(void)&tExitFlush;
 		}
+		return tTagBatches[Index];
+	}
 
-		throw std::bad_alloc{}; // required by [new.delete.single]/3
+	inline void FlushTagBatchIfFull(std::size_t Index)
+	{
+		const sTagBatch& Batch = tTagBatches[Index];
+		if (tIsExiting || Batch.PendingCount >= BatchFlushCount || Batch.LiveBytes >= BatchFlushBytes || Batch.LiveBytes <= -BatchFlushBytes)
+			FlushTagBatch(Index);
 	}
 
-	void* operator new (size_t size, const char* filename, int line)
+	inline void TrackAllocation(EMemoryTag Tag, std::size_t Size)
 	{
-		void* ptr = ::operator new(size);
-		return ptr;
+		const std::size_t Index = (std::size_t)Tag;
+		sTagBatch& Batch = GetTagBatch(Index);
+		Batch.LiveBytes += (std::int64_t)Size;
+		Batch.LiveAllocations++;
+		Batch.TotalAllocations++;
+		Batch.TotalBytes += Size;
+		Batch.PendingCount++;
+		FlushTagBatchIfFull(Index);
 	}
 
-	//#define new new(__FILE__, __LINE__)
+	inline void TrackDeallocation(EMemoryTag Tag, std::size_t Size)
+	{
+		const std::size_t Index = (std::size_t)Tag;
+		sTagBatch& Batch = GetTagBatch(Index);
+		Batch.LiveBytes -= (std::int64_t)Size;
+		Batch.LiveAllocations--;
+		Batch.PendingCount++;
+		FlushTagBatchIfFull(Index);
+	}
 
-	void operator delete(void* ptr) noexcept
+#if !defined(_WIN32)
+	/*
+	* Reads "Key: <value> kB" lines from /proc files, returns bytes.
+	*/
+	std::uint64_t ReadProcValue(const char* File, const char* Key)
 	{
-		/*if (std::find(memory.begin(), memory.end(), ptr) != memory.end())
+		std::FILE* Stream = std::fopen(File, "r");
+		if (!Stream)
+			return 0;
+
+		const std::size_t KeyLength = std::strlen(Key);
+		char Line[256];
+		std::uint64_t Value = 0;
+		while (std::fgets(Line, sizeof(Line), Stream))
 		{
-			if (auto obj = static_cast<Object*>(ptr))
+			if (std::strncmp(Line, Key, KeyLength) == 0 && Line[KeyLength] == ':')
 			{
-				std::cout << "TypeID-obj = " << typeid(obj).name() << std::endl;
+				Value = std::strtoull(Line + KeyLength + 1, nullptr, 10) * 1024ull;
+				break;
 			}
-			std::cout << "TypeID = " << typeid(ptr).name() << std::endl;
-			memory.erase(std::remove(memory.begin(), memory.end(), ptr), memory.end());
-		}*/
-		//auto ind = std::distance(myAlloc.begin(), std::find(myAlloc.begin(), myAlloc.end(), ptr));
-		//myAlloc[ind] = nullptr;
-		std::free(ptr);
+		}
+		std::fclose(Stream);
+		return Value;
+	}
+#endif
+}
+
+#if Enable_MemoryTracking
+void* operator new(std::size_t Size)
+{
+	const EMemoryTag Tag = tCurrentTag;
+	sAllocationHeader* Header = static_cast<sAllocationHeader*>(std::malloc(Size + sizeof(sAllocationHeader)));
+	if (!Header)
+		throw std::bad_alloc();
+
+	Header->Size = Size;
+	Header->Tag = (std::uint64_t)Tag;
+	TrackAllocation(Tag, Size);
+	return Header + 1;
+}
+
+void* operator new[](std::size_t Size)
+{
+	return ::operator new(Size);
+}
+
+void operator delete(void* Ptr) noexcept
+{
+	if (!Ptr)
+		return;
+
+	sAllocationHeader* Header = static_cast<sAllocationHeader*>(Ptr) - 1;
+	TrackDeallocation((EMemoryTag)Header->Tag, (std::size_t)Header->Size);
+	std::free(Header);
+}
+
+void operator delete[](void* Ptr) noexcept
+{
+	::operator delete(Ptr);
+}
+
+void operator delete(void* Ptr, std::size_t) noexcept
+{
+	::operator delete(Ptr);
+}
+
+void operator delete[](void* Ptr, std::size_t) noexcept
+{
+	::operator delete(Ptr);
+}
+#endif
+
+namespace MemoryManager
+{
+	sScopedMemoryTag::sScopedMemoryTag(EMemoryTag Tag)
+		: PreviousTag(tCurrentTag)
+	{
+		tCurrentTag = Tag;
+	}
+
+	sScopedMemoryTag::~sScopedMemoryTag()
+	{
+		tCurrentTag = PreviousTag;
 	}
+
+	EMemoryTag GetCurrentTag()
+	{
+		return tCurrentTag;
+	}
+
+	const char* GetTagName(EMemoryTag Tag)
+	{
+		switch (Tag)
+		{
+		case EMemoryTag::eUntagged: return "Untagged";
+		case EMemoryTag::eRender: return "Render";
+		case EMemoryTag::ePhysics: return "Physics";
+		case EMemoryTag::eNetwork: return "Network";
+		case EMemoryTag::eAudio: return "Audio";
+		case EMemoryTag::eContent: return "Content";
+		case EMemoryTag::eGameplay: return "Gameplay";
+		default: return "Unknown";
+		}
+	}
+
+	sMemoryTagStats GetTagStats(EMemoryTag Tag)
+	{
+		const std::size_t Index = (std::size_t)Tag;
+		sMemoryTagStats Stats;
+		if (Index >= TagCount)
+			return Stats;
+
+		// The calling thread's own changes are always included.
+		FlushTagBatch(Index);
+
+		const sTagCounters& Counters = TagCounters[Index];
+		Stats.Tag = Tag;
+		Stats.LiveBytes = Counters.LiveBytes.load(std::memory_order_relaxed);
+		Stats.PeakBytes = Counters.PeakBytes.load(std::memory_order_relaxed);
+		Stats.LiveAllocations = Counters.LiveAllocations.load(std::memory_order_relaxed);
+		Stats.TotalAllocations = Counters.TotalAllocations.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> Lock(FrameMutex);
+		Stats.FrameDeltaBytes = LastFrameDelta[Index].LiveBytes;
+		Stats.FrameAllocations = LastFrameDelta[Index].TotalAllocations;
+		return Stats;
+	}
+
+	std::vector<sMemoryTagStats> GetAllTagStats()
+	{
+		std::vector<sMemoryTagStats> Stats;
+		Stats.reserve(TagCount);
+		for (std::size_t i = 0; i < TagCount; i++)
+			Stats.push_back(GetTagStats((EMemoryTag)i));
+		return Stats;
+	}
+
+	std::uint64_t GetTotalAllocationCount()
+	{
+		FlushTagBatches();
+
+		std::uint64_t Count = 0;
+		for (const auto& Counters : TagCounters)
+			Count += Counters.TotalAllocations.load(std::memory_order_relaxed);
+		return Count;
+	}
+
+	std::uint64_t GetTotalAllocatedBytes()
+	{
+		FlushTagBatches();
+
+		std::uint64_t Bytes = 0;
+		for (const auto& Counters : TagCounters)
+			Bytes += Counters.TotalBytes.load(std::memory_order_relaxed);
+		return Bytes;
+	}
+
+	std::int64_t GetLiveBytes()
+	{
+		FlushTagBatches();
+
+		std::int64_t Bytes = 0;
+		for (const auto& Counters : TagCounters)
+			Bytes += Counters.LiveBytes.load(std::memory_order_relaxed);
+		return Bytes;
+	}
+
+	void BeginFrame()
+	{
+		FlushTagBatches();
+
+		std::lock_guard<std::mutex> Lock(FrameMutex);
+		for (std::size_t i = 0; i < TagCount; i++)
+		{
+			sFrameSnapshot Now;
+			Now.LiveBytes = TagCounters[i].LiveBytes.load(std::memory_order_relaxed);
+			Now.TotalAllocations = TagCounters[i].TotalAllocations.load(std::memory_order_relaxed);
+
+			LastFrameDelta[i].LiveBytes = Now.LiveBytes - FrameStart[i].LiveBytes;
+			LastFrameDelta[i].TotalAllocations = Now.TotalAllocations - FrameStart[i].TotalAllocations;
+			FrameStart[i] = Now;
+		}
+	}
+
+	sProcessMemoryStats GetProcessMemoryStats()
+	{
+		sProcessMemoryStats Stats;
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS_EX pmc;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc)))
+		{
+			Stats.ResidentBytes = pmc.WorkingSetSize;
+			Stats.PeakResidentBytes = pmc.PeakWorkingSetSize;
+			Stats.PrivateBytes = pmc.PrivateUsage;
+		}
+		MEMORYSTATUSEX memInfo;
+		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+		if (GlobalMemoryStatusEx(&memInfo))
+		{
+			Stats.TotalPhysicalBytes = memInfo.ullTotalPhys;
+			Stats.UsedPhysicalBytes = memInfo.ullTotalPhys - memInfo.ullAvailPhys;
+		}
+#else
+		Stats.ResidentBytes = ReadProcValue("/proc/self/status", "VmRSS");
+		Stats.PeakResidentBytes = ReadProcValue("/proc/self/status", "VmHWM");
+		Stats.PrivateBytes = ReadProcValue("/proc/self/status", "RssAnon");
+		Stats.TotalPhysicalBytes = ReadProcValue("/proc/meminfo", "MemTotal");
+		const std::uint64_t Available = ReadProcValue("/proc/meminfo", "MemAvailable");
+		Stats.UsedPhysicalBytes = Stats.TotalPhysicalBytes > Available ? Stats.TotalPhysicalBytes - Available : 0;
+#endif
+		return Stats;
+	}
+
+	std::uint64_t GetTotalVirtualMem()
+	{
+#if defined(_WIN32)
+		MEMORYSTATUSEX memInfo;
+		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+		GlobalMemoryStatusEx(&memInfo);
+		return memInfo.ullTotalPageFile;
+#else
+		return ReadProcValue("/proc/meminfo", "MemTotal") + ReadProcValue("/proc/meminfo", "SwapTotal");
+#endif
+	}
+
+	std::uint64_t GetVirtualMemUsed()
+	{
+#if defined(_WIN32)
+		MEMORYSTATUSEX memInfo;
+		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+		GlobalMemoryStatusEx(&memInfo);
+		return memInfo.ullTotalPageFile - memInfo.ullAvailPageFile;
+#else
+		const std::uint64_t Available = ReadProcValue("/proc/meminfo", "MemAvailable") + ReadProcValue("/proc/meminfo", "SwapFree");
+		const std::uint64_t Total = GetTotalVirtualMem();
+		return Total > Available ? Total - Available : 0;
+#endif
+	}
+
+	std::uint64_t GetVirtualMemUsedByEngine()
+	{
+#if defined(_WIN32)
+		return GetProcessMemoryStats().PrivateBytes;
+#else
+		return ReadProcValue("/proc/self/status", "VmSize");
 #endif
+	}
+
+	std::uint64_t GetTotalPhysicalMemory()
+	{
+		return GetProcessMemoryStats().TotalPhysicalBytes;
+	}
+
+	std::uint64_t GetTotalPhysicalMemoryUsed()
+	{
+		return GetProcessMemoryStats().UsedPhysicalBytes;
+	}
+
+	std::uint64_t GetTotalPhysicalMemoryUsedByEngine()
+	{
+		return GetProcessMemoryStats().ResidentBytes;
+	}
 }
@@ -38,14 +38,15 @@
 #include <queue>
 #include <map>
 #include <cctype>
-#include <Windows.h>
-#include <winsock2.h>
 #include "Network.h"
 #include "Engine/AbstractEngine.h"
 #include "RemoteProcedureCall.h"
+#include "Replication.h"
+#include "Engine/MemoryManager.h"
+#include "Core/Profiler.h"
 #include <chrono>
 
-#if Enable_Winsock
+#if Enable_Winsock && defined(_WIN32)
 // Need to link with Ws2_32.lib, Mswsock.lib, and Advapi32.lib
 #pragma comment (lib, "Ws2_32.lib")
 #pragma comment (lib, "Mswsock.lib")
@@ -73,6 +74,361 @@
 
 #endif
 
+/*
+* Packet headers and engine RPC names, small packets find most of their bytes in here.
+* Both ends need the same dictionary, frames carry its ID and a mismatch is dropped.
+*/
+static const sCompressionDictionary& GetNetworkDictionary()
+{
+	static const sCompressionDictionary Dictionary = []()
+	{
+		sArchive Header;
+		Header << sPacket(sDateTime(), eNetworkPacketType::RPC, "Global", "WSClient", "PingFromServer", "");
+		Header << sPacket(sDateTime(), eNetworkPacketType::DirectCall, "Global", "WSServer", "PingFromClient", "");
+
+		std::vector<std::uint8_t> Bytes = Header.GetData();
+		const std::vector<std::string> Names = {
+			"GNSServer", "GNSClient", "WSServer", "WSClient", "Global", "Level",
+			"ClientValidation", "OnClientSuccessfullyConnected", "OnConnected", "OnConnecting", "OnReciveServerInfo", "OnServerLevelChanged",
+			"OnNewPlayerConnected", "OnPlayerDisconnected", "OnNameChanged", "OnNameChangedFromServer", "OnPlayerNameChanged",
+			"StringFromServer\n", "StringFromClient\n", "RequestServerStats", "OnServerStats", "PingClient", "PingServer",
+			"AddToActiveLevel_Server", "SpawnPlayerFocusedActor_Server", "SpawnPlayerFocusedActor_Client",
+			"ReplicationFromServer", "ReplicationAck", "ViewFromClient",
+		};
+		for (const auto& Name : Names)
+			Bytes.insert(Bytes.end(), Name.begin(), Name.end());
+		return sCompressionDictionary(std::move(Bytes));
+	}();
+	return Dictionary;
+}
+
+/*
+* A frame from the network can claim any raw size, nothing larger than this is decoded.
+*/
+static constexpr std::size_t MaxCompressedPacketSize = sPacketBatch::MaxPacketSize;
+
+/*
+* Wraps an encoded packet into a Compressed packet, false if it is under the threshold or doesn't get smaller.
+*/
+static bool CompressPacket(const sArchive& Archive, std::size_t Threshold, sArchive& Out, sCompressionStats& Stats)
+{
+	// Receivers reject frames that decode past MaxCompressedPacketSize, larger packets go as they are.
+	if (Threshold == 0 || Archive.GetSize() <= Threshold || Archive.GetSize() > MaxCompressedPacketSize)
+		return false;
+
+	std::vector<std::uint8_t> Frame;
+	if (!Compression::Compress(Archive.GetData().data(), Archive.GetSize(), Frame, eCompressionCodec::LZ, &GetNetworkDictionary(), &Stats))
+		return false;
+
+	sPacket Packet;
+	Packet.Type = eNetworkPacketType::Compressed;
+	Packet.Data.assign(Frame.begin(), Frame.end());
+	Out << Packet;
+	return Out.GetSize() < Archive.GetSize();
+}
+
+/*
+* Replaces a Compressed packet with the one inside it, false if the frame is damaged.
+*/
+static bool DecompressPacket(sPacket& Packet, sCompressionStats& Stats)
+{
+	std::vector<std::uint8_t> Raw;
+	if (!Compression::Decompress(sArchiveView(Packet.Data), Raw, &GetNetworkDictionary(), &Stats, MaxCompressedPacketSize))
+		return false;
+
+	const sArchiveView Archive(Raw);
+	sPacket Inner;
+	Archive >> Inner;
+	if (Archive.IsFailed())
+		return false;
+	Packet = std::move(Inner);
+	return Packet.Type != eNetworkPacketType::Compressed;
+}
+
+/*
+* Adds the counters Receive gathered on a worker to the game thread ones and resets them.
+*/
+static void MergeCompressionStats(sCompressionStats& Stats, sCompressionStats& Pending)
+{
+	Stats.CompressedCount += Pending.CompressedCount;
+	Stats.SkippedCount += Pending.SkippedCount;
+	Stats.DecompressedCount += Pending.DecompressedCount;
+	Stats.FailedCount += Pending.FailedCount;
+	Stats.BytesIn += Pending.BytesIn;
+	Stats.BytesOut += Pending.BytesOut;
+	Stats.CompressTimeMS += Pending.CompressTimeMS;
+	Stats.DecompressTimeMS += Pending.DecompressTimeMS;
+	Pending = sCompressionStats();
+}
+
+/*
+* GNS bundles stay under a typical MTU so unreliable ones are not fragmented.
+* WS frames carry their own size and TCP has no MTU to respect, so they can be larger.
+*/
+static constexpr std::size_t GNSBundleSize = 1200;
+static constexpr std::size_t WSBundleSize = 4096;
+
+/*
+* WS streams are framed, every send is a 32 bit size followed by the encoded packet.
+* TCP splits and joins sends as it likes, a partial frame waits in Pending for the rest.
+*/
+static constexpr std::size_t WSMaxFrameSize = 16 * 1024 * 1024;
+
+static std::vector<std::uint8_t> MakeWSFrame(const void* Buffer, std::size_t Size)
+{
+	const std::uint32_t FrameSize = (std::uint32_t)Size;
+	std::vector<std::uint8_t> Frame(sizeof(FrameSize) + Size);
+	memcpy(Frame.data(), &FrameSize, sizeof(FrameSize));
+	memcpy(Frame.data() + sizeof(FrameSize), Buffer, Size);
+	return Frame;
+}
+
+/*
+* Decodes every complete frame of the received bytes, false if a size or a packet is invalid and the stream can't be followed anymore.
+* Frames are decoded in place, only a partial one is copied.
+*/
+template<typename Func>
+static bool ReadWSFrames(std::vector<std::uint8_t>& Pending, const std::uint8_t* Data, std::size_t Size, Func&& OnPacket)
+{
+	const auto Read = [&](const std::uint8_t* Bytes, std::size_t Count) -> std::optional<std::size_t>
+	{
+		std::size_t Pos = 0;
+		while (Count - Pos >= sizeof(std::uint32_t))
+		{
+			std::uint32_t FrameSize = 0;
+			memcpy(&FrameSize, Bytes + Pos, sizeof(FrameSize));
+			if (FrameSize == 0 || FrameSize > WSMaxFrameSize)
+				return std::nullopt;
+			if (Count - Pos - sizeof(FrameSize) < FrameSize)
+				break;
+
+			// A frame that doesn't hold a whole packet means the stream can't be trusted anymore.
+			const sArchiveView Frame(Bytes + Pos + sizeof(FrameSize), FrameSize);
+			sPacket Packet;
+			Frame >> Packet;
+			if (Frame.IsFailed())
+				return std::nullopt;
+			OnPacket(Packet);
+			Pos += sizeof(FrameSize) + FrameSize;
+		}
+		return Pos;
+	};
+
+	if (Pending.empty())
+	{
+		const auto Used = Read(Data, Size);
+		if (!Used)
+			return false;
+		Pending.assign(Data + *Used, Data + Size);
+		return true;
+	}
+
+	Pending.insert(Pending.end(), Data, Data + Size);
+	const auto Used = Read(Pending.data(), Pending.size());
+	if (!Used)
+	{
+		Pending.clear();
+		return false;
+	}
+	Pending.erase(Pending.begin(), Pending.begin() + *Used);
+	return true;
+}
+
+/*
+* Cuts a batch queue into bundles of at most BundleSize encoded bytes and clears it.
+* Send gets the packets of each bundle, see MakeBundle.
+*/
+template<typename Func>
+static void FlushBatch(std::vector<sPacketBatch::SharedPacket>& Queue, std::size_t BundleSize, Func&& Send)
+{
+	static const std::size_t HeaderSize = []()
+	{
+		sPacket Bundle;
+		Bundle.Type = eNetworkPacketType::Bundle;
+		return sArchive(Bundle).GetSize();
+	}();
+
+	std::size_t Pos = 0;
+	while (Pos < Queue.size())
+	{
+		std::size_t End = Pos;
+		std::size_t Bytes = 0;
+		while (End < Queue.size())
+		{
+			const std::size_t Next = Bytes + sizeof(std::uint16_t) + Queue[End]->size();
+			if (End > Pos && HeaderSize + Next > BundleSize)
+				break;
+			Bytes = Next;
+			End++;
+		}
+
+		Send(std::span<const sPacketBatch::SharedPacket>(Queue.data() + Pos, End - Pos));
+		Pos = End;
+	}
+	Queue.clear();
+}
+
+/*
+* A packet alone in its bundle goes out as is, more become a Bundle of [std::uint16_t Size][encoded packet].
+*/
+static sArchive MakeBundle(std::span<const sPacketBatch::SharedPacket> Packets)
+{
+	sArchive Archive;
+	if (Packets.size() == 1)
+	{
+		Archive.WriteBytes(Packets[0]->data(), Packets[0]->size());
+		return Archive;
+	}
+
+	sPacket Bundle;
+	Bundle.TimeStamp = Engine::GetUTCTimeNow();
+	Bundle.Type = eNetworkPacketType::Bundle;
+	for (const auto& Packet : Packets)
+	{
+		const std::uint16_t Prefix = (std::uint16_t)Packet->size();
+		Bundle.Data.append(reinterpret_cast<const char*>(&Prefix), sizeof(Prefix));
+		Bundle.Data.append(reinterpret_cast<const char*>(Packet->data()), Packet->size());
+	}
+	Archive << Bundle;
+	return Archive;
+}
+
+/*
+* Bundles flushed to several connections in one SendMessages, keyed by the packets they hold.
+* Broadcasts give every connection the same bundles, each is built and compressed once.
+* The keys own their packets, so a freed packet can't hand its address to a new one.
+*/
+class sEncodedBundleCache
+{
+public:
+	sEncodedBundleCache(std::size_t InThreshold, sCompressionStats& InStats)
+		: Threshold(InThreshold)
+		, Stats(InStats)
+	{}
+
+	const sArchive& Get(std::span<const sPacketBatch::SharedPacket> Packets)
+	{
+		std::vector<sPacketBatch::SharedPacket> Key(Packets.begin(), Packets.end());
+		auto It = Bundles.find(Key);
+		if (It != Bundles.end())
+			return It->second;
+
+		sArchive Bundle = MakeBundle(Packets);
+		sArchive Compressed;
+		const bool bCompressed = CompressPacket(Bundle, Threshold, Compressed, Stats);
+		return Bundles.emplace(std::move(Key), bCompressed ? std::move(Compressed) : std::move(Bundle)).first->second;
+	}
+
+private:
+	std::size_t Threshold;
+	sCompressionStats& Stats;
+	std::map<std::vector<sPacketBatch::SharedPacket>, sArchive> Bundles;
+};
+
+/*
+* Decompresses and unbundles a received packet, Fn gets every packet inside in order and returns false
+* to drop the rest of the bundle. False if the packet is damaged.
+*/
+template<typename Func>
+static bool UnpackPacket(sPacket& Packet, sCompressionStats& Stats, Func&& Fn)
+{
+	if (Packet.Type == eNetworkPacketType::Compressed && !DecompressPacket(Packet, Stats))
+		return false;
+
+	if (Packet.Type != eNetworkPacketType::Bundle)
+	{
+		Fn(Packet);
+		return true;
+	}
+
+	const sArchiveView Archive(Packet.Data);
+	while (Archive.GetRemainingSize() > 0)
+	{
+		// MakeBundle never writes an empty slot, nor anything after the last one.
+		std::uint16_t Size = 0;
+		if (!Archive.ReadBytes(&Size, sizeof(Size)) || Size == 0 || Size > Archive.GetRemainingSize())
+			return false;
+
+		const sArchiveView Slot = Archive.Consume(Size);
+		sPacket Inner;
+		Slot >> Inner;
+		if (Slot.IsFailed())
+			return false;
+		if (Inner.Type == eNetworkPacketType::Compressed || Inner.Type == eNetworkPacketType::Bundle)
+			return false;
+		if (!Fn(Inner))
+			break;
+	}
+	return true;
+}
+
+/*
+* Packets carry the RPC handle, the names only go out in debug mode or when the handle collides here.
+*/
+static sRPCHandle GetWireHandle(const sPacket& Packet)
+{
+	const auto& Manager = RemoteProcedureCallManager::Get();
+	if (Manager.IsSendingRPCNames())
+		return sRPCHandle();
+	const sRPCHandle Handle(Packet.Address, Packet.ClassName, Packet.FunctionName);
+	return Manager.IsHandleAmbiguous(Handle) ? sRPCHandle() : Handle;
+}
+
+/*
+* Multicasts encode their packet once with this and hand the same bytes to every recipient.
+*/
+static sArchive EncodePacket(eNetworkPacketType Type, const std::string& Address, const std::string& ClassName, const std::string& FunctionName, const std::optional<std::string>& Data)
+{
+	sPacket Packet;
+	Packet.TimeStamp = Engine::GetUTCTimeNow();
+	Packet.Address = Address;
+	Packet.ClassName = ClassName;
+	Packet.FunctionName = FunctionName;
+	Packet.Data = Data.has_value() ? *Data : "";
+	Packet.Type = Type;
+	Packet.Handle = GetWireHandle(Packet);
+	sArchive Archive;
+	Archive << Packet;
+	return Archive;
+}
+
+static std::string GetPacketName(const sPacket& Packet)
+{
+	if (Packet.Handle.IsValid())
+		return "Handle : " + Packet.Handle.ToString();
+	return "Address : " + Packet.Address + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName;
+}
+
+/*
+* Entry of an incoming RPC packet. Clients pass their local player address and the server side one,
+* a packet addressed to either is looked up under the other.
+*/
+static const RemoteProcedureCallManager::sRPCEntry* FindPacketRPC(const sPacket& Packet, const std::string& LocalAddress = "", const std::string& RemoteAddress = "")
+{
+	const auto& Manager = RemoteProcedureCallManager::Get();
+	if (Packet.Handle.IsValid())
+	{
+		const std::uint32_t Local = sRPCHandle::Hash(LocalAddress);
+		const std::uint32_t Remote = sRPCHandle::Hash(RemoteAddress);
+		const std::uint32_t Address = Packet.Handle.Address == Local ? Remote : Packet.Handle.Address == Remote ? Local : Packet.Handle.Address;
+		return Manager.FindRPC(sRPCHandle(Address, Packet.Handle.Member));
+	}
+	return Manager.FindRPC(Packet.Address == LocalAddress ? RemoteAddress : Packet.Address == RemoteAddress ? LocalAddress : Packet.Address, Packet.ClassName, Packet.FunctionName);
+}
+
+/*
+* Direct calls only reach the "Global" RPCs of the receiving class.
+*/
+static const RemoteProcedureCallManager::sRPCEntry* FindDirectCall(const sPacket& Packet, const std::string& ClassName)
+{
+	const auto& Manager = RemoteProcedureCallManager::Get();
+	if (!Packet.Handle.IsValid())
+		return Manager.FindRPC("Global", ClassName, Packet.FunctionName);
+
+	const auto* Entry = Manager.FindRPC(sRPCHandle(sRPCHandle::Hash("Global"), Packet.Handle.Member));
+	return Entry && Entry->ClassName == ClassName ? Entry : nullptr;
+}
+
 void IServer::OnSessionCreated()
 {
 	GetGameInstance()->SessionCreated();
@@ -218,6 +574,9 @@ GNSServer::GNSServer()
 	, Instance(nullptr)
 	, serverLocalAddr(SteamNetworkingIPAddr())
 	, MaximumMessagePerTick(32)
+	, CompressionThreshold(128)
+	, DamagedPacketCount(0)
+	, ReceiveGroup(0)
 	, bIsServerRunning(false)
 {
 	s_pServerCallbackInstance = this;
@@ -232,6 +591,8 @@ GNSServer::GNSServer()
 	RegisterRPCfn("Global", "GNSServer", "ClientValidation", eRPCType::Server, true, false, std::bind(&GNSServer::ValidateClient, this, std::placeholders::_1, std::placeholders::_2), std::uint32_t, std::string);
 	RegisterRPCfn("Global", "GNSServer", "PingFromClient", eRPCType::Server, true, false, std::bind(&GNSServer::PingFromClient, this, std::placeholders::_1, std::placeholders::_2), std::uint32_t, std::uint64_t);
 	RegisterRPCfn("Global", "GNSServer", "PingClient", eRPCType::Server, true, false, std::bind(&GNSServer::PingClient, this, std::placeholders::_1), std::uint32_t);
+	RegisterRPCfn("Global", "GNSServer", "ReplicationAck", eRPCType::Server, false, false, std::bind(&GNSServer::ReplicationAck, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::uint32_t, std::uint32_t, std::vector<sRPCHandle>);
+	RegisterRPCfn("Global", "GNSServer", "ViewFromClient", eRPCType::Server, false, false, std::bind(&GNSServer::ViewFromClient, this, std::placeholders::_1, std::placeholders::_2), std::uint32_t, std::vector<FVector>);
 }
 
 GNSServer::~GNSServer()
@@ -259,22 +620,37 @@ GNSServer::~GNSServer()
 
 void GNSServer::Tick(const double DeltaTime)
 {
+	sProfileFunction;
 	if (bIsServerRunning)
 	{
 		//auto MS = Engine::GetUTCTimeNow().GetTotalMillisecond();
 
 		//if ((MS - gTime) > 70)
 		{
-			PollIncomingMessages();
+			HandleReceivedPackets();
 			PollConnectionStateChanges();
+			ReplicationManager::Get().Tick(DeltaTime, [&](std::uint32_t ClientID, const sArchive& Update)
+				{
+					// Goes in as a parameter, sArchive(Bytes) would take the vector as its raw data.
+					sArchive Params;
+					Params << Update.GetData();
+					DirectCallToClient(ClientID, "ReplicationFromServer", false, Params);
+				});
 			SendMessages();
 			//gTime = Engine::GetUTCTimeNow().GetTotalMillisecond();
 		}
 	}
 }
 
-void GNSServer::PollIncomingMessages()
+void GNSServer::Receive()
 {
+	sProfileFunction;
+	if (!bIsServerRunning)
+	{
+		Received.clear();
+		return;
+	}
+
 	while (bIsServerRunning)
 	{
 		std::vector<ISteamNetworkingMessage*> pIncomingMsgs(MaximumMessagePerTick);
@@ -290,10 +666,6 @@ void GNSServer::PollIncomingMessages()
 		for (int i = 0; i < numMsgs; i++)
 		{
 			ISteamNetworkingMessage* pIncomingMsg = pIncomingMsgs[i];
-			if (std::find(KickList.begin(), KickList.end(), pIncomingMsg->m_conn) != KickList.end())
-				continue;
-
-			assert(IsPlayerExist(pIncomingMsg->m_conn));
 
 			/*SteamNetConnectionRealTimeStatus_t* pStatus = nullptr;
 			int nLanes = 0;
@@ -303,82 +675,113 @@ void GNSServer::PollIncomingMessages()
 			if (pLanes)
 				PrintToConsole("Ping : " + std::to_string(pLanes->m_usecQueueTime));*/
 
-			sArchive pArchive;
-			pArchive.SetData((std::uint8_t*)pIncomingMsg->m_pData, pIncomingMsg->m_cbSize);
+			const sArchiveView pArchive((const std::uint8_t*)pIncomingMsg->m_pData, (std::size_t)pIncomingMsg->m_cbSize);
 			sPacket Packet;
 			pArchive >> Packet;
 
-			auto Info = GetPlayerInfo(pIncomingMsg->m_conn);
-			if (!Info.bIsValid)
+			const bool bIsIntact = !pArchive.IsFailed() && UnpackPacket(Packet, ReceiveCompressionStats, [&](sPacket& Inner)
 			{
-				if (Packet.Type == eNetworkPacketType::Validation)
-				{
-					ValidateClient(pIncomingMsg->m_conn, Packet.Data);
-				}
-				else
-				{
-					PrintToConsole("Validation Skipped! msg : " + Packet.FunctionName);
-					KickClient(pIncomingMsg->m_conn);
-				}
+				Received.emplace_back(pIncomingMsg->m_conn, ReceiveGroup, std::move(Inner));
+				return true;
+			});
+			if (!bIsIntact)
+				DamagedPacketCount++;
+			ReceiveGroup++;
+
+			pIncomingMsg->Release();
+		}
+	}
+}
+
+void GNSServer::HandleReceivedPackets()
+{
+	MergeCompressionStats(CompressionStats, ReceiveCompressionStats);
+	if (DamagedPacketCount > 0)
+	{
+		PrintToConsole("Dropped " + std::to_string(DamagedPacketCount) + " damaged packets.");
+		DamagedPacketCount = 0;
+	}
+
+	std::optional<std::uint64_t> DroppedGroup;
+	for (auto& Msg : Received)
+	{
+		if (!bIsServerRunning)
+			break;
+		if (DroppedGroup == Msg.Group)
+			continue;
+		if (std::find(KickList.begin(), KickList.end(), Msg.ID) != KickList.end())
+			continue;
+
+		assert(IsPlayerExist(Msg.ID));
+
+		auto Info = GetPlayerInfo(Msg.ID);
+		if (!Info.bIsValid)
+		{
+			if (Msg.Packet.Type == eNetworkPacketType::Validation)
+			{
+				ValidateClient(Msg.ID, Msg.Packet.Data);
 			}
 			else
 			{
-				HandleMessages(pIncomingMsg->m_conn, Packet);
+				PrintToConsole("Validation Skipped! msg : " + GetPacketName(Msg.Packet));
+				KickClient(Msg.ID);
+				DroppedGroup = Msg.Group;
 			}
-
-			pIncomingMsg->Release();
+		}
+		else
+		{
+			HandleMessages(Msg.ID, Msg.Packet);
 		}
 	}
+	Received.clear();
 }
 
 void GNSServer::HandleMessages(HSteamNetConnection ID, sPacket Packet, std::optional<bool> reliable)
 {
 	if (Packet.Type == eNetworkPacketType::RPC)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC(Packet.Address, Packet.ClassName, Packet.FunctionName);
-		if (!RPC)
+		const auto* Entry = FindPacketRPC(Packet);
+		if (!Entry)
 		{
-			PrintToConsole("Failed to Call RPC | Address : " + Packet.Address + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
+			PrintToConsole("Failed to Call RPC | " + GetPacketName(Packet));
 			return;
 		}
+		auto RPC = Entry->RPC;
 
 		//PrintToConsole("RPC Called | Address : " + Packet.Address + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
 
 		switch (RPC->GetType())
 		{
 		case eRPCType::Client:
-			CallRPCFromClient(ID, Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable());
-			CallRPCFromClients(Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ID);
+			// The sender gets it back like every client the object is relevant to, encoded once for all of them.
+			CallRPCFromClients(Entry->Address, Entry->ClassName, RPC->GetName(), Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ReplicationManager::Get().GetIrrelevantConnections(Entry->Address, Entry->ClassName));
 			break;
 		case eRPCType::Server:
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
+				RPC->Call(sArchiveView(Packet.Data));
 			break;
 		case eRPCType::ServerAndClient:
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
-			CallRPCFromClient(ID, Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable());
-			CallRPCFromClients(Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ID);
+				RPC->Call(sArchiveView(Packet.Data));
+			// The sender gets it back like every client the object is relevant to, encoded once for all of them.
+			CallRPCFromClients(Entry->Address, Entry->ClassName, RPC->GetName(), Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ReplicationManager::Get().GetIrrelevantConnections(Entry->Address, Entry->ClassName));
 			break;
 		}
 	}
 	else if (Packet.Type == eNetworkPacketType::DirectCall)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC("Global", "GNSServer", Packet.FunctionName);
+		const auto* Entry = FindDirectCall(Packet, "GNSServer");
+		auto RPC = Entry ? Entry->RPC : nullptr;
 		if (!RPC)
 		{
 			//PrintToConsole("RPC Not Called!");
 			return;
 		}
 
-		sArchive ParamWithID;
-		ParamWithID << ID;
-		ParamWithID << Packet.Data;
-
 		switch (RPC->GetType())
 		{
 		case eRPCType::ServerAndClient:
@@ -386,7 +789,7 @@ void GNSServer::HandleMessages(HSteamNetConnection ID, sPacket Packet, std::opti
 			//PrintToConsole("RPC Not Called!");
 			break;
 		case eRPCType::Server:
-			RPC->Call(ParamWithID);
+			RPC->Call(ID, sArchiveView(Packet.Data));
 			break;
 		}
 	}
@@ -463,6 +866,9 @@ bool GNSServer::DestroySession()
 	if (!bIsServerRunning)
 		return false;
 
+	SendMessages();
+	ReplicationManager::Get().ResetSession();
+
 	PrintToConsole("Closing connections...");
 	for (auto it : ServerInfo.ConnectedPlayerInfos)
 	{
@@ -513,16 +919,57 @@ bool GNSServer::DestroySession()
 
 void GNSServer::SendToClient(HSteamNetConnection clientID, const sArchive& Archive, bool reliable)
 {
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	{
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		if (OutgoingBatches[clientID].Push(Archive, reliable))
+			return;
+	}
+	// Too large for a bundle, what is queued goes first to keep the order.
+	SendMessages();
+	SendArchiveToClient(clientID, Archive, reliable);
+}
+
+void GNSServer::SendArchiveToClient(HSteamNetConnection clientID, const sArchive& Archive, bool reliable)
+{
+	sArchive Compressed;
+	if (CompressPacket(Archive, CompressionThreshold, Compressed, CompressionStats))
+		SendBufferToClient(clientID, Compressed.GetData().data(), Compressed.GetSize(), reliable);
+	else
+		SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
 }
 
 void GNSServer::SendToClients(const sArchive& Archive, bool reliable, HSteamNetConnection excludeClientID)
 {
+	SendToClients(Archive, reliable, std::vector<HSteamNetConnection>{ excludeClientID });
+}
+
+void GNSServer::SendToClients(const sArchive& Archive, bool reliable, const std::vector<HSteamNetConnection>& excludeClientIDs)
+{
+	// Collected first, a failed send can disconnect a client.
+	std::vector<HSteamNetConnection> Recipients;
+	Recipients.reserve(ServerInfo.ConnectedPlayerInfos.size());
 	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
 	{
-		if (clientInfo.ID != excludeClientID)
-			SendToClient(clientInfo.ID, Archive, reliable);
+		if (std::find(excludeClientIDs.begin(), excludeClientIDs.end(), clientInfo.ID) == excludeClientIDs.end())
+			Recipients.push_back(clientInfo.ID);
+	}
+
+	if (sPacketBatch::IsBatchable(Archive))
+	{
+		// Encoded once, every recipient queues the same bytes.
+		const sPacketBatch::SharedPacket Packet = sPacketBatch::MakeShared(Archive);
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		for (const auto& ID : Recipients)
+			OutgoingBatches[ID].Push(Packet, reliable);
+		return;
 	}
+
+	// Too large for a bundle, compressed once and sent to everyone after what is queued.
+	SendMessages();
+	sArchive Compressed;
+	const sArchive& Encoded = CompressPacket(Archive, CompressionThreshold, Compressed, CompressionStats) ? Compressed : Archive;
+	for (const auto& ID : Recipients)
+		SendBufferToClient(ID, Encoded.GetData().data(), Encoded.GetSize(), reliable);
 }
 
 void GNSServer::SendStringToAllClients(const std::string& string, bool reliable, HSteamNetConnection excludeClientID)
@@ -564,19 +1011,21 @@ void GNSServer::CallRPCFromClient(HSteamNetConnection clientID, std::string Addr
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::RPC;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
 	Archive << Packet;
 	//SendStringToClient(clientID, Archive.GetDataAsString(), reliable);
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToClient(clientID, Archive, reliable);
 }
 
 void GNSServer::CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data, bool reliable, HSteamNetConnection excludeClientID)
 {
-	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
-	{
-		if (clientInfo.ID != excludeClientID)
-			CallRPCFromClient(clientInfo.ID, Address, ClassName, FunctionName, Data, reliable);
-	}
+	CallRPCFromClients(Address, ClassName, FunctionName, Data, reliable, std::vector<HSteamNetConnection>{ excludeClientID });
+}
+
+void GNSServer::CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data, bool reliable, const std::vector<HSteamNetConnection>& excludeClientIDs)
+{
+	SendToClients(EncodePacket(eNetworkPacketType::RPC, Address, ClassName, FunctionName, Data), reliable, excludeClientIDs);
 }
 
 void GNSServer::DirectCallToClient(HSteamNetConnection clientID, std::string FunctionName, bool reliable, std::optional<std::string> Data)
@@ -588,19 +1037,16 @@ void GNSServer::DirectCallToClient(HSteamNetConnection clientID, std::string Fun
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::DirectCall;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
 	Archive << Packet;
 	//SendStringToClient(clientID, Archive.GetDataAsString(), reliable);
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToClient(clientID, Archive, reliable);
 }
 
 void GNSServer::DirectCallToClients(std::string FunctionName, HSteamNetConnection excludeClientID, bool reliable, std::optional<std::string> Data)
 {
-	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
-	{
-		if (clientInfo.ID != excludeClientID)
-			DirectCallToClient(clientInfo.ID, FunctionName, reliable, Data);
-	}
+	SendToClients(EncodePacket(eNetworkPacketType::DirectCall, "Global", "GNSClient", FunctionName, Data), reliable, excludeClientID);
 }
 
 void GNSServer::CallMessageRPCFromClient(HSteamNetConnection clientID, std::string Message, bool reliable)
@@ -612,19 +1058,16 @@ void GNSServer::CallMessageRPCFromClient(HSteamNetConnection clientID, std::stri
 	Packet.FunctionName = "StringFromServer\n";
 	Packet.Data = Message;
 	Packet.Type = eNetworkPacketType::String;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
 	Archive << Packet;
 	//SendStringToClient(clientID, Archive.GetDataAsString(), reliable);
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToClient(clientID, Archive, reliable);
 }
 
 void GNSServer::CallMessageRPCFromClients(std::string Message, bool reliable, HSteamNetConnection excludeClientID)
 {
-	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
-	{
-		if (clientInfo.ID != excludeClientID)
-			CallMessageRPCFromClient(clientInfo.ID, Message, reliable);
-	}
+	SendToClients(EncodePacket(eNetworkPacketType::String, "Global", "GNSClient", "StringFromServer\n", Message), reliable, excludeClientID);
 }
 
 void GNSServer::PushMessageForAllClients(void* buffer, std::size_t size, bool reliable, HSteamNetConnection excludeClientID)
@@ -659,6 +1102,36 @@ void GNSServer::SendMessages()
 	//for (auto& Message : Messages)
 	//	Message->Release();
 	Messages.clear();
+
+	// Swapped out, sending can disconnect a client or queue more packets.
+	std::unordered_map<HSteamNetConnection, sPacketBatch> Batches;
+	{
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		std::swap(Batches, OutgoingBatches);
+	}
+
+	sEncodedBundleCache Encoded(CompressionThreshold, CompressionStats);
+	for (auto& Batch : Batches)
+	{
+		FlushBatch(Batch.second.Reliable, GNSBundleSize, [&](std::span<const sPacketBatch::SharedPacket> Packets)
+			{
+				const sArchive& Archive = Encoded.Get(Packets);
+				SendBufferToClient(Batch.first, Archive.GetData().data(), Archive.GetSize(), true);
+			});
+		FlushBatch(Batch.second.Unreliable, GNSBundleSize, [&](std::span<const sPacketBatch::SharedPacket> Packets)
+			{
+				const sArchive& Archive = Encoded.Get(Packets);
+				SendBufferToClient(Batch.first, Archive.GetData().data(), Archive.GetSize(), false);
+			});
+	}
+
+	// The emptied batches keep their capacity for the next tick.
+	std::lock_guard<std::mutex> locker(BatchMutex);
+	for (auto& Batch : Batches)
+	{
+		if (IsPlayerExist(Batch.first))
+			OutgoingBatches.try_emplace(Batch.first, std::move(Batch.second));
+	}
 }
 
 void GNSServer::StringFromClient(std::uint32_t ClientID, std::string STR)
@@ -760,6 +1233,8 @@ void GNSServer::OnPlayerDisconnected(HSteamNetConnection ID)
 	if (!IsPlayerExist(ID))
 		return;
 
+	ReplicationManager::Get().RemoveConnection(ID);
+
 	auto PlayerIndex = GetPlayerIndexFromID(ID);
 	if (PlayerIndex == 0)
 		return;
@@ -875,6 +1350,9 @@ void GNSServer::OnClientSuccessfullyConnected(HSteamNetConnection ID, sClientInf
 		CallRPC(Player->GetClassNetworkAddress(), "Player", "SpawnPlayerFocusedActor_Client", sArchive(Spawn.Location, Spawn.LayerIndex), true);
 		Player->GetPlayerFocusedActor()->SetLocation(Player->GetPlayerFocusedActor()->GetLocation());
 	}
+
+	// Replicated properties start with the whole state of every object, relevancy is judged around this player's actors.
+	ReplicationManager::Get().AddConnection(ID, Instance->GetPlayer(GetPlayerIndexFromID(ID))->GetClassNetworkAddress());
 }
 
 void GNSServer::PingClient(HSteamNetConnection clientID)
@@ -901,6 +1379,20 @@ void GNSServer::PingFromClient(HSteamNetConnection clientID, std::uint64_t TimeM
 	//PrintToConsole("Ping req from Client(" + std::to_string(clientID) + ") : " + std::to_string(Ping));
 }
 
+void GNSServer::ReplicationAck(std::uint32_t ClientID, std::uint32_t Sequence, std::vector<sRPCHandle> Missing)
+{
+	ReplicationManager::Get().OnAcknowledged(ClientID, Sequence, Missing);
+}
+
+void GNSServer::ViewFromClient(std::uint32_t ClientID, std::vector<FVector> Views)
+{
+	std::vector<FBoundingBox> Bounds;
+	Bounds.reserve(Views.size() / 2);
+	for (std::size_t i = 0; i + 1 < Views.size(); i += 2)
+		Bounds.push_back(FBoundingBox(Views[i], Views[i + 1]));
+	ReplicationManager::Get().SetConnectionViews(ClientID, std::move(Bounds));
+}
+
 bool GNSServer::IsPlayerExist(std::string Name) const
 {
 	for (const auto& Info : ServerInfo.ConnectedPlayerInfos)
@@ -1190,6 +1682,9 @@ GNSClient::GNSClient()
 	, Instance(nullptr)
 	, addrServer(SteamNetworkingIPAddr())
 	, MaximumMessagePerTick(64)
+	, CompressionThreshold(128)
+	, DamagedPacketCount(0)
+	, ReceiveGroup(0)
 	, bIsConnected(false)
 	, Latency(0)
 	, bIsValidationCalled(false)
@@ -1215,6 +1710,7 @@ GNSClient::GNSClient()
 	RegisterRPCfn("Global", "GNSClient", "ClientValidation", eRPCType::Client, true, false, std::bind(&GNSClient::ClientValidation, this));
 	RegisterRPCfn("Global", "GNSClient", "PingServer", eRPCType::Client, true, false, std::bind(&GNSClient::PingServer, this));
 	RegisterRPCfn("Global", "GNSClient", "PingFromServer", eRPCType::Client, true, false, std::bind(&GNSClient::PingFromServer, this, std::placeholders::_1), std::uint64_t);
+	RegisterRPCfn("Global", "GNSClient", "ReplicationFromServer", eRPCType::Client, false, false, std::bind(&GNSClient::ReplicationFromServer, this, std::placeholders::_1), std::vector<std::uint8_t>);
 }
 
 GNSClient::~GNSClient()
@@ -1236,6 +1732,7 @@ GNSClient::~GNSClient()
 
 void GNSClient::Tick(const double DeltaTime)
 {
+	sProfileFunction;
 	if (bIsConnected)
 	{
 		auto MS = Engine::GetUTCTimeNow().GetTotalMillisecond();
@@ -1245,16 +1742,27 @@ void GNSClient::Tick(const double DeltaTime)
 			Time = Engine::GetUTCTimeNow().GetTotalMillisecond();
 		}
 
-		PollIncomingMessages();
+		HandleReceivedPackets();
 		PollConnectionStateChanges();
+		ReplicationManager::Get().SendViews(DeltaTime, [&](const std::vector<FVector>& Views)
+			{
+				DirectCallToServerEx("ViewFromClient", false, Views);
+			});
 		SendMessages();
 
 		//CallMessageRPCFromServer("sadasd");
 	}
 }
 
-void GNSClient::PollIncomingMessages()
+void GNSClient::Receive()
 {
+	sProfileFunction;
+	if (!bIsConnected)
+	{
+		Received.clear();
+		return;
+	}
+
 	while (bIsConnected)
 	{
 		std::vector<ISteamNetworkingMessage*> pIncomingMsgs(MaximumMessagePerTick);
@@ -1271,28 +1779,53 @@ void GNSClient::PollIncomingMessages()
 		{
 			ISteamNetworkingMessage* pIncomingMsg = pIncomingMsgs[i];
 
-			sArchive pArchive;
-			pArchive.SetData((std::uint8_t*)pIncomingMsg->m_pData, pIncomingMsg->m_cbSize);
+			const sArchiveView pArchive((const std::uint8_t*)pIncomingMsg->m_pData, (std::size_t)pIncomingMsg->m_cbSize);
 			sPacket Packet;
 			pArchive >> Packet;
 
-			HandleMessages(Packet);
+			const bool bIsIntact = !pArchive.IsFailed() && UnpackPacket(Packet, ReceiveCompressionStats, [&](sPacket& Inner)
+			{
+				Received.emplace_back(0, ReceiveGroup, std::move(Inner));
+				return true;
+			});
+			if (!bIsIntact)
+				DamagedPacketCount++;
+			ReceiveGroup++;
 			
 			pIncomingMsg->Release();
 		}
 	}
 }
 
+void GNSClient::HandleReceivedPackets()
+{
+	MergeCompressionStats(CompressionStats, ReceiveCompressionStats);
+	if (DamagedPacketCount > 0)
+	{
+		PrintToConsole("Dropped " + std::to_string(DamagedPacketCount) + " damaged packets.");
+		DamagedPacketCount = 0;
+	}
+
+	for (auto& Msg : Received)
+	{
+		if (!bIsConnected)
+			break;
+		HandleMessages(Msg.Packet);
+	}
+	Received.clear();
+}
+
 void GNSClient::HandleMessages(sPacket Packet)
 {
 	if (Packet.Type == eNetworkPacketType::RPC)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC(Packet.Address == PlayerNetworkAddress ? ClientInfo.NetworkAddress : Packet.Address == ClientInfo.NetworkAddress ? PlayerNetworkAddress : Packet.Address, Packet.ClassName, Packet.FunctionName);
-		if (!RPC)
+		const auto* Entry = FindPacketRPC(Packet, PlayerNetworkAddress, ClientInfo.NetworkAddress);
+		if (!Entry)
 		{
-			PrintToConsole("Failed to Call RPC | Address : " + (Packet.Address == PlayerNetworkAddress ? ClientInfo.NetworkAddress : Packet.Address == ClientInfo.NetworkAddress ? PlayerNetworkAddress : Packet.Address) + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
+			PrintToConsole("Failed to Call RPC | " + GetPacketName(Packet));
 			return;
 		}
+		auto RPC = Entry->RPC;
 
 		//if (!Network::IsHost() && (Packet.Address == "0" || Packet.Address == "1"))
 		//	PrintToConsole("RPC Called | Address : " + (Packet.Address == PlayerNetworkAddress ? ClientInfo.NetworkAddress : Packet.Address == ClientInfo.NetworkAddress ? PlayerNetworkAddress : Packet.Address) + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
@@ -1301,25 +1834,26 @@ void GNSClient::HandleMessages(sPacket Packet)
 		{
 		case eRPCType::Client:
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
+				RPC->Call(sArchiveView(Packet.Data));
 			break;
 		case eRPCType::Server:
-			CallRPCFromServer(ClientInfo.NetworkAddress/*Packet.Address*/, Packet.FunctionName, Packet.Data, RPC->IsReliable());
+			CallRPCFromServer(Entry->Address, Entry->ClassName, RPC->GetName(), RPC->IsReliable(), Packet.Data);
 			break;
 		case eRPCType::ServerAndClient:
 			// Called on Server first
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
+				RPC->Call(sArchiveView(Packet.Data));
 			break;
 		}
 	}
 	else if (Packet.Type == eNetworkPacketType::DirectCall)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC("Global", "GNSClient", Packet.FunctionName);
+		const auto* Entry = FindDirectCall(Packet, "GNSClient");
+		auto RPC = Entry ? Entry->RPC : nullptr;
 		if (!RPC)
 		{
 			//PrintToConsole("RPC Not Called!");
@@ -1335,7 +1869,7 @@ void GNSClient::HandleMessages(sPacket Packet)
 			//PrintToConsole("RPC Not Called!");
 			break;
 		case eRPCType::Client:
-			RPC->Call(sArchive(Packet.Data));
+			RPC->Call(sArchiveView(Packet.Data));
 			break;
 		}
 	}
@@ -1397,6 +1931,9 @@ bool GNSClient::Disconnect()
 	if (!bIsConnected)
 		return false;
 
+	SendMessages();
+	ReplicationManager::Get().ResetSession();
+
 	Info = sServerInfo();
 
 	bIsConnected = false;
@@ -1433,7 +1970,23 @@ void GNSClient::SendBufferToServer(const void* buffer, std::size_t Size, bool re
 
 void GNSClient::SendToServer(const sArchive& Archive, bool reliable)
 {
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	{
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		if (OutgoingBatch.Push(Archive, reliable))
+			return;
+	}
+	// Too large for a bundle, what is queued goes first to keep the order.
+	SendMessages();
+	SendArchiveToServer(Archive, reliable);
+}
+
+void GNSClient::SendArchiveToServer(const sArchive& Archive, bool reliable)
+{
+	sArchive Compressed;
+	if (CompressPacket(Archive, CompressionThreshold, Compressed, CompressionStats))
+		SendBufferToServer(Compressed.GetData().data(), Compressed.GetSize(), reliable);
+	else
+		SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
 }
 
 void GNSClient::CallRPCFromServer(std::string Address, std::string ClassName, std::string FunctionName, bool reliable, std::optional<std::string> Data)
@@ -1450,10 +2003,11 @@ void GNSClient::CallRPCFromServer(std::string Address, std::string ClassName, st
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::RPC;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
 	Archive << Packet;
 	//SendStringToServer(Archive.GetDataAsString(), reliable);
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToServer(Archive, reliable);
 }
 
 void GNSClient::CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable)
@@ -1478,10 +2032,11 @@ void GNSClient::CallMessageRPCFromServer(std::string Message, bool reliable)
 	Packet.FunctionName = "StringFromClient";
 	Packet.Data = DataArchive.GetDataAsString(); // m_hConnection (ClientID)
 	Packet.Type = eNetworkPacketType::String;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
 	Archive << Packet;
 	//SendStringToServer(Archive.GetDataAsString(), reliable);
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToServer(Archive, reliable);
 }
 
 void GNSClient::DirectCallToServer(std::string FunctionName, bool reliable, std::optional<std::string> Data)
@@ -1498,10 +2053,11 @@ void GNSClient::DirectCallToServer(std::string FunctionName, bool reliable, std:
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::DirectCall;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
 	Archive << Packet;
 	//SendStringToServer(Archive.GetDataAsString(), reliable);
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToServer(Archive, reliable);
 }
 
 void GNSClient::SendStringToServer(const std::string& string, bool reliable)
@@ -1532,6 +2088,20 @@ void GNSClient::SendMessages()
 	//for (auto& Message : Messages)
 	//	Message->Release();
 	Messages.clear();
+
+	sPacketBatch Batch;
+	{
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		std::swap(Batch, OutgoingBatch);
+	}
+
+	FlushBatch(Batch.Reliable, GNSBundleSize, [&](std::span<const sPacketBatch::SharedPacket> Packets) { SendArchiveToServer(MakeBundle(Packets), true); });
+	FlushBatch(Batch.Unreliable, GNSBundleSize, [&](std::span<const sPacketBatch::SharedPacket> Packets) { SendArchiveToServer(MakeBundle(Packets), false); });
+
+	// The emptied batch keeps its capacity for the next tick.
+	std::lock_guard<std::mutex> locker(BatchMutex);
+	if (OutgoingBatch.IsEmpty())
+		std::swap(Batch, OutgoingBatch);
 }
 
 void GNSClient::ClientValidation()
@@ -1545,6 +2115,7 @@ void GNSClient::ClientValidation()
 	Packet.FunctionName = "ValidateClient";
 	Packet.Data = "Some Encrypted Code";
 	Packet.Type = eNetworkPacketType::Validation;
+	Packet.Handle = GetWireHandle(Packet);
 	SendToServer(sArchive(Packet), true);
 }
 
@@ -1559,6 +2130,14 @@ void GNSClient::PingFromServer(std::uint64_t duration)
 	//PrintToConsole("Ping : " + std::to_string(Ping));
 }
 
+void GNSClient::ReplicationFromServer(std::vector<std::uint8_t> Update)
+{
+	std::vector<sRPCHandle> Missing;
+	const auto Sequence = ReplicationManager::Get().Apply(sArchiveView(Update), sRPCHandle::Hash(PlayerNetworkAddress), sRPCHandle::Hash(ClientInfo.NetworkAddress), Missing);
+	if (Sequence.has_value())
+		DirectCallToServerEx("ReplicationAck", false, *Sequence, Missing);
+}
+
 void GNSClient::OnReciveServerInfo(sServerInfo pInfo)
 {
 	Info = pInfo;
@@ -1762,15 +2341,23 @@ void GNSClient::SteamNetConnectionStatusChangedCallback(SteamNetConnectionStatus
 
 #if Enable_Winsock
 
+#if defined(_WIN32)
 // Need to link with Ws2_32.lib
 #pragma comment (lib, "Ws2_32.lib")
 // #pragma comment (lib, "Mswsock.lib")
+#endif
 
 WSServer::WSServer()
 	: MaximumMessagePerTick(64)
+	, CompressionThreshold(128)
+	, DamagedPacketCount(0)
+	, ReceiveGroup(0)
 	, ClientCounter(0)
 	, bIsServerRunning(false)
 	, Instance(nullptr)
+	, Packets(4096)
+	, AcceptThread(nullptr)
+	, ReceiveThread(nullptr)
 {
 	ListenSocket = INVALID_SOCKET;
 
@@ -1784,6 +2371,9 @@ WSServer::WSServer()
 	RegisterRPCfn("Global", "WSServer", "ClientValidation", eRPCType::Server, true, false, std::bind(&WSServer::ValidateClient, this, std::placeholders::_1, std::placeholders::_2), std::uint32_t, std::string);
 	RegisterRPCfn("Global", "WSServer", "PingFromClient", eRPCType::Server, true, false, std::bind(&WSServer::PingFromClient, this, std::placeholders::_1, std::placeholders::_2), std::uint32_t, std::uint64_t);
 	RegisterRPCfn("Global", "WSServer", "PingClient", eRPCType::Server, true, false, std::bind(&WSServer::PingClient, this, std::placeholders::_1), std::uint32_t);
+	RegisterRPCfn("Global", "WSServer", "ReplicationAck", eRPCType::Server, false, false, std::bind(&WSServer::ReplicationAck, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::uint32_t, std::uint32_t, std::vector<sRPCHandle>);
+	RegisterRPCfn("Global", "WSServer", "ViewFromClient", eRPCType::Server, false, false, std::bind(&WSServer::ViewFromClient, this, std::placeholders::_1, std::placeholders::_2), std::uint32_t, std::vector<FVector>);
+	RegisterRPCfn("Global", "WSServer", "RequestServerStats", eRPCType::Server, true, false, std::bind(&WSServer::RequestServerStats, this, std::placeholders::_1), std::uint32_t);
 }
 
 WSServer::~WSServer()
@@ -1799,10 +2389,7 @@ WSServer::~WSServer()
 	KickList.clear();
 	BannedIPList.clear();
 
-	while (!Packets.empty())
-	{
-		Packets.pop();
-	}
+	Packets.Clear();
 
 	// cleanup
 	WSACleanup();
@@ -1810,114 +2397,183 @@ WSServer::~WSServer()
 
 void WSServer::Tick(const double DeltaTime)
 {
+	sProfileFunction;
 	if (bIsServerRunning)
 	{
+		const auto Start = std::chrono::steady_clock::now();
+
 		//auto MS = Engine::GetUTCTimeNow().GetTotalMillisecond();
 
 		//if ((MS - gTime) > 70)
 		{
-			PollIncomingMessages();
+			HandleReceivedPackets();
+			ReplicationManager::Get().Tick(DeltaTime, [&](std::uint32_t ClientID, const sArchive& Update)
+				{
+					// Goes in as a parameter, sArchive(Bytes) would take the vector as its raw data.
+					sArchive Params;
+					Params << Update.GetData();
+					DirectCallToClient(ClientID, "ReplicationFromServer", false, Params);
+				});
 			SendMessages();
 			//gTime = Engine::GetUTCTimeNow().GetTotalMillisecond();
 		}
+
+		const double TickMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+		Traffic.TickCount.fetch_add(1, std::memory_order_relaxed);
+		Traffic.TickTimeTotalMS.store(Traffic.TickTimeTotalMS.load(std::memory_order_relaxed) + TickMS, std::memory_order_relaxed);
+		if (TickMS > Traffic.TickTimeMaxMS.load(std::memory_order_relaxed))
+			Traffic.TickTimeMaxMS.store(TickMS, std::memory_order_relaxed);
 	}
 }
 
-void WSServer::PollIncomingMessages()
+void WSServer::Receive()
 {
-	std::size_t Counter = 0;
-	while (bIsServerRunning)
+	sProfileFunction;
+	if (!bIsServerRunning)
 	{
-		std::lock_guard<std::mutex> locker(Mutex);
+		Received.clear();
+		return;
+	}
+
+	sMsg Msg;
+	while (bIsServerRunning && Packets.TryPop(Msg))
+	{
+		const bool bIsIntact = UnpackPacket(Msg.Packet, ReceiveCompressionStats, [&](sPacket& Inner)
+		{
+			Received.emplace_back(Msg.ID, ReceiveGroup, std::move(Inner));
+			return true;
+		});
+		if (!bIsIntact)
+			DamagedPacketCount++;
+		ReceiveGroup++;
+	}
+}
+
+void WSServer::HandleReceivedPackets()
+{
+	if (!bIsServerRunning)
+		return;
+
+	MergeCompressionStats(CompressionStats, ReceiveCompressionStats);
+	if (DamagedPacketCount > 0)
+	{
+		PrintToConsole("Dropped " + std::to_string(DamagedPacketCount) + " damaged packets.");
+		DamagedPacketCount = 0;
+	}
+
+	// Collected under the lock, connecting sends and a failed send can disconnect a client.
+	std::vector<std::uint32_t> NewClients;
+	std::vector<std::pair<std::uint32_t, SOCKET>> ClosedClients;
+	{
+		std::lock_guard<std::mutex> locker(ClientsMutex);
 		for (auto& Client : Clients)
 		{
-			if (!Client.second.IsValid)
+			if (Client.second.bIsClosed)
+			{
+				ClosedClients.push_back({ Client.first, Client.second.Socket });
+			}
+			else if (!Client.second.IsValid)
 			{
-				OnPlayerConnecting(Client.first);
-				OnPlayerConnected(Client.first);
 				Client.second.IsValid = true;
+				NewClients.push_back(Client.first);
 			}
 		}
-
-		if (!Packets.empty()/* && Counter < MaximumMessagePerTick*/)
+	}
+	for (const auto ID : NewClients)
+	{
+		OnPlayerConnecting(ID);
+		OnPlayerConnected(ID);
+	}
+	for (const auto& Client : ClosedClients)
+	{
+		OnPlayerDisconnected(Client.first);
 		{
-			sMsg Msg = Packets.front();
+			// OnPlayerDisconnected skips clients that never validated.
+			std::lock_guard<std::mutex> locker(ClientsMutex);
+			Clients.erase(Client.first);
+		}
+		closesocket(Client.second);
+	}
 
-			auto Info = GetPlayerInfo(Msg.ID);
-			if (!Info.bIsValid)
+	std::optional<std::uint64_t> DroppedGroup;
+	for (auto& Msg : Received)
+	{
+		if (!bIsServerRunning)
+			break;
+		if (DroppedGroup == Msg.Group)
+			continue;
+
+		auto Info = GetPlayerInfo(Msg.ID);
+		if (!Info.bIsValid)
+		{
+			if (Msg.Packet.Type == eNetworkPacketType::Validation)
 			{
-				if (Msg.Packet.Type == eNetworkPacketType::Validation)
-				{
-					ValidateClient(Msg.ID, Msg.Packet.Data);
-				}
-				else
-				{
-					PrintToConsole("Validation Skipped! msg : " + Msg.Packet.FunctionName);
-					KickClient(Msg.ID);
-				}
+				ValidateClient(Msg.ID, Msg.Packet.Data);
 			}
 			else
 			{
-				HandleMessages(Msg.ID, Msg.Packet);
+				PrintToConsole("Validation Skipped! msg : " + GetPacketName(Msg.Packet));
+				KickClient(Msg.ID);
+				DroppedGroup = Msg.Group;
 			}
-
-			Packets.pop();
-			Counter++;
 		}
 		else
 		{
-			break;
+			HandleMessages(Msg.ID, Msg.Packet);
 		}
 	}
+	Received.clear();
 }
 
 void WSServer::HandleMessages(std::uint32_t ID, const sPacket& Packet, std::optional<bool> reliable)
 {
 	if (Packet.Type == eNetworkPacketType::RPC)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC(Packet.Address, Packet.ClassName, Packet.FunctionName);
-		if (!RPC)
+		const auto* Entry = FindPacketRPC(Packet);
+		if (!Entry)
 		{
-			PrintToConsole("Failed to Call RPC | Address : " + Packet.Address + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
+			PrintToConsole("Failed to Call RPC | " + GetPacketName(Packet));
 			return;
 		}
+		auto RPC = Entry->RPC;
 
 		//PrintToConsole("RPC Called | Address : " + Packet.Address + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
 
+		Traffic.RPCsHandled.fetch_add(1, std::memory_order_relaxed);
+
 		switch (RPC->GetType())
 		{
 		case eRPCType::Client:
-			CallRPCFromClient(ID, Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable());
-			CallRPCFromClients(Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ID);
+			// The sender gets it back like every client the object is relevant to, encoded once for all of them.
+			CallRPCFromClients(Entry->Address, Entry->ClassName, RPC->GetName(), Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ReplicationManager::Get().GetIrrelevantConnections(Entry->Address, Entry->ClassName));
 			break;
 		case eRPCType::Server:
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
+				RPC->Call(sArchiveView(Packet.Data));
 			break;
 		case eRPCType::ServerAndClient:
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
-			CallRPCFromClient(ID, Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable());
-			CallRPCFromClients(Packet.Address, Packet.ClassName, Packet.FunctionName, Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ID);
+				RPC->Call(sArchiveView(Packet.Data));
+			// The sender gets it back like every client the object is relevant to, encoded once for all of them.
+			CallRPCFromClients(Entry->Address, Entry->ClassName, RPC->GetName(), Packet.Data, reliable.has_value() ? *reliable : RPC->IsReliable(), ReplicationManager::Get().GetIrrelevantConnections(Entry->Address, Entry->ClassName));
 			break;
 		}
 	}
 	else if (Packet.Type == eNetworkPacketType::DirectCall)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC("Global", "WSServer", Packet.FunctionName);
+		const auto* Entry = FindDirectCall(Packet, "WSServer");
+		auto RPC = Entry ? Entry->RPC : nullptr;
 		if (!RPC)
 		{
 			PrintToConsole("DirectCall::RPC Not Called!");
 			return;
 		}
 
-		sArchive ParamWithID;
-		ParamWithID << ID;
-		ParamWithID << Packet.Data;
+		Traffic.RPCsHandled.fetch_add(1, std::memory_order_relaxed);
 
 		switch (RPC->GetType())
 		{
@@ -1926,7 +2582,7 @@ void WSServer::HandleMessages(std::uint32_t ID, const sPacket& Packet, std::opti
 			//PrintToConsole("RPC Not Called!");
 			break;
 		case eRPCType::Server:
-			RPC->Call(ParamWithID);
+			RPC->Call(ID, sArchiveView(Packet.Data));
 			break;
 		}
 	}
@@ -2005,77 +2661,126 @@ bool WSServer::CreateSession(std::string Name, sGameInstance* pInstance, std::st
         return 1;
     }
 
+	ResetTrafficStats();
+
 	bIsServerRunning.store(true, std::memory_order_release);
 
-	Engine::QueueJob([&]()
+	/*
+	* Both threads wait in poll with a timeout, so they notice DestroySession without relying on
+	* closesocket to unblock a call, which POSIX doesn't guarantee.
+	*/
+	static constexpr int PollTimeoutMS = 10;
+
+	AcceptThread = Engine::StartServiceThread("WSServer Accept", [&]()
 		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eNetwork);
 			while (bIsServerRunning.load(std::memory_order_acquire))
 			{
+				WSAPOLLFD Listen = {};
+				Listen.fd = ListenSocket;
+				Listen.events = POLLIN;
+				if (PollSockets(&Listen, 1, PollTimeoutMS * 10) <= 0 || !(Listen.revents & POLLIN))
+					continue;
+
 				SOCKET ClientSocket = accept(ListenSocket, NULL, NULL);
-				if (ClientSocket != INVALID_SOCKET)
-				{
-					if (ServerInfo.ConnectedPlayerCount >= ServerInfo.MaximumConnectedPlayerSize)
-					{
-						closesocket(ClientSocket);
-						continue;
-					}
-					std::lock_guard<std::mutex> locker(Mutex);
+				if (ClientSocket == INVALID_SOCKET)
+					continue;
 
-					Clients.insert({ ClientCounter, ClientSocket });
-					ClientCounter++;
+				// Counts the clients still connecting too, ServerInfo belongs to the game thread.
+				std::lock_guard<std::mutex> locker(ClientsMutex);
+				if (Clients.size() >= ServerInfo.MaximumConnectedPlayerSize)
+				{
+					closesocket(ClientSocket);
+					continue;
 				}
+				Clients.insert({ ClientCounter, ClientSocket });
+				ClientCounter++;
 			}
 		}
 	);
 
-	Engine::QueueJob([&]()
+	ReceiveThread = Engine::StartServiceThread("WSServer Receive", [&]()
 		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eNetwork);
 			std::vector<std::uint8_t> buffer(256 * MaximumMessagePerTick);
+			// Partial frames per client, only touched by this thread.
+			std::unordered_map<std::uint32_t, std::vector<std::uint8_t>> Streams;
+			std::vector<std::uint32_t> IDs;
+			std::vector<WSAPOLLFD> Sockets;
 
-			int bytesReceived = 0;
+			const auto Close = [&](std::uint32_t ID)
+			{
+				std::lock_guard<std::mutex> locker(ClientsMutex);
+				const auto It = Clients.find(ID);
+				if (It != Clients.end())
+					It->second.bIsClosed = true;
+			};
 
 			while (bIsServerRunning.load(std::memory_order_acquire))
 			{
-				for (const auto& Client : Clients)
+				// The accept thread and disconnects change the map, poll works on a copy.
+				IDs.clear();
+				Sockets.clear();
 				{
-					// Attempt to receive data (non-blocking)
-					bytesReceived = recv(Client.second.Socket, (char*)buffer.data(), (int)buffer.size(), 0);
-					//bytesReceived = recvfrom(Client.second, buffer, sizeof(buffer), 0, NULL, NULL);
-
-					if (bytesReceived == SOCKET_ERROR) {
-						int error = WSAGetLastError();
-
-						if (error == WSAEWOULDBLOCK) {
-							// No data available, continue or sleep and retry
-							std::this_thread::sleep_for(std::chrono::milliseconds(100));
+					std::lock_guard<std::mutex> locker(ClientsMutex);
+					for (const auto& Client : Clients)
+					{
+						if (Client.second.bIsClosed)
 							continue;
-						}
-						else {
-							std::cerr << "Error in recv: " << error << std::endl;
-							break;
-						}
+						WSAPOLLFD Socket = {};
+						Socket.fd = Client.second.Socket;
+						Socket.events = POLLIN;
+						IDs.push_back(Client.first);
+						Sockets.push_back(Socket);
 					}
+				}
+				std::erase_if(Streams, [&](const auto& Stream)
+					{
+						return std::find(IDs.begin(), IDs.end(), Stream.first) == IDs.end();
+					});
 
-					// Process received data (use bytesReceived)
-					if (bytesReceived > 0)
+				if (Sockets.empty())
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					continue;
+				}
+
+				// One wait for every client, recv only runs on sockets that have data and never blocks.
+				if (PollSockets(Sockets.data(), Sockets.size(), PollTimeoutMS) <= 0)
+					continue;
+
+				for (std::size_t i = 0; i < Sockets.size(); i++)
+				{
+					if (Sockets[i].revents == 0)
+						continue;
+
+					const std::uint32_t ID = IDs[i];
+					const int bytesReceived = recv(Sockets[i].fd, (char*)buffer.data(), (int)buffer.size(), 0);
+					if (bytesReceived == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK)
+						continue;
+					if (bytesReceived <= 0)
 					{
-						std::lock_guard<std::mutex> locker(Mutex);
-						sArchive pArchive;
-						pArchive.AppendData(buffer, bytesReceived);
+						// Closed by the client or broken, a closed socket would keep polling as readable.
+						Close(ID);
+						continue;
+					}
 
-						int i = 1;
-						while (pArchive.GetPosition() < pArchive.GetSize())
+					Traffic.BytesReceived.fetch_add(bytesReceived, std::memory_order_relaxed);
+
+					const bool bIsValid = ReadWSFrames(Streams[ID], buffer.data(), (std::size_t)bytesReceived, [&](const sPacket& Packet)
 						{
-							sPacket Packet;
-							//pArchive.ResizeData(256 * 32);
-							pArchive >> Packet;
-							Packets.push(sMsg(Client.first, Packet));
-							pArchive.ResetPos(i * 256);
-							i++;
-
-							if (Packet.Address == "" || Packet.FunctionName == "" || Packet.ClassName == "")
+							Packets.Push(sMsg(ID, Packet), &bIsServerRunning);
+							Traffic.PacketsReceived.fetch_add(1, std::memory_order_relaxed);
+
+							if (Packet.Type != eNetworkPacketType::Compressed && Packet.Type != eNetworkPacketType::Bundle && !Packet.Handle.IsValid() && (Packet.Address == "" || Packet.FunctionName == "" || Packet.ClassName == ""))
 								PrintToConsole("Empty");
-						}
+						});
+
+					if (!bIsValid)
+					{
+						PrintToConsole("Invalid frame from client " + std::to_string(ID) + ", closing the connection.");
+						shutdown(Sockets[i].fd, SD_BOTH);
+						Close(ID);
 					}
 				}
 			}
@@ -2087,31 +2792,48 @@ bool WSServer::CreateSession(std::string Name, sGameInstance* pInstance, std::st
 
 bool WSServer::DestroySession()
 {
-	std::lock_guard<std::mutex> locker(Mutex);
-
 	if (!bIsServerRunning)
 		return false;
 
-	// No longer need server socket
-	closesocket(ListenSocket);
+	SendMessages();
+	ReplicationManager::Get().ResetSession();
+
+	bIsServerRunning.store(false, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> locker(Mutex);
+
+		// No longer need server socket
+		closesocket(ListenSocket);
+
+		// Unblocks the receive thread.
+		std::lock_guard<std::mutex> ClientsLocker(ClientsMutex);
+		for (auto& Client : Clients)
+		{
+			closesocket(Client.second.Socket);
+		}
+	}
+
+	// Service threads take the mutex, join them outside of it.
+	AcceptThread = nullptr;
+	ReceiveThread = nullptr;
+
+	std::lock_guard<std::mutex> locker(Mutex);
 
 	PrintToConsole("Closing connections...");
 	
 	//m_mapClients.clear();
 	ServerInfo.ConnectedPlayerInfos.clear();
 
-	bIsServerRunning.store(false, std::memory_order_release);
-
 	while (Instance->GetPlayerCount() != 0)
 	{
 		Instance->RemoveLastPlayer();
 	}
 
-	for (auto& Client : Clients)
 	{
-		closesocket(Client.second.Socket);
+		std::lock_guard<std::mutex> ClientsLocker(ClientsMutex);
+		Clients.clear();
 	}
-	Clients.clear();
 
 	OnSessionDestroyed();
 
@@ -2120,16 +2842,58 @@ bool WSServer::DestroySession()
 
 void WSServer::SendToClient(std::uint32_t clientID, const sArchive& Archive, bool reliable)
 {
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	{
+		// TCP delivers everything in one order, so everything goes to the reliable queue.
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		if (OutgoingBatches[clientID].Push(Archive, true))
+			return;
+	}
+	// Too large for a bundle, what is queued goes first to keep the order.
+	SendMessages();
+	SendArchiveToClient(clientID, Archive, reliable);
+}
+
+void WSServer::SendArchiveToClient(std::uint32_t clientID, const sArchive& Archive, bool reliable)
+{
+	sArchive Compressed;
+	if (CompressPacket(Archive, CompressionThreshold, Compressed, CompressionStats))
+		SendBufferToClient(clientID, Compressed.GetData().data(), Compressed.GetSize(), reliable);
+	else
+		SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
 }
 
 void WSServer::SendToClients(const sArchive& Archive, bool reliable, std::uint32_t excludeClientID)
 {
+	SendToClients(Archive, reliable, std::vector<std::uint32_t>{ excludeClientID });
+}
+
+void WSServer::SendToClients(const sArchive& Archive, bool reliable, const std::vector<std::uint32_t>& excludeClientIDs)
+{
+	// Collected first, a failed send can disconnect a client.
+	std::vector<std::uint32_t> Recipients;
+	Recipients.reserve(ServerInfo.ConnectedPlayerInfos.size());
 	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
 	{
-		if (clientInfo.ID != excludeClientID)
-			SendToClient(clientInfo.ID, Archive, reliable);
+		if (std::find(excludeClientIDs.begin(), excludeClientIDs.end(), clientInfo.ID) == excludeClientIDs.end())
+			Recipients.push_back(clientInfo.ID);
 	}
+
+	if (sPacketBatch::IsBatchable(Archive))
+	{
+		// Encoded once, every recipient queues the same bytes.
+		const sPacketBatch::SharedPacket Packet = sPacketBatch::MakeShared(Archive);
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		for (const auto& ID : Recipients)
+			OutgoingBatches[ID].Push(Packet, true);
+		return;
+	}
+
+	// Too large for a bundle, compressed once and sent to everyone after what is queued.
+	SendMessages();
+	sArchive Compressed;
+	const sArchive& Encoded = CompressPacket(Archive, CompressionThreshold, Compressed, CompressionStats) ? Compressed : Archive;
+	for (const auto& ID : Recipients)
+		SendBufferToClient(ID, Encoded.GetData().data(), Encoded.GetSize(), reliable);
 }
 
 void WSServer::SendStringToAllClients(const std::string& string, bool reliable, std::uint32_t excludeClientID)
@@ -2139,10 +2903,23 @@ void WSServer::SendStringToAllClients(const std::string& string, bool reliable,
 
 void WSServer::SendBufferToClient(std::uint32_t clientID, const void* buffer, std::size_t Size, bool reliable)
 {
-	if (!Clients.contains(clientID))
+	SOCKET Socket = INVALID_SOCKET;
+	{
+		std::lock_guard<std::mutex> locker(ClientsMutex);
+		const auto It = Clients.find(clientID);
+		if (It == Clients.end())
+			return;
+		Socket = It->second.Socket;
+	}
+
+	if (Size == 0 || Size > WSMaxFrameSize)
+	{
+		PrintToConsole("SendBufferToClient: " + std::to_string(Size) + " bytes can't be framed and are dropped.");
 		return;
+	}
 
-	int result = send(Clients[clientID].Socket, (char*)buffer, (int)Size, 0);
+	const std::vector<std::uint8_t> Frame = MakeWSFrame(buffer, Size);
+	int result = send(Socket, (char*)Frame.data(), (int)Frame.size(), SocketSendFlags);
 
 	/*sockaddr_in serverAddr;
 	serverAddr.sin_family = AF_INET;
@@ -2156,14 +2933,21 @@ void WSServer::SendBufferToClient(std::uint32_t clientID, const void* buffer, st
 		int error = WSAGetLastError();
 		if (error == 10053)
 		{
-			if (Clients[clientID].TimeOutTest == 24)
+			std::uint32_t TimeOutTest = 0;
+			{
+				std::lock_guard<std::mutex> locker(ClientsMutex);
+				const auto It = Clients.find(clientID);
+				if (It == Clients.end())
+					return;
+				TimeOutTest = It->second.TimeOutTest++;
+			}
+			if (TimeOutTest == 24)
 			{
-				closesocket(Clients[clientID].Socket);
+				closesocket(Socket);
 				OnPlayerDisconnected(clientID);
 				return;
 			}
-			Clients[clientID].TimeOutTest++;
-			PrintToConsole("Time out counter : " + std::to_string(Clients[clientID].TimeOutTest));
+			PrintToConsole("Time out counter : " + std::to_string(TimeOutTest + 1));
 			SendBufferToClient(clientID, buffer, Size, reliable);
 			return;
 		}
@@ -2180,7 +2964,14 @@ void WSServer::SendBufferToClient(std::uint32_t clientID, const void* buffer, st
 	else 
 	{
 		// 'result' contains the number of bytes sent
-		Clients[clientID].TimeOutTest = 0;
+		{
+			std::lock_guard<std::mutex> locker(ClientsMutex);
+			const auto It = Clients.find(clientID);
+			if (It != Clients.end())
+				It->second.TimeOutTest = 0;
+		}
+		Traffic.BytesSent.fetch_add(result, std::memory_order_relaxed);
+		Traffic.PacketsSent.fetch_add(1, std::memory_order_relaxed);
 	}
 }
 
@@ -2212,20 +3003,21 @@ void WSServer::CallRPCFromClient(std::uint32_t clientID, std::string Address, st
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::RPC;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	//SendStringToClient(clientID, Archive.GetDataAsString(), reliable);
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToClient(clientID, Archive, reliable);
 }
 
 void WSServer::CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data, bool reliable, std::uint32_t excludeClientID)
 {
-	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
-	{
-		if (clientInfo.ID != excludeClientID)
-			CallRPCFromClient(clientInfo.ID, Address, ClassName, FunctionName, Data, reliable);
-	}
+	CallRPCFromClients(Address, ClassName, FunctionName, Data, reliable, std::vector<std::uint32_t>{ excludeClientID });
+}
+
+void WSServer::CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data, bool reliable, const std::vector<std::uint32_t>& excludeClientIDs)
+{
+	SendToClients(EncodePacket(eNetworkPacketType::RPC, Address, ClassName, FunctionName, Data), reliable, excludeClientIDs);
 }
 
 void WSServer::DirectCallToClient(std::uint32_t clientID, std::string FunctionName, bool reliable, std::optional<std::string> Data)
@@ -2237,20 +3029,16 @@ void WSServer::DirectCallToClient(std::uint32_t clientID, std::string FunctionNa
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::DirectCall;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	//SendStringToClient(clientID, Archive.GetDataAsString(), reliable);
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToClient(clientID, Archive, reliable);
 }
 
 void WSServer::DirectCallToClients(std::string FunctionName, std::uint32_t excludeClientID, bool reliable, std::optional<std::string> Data)
 {
-	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
-	{
-		if (clientInfo.ID != excludeClientID)
-			DirectCallToClient(clientInfo.ID, FunctionName, reliable, Data);
-	}
+	SendToClients(EncodePacket(eNetworkPacketType::DirectCall, "Global", "WSClient", FunctionName, Data), reliable, excludeClientID);
 }
 
 void WSServer::CallMessageRPCFromClient(std::uint32_t clientID, std::string Message, bool reliable)
@@ -2262,20 +3050,16 @@ void WSServer::CallMessageRPCFromClient(std::uint32_t clientID, std::string Mess
 	Packet.FunctionName = "StringFromServer\n";
 	Packet.Data = Message;
 	Packet.Type = eNetworkPacketType::String;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	//SendStringToClient(clientID, Archive.GetDataAsString(), reliable);
-	SendBufferToClient(clientID, Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToClient(clientID, Archive, reliable);
 }
 
 void WSServer::CallMessageRPCFromClients(std::string Message, bool reliable, std::uint32_t excludeClientID)
 {
-	for (const auto& clientInfo : ServerInfo.ConnectedPlayerInfos)
-	{
-		if (clientInfo.ID != excludeClientID)
-			CallMessageRPCFromClient(clientInfo.ID, Message, reliable);
-	}
+	SendToClients(EncodePacket(eNetworkPacketType::String, "Global", "WSClient", "StringFromServer\n", Message), reliable, excludeClientID);
 }
 
 void WSServer::PushMessageForAllClients(void* buffer, std::size_t size, bool reliable, std::uint32_t excludeClientID)
@@ -2294,7 +3078,30 @@ void WSServer::PushMessage(std::uint32_t clientID, void* buffer, std::size_t siz
 
 void WSServer::SendMessages()
 {
+	// Swapped out, sending can disconnect a client or queue more packets.
+	std::unordered_map<std::uint32_t, sPacketBatch> Batches;
+	{
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		std::swap(Batches, OutgoingBatches);
+	}
+
+	sEncodedBundleCache Encoded(CompressionThreshold, CompressionStats);
+	for (auto& Batch : Batches)
+	{
+		FlushBatch(Batch.second.Reliable, WSBundleSize, [&](std::span<const sPacketBatch::SharedPacket> Packets)
+			{
+				const sArchive& Archive = Encoded.Get(Packets);
+				SendBufferToClient(Batch.first, Archive.GetData().data(), Archive.GetSize(), true);
+			});
+	}
 
+	// The emptied batches keep their capacity for the next tick.
+	std::lock_guard<std::mutex> locker(BatchMutex);
+	for (auto& Batch : Batches)
+	{
+		if (IsPlayerExist(Batch.first))
+			OutgoingBatches.try_emplace(Batch.first, std::move(Batch.second));
+	}
 }
 
 void WSServer::StringFromClient(std::uint32_t ClientID, std::string STR)
@@ -2307,11 +3114,19 @@ void WSServer::KickClient(std::uint32_t clientID)
 	KickList.push_back(clientID);
 	std::size_t TryCounter = 0;
 	bool IsClosed = false;
+	// Taken before the disconnect drops the client from the map.
+	SOCKET Socket = INVALID_SOCKET;
+	{
+		std::lock_guard<std::mutex> locker(ClientsMutex);
+		const auto It = Clients.find(clientID);
+		if (It != Clients.end())
+			Socket = It->second.Socket;
+	}
 	OnPlayerDisconnected(clientID);
 	while (!IsClosed && TryCounter < 50)
 	{
 		//IsClosed = m_pInterface->CloseConnection(clientID, 0, nullptr, false);
-		closesocket(Clients[clientID].Socket);
+		closesocket(Socket);
 		TryCounter++;
 	}
 	if (!IsClosed)
@@ -2388,6 +3203,8 @@ void WSServer::OnPlayerDisconnected(std::uint32_t ID)
 	if (!IsPlayerExist(ID))
 		return;
 
+	ReplicationManager::Get().RemoveConnection(ID);
+
 	auto PlayerIndex = GetPlayerIndexFromID(ID);
 	if (PlayerIndex == 0)
 		return;
@@ -2413,7 +3230,10 @@ void WSServer::OnPlayerDisconnected(std::uint32_t ID)
 		return a.PlayerIndex < b.PlayerIndex;
 		});
 
-	Clients.erase(ID);
+	{
+		std::lock_guard<std::mutex> locker(ClientsMutex);
+		Clients.erase(ID);
+	}
 
 	for (auto& Info : ServerInfo.ConnectedPlayerInfos)
 	{
@@ -2505,6 +3325,9 @@ void WSServer::OnClientSuccessfullyConnected(std::uint32_t ID, sClientInfo Clien
 		CallRPC(Player->GetClassNetworkAddress(), "Player", "SpawnPlayerFocusedActor_Client", sArchive(Spawn.Location, Spawn.LayerIndex), true);
 		Player->GetPlayerFocusedActor()->SetLocation(Player->GetPlayerFocusedActor()->GetLocation());
 	}
+
+	// Replicated properties start with the whole state of every object, relevancy is judged around this player's actors.
+	ReplicationManager::Get().AddConnection(ID, Instance->GetPlayer(GetPlayerIndexFromID(ID))->GetClassNetworkAddress());
 }
 
 void WSServer::PingClient(std::uint32_t clientID)
@@ -2531,6 +3354,55 @@ void WSServer::PingFromClient(std::uint32_t clientID, std::uint64_t TimeMS)
 	//PrintToConsole("Ping req from Client(" + std::to_string(clientID) + ") : " + std::to_string(Ping));
 }
 
+void WSServer::ReplicationAck(std::uint32_t ClientID, std::uint32_t Sequence, std::vector<sRPCHandle> Missing)
+{
+	ReplicationManager::Get().OnAcknowledged(ClientID, Sequence, Missing);
+}
+
+void WSServer::ViewFromClient(std::uint32_t ClientID, std::vector<FVector> Views)
+{
+	std::vector<FBoundingBox> Bounds;
+	Bounds.reserve(Views.size() / 2);
+	for (std::size_t i = 0; i + 1 < Views.size(); i += 2)
+		Bounds.push_back(FBoundingBox(Views[i], Views[i + 1]));
+	ReplicationManager::Get().SetConnectionViews(ClientID, std::move(Bounds));
+}
+
+void WSServer::RequestServerStats(std::uint32_t clientID)
+{
+	const auto Tick = Engine::GetFrameStats(EFrameStat::eTick);
+	const auto Frame = Engine::GetFrameStats(EFrameStat::eFrame);
+	DirectCallToClientEx(clientID, "OnServerStats", true, GetTrafficStats(), std::uint64_t(ServerInfo.ConnectedPlayerCount),
+		Tick.P50, Tick.P95, Tick.P99, Tick.Max, Frame.P50, Frame.P95, Frame.P99, Frame.Max);
+}
+
+sNetworkTrafficStats WSServer::GetTrafficStats() const
+{
+	sNetworkTrafficStats Stats;
+	Stats.BytesReceived = Traffic.BytesReceived.load(std::memory_order_relaxed);
+	Stats.BytesSent = Traffic.BytesSent.load(std::memory_order_relaxed);
+	Stats.PacketsReceived = Traffic.PacketsReceived.load(std::memory_order_relaxed);
+	Stats.PacketsSent = Traffic.PacketsSent.load(std::memory_order_relaxed);
+	Stats.RPCsHandled = Traffic.RPCsHandled.load(std::memory_order_relaxed);
+	Stats.TickCount = Traffic.TickCount.load(std::memory_order_relaxed);
+	Stats.TickTimeTotalMS = Traffic.TickTimeTotalMS.load(std::memory_order_relaxed);
+	Stats.TickTimeMaxMS = Traffic.TickTimeMaxMS.load(std::memory_order_relaxed);
+	return Stats;
+}
+
+void WSServer::ResetTrafficStats()
+{
+	Traffic.BytesReceived.store(0, std::memory_order_relaxed);
+	Traffic.BytesSent.store(0, std::memory_order_relaxed);
+	Traffic.PacketsReceived.store(0, std::memory_order_relaxed);
+	Traffic.PacketsSent.store(0, std::memory_order_relaxed);
+	Traffic.RPCsHandled.store(0, std::memory_order_relaxed);
+	Traffic.TickCount.store(0, std::memory_order_relaxed);
+	Traffic.TickTimeTotalMS.store(0.0, std::memory_order_relaxed);
+	Traffic.TickTimeMaxMS.store(0.0, std::memory_order_relaxed);
+	CompressionStats = sCompressionStats();
+}
+
 bool WSServer::IsPlayerExist(std::string Name) const
 {
 	for (const auto& Info : ServerInfo.ConnectedPlayerInfos)
@@ -2656,11 +3528,16 @@ void WSServer::PrintToConsole(std::string Message)
 
 WSClient::WSClient()
 	: MaximumMessagePerTick(64)
+	, CompressionThreshold(128)
+	, DamagedPacketCount(0)
+	, ReceiveGroup(0)
 	, Instance(nullptr)
 	, bIsConnected(false)
 	, Latency(0)
 	, Time(0)
 	, bIsValidationCalled(false)
+	, Packets(4096)
+	, ReceiveThread(nullptr)
 {
 	ConnectSocket = INVALID_SOCKET;
 
@@ -2680,6 +3557,7 @@ WSClient::WSClient()
 	RegisterRPCfn("Global", "WSClient", "ClientValidation", eRPCType::Client, true, false, std::bind(&WSClient::ClientValidation, this));
 	RegisterRPCfn("Global", "WSClient", "PingServer", eRPCType::Client, true, false, std::bind(&WSClient::PingServer, this));
 	RegisterRPCfn("Global", "WSClient", "PingFromServer", eRPCType::Client, true, false, std::bind(&WSClient::PingFromServer, this, std::placeholders::_1), std::uint64_t);
+	RegisterRPCfn("Global", "WSClient", "ReplicationFromServer", eRPCType::Client, false, false, std::bind(&WSClient::ReplicationFromServer, this, std::placeholders::_1), std::vector<std::uint8_t>);
 }
 
 WSClient::~WSClient()
@@ -2688,10 +3566,7 @@ WSClient::~WSClient()
 
 	Instance = nullptr;
 
-	while (!Packets.empty())
-	{
-		Packets.pop();
-	}
+	Packets.Clear();
 
 	Disconnect();
 	WSACleanup();
@@ -2699,6 +3574,7 @@ WSClient::~WSClient()
 
 void WSClient::Tick(const double DeltaTime)
 {
+	sProfileFunction;
 	if (bIsConnected)
 	{
 		auto MS = Engine::GetUTCTimeNow().GetTotalMillisecond();
@@ -2708,42 +3584,69 @@ void WSClient::Tick(const double DeltaTime)
 			Time = Engine::GetUTCTimeNow().GetTotalMillisecond();
 		}
 
-		PollIncomingMessages();
+		HandleReceivedPackets();
+		ReplicationManager::Get().SendViews(DeltaTime, [&](const std::vector<FVector>& Views)
+			{
+				DirectCallToServerEx("ViewFromClient", false, Views);
+			});
 		SendMessages();
 
 		//CallMessageRPCFromServer("sadasd");
 	}
 }
 
-void WSClient::PollIncomingMessages()
+void WSClient::Receive()
 {
-	std::size_t Counter = 0;
-	while (bIsConnected)
+	sProfileFunction;
+	if (!bIsConnected)
 	{
-		std::lock_guard<std::mutex> locker(Mutex);
-		if (!Packets.empty() /*&& Counter < MaximumMessagePerTick*/)
-		{
-			HandleMessages(Packets.front());
-			Packets.pop();
-			Counter++;
-		}
-		else
+		Received.clear();
+		return;
+	}
+
+	sPacket Packet;
+	while (bIsConnected && Packets.TryPop(Packet))
+	{
+		const bool bIsIntact = UnpackPacket(Packet, ReceiveCompressionStats, [&](sPacket& Inner)
 		{
+			Received.emplace_back(0, ReceiveGroup, std::move(Inner));
+			return true;
+		});
+		if (!bIsIntact)
+			DamagedPacketCount++;
+		ReceiveGroup++;
+	}
+}
+
+void WSClient::HandleReceivedPackets()
+{
+	MergeCompressionStats(CompressionStats, ReceiveCompressionStats);
+	if (DamagedPacketCount > 0)
+	{
+		PrintToConsole("Dropped " + std::to_string(DamagedPacketCount) + " damaged packets.");
+		DamagedPacketCount = 0;
+	}
+
+	for (auto& Msg : Received)
+	{
+		if (!bIsConnected)
 			break;
-		}
+		HandleMessages(Msg.Packet);
 	}
+	Received.clear();
 }
 
 void WSClient::HandleMessages(const sPacket& Packet)
 {
 	if (Packet.Type == eNetworkPacketType::RPC)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC(Packet.Address == PlayerNetworkAddress ? ClientInfo.NetworkAddress : Packet.Address == ClientInfo.NetworkAddress ? PlayerNetworkAddress : Packet.Address, Packet.ClassName, Packet.FunctionName);
-		if (!RPC)
+		const auto* Entry = FindPacketRPC(Packet, PlayerNetworkAddress, ClientInfo.NetworkAddress);
+		if (!Entry)
 		{
-			PrintToConsole("Failed to Call RPC | Address : " + (Packet.Address == PlayerNetworkAddress ? ClientInfo.NetworkAddress : Packet.Address == ClientInfo.NetworkAddress ? PlayerNetworkAddress : Packet.Address) + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
+			PrintToConsole("Failed to Call RPC | " + GetPacketName(Packet));
 			return;
 		}
+		auto RPC = Entry->RPC;
 
 		//if (!Network::IsHost() && (Packet.Address == "0" || Packet.Address == "1"))
 		//	PrintToConsole("RPC Called | Address : " + (Packet.Address == PlayerNetworkAddress ? ClientInfo.NetworkAddress : Packet.Address == ClientInfo.NetworkAddress ? PlayerNetworkAddress : Packet.Address) + " | ClassName : " + Packet.ClassName + " | FunctionName : " + Packet.FunctionName);
@@ -2752,25 +3655,26 @@ void WSClient::HandleMessages(const sPacket& Packet)
 		{
 		case eRPCType::Client:
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
+				RPC->Call(sArchiveView(Packet.Data));
 			break;
 		case eRPCType::Server:
-			CallRPCFromServer(ClientInfo.NetworkAddress/*Packet.Address*/, Packet.FunctionName, Packet.Data, RPC->IsReliable());
+			CallRPCFromServer(Entry->Address, Entry->ClassName, RPC->GetName(), RPC->IsReliable(), Packet.Data);
 			break;
 		case eRPCType::ServerAndClient:
 			// Called on Server first
 			if (RPC->IsReqTimeStamp())
-				RPC->Call(sArchive(Packet.TimeStamp, Packet.Data));
+				RPC->Call(Packet.TimeStamp, sArchiveView(Packet.Data));
 			else
-				RPC->Call(sArchive(Packet.Data));
+				RPC->Call(sArchiveView(Packet.Data));
 			break;
 		}
 	}
 	else if (Packet.Type == eNetworkPacketType::DirectCall)
 	{
-		auto RPC = RemoteProcedureCallManager::Get().GetRPC("Global", "WSClient", Packet.FunctionName);
+		const auto* Entry = FindDirectCall(Packet, "WSClient");
+		auto RPC = Entry ? Entry->RPC : nullptr;
 		if (!RPC)
 		{
 			//PrintToConsole("RPC Not Called!");
@@ -2786,7 +3690,7 @@ void WSClient::HandleMessages(const sPacket& Packet)
 			//PrintToConsole("RPC Not Called!");
 			break;
 		case eRPCType::Client:
-			RPC->Call(sArchive(Packet.Data));
+			RPC->Call(sArchiveView(Packet.Data));
 			break;
 		}
 	}
@@ -2865,10 +3769,11 @@ bool WSClient::Connect(sGameInstance* pInstance, std::string ip, std::uint16_t P
 
 	bIsConnected.store(true, std::memory_order_release);
 
-	Engine::QueueJob([&]()
+	ReceiveThread = Engine::StartServiceThread("WSClient Receive", [&]()
 		{
+			MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eNetwork);
 			std::vector<std::uint8_t> buffer(256 * MaximumMessagePerTick);
-			sArchive LoD;
+			std::vector<std::uint8_t> Stream;
 
 			int bytesReceived = 0;
 
@@ -2895,22 +3800,18 @@ bool WSClient::Connect(sGameInstance* pInstance, std::string ip, std::uint16_t P
 
 				if (bytesReceived > 0)
 				{
-					std::lock_guard<std::mutex> locker(Mutex);
-					sArchive pArchive;
-					//pArchive.ResizeData(256 * 32);
-					pArchive.AppendData(buffer, bytesReceived);
+					const bool bIsValid = ReadWSFrames(Stream, buffer.data(), (std::size_t)bytesReceived, [&](const sPacket& Packet)
+						{
+							Packets.Push(Packet, &bIsConnected);
 
-					int i = 1;
-					while (pArchive.GetPosition() < pArchive.GetSize())
+							if (Packet.Type != eNetworkPacketType::Compressed && Packet.Type != eNetworkPacketType::Bundle && !Packet.Handle.IsValid() && (Packet.Address == "" || Packet.FunctionName == "" || Packet.ClassName == ""))
+								PrintToConsole("Empty");
+						});
+
+					if (!bIsValid)
 					{
-						sPacket Packet;
-						pArchive >> Packet;
-						Packets.push(Packet);
-						pArchive.ResetPos(i * 256);
-						i++;
-
-						if (Packet.Address == "" || Packet.FunctionName == "" || Packet.ClassName == "")
-							PrintToConsole("Empty");
+						std::cerr << "Invalid frame from the server, closing the connection." << std::endl;
+						break;
 					}
 				}
 			}
@@ -2922,29 +3823,34 @@ bool WSClient::Connect(sGameInstance* pInstance, std::string ip, std::uint16_t P
 
 bool WSClient::Disconnect()
 {
-	std::lock_guard<std::mutex> locker(Mutex);
-
 	if (!bIsConnected)
 		return false;
 
-	Info = sServerInfo();
+	SendMessages();
+	ReplicationManager::Get().ResetSession();
+
+	{
+		std::lock_guard<std::mutex> locker(Mutex);
 
-	bIsConnected.store(false, std::memory_order_release);
+		Info = sServerInfo();
 
-	WSAEVENT NewEvent;
-	NewEvent = WSACreateEvent();
+		bIsConnected.store(false, std::memory_order_release);
 
-	int iResult = 0;
-	// shutdown the connection since no more data will be sent
-	iResult = WSAEventSelect(ConnectSocket, NewEvent, FD_CLOSE);
-	iResult = shutdown(ConnectSocket, SD_SEND);
-	if (iResult == SOCKET_ERROR)
-	{
-		printf("Client : shutdown failed with error: %d\n", WSAGetLastError());
+		// shutdown the connection since no more data will be sent
+		int iResult = shutdown(ConnectSocket, SD_SEND);
+		if (iResult == SOCKET_ERROR)
+		{
+			printf("Client : shutdown failed with error: %d\n", WSAGetLastError());
+		}
+
+		// cleanup
+		closesocket(ConnectSocket);
 	}
 
-	// cleanup
-	closesocket(ConnectSocket);
+	// The receive thread takes the mutex, join it outside of it.
+	ReceiveThread = nullptr;
+
+	std::lock_guard<std::mutex> locker(Mutex);
 
 	Instance->OpenLevel("DefaultLevel");
 
@@ -2971,7 +3877,14 @@ void WSClient::SendBufferToServer(const void* buffer, std::size_t Size, bool rel
 		return;
 	}
 
-	int result = send(ConnectSocket, (char*)buffer, (int)Size, 0);
+	if (Size == 0 || Size > WSMaxFrameSize)
+	{
+		PrintToConsole("SendBufferToServer: " + std::to_string(Size) + " bytes can't be framed and are dropped.");
+		return;
+	}
+
+	const std::vector<std::uint8_t> Frame = MakeWSFrame(buffer, Size);
+	int result = send(ConnectSocket, (char*)Frame.data(), (int)Frame.size(), SocketSendFlags);
 
 	if (result == SOCKET_ERROR) 
 	{
@@ -2987,7 +3900,24 @@ void WSClient::SendBufferToServer(const void* buffer, std::size_t Size, bool rel
 
 void WSClient::SendToServer(const sArchive& Archive, bool reliable)
 {
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	{
+		// TCP delivers everything in one order, so everything goes to the reliable queue.
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		if (OutgoingBatch.Push(Archive, true))
+			return;
+	}
+	// Too large for a bundle, what is queued goes first to keep the order.
+	SendMessages();
+	SendArchiveToServer(Archive, reliable);
+}
+
+void WSClient::SendArchiveToServer(const sArchive& Archive, bool reliable)
+{
+	sArchive Compressed;
+	if (CompressPacket(Archive, CompressionThreshold, Compressed, CompressionStats))
+		SendBufferToServer(Compressed.GetData().data(), Compressed.GetSize(), reliable);
+	else
+		SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
 }
 
 void WSClient::CallRPCFromServer(std::string Address, std::string ClassName, std::string FunctionName, bool reliable, std::optional<std::string> Data)
@@ -3004,11 +3934,11 @@ void WSClient::CallRPCFromServer(std::string Address, std::string ClassName, std
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::RPC;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	//SendStringToServer(Archive.GetDataAsString(), reliable);
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToServer(Archive, reliable);
 }
 
 void WSClient::CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable)
@@ -3032,11 +3962,11 @@ void WSClient::CallMessageRPCFromServer(std::string Message, bool reliable)
 	Packet.FunctionName = "StringFromClient";
 	Packet.Data = DataArchive.GetDataAsString();
 	Packet.Type = eNetworkPacketType::String;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	//SendStringToServer(Archive.GetDataAsString(), reliable);
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToServer(Archive, reliable);
 }
 
 void WSClient::DirectCallToServer(std::string FunctionName, bool reliable, std::optional<std::string> Data)
@@ -3053,11 +3983,11 @@ void WSClient::DirectCallToServer(std::string FunctionName, bool reliable, std::
 	Packet.FunctionName = FunctionName;
 	Packet.Data = Data.has_value() ? *Data : "";
 	Packet.Type = eNetworkPacketType::DirectCall;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	//SendStringToServer(Archive.GetDataAsString(), reliable);
-	SendBufferToServer(Archive.GetData().data(), Archive.GetSize(), reliable);
+	SendToServer(Archive, reliable);
 }
 
 void WSClient::SendStringToServer(const std::string& string, bool reliable)
@@ -3072,7 +4002,18 @@ void WSClient::PushMessage(void* buffer, std::size_t size, bool reliable)
 
 void WSClient::SendMessages()
 {
+	sPacketBatch Batch;
+	{
+		std::lock_guard<std::mutex> locker(BatchMutex);
+		std::swap(Batch, OutgoingBatch);
+	}
+
+	FlushBatch(Batch.Reliable, WSBundleSize, [&](std::span<const sPacketBatch::SharedPacket> Packets) { SendArchiveToServer(MakeBundle(Packets), true); });
 
+	// The emptied batch keeps its capacity for the next tick.
+	std::lock_guard<std::mutex> locker(BatchMutex);
+	if (OutgoingBatch.IsEmpty())
+		std::swap(Batch, OutgoingBatch);
 }
 
 void WSClient::ClientValidation()
@@ -3086,8 +4027,8 @@ void WSClient::ClientValidation()
 	Packet.FunctionName = "ValidateClient";
 	Packet.Data = "Some Encrypted Code";
 	Packet.Type = eNetworkPacketType::Validation;
+	Packet.Handle = GetWireHandle(Packet);
 	sArchive Archive;
-	Archive.ResizeData(256);
 	Archive << Packet;
 	SendToServer(Archive, true);
 }
@@ -3103,6 +4044,14 @@ void WSClient::PingFromServer(std::uint64_t duration)
 	//PrintToConsole("Ping : " + std::to_string(Ping));
 }
 
+void WSClient::ReplicationFromServer(std::vector<std::uint8_t> Update)
+{
+	std::vector<sRPCHandle> Missing;
+	const auto Sequence = ReplicationManager::Get().Apply(sArchiveView(Update), sRPCHandle::Hash(PlayerNetworkAddress), sRPCHandle::Hash(ClientInfo.NetworkAddress), Missing);
+	if (Sequence.has_value())
+		DirectCallToServerEx("ReplicationAck", false, *Sequence, Missing);
+}
+
 void WSClient::OnReciveServerInfo(sServerInfo pInfo)
 {
 	Info = pInfo;
@@ -3238,7 +4187,7 @@ void ENetServer::StartServer(std::uint16_t Port, std::size_t PlayerCount)
 
 	bIsServerRunning.store(true, std::memory_order_release);
 
-	Engine::QueueJob([&]()
+	ServiceThread = Engine::StartServiceThread("ENetServer Service", [&]()
 		{
 			/* Bind the server to the default localhost.     */
 			/* A specific host address can be specified by   */
@@ -3312,6 +4261,7 @@ void ENetServer::StartServer(std::uint16_t Port, std::size_t PlayerCount)
 void ENetServer::CloseServer()
 {
 	bIsServerRunning.store(false, std::memory_order_release);
+	ServiceThread = nullptr;
 }
 
 void ENetServer::ParsePacket(int ID, char* Data)
@@ -3390,7 +4340,7 @@ bool ENetClient::Join(std::string ip, std::uint16_t Port)
 
 	bJoined.store(true, std::memory_order_release);
 
-	Engine::QueueJob([&]()
+	ServiceThread = Engine::StartServiceThread("ENetClient Service", [&]()
 		{
 			while (bJoined.load(std::memory_order_acquire))
 			{
@@ -3438,6 +4388,7 @@ void ENetClient::Disconnect()
 		return;
 
 	bJoined.store(false, std::memory_order_release);
+	ServiceThread = nullptr;
 
 	ENetEvent event;
 
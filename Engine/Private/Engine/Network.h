@@ -30,10 +30,16 @@
 #include "Utilities/Input.h"
 #include "Engine/IMetaWorld.h"
 #include <mutex>
+#include <unordered_map>
 #include "Core/Archive.h"
+#include "Core/ArchiveView.h"
+#include "Core/ArchiveReflection.h"
+#include "Core/Compression.h"
 #include <stdio.h>
 #include "Gameplay/GameInstance.h"
 #include "Engine/StepTimer.h"
+#include "Core/ThreadPool.h"
+#include "Core/MPSCQueue.h"
 
 #if Enable_ENET
 #include <enet/enet.h>
@@ -55,9 +61,7 @@
 #define Enable_ENET 0
 
 #if Enable_Winsock
-#include <windows.h>
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include "NetworkSocket.h"
 #include <stdlib.h>
 #include <stdio.h>
 #endif
@@ -76,6 +80,14 @@ enum class eNetworkPacketType : std::uint8_t
 	String,
 	RPC,
 	DirectCall,
+	/*
+	* Data is a compression frame holding another encoded packet.
+	*/
+	Compressed,
+	/*
+	* Data is a run of [std::uint16_t Size][encoded packet], see MakeBundle.
+	*/
+	Bundle,
 };
 
 /*__declspec(align(256))*/ struct sPacket
@@ -87,8 +99,14 @@ public:
 	eNetworkPacketType Type = eNetworkPacketType::RPC;
 	std::string ClassName = "";
 	std::string FunctionName = "";
+	/*
+	* When valid it goes on the wire instead of the three names, which are left empty on receive.
+	*/
+	sRPCHandle Handle;
 	std::string Data = "";
 
+	static constexpr std::uint8_t HandleFlag = 0x80;
+
 	sPacket() = default;
 	sPacket(sDateTime InTimeStamp, eNetworkPacketType InType, std::string InAddress, std::string InClassName, std::string InFunctionName, std::string InData)
 		: TimeStamp(InTimeStamp)
@@ -102,39 +120,116 @@ public:
 	friend void operator<<(sArchive& Archive, const sPacket& data)
 	{
 		Archive << data.TimeStamp;
-		Archive << data.Address;
-		Archive << (std::uint8_t)data.Type;
-		Archive << data.ClassName;
-		Archive << data.FunctionName;
+		Archive << (std::uint8_t)((std::uint8_t)data.Type | (data.Handle.IsValid() ? HandleFlag : 0));
+		if (data.Handle.IsValid())
+		{
+			Archive << data.Handle;
+		}
+		else
+		{
+			Archive << data.Address;
+			Archive << data.ClassName;
+			Archive << data.FunctionName;
+		}
 		Archive << data.Data;
 	}
 
 	friend void operator>>(const sArchive& Archive, sPacket& data)
+	{
+		sArchiveView::Read(Archive, data);
+	}
+
+	/*
+	* Data is everything after the header, give it a view over one packet only.
+	*/
+	friend void operator>>(const sArchiveView& Archive, sPacket& data)
 	{
 		Archive >> data.TimeStamp;
-		Archive >> data.Address;
 		std::uint8_t eType = 0;
 		Archive >> eType;
-		Archive >> data.ClassName;
-		Archive >> data.FunctionName;
-		//Archive >> data.Data;
-		data.Data.assign(Archive.GetDataAsString(), Archive.GetPosition(), Archive.GetSize() - Archive.GetPosition());
-		data.Type = (eNetworkPacketType)eType;
+		if (eType & HandleFlag)
+		{
+			Archive >> data.Handle;
+		}
+		else
+		{
+			Archive >> data.Address;
+			Archive >> data.ClassName;
+			Archive >> data.FunctionName;
+		}
+		const sArchiveView Payload = Archive.Consume(Archive.GetRemainingSize());
+		data.Data.assign(reinterpret_cast<const char*>(Payload.GetData()), Payload.GetSize());
+		data.Type = (eNetworkPacketType)(eType & ~HandleFlag);
 	}
 };
 
-struct sClientInfo
+/*
+* Packets queued for one connection during a tick, SendMessages sends them as Bundle packets.
+* Encoded packets are immutable and shared, a broadcast queues the same bytes for every connection.
+*/
+struct sPacketBatch
 {
-	std::string PlayerName;
-	friend void operator<<(sArchive& Archive, const sClientInfo& data)
+	typedef std::shared_ptr<const std::vector<std::uint8_t>> SharedPacket;
+
+	std::vector<SharedPacket> Reliable;
+	std::vector<SharedPacket> Unreliable;
+
+	static constexpr std::size_t MaxPacketSize = 0xFFFF;
+
+	static inline bool IsBatchable(const sArchive& Archive)
+	{
+		return Archive.GetSize() > 0 && Archive.GetSize() <= MaxPacketSize;
+	}
+
+	static inline SharedPacket MakeShared(const sArchive& Archive)
+	{
+		return std::make_shared<const std::vector<std::uint8_t>>(Archive.GetData());
+	}
+
+	/*
+	* False if the packet doesn't fit the size prefix, flush the batch and send it directly.
+	*/
+	inline bool Push(const sArchive& Archive, bool reliable)
 	{
-		Archive << data.PlayerName;
+		if (!IsBatchable(Archive))
+			return false;
+
+		Push(MakeShared(Archive), reliable);
+		return true;
 	}
 
-	friend void operator>>(const sArchive& Archive, sClientInfo& data)
+	inline void Push(const SharedPacket& Packet, bool reliable)
 	{
-		Archive >> data.PlayerName;
+		(reliable ? Reliable : Unreliable).push_back(Packet);
 	}
+
+	inline bool IsEmpty() const { return Reliable.empty() && Unreliable.empty(); }
+};
+
+/*
+* A packet decoded by Receive, waiting for Tick to handle it on the game thread.
+* Packets unpacked from the same received packet share a Group, a kick drops the rest of the group.
+*/
+struct sReceivedPacket
+{
+	std::uint32_t ID = 0;
+	std::uint64_t Group = 0;
+	sPacket Packet = sPacket();
+	sReceivedPacket(std::uint32_t InID = 0, std::uint64_t InGroup = 0, sPacket&& InPacket = sPacket())
+		: ID(InID)
+		, Group(InGroup)
+		, Packet(std::move(InPacket))
+	{}
+};
+
+struct sClientInfo
+{
+	std::string PlayerName;
+	static constexpr auto GetArchiveFields()
+	{
+		return MakeArchiveFields(&sClientInfo::PlayerName);
+	}
+	sArchiveFieldsBody(sClientInfo)
 };
 
 struct sServerInfo
@@ -154,19 +249,11 @@ struct sServerInfo
 		std::uint32_t PlayerIndex;
 		std::string PlayerName;
 
-		friend void operator<<(sArchive& Archive, const sConnectedPlayerInfo& data)
-		{
-			Archive << data.NetworkAddress;
-			Archive << data.PlayerIndex;
-			Archive << data.PlayerName;
-		}
-
-		friend void operator>>(const sArchive& Archive, sConnectedPlayerInfo& data)
+		static constexpr auto GetArchiveFields()
 		{
-			Archive >> data.NetworkAddress;
-			Archive >> data.PlayerIndex;
-			Archive >> data.PlayerName;
+			return MakeArchiveFields(&sConnectedPlayerInfo::NetworkAddress, &sConnectedPlayerInfo::PlayerIndex, &sConnectedPlayerInfo::PlayerName);
 		}
+		sArchiveFieldsBody(sConnectedPlayerInfo)
 
 		friend bool operator==(sConnectedPlayerInfo v1, sConnectedPlayerInfo v2)
 		{
@@ -180,23 +267,11 @@ struct sServerInfo
 
 	std::vector<sConnectedPlayerInfo> ConnectedPlayerInfos;
 
-	friend void operator<<(sArchive& Archive, const sServerInfo& data)
-	{
-		Archive << data.ServerName;
-		Archive << data.ConnectedPlayerCount;
-		Archive << data.MaximumConnectedPlayerSize;
-		Archive << data.LevelName;
-		Archive << data.ConnectedPlayerInfos;
-	}
-
-	friend void operator>>(const sArchive& Archive, sServerInfo& data)
+	static constexpr auto GetArchiveFields()
 	{
-		Archive >> data.ServerName;
-		Archive >> data.ConnectedPlayerCount;
-		Archive >> data.MaximumConnectedPlayerSize;
-		Archive >> data.LevelName;
-		Archive >> data.ConnectedPlayerInfos;
+		return MakeArchiveFields(&sServerInfo::ServerName, &sServerInfo::ConnectedPlayerCount, &sServerInfo::MaximumConnectedPlayerSize, &sServerInfo::LevelName, &sServerInfo::ConnectedPlayerInfos);
 	}
+	sArchiveFieldsBody(sServerInfo)
 };
 
 class IServer
@@ -206,6 +281,10 @@ public:
 	virtual bool CreateSession(std::string Name, sGameInstance* Instance, std::string Level, std::uint16_t Port = 27020, std::size_t PlayerCount = 8) = 0;
 	virtual bool DestroySession() = 0;
 
+	/*
+	* Drains and decodes the received packets, runs on a worker before Tick. Empty for backends that receive in Tick.
+	*/
+	virtual void Receive() {}
 	virtual void Tick(const double DeltaTime) = 0;
 
 	virtual sGameInstance* GetGameInstance() const = 0;
@@ -222,8 +301,24 @@ public:
 	virtual void SetMaximumMessagePerTick(std::size_t Size) = 0;
 	virtual std::size_t GetMaximumMessagePerTick() const = 0;
 
+	/*
+	* Encoded packets larger than Bytes are sent compressed, 0 sends everything raw.
+	*/
+	virtual void SetCompressionThreshold(std::size_t Bytes) = 0;
+	virtual std::size_t GetCompressionThreshold() const = 0;
+	virtual sCompressionStats GetCompressionStats() const = 0;
+
 	virtual void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt) = 0;
 
+	/*
+	* Receive thread to game thread handoff, empty for backends that poll on the game thread.
+	*/
+	virtual sMPSCQueueStats GetIncomingQueueStats() const { return sMPSCQueueStats(); }
+	/*
+	* Empty for backends without counters.
+	*/
+	virtual sNetworkTrafficStats GetTrafficStats() const { return sNetworkTrafficStats(); }
+
 	void OnSessionCreated();
 	void OnSessionDestroyed();
 	void OnPlayerConnectedToServer(std::string PlayerName, std::string NetAddress);
@@ -234,6 +329,10 @@ class IClient
 {
 	sBaseClassBody(sClassDefaultProtectedConstructor, IClient)
 public:
+	/*
+	* Drains and decodes the received packets, runs on a worker before Tick. Empty for backends that receive in Tick.
+	*/
+	virtual void Receive() {}
 	virtual void Tick(const double DeltaTime) = 0;
 
 	virtual sGameInstance* GetGameInstance() const = 0;
@@ -245,10 +344,22 @@ public:
 	virtual void SetMaximumMessagePerTick(std::size_t Size) = 0;
 	virtual std::size_t GetMaximumMessagePerTick() const = 0;
 
+	/*
+	* Encoded packets larger than Bytes are sent compressed, 0 sends everything raw.
+	*/
+	virtual void SetCompressionThreshold(std::size_t Bytes) = 0;
+	virtual std::size_t GetCompressionThreshold() const = 0;
+	virtual sCompressionStats GetCompressionStats() const = 0;
+
 	virtual void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt) = 0;
 
 	virtual std::uint64_t GetLatency() const = 0;
 
+	/*
+	* Receive thread to game thread handoff, empty for backends that poll on the game thread.
+	*/
+	virtual sMPSCQueueStats GetIncomingQueueStats() const { return sMPSCQueueStats(); }
+
 	void OnConnectedToServer();
 	void OnDisconnectedFromServer();
 	void OnPlayerConnectedToServer(std::string PlayerName, std::string NetAddress);
@@ -264,6 +375,7 @@ public:
 	GNSServer();
 	virtual ~GNSServer();
 
+	virtual void Receive() override final;
 	virtual void Tick(const double DeltaTime) override final;
 
 	virtual sGameInstance* GetGameInstance() const override final { return Instance; }
@@ -277,6 +389,10 @@ public:
 
 	void CallRPCFromClient(HSteamNetConnection clientID, std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data = std::nullopt, bool reliable = true);
 	void CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data = std::nullopt, bool reliable = true, HSteamNetConnection excludeClientID = k_HSteamNetConnection_Invalid);
+	/*
+	* Encodes the packet once and queues the same bytes for every client not in the list.
+	*/
+	void CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data, bool reliable, const std::vector<HSteamNetConnection>& excludeClientIDs);
 
 	template <typename... Args>
 	void CallRPCFromClientEx(HSteamNetConnection clientID, std::string Address, std::string ClassName, std::string FunctionName, bool reliable, Args&&... args)
@@ -304,8 +420,12 @@ public:
 	void CallMessageRPCFromClient(HSteamNetConnection clientID, std::string Message, bool reliable = true);
 	void CallMessageRPCFromClients(std::string Message, bool reliable = true, HSteamNetConnection excludeClientID = k_HSteamNetConnection_Invalid);
 
+	/*
+	* Queued until SendMessages, which bundles everything sent to a client during the tick.
+	*/
 	void SendToClient(HSteamNetConnection clientID, const sArchive& Archive, bool reliable = true);
 	void SendToClients(const sArchive& Archive, bool reliable = true, HSteamNetConnection excludeClientID = k_HSteamNetConnection_Invalid);
+	void SendToClients(const sArchive& Archive, bool reliable, const std::vector<HSteamNetConnection>& excludeClientIDs);
 
 	void SendBufferToClient(HSteamNetConnection clientID, const void* buffer, std::size_t size, bool reliable = true);
 	void SendBufferToAllClients(const void* buffer, std::size_t size, bool reliable = true, HSteamNetConnection excludeClientID = k_HSteamNetConnection_Invalid);
@@ -328,17 +448,16 @@ public:
 	virtual void SetMaximumMessagePerTick(std::size_t Size) override;
 	virtual std::size_t GetMaximumMessagePerTick() const override { return MaximumMessagePerTick; }
 
+	virtual void SetCompressionThreshold(std::size_t Bytes) override { CompressionThreshold = Bytes; }
+	virtual std::size_t GetCompressionThreshold() const override { return CompressionThreshold; }
+	virtual sCompressionStats GetCompressionStats() const override { return CompressionStats; }
+
 	virtual void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt) override;
-	template <typename... Args>
-	void CallRPCEx(std::uint32_t CalledPlayerIndex, std::string Address, std::string ClassName, std::string Name, std::optional<bool> reliable = std::nullopt, Args&&... args)
-	{
-		return CallRPC(CalledPlayerIndex, Address, ClassName, Name, sArchive(args...), reliable);
-	}
 
 	void PingClient(HSteamNetConnection clientID);
 
 private:
-	void PollIncomingMessages();
+	void HandleReceivedPackets();
 
 	void PollConnectionStateChanges();
 
@@ -367,6 +486,10 @@ private:
 	void OnClientSuccessfullyConnected(HSteamNetConnection ID, sClientInfo Info);
 
 	void HandleMessages(HSteamNetConnection ID, sPacket Packet, std::optional<bool> reliable = std::nullopt);
+	/*
+	* Compresses when worth it and sends right away, used when flushing the batches.
+	*/
+	void SendArchiveToClient(HSteamNetConnection clientID, const sArchive& Archive, bool reliable);
 
 	bool IsPlayerNameUnique(HSteamNetConnection ID, std::string Name) const;
 
@@ -376,7 +499,7 @@ private:
 
 private:
 	std::mutex Mutex;
-	bool bIsServerRunning;
+	std::atomic<bool> bIsServerRunning;
 
 	HSteamListenSocket m_hListenSock;
 	HSteamNetPollGroup m_hPollGroup;
@@ -389,6 +512,20 @@ private:
 
 	std::size_t MaximumMessagePerTick;
 
+	std::size_t CompressionThreshold;
+	sCompressionStats CompressionStats;
+
+	/*
+	* Written by Receive on a worker, handled and cleared by Tick on the game thread.
+	*/
+	std::vector<sReceivedPacket> Received;
+	sCompressionStats ReceiveCompressionStats;
+	std::size_t DamagedPacketCount;
+	std::uint64_t ReceiveGroup;
+
+	std::mutex BatchMutex;
+	std::unordered_map<HSteamNetConnection, sPacketBatch> OutgoingBatches;
+
 	std::vector<SteamNetworkingMessage_t*> Messages;
 	sServerInfo ServerInfo;
 
@@ -397,6 +534,8 @@ private:
 
 private:
 	void StringFromClient(std::uint32_t ClientID, std::string STR);
+	void ReplicationAck(std::uint32_t ClientID, std::uint32_t Sequence, std::vector<sRPCHandle> Missing);
+	void ViewFromClient(std::uint32_t ClientID, std::vector<FVector> Views);
 };
 
 class GNSClient : public IClient
@@ -406,6 +545,7 @@ public:
 	GNSClient();
 	virtual ~GNSClient();
 
+	virtual void Receive() override final;
 	virtual void Tick(const double DeltaTime) override final;
 
 	virtual sGameInstance* GetGameInstance() const override final { return Instance; }
@@ -428,6 +568,9 @@ public:
 		DirectCallToServer(Name, reliable, sArchive(args...));
 	}
 	void CallMessageRPCFromServer(std::string Message, bool reliable = true);
+	/*
+	* Queued until SendMessages, which bundles everything sent during the tick.
+	*/
 	void SendToServer(const sArchive& Archive, bool reliable = true);
 	void SendBufferToServer(const void* buffer, std::size_t Size, bool reliable = true);
 	void SendStringToServer(const std::string& string, bool reliable = true);
@@ -437,6 +580,10 @@ public:
 	virtual void SetMaximumMessagePerTick(std::size_t Size) override;
 	virtual std::size_t GetMaximumMessagePerTick() const override { return MaximumMessagePerTick; }
 
+	virtual void SetCompressionThreshold(std::size_t Bytes) override { CompressionThreshold = Bytes; }
+	virtual std::size_t GetCompressionThreshold() const override { return CompressionThreshold; }
+	virtual sCompressionStats GetCompressionStats() const override { return CompressionStats; }
+
 	virtual void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt) override;
 	template <typename... Args>
 	void CallRPCEx(std::string Address, std::string ClassName, std::string Name, std::optional<bool> reliable = std::nullopt, Args&&... args)
@@ -449,7 +596,7 @@ public:
 	virtual std::uint64_t GetLatency() const override final { return Latency; }
 
 private:
-	void PollIncomingMessages();
+	void HandleReceivedPackets();
 	void PollConnectionStateChanges();
 
 	void StringFromServer(std::string STR);
@@ -471,14 +618,19 @@ private:
 	void PrintToConsole(std::string Message);
 
 	void HandleMessages(sPacket Packet);
+	/*
+	* Compresses when worth it and sends right away, used when flushing the batch.
+	*/
+	void SendArchiveToServer(const sArchive& Archive, bool reliable);
 
 	void ClientValidation();
 
 	void PingFromServer(std::uint64_t duration);
+	void ReplicationFromServer(std::vector<std::uint8_t> Update);
 
 private:
 	std::mutex Mutex;
-	bool bIsConnected;
+	std::atomic<bool> bIsConnected;
 	
 	HSteamNetConnection m_hConnection;
 	ISteamNetworkingSockets* m_pInterface;
@@ -487,6 +639,21 @@ private:
 	sGameInstance* Instance;
 
 	std::size_t MaximumMessagePerTick;
+
+	std::size_t CompressionThreshold;
+	sCompressionStats CompressionStats;
+
+	/*
+	* Written by Receive on a worker, handled and cleared by Tick on the game thread.
+	*/
+	std::vector<sReceivedPacket> Received;
+	sCompressionStats ReceiveCompressionStats;
+	std::size_t DamagedPacketCount;
+	std::uint64_t ReceiveGroup;
+
+	std::mutex BatchMutex;
+	sPacketBatch OutgoingBatch;
+
 	sServerInfo Info;
 	sServerInfo::sConnectedPlayerInfo ClientInfo;
 	std::string PlayerNetworkAddress;
@@ -509,6 +676,7 @@ public:
 	WSServer();
 	virtual ~WSServer();
 
+	virtual void Receive() override final;
 	virtual void Tick(const double DeltaTime) override final;
 
 	virtual sGameInstance* GetGameInstance() const override final { return Instance; }
@@ -520,8 +688,15 @@ public:
 
 	virtual std::size_t GetPlayerSize() const override { return ServerInfo.MaximumConnectedPlayerSize; }
 
+	virtual sMPSCQueueStats GetIncomingQueueStats() const override { return Packets.GetStats(); }
+	virtual sNetworkTrafficStats GetTrafficStats() const override;
+
 	void CallRPCFromClient(std::uint32_t clientID, std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data = std::nullopt, bool reliable = true);
 	void CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data = std::nullopt, bool reliable = true, std::uint32_t excludeClientID = 0);
+	/*
+	* Encodes the packet once and queues the same bytes for every client not in the list.
+	*/
+	void CallRPCFromClients(std::string Address, std::string ClassName, std::string FunctionName, std::optional<std::string> Data, bool reliable, const std::vector<std::uint32_t>& excludeClientIDs);
 
 	template <typename... Args>
 	void CallRPCFromClientEx(std::uint32_t clientID, std::string Address, std::string ClassName, std::string FunctionName, bool reliable, Args&&... args)
@@ -549,8 +724,12 @@ public:
 	void CallMessageRPCFromClient(std::uint32_t clientID, std::string Message, bool reliable = true);
 	void CallMessageRPCFromClients(std::string Message, bool reliable = true, std::uint32_t excludeClientID = 0);
 
+	/*
+	* Queued until SendMessages, which bundles everything sent to a client during the tick.
+	*/
 	void SendToClient(std::uint32_t clientID, const sArchive& Archive, bool reliable = true);
 	void SendToClients(const sArchive& Archive, bool reliable = true, std::uint32_t excludeClientID = 0);
+	void SendToClients(const sArchive& Archive, bool reliable, const std::vector<std::uint32_t>& excludeClientIDs);
 
 	void SendBufferToClient(std::uint32_t clientID, const void* buffer, std::size_t size, bool reliable = true);
 	void SendBufferToAllClients(const void* buffer, std::size_t size, bool reliable = true, std::uint32_t excludeClientID = 0);
@@ -572,17 +751,16 @@ public:
 	virtual void SetMaximumMessagePerTick(std::size_t Size) override;
 	virtual std::size_t GetMaximumMessagePerTick() const override { return MaximumMessagePerTick; }
 
+	virtual void SetCompressionThreshold(std::size_t Bytes) override { CompressionThreshold = Bytes; }
+	virtual std::size_t GetCompressionThreshold() const override { return CompressionThreshold; }
+	virtual sCompressionStats GetCompressionStats() const override { return CompressionStats; }
+
 	virtual void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt) override;
-	template <typename... Args>
-	void CallRPCEx(std::uint32_t CalledPlayerIndex, std::string Address, std::string ClassName, std::string Name, std::optional<bool> reliable = std::nullopt, Args&&... args)
-	{
-		return CallRPC(CalledPlayerIndex, Address, ClassName, Name, sArchive(args...), reliable);
-	}
 
 	void PingClient(std::uint32_t clientID);
 
 private:
-	void PollIncomingMessages();
+	void HandleReceivedPackets();
 
 	void OnServerInfoRefresh();
 	void OnPlayerConnecting(std::uint32_t ID);
@@ -606,21 +784,61 @@ private:
 	void OnClientSuccessfullyConnected(std::uint32_t ID, sClientInfo Info);
 
 	void HandleMessages(std::uint32_t ID, const sPacket& Packet, std::optional<bool> reliable = std::nullopt);
+	/*
+	* Compresses when worth it and sends right away, used when flushing the batches.
+	*/
+	void SendArchiveToClient(std::uint32_t clientID, const sArchive& Archive, bool reliable);
 
 	bool IsPlayerNameUnique(std::uint32_t ID, std::string Name) const;
 
 	void ValidateClient(std::uint32_t ID, std::string Data);
 
 	void PingFromClient(std::uint32_t clientID, std::uint64_t TimeMS);
+	/*
+	* Answers with "OnServerStats", used by the load test to read the server side of a run.
+	*/
+	void RequestServerStats(std::uint32_t clientID);
+
+	void ResetTrafficStats();
 
 private:
 	std::mutex Mutex;
 	std::atomic<bool> bIsServerRunning;
 
+	/*
+	* Bytes and packets received are counted on the receive thread, the rest on the game thread.
+	*/
+	struct sTrafficCounters
+	{
+		std::atomic<std::uint64_t> BytesReceived = 0;
+		std::atomic<std::uint64_t> BytesSent = 0;
+		std::atomic<std::uint64_t> PacketsReceived = 0;
+		std::atomic<std::uint64_t> PacketsSent = 0;
+		std::atomic<std::uint64_t> RPCsHandled = 0;
+		std::atomic<std::uint64_t> TickCount = 0;
+		std::atomic<double> TickTimeTotalMS = 0.0;
+		std::atomic<double> TickTimeMaxMS = 0.0;
+	};
+	sTrafficCounters Traffic;
+
 	sGameInstance* Instance;
 
 	std::size_t MaximumMessagePerTick;
 
+	std::size_t CompressionThreshold;
+	sCompressionStats CompressionStats;
+
+	/*
+	* Written by Receive on a worker, handled and cleared by Tick on the game thread.
+	*/
+	std::vector<sReceivedPacket> Received;
+	sCompressionStats ReceiveCompressionStats;
+	std::size_t DamagedPacketCount;
+	std::uint64_t ReceiveGroup;
+
+	std::mutex BatchMutex;
+	std::unordered_map<std::uint32_t, sPacketBatch> OutgoingBatches;
+
 	sServerInfo ServerInfo;
 
 	std::vector<std::uint32_t> KickList;
@@ -629,15 +847,24 @@ private:
 	struct sClientSocket
 	{
 		bool IsValid = false;
+		/*
+		* Set by the receive thread when the client closed the connection, the game thread disconnects it.
+		*/
+		bool bIsClosed = false;
 		SOCKET Socket = INVALID_SOCKET;
 		std::uint32_t TimeOutTest = 0;
 		sClientSocket(SOCKET Socket = INVALID_SOCKET)
 			: IsValid(false)
+			, bIsClosed(false)
 			, Socket(Socket)
 			, TimeOutTest(0)
 		{}
 	};
 	std::map<std::uint32_t, sClientSocket> Clients;
+	/*
+	* Guards Clients against the accept and receive threads, held only around map access and never while sending.
+	*/
+	std::mutex ClientsMutex;
 
 	WSADATA wsaData;
 	SOCKET ListenSocket;
@@ -646,17 +873,25 @@ private:
 	{
 		std::uint32_t ID = 0;
 		sPacket Packet = sPacket();
-		sMsg(std::uint32_t InID, const sPacket& InPacket)
+		sMsg(std::uint32_t InID = 0, const sPacket& InPacket = sPacket())
 			: ID(InID)
 			, Packet(InPacket)
 		{}
 	};
-	std::queue<sMsg> Packets;
+	/*
+	* Filled by the receive thread, drained on the game thread.
+	*/
+	sMPSCQueue<sMsg> Packets;
 
 	std::uint32_t ClientCounter;
 
+	sServiceThread::UniquePtr AcceptThread;
+	sServiceThread::UniquePtr ReceiveThread;
+
 private:
 	void StringFromClient(std::uint32_t ClientID, std::string STR);
+	void ReplicationAck(std::uint32_t ClientID, std::uint32_t Sequence, std::vector<sRPCHandle> Missing);
+	void ViewFromClient(std::uint32_t ClientID, std::vector<FVector> Views);
 };
 
 class WSClient : public IClient
@@ -666,6 +901,7 @@ public:
 	WSClient();
 	virtual ~WSClient();
 
+	virtual void Receive() override final;
 	virtual void Tick(const double DeltaTime) override final;
 
 	virtual sGameInstance* GetGameInstance() const override final { return Instance; }
@@ -675,6 +911,8 @@ public:
 
 	virtual bool IsConnected() const override { return bIsConnected; }
 
+	virtual sMPSCQueueStats GetIncomingQueueStats() const override { return Packets.GetStats(); }
+
 	void CallRPCFromServer(std::string Address, std::string ClassName, std::string FunctionName, bool reliable = true, std::optional<std::string> Data = std::nullopt);
 	template <typename... Args>
 	void CallRPCFromServerEx(std::string Address, std::string ClassName, std::string Name, bool reliable, Args&&... args)
@@ -688,6 +926,9 @@ public:
 		DirectCallToServer(Name, reliable, sArchive(args...));
 	}
 	void CallMessageRPCFromServer(std::string Message, bool reliable = true);
+	/*
+	* Queued until SendMessages, which bundles everything sent during the tick.
+	*/
 	void SendToServer(const sArchive& Archive, bool reliable = true);
 	void SendBufferToServer(const void* buffer, std::size_t Size, bool reliable = true);
 	void SendStringToServer(const std::string& string, bool reliable = true);
@@ -697,6 +938,10 @@ public:
 	virtual void SetMaximumMessagePerTick(std::size_t Size) override;
 	virtual std::size_t GetMaximumMessagePerTick() const override { return MaximumMessagePerTick; }
 
+	virtual void SetCompressionThreshold(std::size_t Bytes) override { CompressionThreshold = Bytes; }
+	virtual std::size_t GetCompressionThreshold() const override { return CompressionThreshold; }
+	virtual sCompressionStats GetCompressionStats() const override { return CompressionStats; }
+
 	virtual void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt) override;
 	template <typename... Args>
 	void CallRPCEx(std::string Address, std::string ClassName, std::string Name, std::optional<bool> reliable = std::nullopt, Args&&... args)
@@ -709,7 +954,7 @@ public:
 	virtual std::uint64_t GetLatency() const override final { return Latency; }
 
 private:
-	void PollIncomingMessages();
+	void HandleReceivedPackets();
 
 	void StringFromServer(std::string STR);
 
@@ -727,10 +972,15 @@ private:
 	void PrintToConsole(std::string Message);
 
 	void HandleMessages(const sPacket& Packet);
+	/*
+	* Compresses when worth it and sends right away, used when flushing the batch.
+	*/
+	void SendArchiveToServer(const sArchive& Archive, bool reliable);
 
 	void ClientValidation();
 
 	void PingFromServer(std::uint64_t duration);
+	void ReplicationFromServer(std::vector<std::uint8_t> Update);
 
 private:
 	std::mutex Mutex;
@@ -739,6 +989,21 @@ private:
 	sGameInstance* Instance;
 
 	std::size_t MaximumMessagePerTick;
+
+	std::size_t CompressionThreshold;
+	sCompressionStats CompressionStats;
+
+	/*
+	* Written by Receive on a worker, handled and cleared by Tick on the game thread.
+	*/
+	std::vector<sReceivedPacket> Received;
+	sCompressionStats ReceiveCompressionStats;
+	std::size_t DamagedPacketCount;
+	std::uint64_t ReceiveGroup;
+
+	std::mutex BatchMutex;
+	sPacketBatch OutgoingBatch;
+
 	sServerInfo Info;
 	sServerInfo::sConnectedPlayerInfo ClientInfo;
 	std::string PlayerNetworkAddress;
@@ -750,7 +1015,12 @@ private:
 	WSADATA wsaData;
 	SOCKET ConnectSocket;
 
-	std::queue<sPacket> Packets;
+	/*
+	* Filled by the receive thread, drained on the game thread.
+	*/
+	sMPSCQueue<sPacket> Packets;
+
+	sServiceThread::UniquePtr ReceiveThread;
 };
 
 #endif
@@ -780,6 +1050,7 @@ private:
 	std::atomic<bool> bIsServerRunning;
 	std::size_t PlayerSize;
 	ENetHost* Server;
+	sServiceThread::UniquePtr ServiceThread;
 };
 
 class ENetClient : public IClient
@@ -805,6 +1076,7 @@ private:
 	ENetPeer* Peer;
 
 	std::atomic<bool> bJoined;
+	sServiceThread::UniquePtr ServiceThread;
 };
 
 #endif
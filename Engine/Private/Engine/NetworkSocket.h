@@ -0,0 +1,77 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+
+#pragma once
+
+/*
+* Winsock on Windows, BSD sockets everywhere else.
+* The POSIX side maps the handful of Winsock names the network code uses.
+*/
+#if defined(_WIN32)
+#include <windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+constexpr int SocketSendFlags = 0;
+
+inline int PollSockets(WSAPOLLFD* Sockets, std::size_t Count, int TimeoutMS) { return WSAPoll(Sockets, (ULONG)Count, TimeoutMS); }
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+typedef int SOCKET;
+typedef pollfd WSAPOLLFD;
+struct WSADATA {};
+
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR (-1)
+#define SD_RECEIVE SHUT_RD
+#define SD_SEND SHUT_WR
+#define SD_BOTH SHUT_RDWR
+#define WSAEWOULDBLOCK EWOULDBLOCK
+#define MAKEWORD(a, b) ((unsigned short)(((unsigned char)(a)) | ((unsigned short)((unsigned char)(b)) << 8)))
+#define ZeroMemory(Destination, Length) std::memset((Destination), 0, (Length))
+
+inline int WSAStartup(unsigned short, WSADATA*) { return 0; }
+inline int WSACleanup() { return 0; }
+inline int WSAGetLastError() { return errno; }
+inline int closesocket(SOCKET Socket) { return ::close(Socket); }
+
+inline int PollSockets(WSAPOLLFD* Sockets, std::size_t Count, int TimeoutMS) { return ::poll(Sockets, (nfds_t)Count, TimeoutMS); }
+
+/*
+* A peer that went away raises SIGPIPE on send instead of returning an error.
+*/
+constexpr int SocketSendFlags = MSG_NOSIGNAL;
+#endif
@@ -38,6 +38,7 @@
 #include <queue>
 #include <thread>
 #include <any>
+#include <atomic>
 
 #include "Engine/AbstractEngine.h"
 
@@ -56,9 +57,48 @@ public:
 		return instance;
 	}
 
+public:
+	struct sRPCEntry
+	{
+		std::string Address;
+		std::string ClassName;
+		RemoteProcedureCallBase* RPC;
+	};
+
 private:
 	std::mutex mutex;
 	std::map<std::string, std::map<std::string, std::vector<RemoteProcedureCallBase*>>> Functions;
+	/*
+	* Wire handles of the registered RPCs, more than one entry under a handle is a collision
+	* and those RPCs go by name.
+	*/
+	std::unordered_multimap<sRPCHandle, sRPCEntry, sRPCHandleHasher> Handles;
+	std::atomic<bool> bSendRPCNames = false;
+
+    inline void AddHandle(const std::string& Address, const std::string& ClassName, RemoteProcedureCallBase* RPC)
+    {
+        const sRPCHandle Handle(Address, ClassName, RPC->GetName());
+        if (Handles.count(Handle) == 1)
+        {
+            const auto& Other = Handles.find(Handle)->second;
+            std::cerr << "RPC handle collision between '" << Address << "::" << ClassName << "::" << RPC->GetName() << "' and '"
+                << Other.Address << "::" << Other.ClassName << "::" << Other.RPC->GetName() << "', both are sent by name." << std::endl;
+        }
+        Handles.emplace(Handle, sRPCEntry{ Address, ClassName, RPC });
+    }
+
+    inline void RemoveHandle(const std::string& Address, const std::string& ClassName, RemoteProcedureCallBase* RPC)
+    {
+        auto Range = Handles.equal_range(sRPCHandle(Address, ClassName, RPC->GetName()));
+        for (auto It = Range.first; It != Range.second; ++It)
+        {
+            if (It->second.RPC == RPC)
+            {
+                Handles.erase(It);
+                return;
+            }
+        }
+    }
 
 public:
 	~RemoteProcedureCallManager()
@@ -80,6 +120,7 @@ public:
             }
 		}
 		Functions.clear();
+		Handles.clear();
 	}
 
     inline bool IsExist(std::string InAddress, std::string ClassName, std::string Name) const
@@ -87,39 +128,78 @@ public:
         return GetRPC(InAddress, ClassName, Name) != nullptr;
     }
 
+    /*
+    * Nothing changes when NewName is already registered.
+    */
     inline void ChangeBase(std::string InOldName, std::string NewName)
     {
+        if (InOldName == NewName || Functions.find(NewName) != Functions.end())
+            return;
+
         auto nodeHandler = Functions.extract(InOldName);
+        if (nodeHandler.empty())
+            return;
+
+        for (auto& Class : nodeHandler.mapped())
+            for (auto& pfn : Class.second)
+                RemoveHandle(InOldName, Class.first, pfn);
+
         nodeHandler.key() = NewName;
-        Functions.insert(std::move(nodeHandler));
+        auto Result = Functions.insert(std::move(nodeHandler));
+
+        for (auto& Class : Result.position->second)
+            for (auto& pfn : Class.second)
+                AddHandle(NewName, Class.first, pfn);
     }
 
-    inline RemoteProcedureCallBase* GetRPC(std::string InAddress, std::string ClassName, std::string Name) const
+    /*
+    * O(1) lookup of an incoming handle, null if nothing or more than one RPC is registered under it.
+    */
+    inline const sRPCEntry* FindRPC(const sRPCHandle& Handle) const
     {
-        for (const auto& Address : Functions)
+        auto Range = Handles.equal_range(Handle);
+        if (Range.first == Range.second || std::next(Range.first) != Range.second)
+            return nullptr;
+        return &Range.first->second;
+    }
+
+    /*
+    * Name lookup, hashes the names and checks them against the entries under the handle.
+    */
+    inline const sRPCEntry* FindRPC(const std::string& InAddress, const std::string& ClassName, const std::string& Name) const
+    {
+        auto Range = Handles.equal_range(sRPCHandle(InAddress, ClassName, Name));
+        for (auto It = Range.first; It != Range.second; ++It)
         {
-            if (Address.first == InAddress)
-            {
-                for (const auto& Class : Address.second)
-                {
-                    if (Class.first == ClassName)
-                    {
-                        for (const auto& pfn : Class.second)
-                        {
-                            if (pfn->GetName() == Name)
-                            {
-                                return pfn;
-                            }
-                        }
-                        break;
-                    }
-                }
-                break;
-            }
+            if (It->second.Address == InAddress && It->second.ClassName == ClassName && It->second.RPC->GetName() == Name)
+                return &It->second;
         }
         return nullptr;
     }
 
+    inline RemoteProcedureCallBase* GetRPC(const sRPCHandle& Handle) const
+    {
+        const sRPCEntry* Entry = FindRPC(Handle);
+        return Entry ? Entry->RPC : nullptr;
+    }
+
+    inline RemoteProcedureCallBase* GetRPC(std::string InAddress, std::string ClassName, std::string Name) const
+    {
+        const sRPCEntry* Entry = FindRPC(InAddress, ClassName, Name);
+        return Entry ? Entry->RPC : nullptr;
+    }
+
+    inline bool IsHandleAmbiguous(const sRPCHandle& Handle) const
+    {
+        return Handles.count(Handle) > 1;
+    }
+
+    /*
+    * Debug fallback, packets carry the names instead of the handle.
+    */
+    inline void SetSendRPCNames(bool bEnable) { bSendRPCNames.store(bEnable, std::memory_order_relaxed); }
+    inline bool IsSendingRPCNames() const { return bSendRPCNames.load(std::memory_order_relaxed); }
+
     inline void Unregister(std::string Address)
     {
         if (Functions.find(Address) != Functions.end()) 
@@ -128,6 +208,7 @@ public:
             {
                 for (auto& pfn : Class.second)
                 {
+                    RemoveHandle(Address, Class.first, pfn);
                     delete pfn;
                     pfn = nullptr;
                 }
@@ -144,6 +225,7 @@ public:
             {
                 for (auto& pfn : Functions[Address][InName])
                 {
+                    RemoveHandle(Address, InName, pfn);
                     delete pfn;
                     pfn = nullptr;
                 }
@@ -176,6 +258,7 @@ public:
 
                 if (RPC)
                 {
+                    RemoveHandle(Address, InClassName, RPC);
                     delete RPC;
                     RPC = nullptr;
                 }
@@ -188,6 +271,7 @@ public:
         if (IsExist(Address, InClassName, RPC->GetName()))
             Unregister(Address, InClassName, RPC->GetName());
         Functions[Address][InClassName].push_back(RPC);
+        AddHandle(Address, InClassName, RPC);
     }
 
     // Register a function to be called remotely.
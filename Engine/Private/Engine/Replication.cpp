@@ -0,0 +1,764 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "Replication.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+bool sReplicatedProperties::Register(const std::string& Address, const std::string& ClassName)
+{
+	Unregister();
+	bIsRegistered = ReplicationManager::Get().Register(Address, ClassName, this);
+	return bIsRegistered;
+}
+
+void sReplicatedProperties::Unregister()
+{
+	if (!bIsRegistered)
+		return;
+
+	ReplicationManager::Get().Unregister(this);
+	bIsRegistered = false;
+}
+
+ReplicationManager::ReplicationManager()
+	: VersionCounter(0)
+	, Rate(20)
+	, Accumulator(0.0)
+	, TickCounter(0)
+	, RelevancyDistance(2048.0f)
+	, bLocalViewsChanged(false)
+	, ViewAccumulator(0.0)
+	, ViewResendTimer(0.0)
+{
+}
+
+bool ReplicationManager::Register(const std::string& Address, const std::string& ClassName, sReplicatedProperties* Properties)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	if (!Properties || Handles.contains(Properties))
+		return false;
+
+	const sRPCHandle Handle(Address, ClassName, "");
+	const auto Existing = Objects.find(Handle);
+	if (Existing != Objects.end())
+	{
+		std::cerr << "Replicated properties of '" << Address << "::" << ClassName << "' collide with '"
+			<< Existing->second.Address << "::" << Existing->second.ClassName << "' and are not replicated." << std::endl;
+		return false;
+	}
+
+	sObject Object;
+	Object.Address = Address;
+	Object.ClassName = ClassName;
+	Object.Properties = Properties;
+	// Everything is newer than what a client has, the first update is the whole object.
+	Object.Versions.resize(Properties->GetPropertyCount());
+	for (auto& Version : Object.Versions)
+		Version = ++VersionCounter;
+	Properties->ConsumeDirtyMask();
+
+	Objects.emplace(Handle, std::move(Object));
+	Handles.emplace(Properties, Handle);
+	for (auto& Connection : Connections)
+	{
+		Connection.second.ChangedAt[Handle] = Connection.second.NextSequence;
+		Connection.second.Relevant.insert(Handle);
+		Connection.second.Pending.insert(Handle);
+	}
+
+	return true;
+}
+
+void ReplicationManager::Unregister(sReplicatedProperties* Properties)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	const auto It = Handles.find(Properties);
+	if (It == Handles.end())
+		return;
+
+	const sRPCHandle Handle = It->second;
+	Handles.erase(It);
+	Objects.erase(Handle);
+	for (auto& Connection : Connections)
+	{
+		Connection.second.Relevant.erase(Handle);
+		Connection.second.Leaving.erase(Handle);
+		Connection.second.ChangedAt.erase(Handle);
+		Connection.second.Acknowledged.erase(Handle);
+		Connection.second.Pending.erase(Handle);
+		Connection.second.Missing.erase(Handle);
+	}
+}
+
+void ReplicationManager::AddConnection(std::uint32_t ID, const std::string& Address)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	sConnection& Connection = Connections[ID];
+	Connection = sConnection();
+	Connection.Address = sRPCHandle::Hash(Address);
+	for (const auto& Object : Objects)
+	{
+		Connection.Relevant.insert(Object.first);
+		Connection.Pending.insert(Object.first);
+	}
+}
+
+void ReplicationManager::RemoveConnection(std::uint32_t ID)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+	Connections.erase(ID);
+}
+
+void ReplicationManager::ResetSession()
+{
+	std::vector<sNotification> Notifications;
+	{
+		std::lock_guard<std::mutex> locker(Mutex);
+
+		Connections.clear();
+		Accumulator = 0.0;
+		ViewAccumulator = 0.0;
+		ViewResendTimer = 0.0;
+		bLocalViewsChanged = true;
+		for (auto& Object : Objects)
+		{
+			Object.second.LastAppliedSequence = 0;
+			// Nothing decides relevancy without a server, left objects come back.
+			if (!Object.second.bIsRelevant)
+			{
+				Object.second.bIsRelevant = true;
+				sNotification Notification;
+				Notification.Properties = Object.second.Properties;
+				Notification.bIsRelevant = true;
+				Notifications.push_back(Notification);
+			}
+		}
+	}
+	Notify(Notifications);
+}
+
+void ReplicationManager::SetRate(std::uint32_t UpdatesPerSecond)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+	Rate = std::max<std::uint32_t>(UpdatesPerSecond, 1);
+}
+
+void ReplicationManager::SetRelevancyDistance(float Distance)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+	RelevancyDistance = std::max(Distance, 0.0f);
+}
+
+void ReplicationManager::SetConnectionViews(std::uint32_t ID, std::vector<FBoundingBox> Views)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	const auto It = Connections.find(ID);
+	if (It == Connections.end())
+		return;
+
+	if (Views.size() > MaxViewsPerConnection)
+		Views.resize(MaxViewsPerConnection);
+	It->second.Views = std::move(Views);
+}
+
+std::vector<std::uint32_t> ReplicationManager::GetIrrelevantConnections(const std::string& Address, const std::string& ClassName)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	std::vector<std::uint32_t> Result;
+	const sRPCHandle Handle(Address, ClassName, "");
+	if (!Objects.contains(Handle))
+		return Result;
+
+	for (const auto& Connection : Connections)
+	{
+		if (!Connection.second.Relevant.contains(Handle))
+			Result.push_back(Connection.first);
+	}
+	return Result;
+}
+
+void ReplicationManager::SetLocalView(std::size_t PlayerIndex, std::optional<FBoundingBox> Bounds)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	const auto It = LocalViews.find(PlayerIndex);
+	if (!Bounds.has_value())
+	{
+		if (It != LocalViews.end())
+		{
+			LocalViews.erase(It);
+			bLocalViewsChanged = true;
+		}
+		return;
+	}
+
+	if (It != LocalViews.end() && It->second.Equals(*Bounds))
+		return;
+	LocalViews[PlayerIndex] = *Bounds;
+	bLocalViewsChanged = true;
+}
+
+void ReplicationManager::SendViews(const double DeltaTime, const std::function<void(const std::vector<FVector>& Views)>& Send)
+{
+	std::vector<FVector> Views;
+	{
+		std::lock_guard<std::mutex> locker(Mutex);
+
+		const double Interval = 1.0 / Rate;
+		ViewAccumulator += DeltaTime;
+		ViewResendTimer += DeltaTime;
+		if (ViewAccumulator < Interval)
+			return;
+		ViewAccumulator = std::fmod(ViewAccumulator, Interval);
+
+		if (!bLocalViewsChanged && ViewResendTimer < 1.0)
+			return;
+		bLocalViewsChanged = false;
+		ViewResendTimer = 0.0;
+
+		Views.reserve(LocalViews.size() * 2);
+		for (const auto& View : LocalViews)
+		{
+			Views.push_back(View.second.Min);
+			Views.push_back(View.second.Max);
+		}
+	}
+
+	Send(Views);
+}
+
+void ReplicationManager::Tick(const double DeltaTime, const std::function<void(std::uint32_t ID, const sArchive& Update)>& Send)
+{
+	// Sent after the lock is released, a failed send can disconnect a client.
+	std::vector<std::pair<std::uint32_t, sArchive>> Updates;
+	{
+		std::lock_guard<std::mutex> locker(Mutex);
+
+		if (Connections.empty())
+		{
+			Accumulator = 0.0;
+			return;
+		}
+
+		const double Interval = 1.0 / Rate;
+		Accumulator += DeltaTime;
+		if (Accumulator < Interval)
+			return;
+		// A long frame sends one update, not the ones it missed.
+		Accumulator = std::fmod(Accumulator, Interval);
+		TickCounter++;
+
+		CollectDirtyProperties();
+		UpdateRelevancy();
+		for (auto& Connection : Connections)
+			WriteUpdates(Connection.first, Connection.second, Updates);
+	}
+
+	for (const auto& Update : Updates)
+		Send(Update.first, Update.second);
+}
+
+void ReplicationManager::CollectDirtyProperties()
+{
+	for (auto& It : Objects)
+	{
+		sObject& Object = It.second;
+		const std::uint64_t Mask = Object.Properties->ConsumeDirtyMask();
+		if (Mask == 0)
+			continue;
+
+		for (std::size_t i = 0; i < Object.Versions.size(); i++)
+		{
+			if (Mask & (1ull << i))
+				Object.Versions[i] = ++VersionCounter;
+		}
+		for (auto& Connection : Connections)
+		{
+			if (Connection.second.Relevant.contains(It.first))
+				Connection.second.Pending.insert(It.first);
+		}
+	}
+}
+
+void ReplicationManager::UpdateRelevancy()
+{
+	using sObjectEntry = std::pair<const sRPCHandle, sObject>;
+
+	// Clamped so far away bounds don't overflow, they just share the border cells.
+	const auto GetCell = [](float Value) { return (std::int64_t)std::clamp<double>(std::floor(Value / GridCellSize), std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()); };
+	const auto GetCellCount = [](std::int64_t MinX, std::int64_t MinY, std::int64_t MaxX, std::int64_t MaxY) { return double(MaxX - MinX + 1) * double(MaxY - MinY + 1); };
+	const auto GetKey = [](std::int64_t X, std::int64_t Y) { return ((std::uint64_t)(std::uint32_t)X << 32) | (std::uint32_t)Y; };
+	// Decided on X and Y, 2D bounds often have no depth.
+	const auto Overlaps = [](const FBoundingBox& A, const FBoundingBox& B)
+	{
+		return A.Min.X <= B.Max.X && B.Min.X <= A.Max.X && A.Min.Y <= B.Max.Y && B.Min.Y <= A.Max.Y;
+	};
+	const auto IsFinite = [](const FBoundingBox& Bounds)
+	{
+		return std::isfinite(Bounds.Min.X) && std::isfinite(Bounds.Min.Y) && std::isfinite(Bounds.Max.X) && std::isfinite(Bounds.Max.Y);
+	};
+
+	std::unordered_map<std::uint32_t, std::vector<FBoundingBox>> OwnedViews;
+	for (const auto& Connection : Connections)
+		OwnedViews[Connection.second.Address];
+
+	std::unordered_map<std::uint64_t, std::vector<sObjectEntry*>> Grid;
+	std::vector<sObjectEntry*> Everywhere;
+	for (auto& It : Objects)
+	{
+		sObject& Object = It.second;
+		Object.Bounds = Object.Properties->GetRelevancyBounds ? Object.Properties->GetRelevancyBounds() : std::nullopt;
+		if (!Object.Bounds.has_value() || !IsFinite(*Object.Bounds))
+		{
+			Object.Bounds = std::nullopt;
+			Everywhere.push_back(&It);
+			continue;
+		}
+
+		const FBoundingBox& Bounds = *Object.Bounds;
+		const auto Owned = OwnedViews.find(It.first.Address);
+		if (Owned != OwnedViews.end())
+		{
+			Owned->second.push_back(FBoundingBox(FVector(Bounds.Min.X - RelevancyDistance, Bounds.Min.Y - RelevancyDistance, Bounds.Min.Z),
+				FVector(Bounds.Max.X + RelevancyDistance, Bounds.Max.Y + RelevancyDistance, Bounds.Max.Z)));
+		}
+
+		const std::int64_t MinX = GetCell(Bounds.Min.X);
+		const std::int64_t MinY = GetCell(Bounds.Min.Y);
+		const std::int64_t MaxX = GetCell(Bounds.Max.X);
+		const std::int64_t MaxY = GetCell(Bounds.Max.Y);
+		if (GetCellCount(MinX, MinY, MaxX, MaxY) > MaxObjectCells)
+		{
+			Everywhere.push_back(&It);
+			continue;
+		}
+
+		for (std::int64_t X = MinX; X <= MaxX; X++)
+		{
+			for (std::int64_t Y = MinY; Y <= MaxY; Y++)
+				Grid[GetKey(X, Y)].push_back(&It);
+		}
+	}
+
+	for (auto& It : Connections)
+	{
+		sConnection& Connection = It.second;
+
+		std::vector<FBoundingBox> Views;
+		for (const auto& View : Connection.Views)
+		{
+			if (IsFinite(View))
+				Views.push_back(View);
+		}
+		const auto& Owned = OwnedViews[Connection.Address];
+		Views.insert(Views.end(), Owned.begin(), Owned.end());
+
+		std::unordered_set<sRPCHandle, sRPCHandleHasher> Relevant;
+		if (Views.empty())
+		{
+			// Nothing tells where the client is yet.
+			Relevant.reserve(Objects.size());
+			for (const auto& Object : Objects)
+				Relevant.insert(Object.first);
+		}
+		else
+		{
+			Relevant.reserve(Connection.Relevant.size() + Everywhere.size());
+			for (const auto* Object : Everywhere)
+				Relevant.insert(Object->first);
+
+			const auto Test = [&](const FBoundingBox& View, const std::vector<sObjectEntry*>& Cell)
+			{
+				for (const auto* Object : Cell)
+				{
+					if (!Relevant.contains(Object->first) && Overlaps(*Object->second.Bounds, View))
+						Relevant.insert(Object->first);
+				}
+			};
+
+			for (const auto& View : Views)
+			{
+				const std::int64_t MinX = GetCell(View.Min.X);
+				const std::int64_t MinY = GetCell(View.Min.Y);
+				const std::int64_t MaxX = GetCell(View.Max.X);
+				const std::int64_t MaxY = GetCell(View.Max.Y);
+				// A view larger than the populated grid walks the cells there are.
+				if (GetCellCount(MinX, MinY, MaxX, MaxY) > Grid.size())
+				{
+					for (const auto& Cell : Grid)
+						Test(View, Cell.second);
+					continue;
+				}
+
+				for (std::int64_t X = MinX; X <= MaxX; X++)
+				{
+					for (std::int64_t Y = MinY; Y <= MaxY; Y++)
+					{
+						const auto Cell = Grid.find(GetKey(X, Y));
+						if (Cell != Grid.end())
+							Test(View, Cell->second);
+					}
+				}
+			}
+		}
+
+		for (const auto& Handle : Relevant)
+		{
+			if (Connection.Relevant.contains(Handle))
+				continue;
+			// Entered, whatever the client kept from before goes whole again.
+			Connection.ChangedAt[Handle] = Connection.NextSequence;
+			Connection.Leaving.erase(Handle);
+			Connection.Acknowledged.erase(Handle);
+			Connection.Pending.insert(Handle);
+		}
+		for (const auto& Handle : Connection.Relevant)
+		{
+			if (Relevant.contains(Handle))
+				continue;
+			Connection.ChangedAt[Handle] = Connection.NextSequence;
+			Connection.Leaving.insert(Handle);
+			Connection.Acknowledged.erase(Handle);
+			Connection.Pending.erase(Handle);
+		}
+		Connection.Relevant = std::move(Relevant);
+	}
+}
+
+void ReplicationManager::WriteUpdates(std::uint32_t ID, sConnection& Connection, std::vector<std::pair<std::uint32_t, sArchive>>& Updates)
+{
+	sArchive Update;
+	sUpdate Sent;
+	bool bIsStarted = false;
+	std::size_t UpdateCount = 0;
+
+	// Leaves go again every tick until an update carrying them is acknowledged, like properties do.
+	const std::vector<sRPCHandle> Leaves(Connection.Leaving.begin(), Connection.Leaving.end());
+	std::size_t NextLeave = 0;
+
+	const auto Begin = [&]()
+	{
+		const std::size_t Count = std::min(Leaves.size() - NextLeave, MaxLeavesPerUpdate);
+		Sent.Sequence = Connection.NextSequence++;
+		Update << Sent.Sequence;
+		Update << (std::uint32_t)Count;
+		for (std::size_t i = 0; i < Count; i++)
+			Update << Leaves[NextLeave + i];
+		Sent.Leaves.assign(Leaves.begin() + NextLeave, Leaves.begin() + NextLeave + Count);
+		NextLeave += Count;
+		bIsStarted = true;
+		UpdateCount++;
+	};
+
+	const auto Flush = [&]()
+	{
+		if (!bIsStarted)
+			return;
+
+		Connection.InFlight.push_back(std::move(Sent));
+		while (Connection.InFlight.size() > MaxUpdatesInFlight)
+			Connection.InFlight.pop_front();
+		Updates.emplace_back(ID, std::move(Update));
+
+		Update = sArchive();
+		Sent = sUpdate();
+		bIsStarted = false;
+	};
+
+	while (NextLeave < Leaves.size() && UpdateCount < MaxUpdatesPerTick)
+	{
+		// The last one stays open for the objects.
+		Flush();
+		Begin();
+	}
+
+	for (auto It = Connection.Pending.begin(); It != Connection.Pending.end();)
+	{
+		const auto ObjectIt = Objects.find(*It);
+		if (ObjectIt == Objects.end())
+		{
+			It = Connection.Pending.erase(It);
+			continue;
+		}
+
+		// Reported missing, stays pending until its retry.
+		const auto MissingIt = Connection.Missing.find(*It);
+		if (MissingIt != Connection.Missing.end() && TickCounter < MissingIt->second.RetryTick)
+		{
+			++It;
+			continue;
+		}
+
+		const sObject& Object = ObjectIt->second;
+		// Not acknowledged since it entered, it goes even without properties so the client knows it is back.
+		const auto AcknowledgedIt = Connection.Acknowledged.find(*It);
+		const bool bIsEntering = AcknowledgedIt == Connection.Acknowledged.end();
+
+		std::uint64_t Mask = 0;
+		for (std::size_t i = 0; i < Object.Versions.size(); i++)
+		{
+			const std::uint32_t Acknowledged = !bIsEntering && i < AcknowledgedIt->second.size() ? AcknowledgedIt->second[i] : 0;
+			if (Object.Versions[i] > Acknowledged)
+				Mask |= 1ull << i;
+		}
+
+		// Acknowledged up to date, comes back when a property changes.
+		if (Mask == 0 && !bIsEntering)
+		{
+			It = Connection.Pending.erase(It);
+			continue;
+		}
+
+		sArchive Properties;
+		for (std::size_t i = 0; i < Object.Versions.size(); i++)
+		{
+			if (Mask & (1ull << i))
+				Object.Properties->WriteProperty(i, Properties);
+		}
+
+		const std::size_t BlockSize = sizeof(sRPCHandle) + sizeof(Mask) + sizeof(std::uint32_t) + Properties.GetSize();
+		if (!Sent.Objects.empty() && Update.GetSize() + BlockSize > MaxUpdateSize)
+			Flush();
+
+		if (!bIsStarted)
+		{
+			if (UpdateCount >= MaxUpdatesPerTick)
+				break;
+			Begin();
+		}
+
+		Update << *It;
+		Update << Mask;
+		Update << (std::uint32_t)Properties.GetSize();
+		Update.WriteBytes(Properties.GetData().data(), Properties.GetSize());
+
+		sSentObject SentObject;
+		SentObject.Handle = *It;
+		SentObject.Mask = Mask;
+		SentObject.Versions = Object.Versions;
+		Sent.Objects.push_back(std::move(SentObject));
+		++It;
+	}
+
+	Flush();
+}
+
+void ReplicationManager::OnAcknowledged(std::uint32_t ID, std::uint32_t Sequence, const std::vector<sRPCHandle>& Missing)
+{
+	std::lock_guard<std::mutex> locker(Mutex);
+
+	const auto ConnectionIt = Connections.find(ID);
+	if (ConnectionIt == Connections.end())
+		return;
+
+	sConnection& Connection = ConnectionIt->second;
+	const auto UpdateIt = std::find_if(Connection.InFlight.begin(), Connection.InFlight.end(), [Sequence](const sUpdate& Update)
+		{
+			return Update.Sequence == Sequence;
+		});
+	if (UpdateIt == Connection.InFlight.end())
+		return;
+
+	// Sent before the object last entered or left, says nothing about what the client has now.
+	const auto IsStale = [&](const sRPCHandle& Handle)
+	{
+		const auto It = Connection.ChangedAt.find(Handle);
+		return It != Connection.ChangedAt.end() && Sequence < It->second;
+	};
+
+	for (const auto& Handle : UpdateIt->Leaves)
+	{
+		if (!IsStale(Handle) && !Connection.Relevant.contains(Handle))
+			Connection.Leaving.erase(Handle);
+	}
+
+	for (const auto& Sent : UpdateIt->Objects)
+	{
+		if (!Objects.contains(Sent.Handle) || !Connection.Relevant.contains(Sent.Handle) || IsStale(Sent.Handle))
+			continue;
+
+		if (std::find(Missing.begin(), Missing.end(), Sent.Handle) != Missing.end())
+		{
+			// Not spawned there yet, the whole object goes again once the backoff passes.
+			auto& Retry = Connection.Missing[Sent.Handle];
+			Retry.Count = std::min<std::uint32_t>(Retry.Count + 1, 31);
+			Retry.RetryTick = TickCounter + std::min<std::uint64_t>(1ull << Retry.Count, MaxMissingBackoff);
+			Connection.Acknowledged.erase(Sent.Handle);
+			Connection.Pending.insert(Sent.Handle);
+			continue;
+		}
+		Connection.Missing.erase(Sent.Handle);
+
+		auto& Acknowledged = Connection.Acknowledged[Sent.Handle];
+		Acknowledged.resize(Sent.Versions.size(), 0);
+		for (std::size_t i = 0; i < Sent.Versions.size(); i++)
+		{
+			if (Sent.Mask & (1ull << i))
+				Acknowledged[i] = std::max(Acknowledged[i], Sent.Versions[i]);
+		}
+	}
+	Connection.InFlight.erase(UpdateIt);
+}
+
+std::optional<std::uint32_t> ReplicationManager::Apply(const sArchiveView& Update, std::uint32_t LocalAddress, std::uint32_t RemoteAddress, std::vector<sRPCHandle>& Missing)
+{
+	std::vector<sNotification> Notifications;
+	bool bIsDamaged = false;
+
+	Update.ResetPos();
+	Update.ClearFailed();
+	std::uint32_t Sequence = 0;
+	std::uint32_t LeaveCount = 0;
+	Update >> Sequence;
+	Update >> LeaveCount;
+	if (Update.IsFailed())
+		return std::nullopt;
+
+	const auto SwapAddress = [&](const sRPCHandle& Handle)
+	{
+		const std::uint32_t Address = Handle.Address == LocalAddress ? RemoteAddress : Handle.Address == RemoteAddress ? LocalAddress : Handle.Address;
+		return sRPCHandle(Address, Handle.Member);
+	};
+
+	{
+		std::lock_guard<std::mutex> locker(Mutex);
+
+		for (std::uint32_t i = 0; i < LeaveCount; i++)
+		{
+			sRPCHandle Handle;
+			Update >> Handle;
+			if (Update.IsFailed())
+			{
+				bIsDamaged = true;
+				break;
+			}
+
+			const auto It = Objects.find(SwapAddress(Handle));
+			if (It == Objects.end())
+				continue;
+
+			sObject& Object = It->second;
+			if (Sequence <= Object.LastAppliedSequence)
+				continue;
+			Object.LastAppliedSequence = Sequence;
+
+			if (Object.bIsRelevant)
+			{
+				Object.bIsRelevant = false;
+				sNotification Notification;
+				Notification.Properties = Object.Properties;
+				Notification.bIsRelevant = false;
+				Notifications.push_back(Notification);
+			}
+		}
+
+		while (!bIsDamaged && Update.GetRemainingSize() > 0)
+		{
+			sRPCHandle Handle;
+			std::uint64_t Mask = 0;
+			std::uint32_t Size = 0;
+			Update >> Handle;
+			Update >> Mask;
+			Update >> Size;
+			const sArchiveView Block = Update.Consume(Size);
+			if (Update.IsFailed())
+			{
+				bIsDamaged = true;
+				break;
+			}
+
+			const auto It = Objects.find(SwapAddress(Handle));
+			if (It == Objects.end())
+			{
+				Missing.push_back(Handle);
+				continue;
+			}
+
+			// An older update arriving late, the newer one already has these properties.
+			sObject& Object = It->second;
+			if (Sequence <= Object.LastAppliedSequence)
+				continue;
+
+			std::uint64_t Applied = 0;
+			for (std::size_t i = 0; i < Object.Properties->GetPropertyCount(); i++)
+			{
+				if ((Mask & (1ull << i)) == 0)
+					continue;
+				Object.Properties->ReadProperty(i, Block);
+				if (Block.IsFailed())
+					break;
+				Applied |= 1ull << i;
+			}
+
+			if (Block.IsFailed())
+				std::cerr << "Replicated properties of '" << Object.Address << "::" << Object.ClassName << "' are truncated, declarations differ between server and client." << std::endl;
+
+			Object.LastAppliedSequence = Sequence;
+
+			sNotification Notification;
+			Notification.Properties = Object.Properties;
+			Notification.ChangedMask = Applied;
+			if (!Object.bIsRelevant)
+			{
+				Object.bIsRelevant = true;
+				Notification.bIsRelevant = true;
+			}
+			if (Notification.bIsRelevant.has_value() || Applied != 0)
+				Notifications.push_back(Notification);
+		}
+	}
+
+	// Called once the whole update is in, an object can read the others it depends on.
+	Notify(Notifications);
+
+	if (bIsDamaged)
+		return std::nullopt;
+	return Sequence;
+}
+
+void ReplicationManager::Notify(const std::vector<sNotification>& Notifications)
+{
+	for (const auto& Notification : Notifications)
+	{
+		{
+			std::lock_guard<std::mutex> locker(Mutex);
+			if (!Handles.contains(Notification.Properties))
+				continue;
+		}
+		if (Notification.bIsRelevant.has_value() && Notification.Properties->OnRelevancyChanged)
+			Notification.Properties->OnRelevancyChanged(*Notification.bIsRelevant);
+		if (Notification.ChangedMask != 0 && Notification.Properties->OnReplicated)
+			Notification.Properties->OnReplicated(Notification.ChangedMask);
+	}
+}
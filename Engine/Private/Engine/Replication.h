@@ -0,0 +1,226 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <optional>
+#include <functional>
+#include <mutex>
+
+#include "Engine/AbstractEngine.h"
+
+/*
+* Host side dirty tracking and per client deltas for sReplicatedProperties, client side apply.
+* Every property change takes a version from one counter, a client is sent the properties whose version
+* is newer than the one it acknowledged. Updates go unreliable, anything lost stays unacknowledged and is sent again.
+*
+* Interest management : every tick the objects with relevancy bounds go into a grid, each client gets the objects
+* its views overlap. A view is the bounds of an actor the client possesses grown by the relevancy distance, or the
+* camera bounds it reports. Objects leaving the set are sent as leaves until acknowledged, entering ones whole.
+* A client without a view yet gets everything.
+*
+* Update layout : Sequence, leave count and handles, then per object its handle, changed property bits, byte size
+* and the properties in bit order.
+*/
+class ReplicationManager
+{
+	sBaseClassBody(sClassNoDefaults, ReplicationManager);
+private:
+	ReplicationManager();
+	ReplicationManager(const ReplicationManager& Other) = delete;
+	ReplicationManager& operator=(const ReplicationManager&) = delete;
+
+public:
+	static ReplicationManager& Get()
+	{
+		static ReplicationManager instance;
+		return instance;
+	}
+
+	/*
+	* Updates are cut at this size, a larger object goes alone.
+	*/
+	static constexpr std::size_t MaxUpdateSize = 1024;
+	/*
+	* Unacknowledged updates kept per client, newer updates carry everything older ones did.
+	*/
+	static constexpr std::size_t MaxUpdatesInFlight = 64;
+	/*
+	* Half the window, so the updates of one tick are still in flight when their acknowledgements come. The rest waits a tick.
+	*/
+	static constexpr std::size_t MaxUpdatesPerTick = MaxUpdatesInFlight / 2;
+	/*
+	* Grid cell size on X and Y, an object covering more cells than MaxObjectCells is relevant to everyone.
+	*/
+	static constexpr float GridCellSize = 512.0f;
+	static constexpr std::size_t MaxObjectCells = 256;
+	static constexpr std::size_t MaxViewsPerConnection = 8;
+	static constexpr std::size_t MaxLeavesPerUpdate = (MaxUpdateSize - 2 * sizeof(std::uint32_t)) / sizeof(sRPCHandle);
+	/*
+	* An object a client reports missing waits twice as many replication ticks before each resend, up to MaxMissingBackoff.
+	*/
+	static constexpr std::uint32_t MaxMissingBackoff = 64;
+
+	bool Register(const std::string& Address, const std::string& ClassName, sReplicatedProperties* Properties);
+	void Unregister(sReplicatedProperties* Properties);
+
+	/*
+	* Address is the network address of the client's player on the host, objects registered under it are its own.
+	*/
+	void AddConnection(std::uint32_t ID, const std::string& Address);
+	void RemoveConnection(std::uint32_t ID);
+	/*
+	* Drops the clients on the host and the applied sequences on a client, for a new session.
+	*/
+	void ResetSession();
+
+	void SetRate(std::uint32_t UpdatesPerSecond);
+	inline std::uint32_t GetRate() const { return Rate; }
+	void SetRelevancyDistance(float Distance);
+	inline float GetRelevancyDistance() const { return RelevancyDistance; }
+
+	/*
+	* Host, camera bounds a client reported.
+	*/
+	void SetConnectionViews(std::uint32_t ID, std::vector<FBoundingBox> Views);
+	/*
+	* Host, clients the object of an RPC isn't relevant to, for the RPC fan-out to skip.
+	*/
+	std::vector<std::uint32_t> GetIrrelevantConnections(const std::string& Address, const std::string& ClassName);
+
+	/*
+	* Client, views of the local players.
+	*/
+	void SetLocalView(std::size_t PlayerIndex, std::optional<FBoundingBox> Bounds);
+	/*
+	* Client, called every network tick. Send gets Min and Max of each local view at the replication rate when they change,
+	* and once a second regardless since it goes unreliable.
+	*/
+	void SendViews(const double DeltaTime, const std::function<void(const std::vector<FVector>& Views)>& Send);
+
+	/*
+	* Host, called every network tick. Once per replication interval Send gets the updates of each client.
+	*/
+	void Tick(const double DeltaTime, const std::function<void(std::uint32_t ID, const sArchive& Update)>& Send);
+	/*
+	* Host, Missing are objects the client doesn't have yet, they are sent whole again after a backoff.
+	*/
+	void OnAcknowledged(std::uint32_t ID, std::uint32_t Sequence, const std::vector<sRPCHandle>& Missing);
+
+	/*
+	* Client, applies an update in one pass and calls OnRelevancyChanged and OnReplicated of the changed objects after it.
+	* Addresses are swapped like RPC addresses. Returns the sequence to acknowledge, nullopt if the update is damaged.
+	*/
+	std::optional<std::uint32_t> Apply(const sArchiveView& Update, std::uint32_t LocalAddress, std::uint32_t RemoteAddress, std::vector<sRPCHandle>& Missing);
+
+private:
+	struct sObject
+	{
+		std::string Address;
+		std::string ClassName;
+		sReplicatedProperties* Properties = nullptr;
+		std::vector<std::uint32_t> Versions;
+		std::optional<FBoundingBox> Bounds;
+		std::uint32_t LastAppliedSequence = 0;
+		bool bIsRelevant = true;
+	};
+
+	struct sSentObject
+	{
+		sRPCHandle Handle;
+		std::uint64_t Mask = 0;
+		std::vector<std::uint32_t> Versions;
+	};
+
+	struct sUpdate
+	{
+		std::uint32_t Sequence = 0;
+		std::vector<sRPCHandle> Leaves;
+		std::vector<sSentObject> Objects;
+	};
+
+	struct sConnection
+	{
+		std::uint32_t NextSequence = 1;
+		std::uint32_t Address = 0;
+		std::vector<FBoundingBox> Views;
+		/*
+		* A client takes every object as relevant until it gets a leave, so this starts with all of them.
+		*/
+		std::unordered_set<sRPCHandle, sRPCHandleHasher> Relevant;
+		std::unordered_set<sRPCHandle, sRPCHandleHasher> Leaving;
+		/*
+		* Sequence of the first update after an object entered or left, acknowledgements of older ones are stale for it.
+		*/
+		std::unordered_map<sRPCHandle, std::uint32_t, sRPCHandleHasher> ChangedAt;
+		std::unordered_map<sRPCHandle, std::vector<std::uint32_t>, sRPCHandleHasher> Acknowledged;
+		std::unordered_set<sRPCHandle, sRPCHandleHasher> Pending;
+		std::deque<sUpdate> InFlight;
+		/*
+		* Objects the client reported missing, held back until RetryTick. Cleared once the client acknowledges one.
+		*/
+		struct sMissing
+		{
+			std::uint32_t Count = 0;
+			std::uint64_t RetryTick = 0;
+		};
+		std::unordered_map<sRPCHandle, sMissing, sRPCHandleHasher> Missing;
+	};
+
+	struct sNotification
+	{
+		sReplicatedProperties* Properties = nullptr;
+		std::optional<bool> bIsRelevant;
+		std::uint64_t ChangedMask = 0;
+	};
+
+	void CollectDirtyProperties();
+	void UpdateRelevancy();
+	void Notify(const std::vector<sNotification>& Notifications);
+	void WriteUpdates(std::uint32_t ID, sConnection& Connection, std::vector<std::pair<std::uint32_t, sArchive>>& Updates);
+
+private:
+	std::mutex Mutex;
+	std::unordered_map<sRPCHandle, sObject, sRPCHandleHasher> Objects;
+	std::unordered_map<sReplicatedProperties*, sRPCHandle> Handles;
+	std::unordered_map<std::uint32_t, sConnection> Connections;
+	std::uint32_t VersionCounter;
+	std::uint32_t Rate;
+	double Accumulator;
+	std::uint64_t TickCounter;
+	float RelevancyDistance;
+
+	std::map<std::size_t, FBoundingBox> LocalViews;
+	bool bLocalViewsChanged;
+	double ViewAccumulator;
+	double ViewResendTimer;
+};
@@ -29,6 +29,7 @@
 #include "Engine/Box2DRigidBody.h"
 #include <array>
 #include "Gameplay/PhysicalComponent.h"
+#include "Core/Profiler.h"
 
 #define DOWNSCALE PhysicalWorldScale
 #define UPSCALE 1.0f / PhysicalWorldScale
@@ -49,7 +50,7 @@ void sWorld2D::DestructionListener::SayGoodbye(b2Joint* joint)
 class AABBQueryCallback : public b2QueryCallback
 {
 public:
-	std::vector<b2Body*> foundBodies;
+	sFrameVector<b2Body*> foundBodies;
 
 	virtual bool ReportFixture(b2Fixture* fixture) override final
 	{
@@ -164,6 +165,7 @@ sWorld2D::~sWorld2D()
 
 void sWorld2D::Tick(const double InDeltaTime)
 {
+	sProfileFunction;
 	m_pointCount = 0;
 
 	if (InternalTick.has_value())
@@ -344,7 +346,7 @@ sPhysicalComponent* sWorld2D::LineTraceToViewPort(const FVector& InOrigin, const
 	return callback.Body;
 }
 
-std::vector<sPhysicalComponent*> sWorld2D::QueryAABB(const FBoundingBox& Bounds) const
+sFrameVector<sPhysicalComponent*> sWorld2D::QueryAABB(const FBoundingBox& Bounds) const
 {
 	b2AABB aabb;
 	aabb.lowerBound = b2Vec2(Bounds.Min.X * DOWNSCALE, Bounds.Min.Y * DOWNSCALE);
@@ -352,7 +354,8 @@ std::vector<sPhysicalComponent*> sWorld2D::QueryAABB(const FBoundingBox& Bounds)
 
 	AABBQueryCallback callback;
 	m_world->QueryAABB(&callback, aabb);
-	std::vector<sPhysicalComponent*> Objs;
+	sFrameVector<sPhysicalComponent*> Objs;
+	Objs.reserve(callback.foundBodies.size());
 	for (auto& Body : callback.foundBodies)
 	{
 		if (std::find(DeferredDestroyBodyList.begin(), DeferredDestroyBodyList.end(), Body) != DeferredDestroyBodyList.end())
@@ -0,0 +1,504 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "NullCommandBuffer.h"
+#include "NullDevice.h"
+
+void NullCommandRecorder::BeginRecord()
+{
+	CommandStream.clear();
+	CommandCount = 0;
+}
+
+void NullCommandRecorder::Submit()
+{
+	Stats.CommandListsExecuted++;
+	Stats.CommandBytesRecorded += CommandStream.size();
+	if (Owner)
+		Owner->SubmitCommandStats(Stats);
+	Stats.Reset();
+}
+
+void NullCommandRecorder::RecordUpload(const void* Resource, std::size_t Location, std::size_t Size)
+{
+	Stats.BytesUploaded += Size;
+	Record(ENullCommand::eUpdateBuffer, Resource, (std::uint64_t)Location, (std::uint64_t)Size);
+}
+
+NullCommandBuffer::NullCommandBuffer(NullDevice* InDevice)
+	: NullCommandRecorder(InDevice)
+	, StencilRef(0)
+{
+	ResetBindings();
+}
+
+void NullCommandBuffer::ResetBindings()
+{
+	CurrentPipeline = nullptr;
+	CurrentIndexBuffer = nullptr;
+	CurrentVertexBuffers.fill(nullptr);
+	CurrentConstantBuffers.fill(nullptr);
+	CurrentTextures.fill(nullptr);
+}
+
+void NullCommandBuffer::BeginRecordCommandList(const ERenderPass RenderPass)
+{
+	BeginRecord();
+	ResetBindings();
+	Record(ENullCommand::eBeginRecord, RenderPass);
+}
+
+void NullCommandBuffer::ExecuteCommandList()
+{
+	Submit();
+}
+
+void NullCommandBuffer::ClearState()
+{
+	ResetBindings();
+	Record(ENullCommand::eClearState);
+}
+
+void NullCommandBuffer::SetViewport(const sViewport& Viewport)
+{
+	Record(ENullCommand::eSetViewport, Viewport);
+}
+
+void NullCommandBuffer::SetScissorRect(std::uint32_t X, std::uint32_t Y, std::uint32_t Z, std::uint32_t W)
+{
+	Record(ENullCommand::eSetScissorRect, X, Y, Z, W);
+}
+
+void NullCommandBuffer::SetStencilRef(std::uint32_t Ref)
+{
+	StencilRef = Ref;
+	Record(ENullCommand::eSetStencilRef, Ref);
+}
+
+void NullCommandBuffer::ClearFrameBuffer(IFrameBuffer* pFB)
+{
+	Stats.Clears++;
+	Record(ENullCommand::eClear, (const void*)pFB);
+}
+
+void NullCommandBuffer::ClearRenderTarget(IRenderTarget* pRT, IDepthTarget* DepthTarget)
+{
+	Stats.Clears += DepthTarget ? 2 : 1;
+	Record(ENullCommand::eClear, (const void*)pRT, (const void*)DepthTarget);
+}
+
+void NullCommandBuffer::ClearRenderTargets(std::vector<IRenderTarget*> pRTs, IDepthTarget* DepthTarget)
+{
+	for (const auto& RT : pRTs)
+		ClearRenderTarget(RT);
+	if (DepthTarget)
+		ClearDepthTarget(DepthTarget);
+}
+
+void NullCommandBuffer::ClearDepthTarget(IDepthTarget* DepthTarget)
+{
+	Stats.Clears++;
+	Record(ENullCommand::eClear, (const void*)DepthTarget);
+}
+
+void NullCommandBuffer::SetFrameBuffer(IFrameBuffer* pFB, std::optional<std::size_t> FBOIndex)
+{
+	Stats.RenderTargetBinds++;
+	Record(ENullCommand::eSetRenderTargets, (const void*)pFB, (std::uint64_t)FBOIndex.value_or(~std::size_t(0)));
+}
+
+void NullCommandBuffer::SetRenderTarget(IRenderTarget* pRT, IDepthTarget* DepthTarget)
+{
+	Stats.RenderTargetBinds++;
+	Record(ENullCommand::eSetRenderTargets, (const void*)pRT, (const void*)DepthTarget);
+}
+
+void NullCommandBuffer::SetRenderTargets(std::vector<IRenderTarget*> pRTs, IDepthTarget* DepthTarget)
+{
+	Stats.RenderTargetBinds++;
+	Record(ENullCommand::eSetRenderTargets, (std::uint32_t)pRTs.size(), (const void*)DepthTarget);
+}
+
+void NullCommandBuffer::SetFrameBufferAsResource(IFrameBuffer* pFB, std::uint32_t RootParameterIndex)
+{
+	if (!pFB)
+		return;
+	SetRenderTargetsAsResource(pFB->GetRenderTargets(), RootParameterIndex);
+}
+
+void NullCommandBuffer::SetFrameBufferAsResource(IFrameBuffer* pFB, std::uint32_t FBOIndex, std::uint32_t RootParameterIndex)
+{
+	if (!pFB)
+		return;
+	SetRenderTargetAsResource(pFB->GetRenderTarget(FBOIndex), RootParameterIndex);
+}
+
+void NullCommandBuffer::SetRenderTargetAsResource(IRenderTarget* pRT, std::uint32_t RootParameterIndex)
+{
+	Stats.TextureBinds++;
+	Record(ENullCommand::eSetResource, (const void*)pRT, RootParameterIndex);
+}
+
+void NullCommandBuffer::SetRenderTargetsAsResource(std::vector<IRenderTarget*> RTs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < RTs.size(); i++)
+		SetRenderTargetAsResource(RTs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullCommandBuffer::SetUnorderedAccessBufferAsResource(IUnorderedAccessBuffer* pUAV, std::uint32_t RootParameterIndex)
+{
+	Stats.TextureBinds++;
+	Record(ENullCommand::eSetResource, (const void*)pUAV, RootParameterIndex);
+}
+
+void NullCommandBuffer::SetUnorderedAccessBuffersAsResource(std::vector<IUnorderedAccessBuffer*> UAVs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < UAVs.size(); i++)
+		SetUnorderedAccessBufferAsResource(UAVs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullCommandBuffer::CopyFrameBuffer(IFrameBuffer* Dest, std::size_t DestFBOIndex, IFrameBuffer* Source, std::uint32_t SourceFBOIndex)
+{
+	Stats.Copies++;
+	Record(ENullCommand::eCopy, (const void*)Dest, (std::uint64_t)DestFBOIndex, (const void*)Source, SourceFBOIndex);
+}
+
+void NullCommandBuffer::CopyFrameBufferDepth(IFrameBuffer* Dest, IFrameBuffer* Source)
+{
+	Stats.Copies++;
+	Record(ENullCommand::eCopy, (const void*)Dest, (const void*)Source);
+}
+
+void NullCommandBuffer::CopyRenderTarget(IRenderTarget* Dest, IRenderTarget* Source)
+{
+	Stats.Copies++;
+	Record(ENullCommand::eCopy, (const void*)Dest, (const void*)Source);
+}
+
+void NullCommandBuffer::CopyDepthBuffer(IDepthTarget* Dest, IDepthTarget* Source)
+{
+	Stats.Copies++;
+	Record(ENullCommand::eCopy, (const void*)Dest, (const void*)Source);
+}
+
+void NullCommandBuffer::SetPipeline(IPipeline* Pipeline)
+{
+	if (!Bind(CurrentPipeline, Pipeline))
+		Stats.PipelineSwitches++;
+	Record(ENullCommand::eSetPipeline, (const void*)Pipeline);
+}
+
+void NullCommandBuffer::SetVertexBuffer(IVertexBuffer* VB, std::uint32_t Slot)
+{
+	Stats.VertexBufferBinds++;
+	if (Slot < MaxVertexBufferSlots)
+		Bind(CurrentVertexBuffers[Slot], VB);
+	Record(ENullCommand::eSetVertexBuffer, (const void*)VB, Slot);
+}
+
+void NullCommandBuffer::SetIndexBuffer(IIndexBuffer* IB)
+{
+	Stats.IndexBufferBinds++;
+	Bind(CurrentIndexBuffer, IB);
+	Record(ENullCommand::eSetIndexBuffer, (const void*)IB);
+}
+
+void NullCommandBuffer::SetConstantBuffer(IConstantBuffer* CB, std::optional<std::uint32_t> RootParameterIndex)
+{
+	const std::uint32_t Index = RootParameterIndex.has_value() ? RootParameterIndex.value() : CB ? CB->GetDefaultRootParameterIndex() : 0;
+
+	Stats.ConstantBufferBinds++;
+	if (Index < MaxRootParameters)
+		Bind(CurrentConstantBuffers[Index], CB);
+	Record(ENullCommand::eSetConstantBuffer, (const void*)CB, Index);
+}
+
+void NullCommandBuffer::SetTexture2D(ITexture2D* Texture2D, std::optional<std::uint32_t> RootParameterIndex)
+{
+	const std::uint32_t Index = RootParameterIndex.has_value() ? RootParameterIndex.value() : Texture2D ? Texture2D->GetDefaultRootParameterIndex() : 0;
+
+	Stats.TextureBinds++;
+	if (Index < MaxRootParameters)
+		Bind(CurrentTextures[Index], Texture2D);
+	Record(ENullCommand::eSetTexture, (const void*)Texture2D, Index);
+}
+
+void NullCommandBuffer::UpdateBufferSubresource(IVertexBuffer* Buffer, BufferSubresource* Subresource)
+{
+	if (Buffer)
+		Buffer->UpdateSubresource(Subresource, this);
+}
+
+void NullCommandBuffer::UpdateBufferSubresource(IVertexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData)
+{
+	BufferSubresource Subresource(const_cast<void*>(pSrcData), Size, Location);
+	UpdateBufferSubresource(Buffer, &Subresource);
+}
+
+void NullCommandBuffer::UpdateBufferSubresource(IIndexBuffer* Buffer, BufferSubresource* Subresource)
+{
+	if (Buffer)
+		Buffer->UpdateSubresource(Subresource, this);
+}
+
+void NullCommandBuffer::UpdateBufferSubresource(IIndexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData)
+{
+	BufferSubresource Subresource(const_cast<void*>(pSrcData), Size, Location);
+	UpdateBufferSubresource(Buffer, &Subresource);
+}
+
+void NullCommandBuffer::Draw(std::uint32_t VertexCount, std::uint32_t VertexStartOffset)
+{
+	Stats.DrawCalls++;
+	Stats.VerticesDrawn += VertexCount;
+	Stats.InstancesDrawn++;
+	Record(ENullCommand::eDraw, VertexCount, VertexStartOffset);
+}
+
+void NullCommandBuffer::DrawInstanced(std::uint32_t VertexCountPerInstance, std::uint32_t InstanceCount, std::uint32_t StartVertexLocation, std::uint32_t StartInstanceLocation)
+{
+	Stats.DrawCalls++;
+	Stats.VerticesDrawn += (std::uint64_t)VertexCountPerInstance * InstanceCount;
+	Stats.InstancesDrawn += InstanceCount;
+	Record(ENullCommand::eDrawInstanced, VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t IndexCountPerInstance, std::uint32_t InstanceCount, std::uint32_t StartIndexLocation, std::int32_t BaseVertexLocation, std::uint32_t StartInstanceLocation)
+{
+	Stats.DrawCalls++;
+	Stats.VerticesDrawn += (std::uint64_t)IndexCountPerInstance * InstanceCount;
+	Stats.InstancesDrawn += InstanceCount;
+	Record(ENullCommand::eDrawIndexedInstanced, IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(const sObjectDrawParameters& Params)
+{
+	DrawIndexedInstanced(Params.IndexCountPerInstance, Params.InstanceCount, Params.StartIndexLocation, Params.BaseVertexLocation, Params.StartInstanceLocation);
+}
+
+void NullCommandBuffer::ExecuteIndirect(IIndirectBuffer* IndirectBuffer)
+{
+	Stats.DrawCalls++;
+	Record(ENullCommand::eExecuteIndirect, (const void*)IndirectBuffer);
+}
+
+void NullComputeCommandContext::BeginRecordCommandList()
+{
+	BeginRecord();
+	CurrentPipeline = nullptr;
+	Record(ENullCommand::eBeginRecord);
+}
+
+void NullComputeCommandContext::ExecuteCommandList()
+{
+	Submit();
+}
+
+void NullComputeCommandContext::ClearState()
+{
+	CurrentPipeline = nullptr;
+	Record(ENullCommand::eClearState);
+}
+
+void NullComputeCommandContext::RecordResource(const void* Resource, std::uint32_t RootParameterIndex)
+{
+	Stats.TextureBinds++;
+	Record(ENullCommand::eSetResource, Resource, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetFrameBuffer(IFrameBuffer* pFB, std::optional<std::size_t> FBOIndex)
+{
+	Stats.RenderTargetBinds++;
+	Record(ENullCommand::eSetRenderTargets, (const void*)pFB, (std::uint64_t)FBOIndex.value_or(~std::size_t(0)));
+}
+
+void NullComputeCommandContext::SetRenderTargetAsResource(IRenderTarget* pRT, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pRT, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetRenderTargetsAsResource(std::vector<IRenderTarget*> RTs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < RTs.size(); i++)
+		RecordResource(RTs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetDepthTargetAsResource(IDepthTarget* pDT, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pDT, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetDepthTargetsAsResource(std::vector<IDepthTarget*> DTs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < DTs.size(); i++)
+		RecordResource(DTs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessTarget(IUnorderedAccessTarget* pST, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pST, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessTargets(std::vector<IUnorderedAccessTarget*> pSTs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < pSTs.size(); i++)
+		RecordResource(pSTs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetRenderTargetAsUAV(IRenderTarget* pRT, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pRT, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetRenderTargetsAsUAV(std::vector<IRenderTarget*> RTs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < RTs.size(); i++)
+		RecordResource(RTs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessTargetAsSRV(IUnorderedAccessTarget* pST, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pST, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessTargetsAsSRV(std::vector<IUnorderedAccessTarget*> pSTs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < pSTs.size(); i++)
+		RecordResource(pSTs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessBuffer(IUnorderedAccessBuffer* pUAV, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pUAV, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessBuffers(std::vector<IUnorderedAccessBuffer*> UAVs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < UAVs.size(); i++)
+		RecordResource(UAVs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessBufferAsResource(IUnorderedAccessBuffer* pUAV, std::uint32_t RootParameterIndex)
+{
+	RecordResource(pUAV, RootParameterIndex);
+}
+
+void NullComputeCommandContext::SetUnorderedAccessBuffersAsResource(std::vector<IUnorderedAccessBuffer*> UAVs, std::uint32_t RootParameterIndex)
+{
+	for (std::size_t i = 0; i < UAVs.size(); i++)
+		RecordResource(UAVs[i], RootParameterIndex + (std::uint32_t)i);
+}
+
+void NullComputeCommandContext::SetPipeline(IComputePipeline* Pipeline)
+{
+	if (CurrentPipeline == Pipeline)
+	{
+		Stats.RedundantBinds++;
+	}
+	else
+	{
+		CurrentPipeline = Pipeline;
+		Stats.PipelineSwitches++;
+	}
+	Record(ENullCommand::eSetPipeline, (const void*)Pipeline);
+}
+
+void NullComputeCommandContext::SetConstantBuffer(IConstantBuffer* CB, std::optional<std::uint32_t> RootParameterIndex)
+{
+	const std::uint32_t Index = RootParameterIndex.has_value() ? RootParameterIndex.value() : CB ? CB->GetDefaultRootParameterIndex() : 0;
+
+	Stats.ConstantBufferBinds++;
+	Record(ENullCommand::eSetConstantBuffer, (const void*)CB, Index);
+}
+
+void NullComputeCommandContext::Dispatch(std::uint32_t ThreadGroupCountX, std::uint32_t ThreadGroupCountY, std::uint32_t ThreadGroupCountZ)
+{
+	Stats.Dispatches++;
+	Record(ENullCommand::eDispatch, ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
+}
+
+void NullComputeCommandContext::ExecuteIndirect(IIndirectBuffer* IndirectBuffer)
+{
+	Stats.Dispatches++;
+	Record(ENullCommand::eExecuteIndirect, (const void*)IndirectBuffer);
+}
+
+void NullCopyCommandContext::BeginRecordCommandList()
+{
+	BeginRecord();
+	Record(ENullCommand::eBeginRecord);
+}
+
+void NullCopyCommandContext::ExecuteCommandList()
+{
+	Submit();
+}
+
+void NullCopyCommandContext::ClearState()
+{
+	Record(ENullCommand::eClearState);
+}
+
+void NullCopyCommandContext::CopyFrameBuffer(IFrameBuffer* Dest, std::size_t DestFBOIndex, IFrameBuffer* Source, std::uint32_t SourceFBOIndex)
+{
+	Stats.Copies++;
+	Record(ENullCommand::eCopy, (const void*)Dest, (std::uint64_t)DestFBOIndex, (const void*)Source, SourceFBOIndex);
+}
+
+void NullCopyCommandContext::CopyFrameBufferDepth(IFrameBuffer* Dest, IFrameBuffer* Source)
+{
+	Stats.Copies++;
+	Record(ENullCommand::eCopy, (const void*)Dest, (const void*)Source);
+}
+
+void NullCopyCommandContext::UpdateBufferSubresource(IVertexBuffer* Buffer, BufferSubresource* Subresource)
+{
+	if (!Buffer || !Subresource)
+		return;
+	const std::size_t Written = static_cast<NullVertexBuffer*>(Buffer)->Write(Subresource->Location, Subresource->Size, Subresource->pSysMem);
+	RecordUpload(Buffer, Subresource->Location, Written);
+}
+
+void NullCopyCommandContext::UpdateBufferSubresource(IVertexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData)
+{
+	BufferSubresource Subresource(const_cast<void*>(pSrcData), Size, Location);
+	UpdateBufferSubresource(Buffer, &Subresource);
+}
+
+void NullCopyCommandContext::UpdateBufferSubresource(IIndexBuffer* Buffer, BufferSubresource* Subresource)
+{
+	if (!Buffer || !Subresource)
+		return;
+	const std::size_t Written = static_cast<NullIndexBuffer*>(Buffer)->Write(Subresource->Location, Subresource->Size, Subresource->pSysMem);
+	RecordUpload(Buffer, Subresource->Location, Written);
+}
+
+void NullCopyCommandContext::UpdateBufferSubresource(IIndexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData)
+{
+	BufferSubresource Subresource(const_cast<void*>(pSrcData), Size, Location);
+	UpdateBufferSubresource(Buffer, &Subresource);
+}
@@ -0,0 +1,270 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+#include "Engine/AbstractEngine.h"
+#include "NullResources.h"
+
+class NullDevice;
+
+enum class ENullCommand : std::uint8_t
+{
+	eBeginRecord,
+	eClearState,
+	eSetViewport,
+	eSetScissorRect,
+	eSetStencilRef,
+	eClear,
+	eSetRenderTargets,
+	eSetResource,
+	eCopy,
+	eSetPipeline,
+	eSetVertexBuffer,
+	eSetIndexBuffer,
+	eSetConstantBuffer,
+	eSetTexture,
+	eUpdateBuffer,
+	eDraw,
+	eDrawInstanced,
+	eDrawIndexedInstanced,
+	eDispatch,
+	eExecuteIndirect,
+};
+
+/*
+* Shared recording state of the null command contexts.
+* The command stream is a packed sequence of [ENullCommand][payload], payloads are the raw call arguments.
+* Counters stay local to the context until ExecuteCommandList hands them to the device.
+*/
+class NullCommandRecorder
+{
+protected:
+	NullDevice* Owner;
+	std::vector<std::uint8_t> CommandStream;
+	std::size_t CommandCount;
+	sGICommandStats Stats;
+
+	NullCommandRecorder(NullDevice* InDevice)
+		: Owner(InDevice)
+		, CommandCount(0)
+	{}
+
+	template<typename... Args>
+	void Record(const ENullCommand Command, const Args&... Payload)
+	{
+		static_assert((std::is_trivially_copyable_v<Args> && ...), "Null command payloads must be trivially copyable.");
+
+		const std::size_t Offset = CommandStream.size();
+		CommandStream.resize(Offset + sizeof(ENullCommand) + (sizeof(Args) + ... + 0));
+		std::uint8_t* Dest = CommandStream.data() + Offset;
+		*Dest++ = (std::uint8_t)Command;
+		((std::memcpy(Dest, &Payload, sizeof(Args)), Dest += sizeof(Args)), ...);
+		CommandCount++;
+	}
+
+	void BeginRecord();
+	void Submit();
+
+public:
+	virtual ~NullCommandRecorder()
+	{
+		Owner = nullptr;
+	}
+
+	FORCEINLINE const std::vector<std::uint8_t>& GetCommandStream() const { return CommandStream; }
+	FORCEINLINE std::size_t GetCommandCount() const { return CommandCount; }
+	/*
+	* Counters recorded since the last ExecuteCommandList.
+	*/
+	FORCEINLINE const sGICommandStats& GetPendingStats() const { return Stats; }
+
+	void RecordUpload(const void* Resource, std::size_t Location, std::size_t Size);
+};
+
+class NullCommandBuffer final : public NullCommandRecorder, public IGraphicsCommandContext
+{
+	sClassBody(sClassConstructor, NullCommandBuffer, IGraphicsCommandContext)
+public:
+	static constexpr std::size_t MaxVertexBufferSlots = 16;
+	static constexpr std::size_t MaxRootParameters = 32;
+
+public:
+	NullCommandBuffer(NullDevice* InDevice);
+	virtual ~NullCommandBuffer() = default;
+
+	virtual void BeginRecordCommandList(const ERenderPass RenderPass = ERenderPass::eNONE) override final;
+	virtual void FinishRecordCommandList() override final {}
+	virtual void ExecuteCommandList() override final;
+	virtual void ClearState() override final;
+
+	virtual void* GetInternalCommandContext() override final { return this; }
+
+	virtual void SetViewport(const sViewport& Viewport) override final;
+
+	virtual void SetScissorRect(std::uint32_t X, std::uint32_t Y, std::uint32_t Z, std::uint32_t W) override final;
+	virtual void SetStencilRef(std::uint32_t Ref) override final;
+	virtual std::uint32_t GetStencilRef() const override final { return StencilRef; }
+
+	virtual void ClearFrameBuffer(IFrameBuffer* pFB) override final;
+	virtual void ClearRenderTarget(IRenderTarget* pRT, IDepthTarget* DepthTarget = nullptr) override final;
+	virtual void ClearRenderTargets(std::vector<IRenderTarget*> pRTs, IDepthTarget* DepthTarget = nullptr) override final;
+	virtual void ClearDepthTarget(IDepthTarget* DepthTarget) override final;
+	virtual void SetFrameBuffer(IFrameBuffer* pFB, std::optional<std::size_t> FBOIndex = std::nullopt) override final;
+	virtual void SetRenderTarget(IRenderTarget* pRT, IDepthTarget* DepthTarget = nullptr) override final;
+	virtual void SetRenderTargets(std::vector<IRenderTarget*> pRTs, IDepthTarget* DepthTarget = nullptr) override final;
+	virtual void SetFrameBufferAsResource(IFrameBuffer* pFB, std::uint32_t RootParameterIndex) override final;
+	virtual void SetFrameBufferAsResource(IFrameBuffer* pFB, std::uint32_t FBOIndex, std::uint32_t RootParameterIndex) override final;
+	virtual void SetRenderTargetAsResource(IRenderTarget* pRT, std::uint32_t RootParameterIndex) override final;
+	virtual void SetRenderTargetsAsResource(std::vector<IRenderTarget*> RTs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessBufferAsResource(IUnorderedAccessBuffer* pUAV, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessBuffersAsResource(std::vector<IUnorderedAccessBuffer*> UAVs, std::uint32_t RootParameterIndex) override final;
+	virtual void CopyFrameBuffer(IFrameBuffer* Dest, std::size_t DestFBOIndex, IFrameBuffer* Source, std::uint32_t SourceFBOIndex) override final;
+	virtual void CopyFrameBufferDepth(IFrameBuffer* Dest, IFrameBuffer* Source) override final;
+	virtual void CopyRenderTarget(IRenderTarget* Dest, IRenderTarget* Source) override final;
+	virtual void CopyDepthBuffer(IDepthTarget* Dest, IDepthTarget* Source) override final;
+
+	virtual void SetPipeline(IPipeline* Pipeline) override final;
+
+	virtual void SetVertexBuffer(IVertexBuffer* VB, std::uint32_t Slot = 0) override final;
+	virtual void SetIndexBuffer(IIndexBuffer* IB) override final;
+	virtual void SetConstantBuffer(IConstantBuffer* CB, std::optional<std::uint32_t> RootParameterIndex = std::nullopt) override final;
+
+	virtual void SetTexture2D(ITexture2D* Texture2D, std::optional<std::uint32_t> RootParameterIndex = std::nullopt) override final;
+
+	virtual void UpdateBufferSubresource(IVertexBuffer* Buffer, BufferSubresource* Subresource) override final;
+	virtual void UpdateBufferSubresource(IVertexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData) override final;
+	virtual void UpdateBufferSubresource(IIndexBuffer* Buffer, BufferSubresource* Subresource) override final;
+	virtual void UpdateBufferSubresource(IIndexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData) override final;
+
+	virtual void Draw(std::uint32_t VertexCount, std::uint32_t VertexStartOffset = 0) override final;
+	virtual void DrawInstanced(std::uint32_t VertexCountPerInstance, std::uint32_t InstanceCount, std::uint32_t StartVertexLocation, std::uint32_t StartInstanceLocation) override final;
+	virtual void DrawIndexedInstanced(std::uint32_t IndexCountPerInstance, std::uint32_t InstanceCount, std::uint32_t StartIndexLocation, std::int32_t BaseVertexLocation, std::uint32_t StartInstanceLocation) override final;
+	virtual void DrawIndexedInstanced(const sObjectDrawParameters& Params) override final;
+
+	virtual void ExecuteIndirect(IIndirectBuffer* IndirectBuffer) override final;
+
+private:
+	/*
+	* Returns true when Value was already bound to Slot.
+	*/
+	template<typename T>
+	FORCEINLINE bool Bind(T*& Slot, T* Value)
+	{
+		if (Slot == Value)
+		{
+			Stats.RedundantBinds++;
+			return true;
+		}
+		Slot = Value;
+		return false;
+	}
+
+	void ResetBindings();
+
+private:
+	std::uint32_t StencilRef;
+	IPipeline* CurrentPipeline;
+	IIndexBuffer* CurrentIndexBuffer;
+	std::array<IVertexBuffer*, MaxVertexBufferSlots> CurrentVertexBuffers;
+	std::array<IConstantBuffer*, MaxRootParameters> CurrentConstantBuffers;
+	std::array<ITexture2D*, MaxRootParameters> CurrentTextures;
+};
+
+class NullComputeCommandContext final : public NullCommandRecorder, public IComputeCommandContext
+{
+	sClassBody(sClassConstructor, NullComputeCommandContext, IComputeCommandContext)
+public:
+	NullComputeCommandContext(NullDevice* InDevice)
+		: NullCommandRecorder(InDevice)
+		, CurrentPipeline(nullptr)
+	{}
+	virtual ~NullComputeCommandContext() = default;
+
+	virtual void BeginRecordCommandList() override final;
+	virtual void FinishRecordCommandList() override final {}
+	virtual void ExecuteCommandList() override final;
+	virtual void ClearState() override final;
+
+	virtual void* GetInternalCommandContext() override final { return this; }
+
+	virtual void SetFrameBuffer(IFrameBuffer* pFB, std::optional<std::size_t> FBOIndex) override final;
+	virtual void SetRenderTargetAsResource(IRenderTarget* pRT, std::uint32_t RootParameterIndex) override final;
+	virtual void SetRenderTargetsAsResource(std::vector<IRenderTarget*> RTs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetDepthTargetAsResource(IDepthTarget* pDT, std::uint32_t RootParameterIndex) override final;
+	virtual void SetDepthTargetsAsResource(std::vector<IDepthTarget*> DTs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessTarget(IUnorderedAccessTarget* pST, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessTargets(std::vector<IUnorderedAccessTarget*> pSTs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetRenderTargetAsUAV(IRenderTarget* pRT, std::uint32_t RootParameterIndex) override final;
+	virtual void SetRenderTargetsAsUAV(std::vector<IRenderTarget*> RTs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessTargetAsSRV(IUnorderedAccessTarget* pST, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessTargetsAsSRV(std::vector<IUnorderedAccessTarget*> pSTs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessBuffer(IUnorderedAccessBuffer* pUAV, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessBuffers(std::vector<IUnorderedAccessBuffer*> UAVs, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessBufferAsResource(IUnorderedAccessBuffer* pUAV, std::uint32_t RootParameterIndex) override final;
+	virtual void SetUnorderedAccessBuffersAsResource(std::vector<IUnorderedAccessBuffer*> UAVs, std::uint32_t RootParameterIndex) override final;
+
+	virtual void SetPipeline(IComputePipeline* Pipeline) override final;
+	virtual void SetConstantBuffer(IConstantBuffer* CB, std::optional<std::uint32_t> RootParameterIndex = std::nullopt) override final;
+
+	virtual void Dispatch(std::uint32_t ThreadGroupCountX, std::uint32_t ThreadGroupCountY, std::uint32_t ThreadGroupCountZ) override final;
+	virtual void ExecuteIndirect(IIndirectBuffer* IndirectBuffer) override final;
+
+private:
+	void RecordResource(const void* Resource, std::uint32_t RootParameterIndex);
+
+private:
+	IComputePipeline* CurrentPipeline;
+};
+
+class NullCopyCommandContext final : public NullCommandRecorder, public ICopyCommandContext
+{
+	sClassBody(sClassConstructor, NullCopyCommandContext, ICopyCommandContext)
+public:
+	NullCopyCommandContext(NullDevice* InDevice)
+		: NullCommandRecorder(InDevice)
+	{}
+	virtual ~NullCopyCommandContext() = default;
+
+	virtual void BeginRecordCommandList() override final;
+	virtual void FinishRecordCommandList() override final {}
+	virtual void ExecuteCommandList() override final;
+	virtual void ClearState() override final;
+
+	virtual void* GetInternalCommandContext() override final { return this; }
+
+	virtual void CopyFrameBuffer(IFrameBuffer* Dest, std::size_t DestFBOIndex, IFrameBuffer* Source, std::uint32_t SourceFBOIndex) override final;
+	virtual void CopyFrameBufferDepth(IFrameBuffer* Dest, IFrameBuffer* Source) override final;
+
+	virtual void UpdateBufferSubresource(IVertexBuffer* Buffer, BufferSubresource* Subresource) override final;
+	virtual void UpdateBufferSubresource(IVertexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData) override final;
+	virtual void UpdateBufferSubresource(IIndexBuffer* Buffer, BufferSubresource* Subresource) override final;
+	virtual void UpdateBufferSubresource(IIndexBuffer* Buffer, std::size_t Location, std::size_t Size, const void* pSrcData) override final;
+};
@@ -0,0 +1,298 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "NullDevice.h"
+#include "NullCommandBuffer.h"
+#include "NullResources.h"
+#include "AbstractGI/ShaderManager.h"
+
+NullDevice::NullDevice(const GPUDeviceCreateInfo& DeviceCreateInfo)
+	: BackBufferDimension(sScreenDimension(DeviceCreateInfo.Width, DeviceCreateInfo.Height))
+	, bIsFullScreen(DeviceCreateInfo.Fullscreen)
+	, bIsVsyncEnabled(false)
+	, mVsyncInterval(0)
+{}
+
+void NullDevice::InitWindow(void* HWND, std::uint32_t Width, std::uint32_t Height, bool Fullscreen)
+{
+	BackBufferDimension = sScreenDimension(Width, Height);
+	bIsFullScreen = Fullscreen;
+}
+
+void NullDevice::Present(IRenderTarget* pRT)
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	Stats.Presents++;
+}
+
+void NullDevice::ResizeWindow(std::size_t Width, std::size_t Height)
+{
+	BackBufferDimension = sScreenDimension(Width, Height);
+}
+
+std::vector<sDisplayMode> NullDevice::GetAllSupportedResolutions() const
+{
+	sDisplayMode Mode;
+	Mode.Name = std::to_string(BackBufferDimension.Width) + "x" + std::to_string(BackBufferDimension.Height);
+	Mode.Width = (std::uint32_t)BackBufferDimension.Width;
+	Mode.Height = (std::uint32_t)BackBufferDimension.Height;
+	Mode.RefreshRate.Numerator = 60;
+	Mode.RefreshRate.Denominator = 1;
+	return { Mode };
+}
+
+sGPUInfo NullDevice::GetGPUInfo() const
+{
+	sGPUInfo Info;
+	Info.GPUName = "Null Device";
+	Info.SupportedAPI = EGITypes::eNull;
+	return Info;
+}
+
+IShader* NullDevice::CompileShader(const sShaderAttachment& Attachment, bool Spirv)
+{
+	if (Attachment.IsCodeValid())
+		return CompileShader(Attachment.GetByteCode(), Attachment.GetByteCodeSize(), Attachment.FunctionName, Attachment.Type, Spirv, Attachment.ShaderDefines);
+	return CompileShader(Attachment.GetLocation(), Attachment.FunctionName, Attachment.Type, Spirv, Attachment.ShaderDefines);
+}
+
+IShader* NullDevice::CompileShader(std::wstring InSrcFile, std::string InFunctionName, eShaderType InProfile, bool Spirv, std::vector<sShaderDefines> InDefines)
+{
+	if (sShaderManager::Get().IsShaderExist(InSrcFile, InFunctionName))
+		return sShaderManager::Get().GetShader(InSrcFile, InFunctionName);
+
+	IShader::SharedPtr pShader = NullShader::Create(InSrcFile, InFunctionName, InProfile);
+	sShaderManager::Get().StoreShader(pShader);
+	return pShader.get();
+}
+
+IShader* NullDevice::CompileShader(const void* InCode, std::size_t Size, std::string InFunctionName, eShaderType InProfile, bool Spirv, std::vector<sShaderDefines> InDefines)
+{
+	if (sShaderManager::Get().IsShaderExist(L"", InFunctionName))
+		return sShaderManager::Get().GetShader(L"", InFunctionName);
+
+	IShader::SharedPtr pShader = NullShader::Create(L"", InFunctionName, InProfile, InCode, Size);
+	sShaderManager::Get().StoreShader(pShader);
+	return pShader.get();
+}
+
+IGraphicsCommandContext::SharedPtr NullDevice::CreateGraphicsCommandContext()
+{
+	return NullCommandBuffer::Create(this);
+}
+
+IGraphicsCommandContext::UniquePtr NullDevice::CreateUniqueGraphicsCommandContext()
+{
+	return NullCommandBuffer::CreateUnique(this);
+}
+
+IComputeCommandContext::SharedPtr NullDevice::CreateComputeCommandContext()
+{
+	return NullComputeCommandContext::Create(this);
+}
+
+IComputeCommandContext::UniquePtr NullDevice::CreateUniqueComputeCommandContext()
+{
+	return NullComputeCommandContext::CreateUnique(this);
+}
+
+ICopyCommandContext::SharedPtr NullDevice::CreateCopyCommandContext()
+{
+	return NullCopyCommandContext::Create(this);
+}
+
+ICopyCommandContext::UniquePtr NullDevice::CreateUniqueCopyCommandContext()
+{
+	return NullCopyCommandContext::CreateUnique(this);
+}
+
+IConstantBuffer::SharedPtr NullDevice::CreateConstantBuffer(std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex)
+{
+	return NullConstantBuffer::Create(this, InName, InDesc, InRootParameterIndex);
+}
+
+IConstantBuffer::UniquePtr NullDevice::CreateUniqueConstantBuffer(std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex)
+{
+	return NullConstantBuffer::CreateUnique(this, InName, InDesc, InRootParameterIndex);
+}
+
+IVertexBuffer::SharedPtr NullDevice::CreateVertexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
+{
+	return NullVertexBuffer::Create(this, InName, InDesc, InSubresource);
+}
+
+IVertexBuffer::UniquePtr NullDevice::CreateUniqueVertexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
+{
+	return NullVertexBuffer::CreateUnique(this, InName, InDesc, InSubresource);
+}
+
+IIndexBuffer::SharedPtr NullDevice::CreateIndexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
+{
+	return NullIndexBuffer::Create(this, InName, InDesc, InSubresource);
+}
+
+IIndexBuffer::UniquePtr NullDevice::CreateUniqueIndexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource)
+{
+	return NullIndexBuffer::CreateUnique(this, InName, InDesc, InSubresource);
+}
+
+IFrameBuffer::SharedPtr NullDevice::CreateFrameBuffer(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments)
+{
+	return NullFrameBuffer::Create(InName, InAttachments);
+}
+
+IFrameBuffer::UniquePtr NullDevice::CreateUniqueFrameBuffer(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments)
+{
+	return NullFrameBuffer::CreateUnique(InName, InAttachments);
+}
+
+IRenderTarget::SharedPtr NullDevice::CreateRenderTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc)
+{
+	return NullRenderTarget::Create(InName, Format, Desc);
+}
+
+IRenderTarget::UniquePtr NullDevice::CreateUniqueRenderTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc)
+{
+	return NullRenderTarget::CreateUnique(InName, Format, Desc);
+}
+
+IDepthTarget::SharedPtr NullDevice::CreateDepthTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc)
+{
+	return NullDepthTarget::Create(InName, Format, Desc);
+}
+
+IDepthTarget::UniquePtr NullDevice::CreateUniqueDepthTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc)
+{
+	return NullDepthTarget::CreateUnique(InName, Format, Desc);
+}
+
+IUnorderedAccessTarget::SharedPtr NullDevice::CreateUnorderedAccessTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc, bool InEnableSRV)
+{
+	return NullUnorderedAccessTarget::Create(InName, Format, Desc, InEnableSRV);
+}
+
+IUnorderedAccessTarget::UniquePtr NullDevice::CreateUniqueUnorderedAccessTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc, bool InEnableSRV)
+{
+	return NullUnorderedAccessTarget::CreateUnique(InName, Format, Desc, InEnableSRV);
+}
+
+IPipeline::SharedPtr NullDevice::CreatePipeline(const std::string& InName, const sPipelineDesc& InDesc)
+{
+	return NullPipeline::Create(InName, InDesc);
+}
+
+IPipeline::UniquePtr NullDevice::CreateUniquePipeline(const std::string& InName, const sPipelineDesc& InDesc)
+{
+	return NullPipeline::CreateUnique(InName, InDesc);
+}
+
+IComputePipeline::SharedPtr NullDevice::CreateComputePipeline(const std::string& InName, const sComputePipelineDesc& InDesc)
+{
+	return NullComputePipeline::Create(InName, InDesc);
+}
+
+IComputePipeline::UniquePtr NullDevice::CreateUniqueComputePipeline(const std::string& InName, const sComputePipelineDesc& InDesc)
+{
+	return NullComputePipeline::CreateUnique(InName, InDesc);
+}
+
+namespace
+{
+	sTextureDesc GetFileTextureDesc()
+	{
+		sTextureDesc Desc;
+		Desc.Dimensions.X = 1;
+		Desc.Dimensions.Y = 1;
+		Desc.MipLevels = 1;
+		Desc.Format = EFormat::RGBA8_UNORM;
+		return Desc;
+	}
+}
+
+ITexture2D::SharedPtr NullDevice::CreateTexture2D(const std::wstring FilePath, const std::string InName, std::uint32_t DefaultRootParameterIndex)
+{
+	return NullTexture2D::Create(this, FilePath, InName, GetFileTextureDesc(), DefaultRootParameterIndex);
+}
+
+ITexture2D::UniquePtr NullDevice::CreateUniqueTexture2D(const std::wstring FilePath, const std::string InName, std::uint32_t DefaultRootParameterIndex)
+{
+	return NullTexture2D::CreateUnique(this, FilePath, InName, GetFileTextureDesc(), DefaultRootParameterIndex);
+}
+
+ITexture2D::SharedPtr NullDevice::CreateTexture2D(const std::string InName, void* InBuffer, const std::size_t InSize, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
+{
+	if (InBuffer)
+		RecordImmediateUpload(InSize);
+	return NullTexture2D::Create(this, L"", InName, InDesc, DefaultRootParameterIndex);
+}
+
+ITexture2D::UniquePtr NullDevice::CreateUniqueTexture2D(const std::string InName, void* InBuffer, const std::size_t InSize, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
+{
+	if (InBuffer)
+		RecordImmediateUpload(InSize);
+	return NullTexture2D::CreateUnique(this, L"", InName, InDesc, DefaultRootParameterIndex);
+}
+
+ITexture2D::SharedPtr NullDevice::CreateEmptyTexture2D(const std::string InName, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
+{
+	return NullTexture2D::Create(this, L"", InName, InDesc, DefaultRootParameterIndex);
+}
+
+ITexture2D::UniquePtr NullDevice::CreateUniqueEmptyTexture2D(const std::string InName, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex)
+{
+	return NullTexture2D::CreateUnique(this, L"", InName, InDesc, DefaultRootParameterIndex);
+}
+
+sGICommandStats NullDevice::GetCommandStats() const
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	return Stats;
+}
+
+void NullDevice::ResetCommandStats()
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	Stats.Reset();
+}
+
+void NullDevice::SubmitCommandStats(const sGICommandStats& InStats)
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	Stats += InStats;
+}
+
+void NullDevice::RecordImmediateUpload(std::size_t Size)
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	Stats.BytesUploaded += Size;
+}
+
+void NullDevice::RecordImmediateCopy()
+{
+	std::lock_guard<std::mutex> Lock(StatsMutex);
+	Stats.Copies++;
+}
@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include "GI/AbstractGI/AbstractGIDevice.h"
+
+/*
+* CPU-only GI device. Resources live in system memory and command contexts record
+* a compact command stream instead of submitting GPU work, see NullCommandBuffer.
+* Lets sRenderer, sCanvasRenderer, sLineRenderer and the particle renderer run without a GPU
+* while GetCommandStats() reports draws, binds, pipeline switches and uploaded bytes.
+*/
+class NullDevice final : public IAbstractGIDevice
+{
+	sClassBody(sClassConstructor, NullDevice, IAbstractGIDevice)
+public:
+	NullDevice(const GPUDeviceCreateInfo& DeviceCreateInfo);
+	virtual ~NullDevice() = default;
+
+	virtual void InitWindow(void* HWND, std::uint32_t Width, std::uint32_t Height, bool Fullscreen) override final;
+	virtual void BeginFrame() override final {}
+	virtual void Present(IRenderTarget* pRT) override final;
+
+	virtual void* GetInternalDevice() override final { return this; }
+
+	virtual void ResizeWindow(std::size_t Width, std::size_t Height) override final;
+	virtual void FullScreen(const bool value) override final { bIsFullScreen = value; }
+	virtual void Vsync(const bool value) override final { bIsVsyncEnabled = value; }
+	virtual void VsyncInterval(const std::uint32_t value) override final { mVsyncInterval = value; }
+
+	virtual bool IsFullScreen() const override final { return bIsFullScreen; }
+	virtual bool IsVsyncEnabled() const override final { return bIsVsyncEnabled; }
+	virtual std::uint32_t GetVsyncInterval() const override final { return mVsyncInterval; }
+
+	virtual std::vector<sDisplayMode> GetAllSupportedResolutions() const override final;
+
+	virtual EGITypes GetGIType() const override final { return EGITypes::eNull; }
+	virtual sGPUInfo GetGPUInfo() const override final;
+
+	virtual sScreenDimension GetBackBufferDimension() const override final { return BackBufferDimension; }
+	virtual EFormat GetBackBufferFormat() const override final { return EFormat::RGBA8_UNORM; }
+	virtual sViewport GetViewport() const override final { return sViewport(BackBufferDimension); }
+
+	virtual IShader* CompileShader(const sShaderAttachment& Attachment, bool Spirv = false) override final;
+	virtual IShader* CompileShader(std::wstring InSrcFile, std::string InFunctionName, eShaderType InProfile, bool Spirv = false, std::vector<sShaderDefines> InDefines = std::vector<sShaderDefines>()) override final;
+	virtual IShader* CompileShader(const void* InCode, std::size_t Size, std::string InFunctionName, eShaderType InProfile, bool Spirv = false, std::vector<sShaderDefines> InDefines = std::vector<sShaderDefines>()) override final;
+
+	virtual IGraphicsCommandContext::SharedPtr CreateGraphicsCommandContext() override final;
+	virtual IGraphicsCommandContext::UniquePtr CreateUniqueGraphicsCommandContext() override final;
+
+	virtual IComputeCommandContext::SharedPtr CreateComputeCommandContext() override final;
+	virtual IComputeCommandContext::UniquePtr CreateUniqueComputeCommandContext() override final;
+
+	virtual ICopyCommandContext::SharedPtr CreateCopyCommandContext() override final;
+	virtual ICopyCommandContext::UniquePtr CreateUniqueCopyCommandContext() override final;
+
+	virtual IConstantBuffer::SharedPtr CreateConstantBuffer(std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex) override final;
+	virtual IConstantBuffer::UniquePtr CreateUniqueConstantBuffer(std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex) override final;
+
+	virtual IVertexBuffer::SharedPtr CreateVertexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr) override final;
+	virtual IVertexBuffer::UniquePtr CreateUniqueVertexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr) override final;
+
+	virtual IIndexBuffer::SharedPtr CreateIndexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr) override final;
+	virtual IIndexBuffer::UniquePtr CreateUniqueIndexBuffer(std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr) override final;
+
+	virtual IFrameBuffer::SharedPtr CreateFrameBuffer(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments) override final;
+	virtual IFrameBuffer::UniquePtr CreateUniqueFrameBuffer(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments) override final;
+
+	virtual IRenderTarget::SharedPtr CreateRenderTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc) override final;
+	virtual IRenderTarget::UniquePtr CreateUniqueRenderTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc) override final;
+	virtual IDepthTarget::SharedPtr CreateDepthTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc) override final;
+	virtual IDepthTarget::UniquePtr CreateUniqueDepthTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc) override final;
+	virtual IUnorderedAccessTarget::SharedPtr CreateUnorderedAccessTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc, bool InEnableSRV) override final;
+	virtual IUnorderedAccessTarget::UniquePtr CreateUniqueUnorderedAccessTarget(const std::string InName, const EFormat Format, const sFBODesc& Desc, bool InEnableSRV) override final;
+
+	virtual IPipeline::SharedPtr CreatePipeline(const std::string& InName, const sPipelineDesc& InDesc) override final;
+	virtual IPipeline::UniquePtr CreateUniquePipeline(const std::string& InName, const sPipelineDesc& InDesc) override final;
+
+	virtual IComputePipeline::SharedPtr CreateComputePipeline(const std::string& InName, const sComputePipelineDesc& InDesc) override final;
+	virtual IComputePipeline::UniquePtr CreateUniqueComputePipeline(const std::string& InName, const sComputePipelineDesc& InDesc) override final;
+
+	virtual ITexture2D::SharedPtr CreateTexture2D(const std::wstring FilePath, const std::string InName, std::uint32_t DefaultRootParameterIndex = 0) override final;
+	virtual ITexture2D::UniquePtr CreateUniqueTexture2D(const std::wstring FilePath, const std::string InName, std::uint32_t DefaultRootParameterIndex = 0) override final;
+	virtual ITexture2D::SharedPtr CreateTexture2D(const std::string InName, void* InBuffer, const std::size_t InSize, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex = 0) override final;
+	virtual ITexture2D::UniquePtr CreateUniqueTexture2D(const std::string InName, void* InBuffer, const std::size_t InSize, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex = 0) override final;
+
+	virtual ITexture2D::SharedPtr CreateEmptyTexture2D(const std::string InName, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex = 0) override final;
+	virtual ITexture2D::UniquePtr CreateUniqueEmptyTexture2D(const std::string InName, const sTextureDesc& InDesc, std::uint32_t DefaultRootParameterIndex = 0) override final;
+
+	/*
+	* Counters of every executed command list plus uploads made outside a command list.
+	*/
+	sGICommandStats GetCommandStats() const;
+	void ResetCommandStats();
+
+	/*
+	* Called by the command contexts on ExecuteCommandList and by resources updated without a command context.
+	*/
+	void SubmitCommandStats(const sGICommandStats& InStats);
+	void RecordImmediateUpload(std::size_t Size);
+	void RecordImmediateCopy();
+
+private:
+	sScreenDimension BackBufferDimension;
+	bool bIsFullScreen;
+	bool bIsVsyncEnabled;
+	std::uint32_t mVsyncInterval;
+
+	mutable std::mutex StatsMutex;
+	sGICommandStats Stats;
+};
@@ -0,0 +1,211 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#include "pch.h"
+#include "NullResources.h"
+#include "NullDevice.h"
+#include "NullCommandBuffer.h"
+#include <algorithm>
+
+namespace
+{
+	void RecordUpload(NullDevice* Owner, const void* Resource, std::size_t Location, std::size_t Size, IGraphicsCommandContext* InCMDBuffer)
+	{
+		if (InCMDBuffer)
+			static_cast<NullCommandBuffer*>(InCMDBuffer)->RecordUpload(Resource, Location, Size);
+		else if (Owner)
+			Owner->RecordImmediateUpload(Size);
+	}
+}
+
+NullBuffer::NullBuffer(NullDevice* InDevice, const BufferLayout& InDesc, BufferSubresource* InSubresource)
+	: Owner(InDevice)
+	, BufferDesc(InDesc)
+	, Data((std::size_t)InDesc.Size, 0)
+{
+	if (InSubresource && InSubresource->pSysMem)
+	{
+		const std::size_t Written = Write(InSubresource->Location, InSubresource->Size, InSubresource->pSysMem);
+		if (Owner)
+			Owner->RecordImmediateUpload(Written);
+	}
+}
+
+std::size_t NullBuffer::Write(std::size_t Location, std::size_t Size, const void* pSrcData)
+{
+	if (!pSrcData || Location >= Data.size())
+		return 0;
+
+	const std::size_t Count = std::min(Size, Data.size() - Location);
+	std::memcpy(Data.data() + Location, pSrcData, Count);
+	return Count;
+}
+
+void NullConstantBuffer::Map(const void* Ptr, IGraphicsCommandContext* InCMDBuffer)
+{
+	const std::size_t Written = Write(0, Data.size(), Ptr);
+	RecordUpload(Owner, static_cast<IConstantBuffer*>(this), 0, Written, InCMDBuffer);
+}
+
+void NullVertexBuffer::UpdateSubresource(BufferSubresource* Subresource, IGraphicsCommandContext* InCMDBuffer)
+{
+	if (!Subresource)
+		return;
+
+	const std::size_t Written = Write(Subresource->Location, Subresource->Size, Subresource->pSysMem);
+	RecordUpload(Owner, static_cast<IVertexBuffer*>(this), Subresource->Location, Written, InCMDBuffer);
+}
+
+void NullIndexBuffer::UpdateSubresource(BufferSubresource* Subresource, IGraphicsCommandContext* InCMDBuffer)
+{
+	if (!Subresource)
+		return;
+
+	const std::size_t Written = Write(Subresource->Location, Subresource->Size, Subresource->pSysMem);
+	RecordUpload(Owner, static_cast<IIndexBuffer*>(this), Subresource->Location, Written, InCMDBuffer);
+}
+
+NullFrameBuffer::NullFrameBuffer(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments)
+	: AttachmentInfo(InAttachments)
+	, Name(InName)
+{
+	const auto& FDesc = AttachmentInfo.Desc;
+
+	for (const auto& FB : AttachmentInfo.FrameBuffer)
+	{
+		switch (FB.AttachmentType)
+		{
+		case eFrameBufferAttachmentType::eUAV:
+		case eFrameBufferAttachmentType::eUAV_SRV:
+			UAVs.push_back(NullUnorderedAccessTarget::Create(Name + "_UAV_" + std::to_string(UAVs.size()), FB.Format, FDesc, FB.AttachmentType == eFrameBufferAttachmentType::eUAV_SRV));
+			break;
+		case eFrameBufferAttachmentType::eRT:
+		case eFrameBufferAttachmentType::eRT_SRV:
+		case eFrameBufferAttachmentType::eRT_UAV:
+		case eFrameBufferAttachmentType::eRT_SRV_UAV:
+		{
+			const bool bSRV = FB.AttachmentType == eFrameBufferAttachmentType::eRT_SRV || FB.AttachmentType == eFrameBufferAttachmentType::eRT_SRV_UAV;
+			const bool bUAV = FB.AttachmentType == eFrameBufferAttachmentType::eRT_UAV || FB.AttachmentType == eFrameBufferAttachmentType::eRT_SRV_UAV;
+			RenderTargets.push_back(NullRenderTarget::Create(Name + "_RenderTarget_" + std::to_string(RenderTargets.size()), FB.Format, FDesc, bSRV, bUAV));
+		}
+		break;
+		default:
+			break;
+		}
+	}
+
+	if (IsValidDepthFormat(AttachmentInfo.DepthFormat))
+		DepthTarget = NullDepthTarget::Create(Name + "_DepthTarget", AttachmentInfo.DepthFormat, FDesc);
+}
+
+std::vector<IRenderTarget*> NullFrameBuffer::GetRenderTargets() const
+{
+	std::vector<IRenderTarget*> Result;
+	Result.reserve(RenderTargets.size());
+	std::transform(RenderTargets.cbegin(), RenderTargets.cend(), std::back_inserter(Result), [](auto& ptr) { return ptr.get(); });
+	return Result;
+}
+
+std::vector<IUnorderedAccessTarget*> NullFrameBuffer::GetUnorderedAccessTargets() const
+{
+	std::vector<IUnorderedAccessTarget*> Result;
+	Result.reserve(UAVs.size());
+	std::transform(UAVs.cbegin(), UAVs.cend(), std::back_inserter(Result), [](auto& ptr) { return ptr.get(); });
+	return Result;
+}
+
+void NullFrameBuffer::AttachRenderTarget(const IRenderTarget::SharedPtr& RenderTarget, std::optional<std::size_t> Index)
+{
+	if (auto RT = std::dynamic_pointer_cast<NullRenderTarget>(RenderTarget))
+	{
+		const eFrameBufferAttachmentType AttachmentType = RT->IsSRV_Allowed() ? (RT->IsUAV_Allowed() ? eFrameBufferAttachmentType::eRT_SRV_UAV : eFrameBufferAttachmentType::eRT_SRV)
+			: (RT->IsUAV_Allowed() ? eFrameBufferAttachmentType::eRT_UAV : eFrameBufferAttachmentType::eRT);
+
+		if (Index.has_value())
+		{
+			RenderTargets.insert(RenderTargets.begin() + Index.value(), RT);
+			AttachmentInfo.FrameBuffer.insert(AttachmentInfo.FrameBuffer.begin() + Index.value(), sFrameBufferAttachmentInfo::sFrameBuffer(RT->GetFormat(), AttachmentType));
+		}
+		else
+		{
+			RenderTargets.push_back(RT);
+			AttachmentInfo.AddFrameBuffer(RT->GetFormat(), AttachmentType);
+		}
+	}
+}
+
+void NullFrameBuffer::AttachUnorderedAccessTarget(const IUnorderedAccessTarget::SharedPtr& UnorderedAccessTarget, std::optional<std::size_t> Index)
+{
+	if (auto ST = std::dynamic_pointer_cast<NullUnorderedAccessTarget>(UnorderedAccessTarget))
+	{
+		const eFrameBufferAttachmentType AttachmentType = ST->IsSRV_Allowed() ? eFrameBufferAttachmentType::eUAV_SRV : eFrameBufferAttachmentType::eUAV;
+
+		if (Index.has_value())
+		{
+			UAVs.insert(UAVs.begin() + Index.value(), ST);
+			AttachmentInfo.FrameBuffer.insert(AttachmentInfo.FrameBuffer.begin() + Index.value(), sFrameBufferAttachmentInfo::sFrameBuffer(ST->GetFormat(), AttachmentType));
+		}
+		else
+		{
+			UAVs.push_back(ST);
+			AttachmentInfo.AddFrameBuffer(ST->GetFormat(), AttachmentType);
+		}
+	}
+}
+
+void NullFrameBuffer::SetDepthTarget(const IDepthTarget::SharedPtr& InDepthTarget)
+{
+	if (auto DT = std::dynamic_pointer_cast<NullDepthTarget>(InDepthTarget))
+	{
+		DepthTarget = DT;
+		AttachmentInfo.DepthFormat = DepthTarget->GetFormat();
+	}
+}
+
+void NullTexture2D::UpdateTexture(ITexture2D* SourceTexture, std::size_t SourceArrayIndex, std::size_t ArrayIndex, const std::optional<IntVector2> Dest, const std::optional<FBounds2D> TargetBounds)
+{
+	if (Owner && SourceTexture)
+		Owner->RecordImmediateCopy();
+}
+
+void NullTexture2D::UpdateTexture(const std::wstring FilePath, std::size_t ArrayIndex, const std::optional<IntVector2> Dest, const std::optional<FBounds2D> TargetBounds)
+{
+	Path = FilePath;
+}
+
+void NullTexture2D::UpdateTexture(const void* pSrcData, const std::size_t InSize, const FDimension2D& Dimension, std::size_t ArrayIndex, const std::optional<IntVector2> Dest, const std::optional<FBounds2D> TargetBounds)
+{
+	if (Owner && pSrcData)
+		Owner->RecordImmediateUpload(InSize);
+}
+
+void NullTexture2D::UpdateTexture(const void* pSrcData, std::size_t RowPitch, std::size_t MinX, std::size_t MinY, std::size_t MaxX, std::size_t MaxY, IGraphicsCommandContext* InCommandBuffer)
+{
+	if (!pSrcData || MaxY <= MinY)
+		return;
+
+	RecordUpload(Owner, static_cast<ITexture2D*>(this), MinY * RowPitch, (MaxY - MinY) * RowPitch, InCommandBuffer);
+}
@@ -0,0 +1,369 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Engine/ClassBody.h"
+#include "Engine/AbstractEngine.h"
+
+class NullDevice;
+
+/*
+* CPU copy of a buffer. Uploads are memcpy'd into Data and counted on the owning device
+* or on the command context passed with the upload.
+*/
+class NullBuffer
+{
+protected:
+	NullDevice* Owner;
+	BufferLayout BufferDesc;
+	std::vector<std::uint8_t> Data;
+
+	NullBuffer(NullDevice* InDevice, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr);
+
+public:
+	virtual ~NullBuffer()
+	{
+		Owner = nullptr;
+		Data.clear();
+	}
+
+	NullDevice* GetOwner() const { return Owner; }
+	FORCEINLINE BufferLayout GetBufferDesc() const { return BufferDesc; }
+	FORCEINLINE const std::vector<std::uint8_t>& GetData() const { return Data; }
+
+	/*
+	* Returns the number of bytes written.
+	*/
+	std::size_t Write(std::size_t Location, std::size_t Size, const void* pSrcData);
+};
+
+class NullConstantBuffer final : public NullBuffer, public IConstantBuffer
+{
+	sClassBody(sClassConstructor, NullConstantBuffer, IConstantBuffer)
+private:
+	std::uint32_t RootParameterIndex;
+	std::string Name;
+
+public:
+	NullConstantBuffer(NullDevice* InDevice, std::string InName, const BufferLayout& InDesc, std::uint32_t InRootParameterIndex)
+		: NullBuffer(InDevice, InDesc)
+		, RootParameterIndex(InRootParameterIndex)
+		, Name(InName)
+	{}
+
+	virtual ~NullConstantBuffer() = default;
+
+	FORCEINLINE virtual std::string GetName() const override final { return Name; };
+
+	virtual void SetDefaultRootParameterIndex(std::uint32_t InRootParameterIndex) override final { RootParameterIndex = InRootParameterIndex; }
+	virtual std::uint32_t GetDefaultRootParameterIndex() const override final { return RootParameterIndex; }
+
+	virtual void Map(const void* Ptr, IGraphicsCommandContext* InCMDBuffer = nullptr) override final;
+};
+
+class NullVertexBuffer final : public NullBuffer, public IVertexBuffer
+{
+	sClassBody(sClassConstructor, NullVertexBuffer, IVertexBuffer)
+private:
+	std::string Name;
+
+public:
+	NullVertexBuffer(NullDevice* InDevice, std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr)
+		: NullBuffer(InDevice, InDesc, InSubresource)
+		, Name(InName)
+	{}
+
+	virtual ~NullVertexBuffer() = default;
+
+	FORCEINLINE virtual std::string GetName() const override final { return Name; };
+
+	virtual std::size_t GetSize() const override final { return BufferDesc.Size; }
+	virtual bool IsMapable() const override final { return true; }
+	virtual void UpdateSubresource(BufferSubresource* Subresource, IGraphicsCommandContext* InCMDBuffer = nullptr) override final;
+};
+
+class NullIndexBuffer final : public NullBuffer, public IIndexBuffer
+{
+	sClassBody(sClassConstructor, NullIndexBuffer, IIndexBuffer)
+private:
+	std::string Name;
+
+public:
+	NullIndexBuffer(NullDevice* InDevice, std::string InName, const BufferLayout& InDesc, BufferSubresource* InSubresource = nullptr)
+		: NullBuffer(InDevice, InDesc, InSubresource)
+		, Name(InName)
+	{}
+
+	virtual ~NullIndexBuffer() = default;
+
+	FORCEINLINE virtual std::string GetName() const override final { return Name; };
+
+	virtual std::size_t GetSize() const override final { return BufferDesc.Size; }
+	virtual bool IsMapable() const override final { return true; }
+	virtual void UpdateSubresource(BufferSubresource* Subresource, IGraphicsCommandContext* InCMDBuffer = nullptr) override final;
+};
+
+class NullRenderTarget final : public IRenderTarget
+{
+	sClassBody(sClassConstructor, NullRenderTarget, IRenderTarget)
+public:
+	NullRenderTarget(const std::string InName, const EFormat InFormat, const sFBODesc& InDesc, bool InIsSRVAllowed = true, bool InIsUnorderedAccessAllowed = false)
+		: Name(InName)
+		, Format(InFormat)
+		, Desc(InDesc)
+		, bIsSRVAllowed(InIsSRVAllowed)
+		, bIsUAVAllowed(InIsUnorderedAccessAllowed)
+	{}
+	virtual ~NullRenderTarget() = default;
+
+	virtual void* GetNativeTexture() const override final { return nullptr; }
+
+	virtual void SetDefaultRootParameterIndex(std::uint32_t RootParameterIndex) override final {}
+	virtual std::uint32_t GetDefaultRootParameterIndex() const override final { return 0; }
+
+	virtual bool IsSRV_Allowed() const override final { return bIsSRVAllowed; }
+	virtual bool IsUAV_Allowed() const override final { return bIsUAVAllowed; }
+
+	EFormat GetFormat() const { return Format; }
+	sFBODesc GetDesc() const { return Desc; }
+
+private:
+	std::string Name;
+	EFormat Format;
+	sFBODesc Desc;
+	bool bIsSRVAllowed;
+	bool bIsUAVAllowed;
+};
+
+class NullDepthTarget final : public IDepthTarget
+{
+	sClassBody(sClassConstructor, NullDepthTarget, IDepthTarget)
+public:
+	NullDepthTarget(const std::string InName, const EFormat InFormat, const sFBODesc& InDesc)
+		: Name(InName)
+		, Format(InFormat)
+		, Desc(InDesc)
+	{}
+	virtual ~NullDepthTarget() = default;
+
+	virtual void* GetNativeTexture() const override final { return nullptr; }
+
+	virtual void SetDefaultRootParameterIndex(std::uint32_t RootParameterIndex) override final {}
+	virtual std::uint32_t GetDefaultRootParameterIndex() const override final { return 0; }
+
+	virtual bool IsSRV_Allowed() const override final { return true; }
+	virtual bool IsUAV_Allowed() const override final { return false; }
+
+	EFormat GetFormat() const { return Format; }
+
+private:
+	std::string Name;
+	EFormat Format;
+	sFBODesc Desc;
+};
+
+class NullUnorderedAccessTarget final : public IUnorderedAccessTarget
+{
+	sClassBody(sClassConstructor, NullUnorderedAccessTarget, IUnorderedAccessTarget)
+public:
+	NullUnorderedAccessTarget(const std::string InName, const EFormat InFormat, const sFBODesc& InDesc, bool InEnableSRV = true)
+		: Name(InName)
+		, Format(InFormat)
+		, Desc(InDesc)
+		, bIsSRVAllowed(InEnableSRV)
+	{}
+	virtual ~NullUnorderedAccessTarget() = default;
+
+	virtual void* GetNativeTexture() const override final { return nullptr; }
+
+	virtual void SetDefaultRootParameterIndex(std::uint32_t RootParameterIndex) override final {}
+	virtual std::uint32_t GetDefaultRootParameterIndex() const override final { return 0; }
+
+	virtual bool IsSRV_Allowed() const override final { return bIsSRVAllowed; }
+
+	EFormat GetFormat() const { return Format; }
+
+private:
+	std::string Name;
+	EFormat Format;
+	sFBODesc Desc;
+	bool bIsSRVAllowed;
+};
+
+class NullFrameBuffer final : public IFrameBuffer
+{
+	sClassBody(sClassConstructor, NullFrameBuffer, IFrameBuffer)
+private:
+	sFrameBufferAttachmentInfo AttachmentInfo;
+	std::string Name;
+
+	std::vector<NullRenderTarget::SharedPtr> RenderTargets;
+	std::vector<NullUnorderedAccessTarget::SharedPtr> UAVs;
+	NullDepthTarget::SharedPtr DepthTarget;
+
+public:
+	NullFrameBuffer(const std::string InName, const sFrameBufferAttachmentInfo& InAttachments);
+
+	virtual ~NullFrameBuffer()
+	{
+		RenderTargets.clear();
+		UAVs.clear();
+		DepthTarget = nullptr;
+	}
+
+	virtual std::string GetName() const override final { return Name; }
+	virtual sFrameBufferAttachmentInfo GetAttachmentInfo() const override final { return AttachmentInfo; }
+	virtual std::size_t GetAttachmentCount() const override final { return AttachmentInfo.GetAttachmentCount(); }
+	virtual std::size_t GetRenderTargetAttachmentCount() const override final { return AttachmentInfo.GetRenderTargetAttachmentCount(); }
+
+	virtual std::vector<IRenderTarget*> GetRenderTargets() const override final;
+	virtual IRenderTarget* GetRenderTarget(std::size_t Index) const override final { return RenderTargets.at(Index).get(); }
+	virtual void AttachRenderTarget(const IRenderTarget::SharedPtr& RenderTarget, std::optional<std::size_t> Index = std::nullopt) override final;
+
+	virtual std::vector<IUnorderedAccessTarget*> GetUnorderedAccessTargets() const override final;
+	virtual IUnorderedAccessTarget* GetUnorderedAccessTarget(std::size_t Index) const override final { return UAVs.at(Index).get(); }
+	virtual void AttachUnorderedAccessTarget(const IUnorderedAccessTarget::SharedPtr& UnorderedAccessTarget, std::optional<std::size_t> Index = std::nullopt) override final;
+
+	virtual IDepthTarget* GetDepthTarget() const override final { return DepthTarget.get(); }
+	virtual void SetDepthTarget(const IDepthTarget::SharedPtr& DepthTarget) override final;
+};
+
+class NullShader final : public IShader
+{
+	sClassBody(sClassConstructor, NullShader, IShader)
+public:
+	NullShader(std::wstring InPath, std::string InFunctionName, eShaderType InType, const void* InCode = nullptr, std::size_t InSize = 0)
+		: Path(InPath)
+		, FunctionName(InFunctionName)
+		, ShaderType(InType)
+		, ByteCode(InCode ? std::vector<std::uint8_t>((const std::uint8_t*)InCode, (const std::uint8_t*)InCode + InSize) : std::vector<std::uint8_t>())
+	{}
+	virtual ~NullShader() = default;
+
+	virtual std::string GetName() const override final { return FunctionName; }
+	virtual std::wstring GetPath() const override final { return Path; }
+	virtual eShaderType Type() const override final { return ShaderType; }
+	virtual void* GetByteCode() const override final { return ByteCode.empty() ? nullptr : (void*)ByteCode.data(); }
+	virtual std::uint32_t GetByteCodeSize() const override final { return (std::uint32_t)ByteCode.size(); }
+
+private:
+	std::wstring Path;
+	std::string FunctionName;
+	eShaderType ShaderType;
+	std::vector<std::uint8_t> ByteCode;
+};
+
+class NullPipeline final : public IPipeline
+{
+	sClassBody(sClassConstructor, NullPipeline, IPipeline)
+public:
+	NullPipeline(const std::string& InName, const sPipelineDesc& InDesc)
+		: Name(InName)
+		, Desc(InDesc)
+		, bIsCompiled(false)
+	{}
+	virtual ~NullPipeline() = default;
+
+	virtual sPipelineDesc GetPipelineDesc() const override final { return Desc; }
+	virtual bool IsCompiled() const override final { return bIsCompiled; }
+	virtual bool Compile(IFrameBuffer* FrameBuffer = nullptr) override final { bIsCompiled = true; return true; }
+	virtual bool Compile(IRenderTarget* RT, IDepthTarget* Depth = nullptr) override final { bIsCompiled = true; return true; }
+	virtual bool Compile(std::vector<IRenderTarget*> RTs, IDepthTarget* Depth = nullptr) override final { bIsCompiled = true; return true; }
+	virtual bool Recompile() override final { bIsCompiled = true; return true; }
+
+	std::string GetName() const { return Name; }
+
+private:
+	std::string Name;
+	sPipelineDesc Desc;
+	bool bIsCompiled;
+};
+
+class NullComputePipeline final : public IComputePipeline
+{
+	sClassBody(sClassConstructor, NullComputePipeline, IComputePipeline)
+public:
+	NullComputePipeline(const std::string& InName, const sComputePipelineDesc& InDesc)
+		: Name(InName)
+		, Desc(InDesc)
+	{}
+	virtual ~NullComputePipeline() = default;
+
+	virtual sComputePipelineDesc GetPipelineDesc() const override final { return Desc; }
+	virtual bool Recompile() override final { return true; }
+
+	std::string GetName() const { return Name; }
+
+private:
+	std::string Name;
+	sComputePipelineDesc Desc;
+};
+
+/*
+* Texture contents are not kept, only the description. Uploads are counted as BytesUploaded.
+* Textures loaded from a file report a 1x1 RGBA8 description since nothing is decoded.
+*/
+class NullTexture2D final : public ITexture2D
+{
+	sClassBody(sClassConstructor, NullTexture2D, ITexture2D)
+public:
+	NullTexture2D(NullDevice* InDevice, const std::wstring InPath, const std::string InName, const sTextureDesc& InDesc, std::uint32_t InRootParameterIndex = 0)
+		: Owner(InDevice)
+		, Path(InPath)
+		, Name(InName)
+		, Desc(InDesc)
+		, RootParameterIndex(InRootParameterIndex)
+	{}
+	virtual ~NullTexture2D()
+	{
+		Owner = nullptr;
+	}
+
+	virtual std::wstring GetPath() const override final { return Path; }
+	virtual std::string GetName() const override final { return Name; }
+
+	virtual sTextureDesc GetDesc() const override final { return Desc; }
+
+	virtual void SetDefaultRootParameterIndex(std::uint32_t InRootParameterIndex) override final { RootParameterIndex = InRootParameterIndex; }
+	virtual std::uint32_t GetDefaultRootParameterIndex() const override final { return RootParameterIndex; }
+
+	virtual void UpdateTexture(ITexture2D* SourceTexture, std::size_t SourceArrayIndex, std::size_t ArrayIndex, const std::optional<IntVector2> Dest = std::nullopt, const std::optional<FBounds2D> TargetBounds = std::nullopt) override final;
+	virtual void UpdateTexture(const std::wstring FilePath, std::size_t ArrayIndex, const std::optional<IntVector2> Dest = std::nullopt, const std::optional<FBounds2D> TargetBounds = std::nullopt) override final;
+	virtual void UpdateTexture(const void* pSrcData, const std::size_t InSize, const FDimension2D& Dimension, std::size_t ArrayIndex, const std::optional<IntVector2> Dest = std::nullopt, const std::optional<FBounds2D> TargetBounds = std::nullopt) override final;
+	virtual void UpdateTexture(const void* pSrcData, std::size_t RowPitch, std::size_t MinX, std::size_t MinY, std::size_t MaxX, std::size_t MaxY, IGraphicsCommandContext* InCommandBuffer = nullptr) override final;
+
+	virtual void SaveToFile(std::wstring InPath) const override final {}
+
+private:
+	NullDevice* Owner;
+	std::wstring Path;
+	std::string Name;
+	sTextureDesc Desc;
+	std::uint32_t RootParameterIndex;
+};
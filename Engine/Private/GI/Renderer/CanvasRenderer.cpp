@@ -295,8 +295,8 @@ void sCanvasRenderer::Render(ICanvas* Canvas, IRenderTarget* pFB, std::optional<
 {
 	using namespace cbgui;
 
-	std::vector<ICanvas::WidgetHierarchy*> DrawLatest;
-	std::vector<ICanvas::WidgetHierarchy*> LastInTheHierarchy;
+	sFrameVector<ICanvas::WidgetHierarchy*> DrawLatest;
+	sFrameVector<ICanvas::WidgetHierarchy*> LastInTheHierarchy;
 
 	std::function<void(IRenderTarget* pFB, IVertexBuffer*, IIndexBuffer*, ICanvas::WidgetHierarchy*, std::optional<cbgui::cbIntBounds>, const sViewport&, const eZOrderMode&)> fDraw;
 	fDraw = [&](IRenderTarget* pFB, IVertexBuffer* VertexBuffer, IIndexBuffer* IndexBuffer, ICanvas::WidgetHierarchy* Node, std::optional<cbgui::cbIntBounds> ScissorsRect, const sViewport& VP, const eZOrderMode& Mode) -> void
@@ -406,8 +406,8 @@ void sCanvasRenderer::Render(const std::vector<ICanvas*>& Canvases, IRenderTarge
 {
 	using namespace cbgui;
 
-	std::vector<ICanvas::WidgetHierarchy*> DrawLatest;
-	std::vector<ICanvas::WidgetHierarchy*> LastInTheHierarchy;
+	sFrameVector<ICanvas::WidgetHierarchy*> DrawLatest;
+	sFrameVector<ICanvas::WidgetHierarchy*> LastInTheHierarchy;
 
 	std::function<void(IRenderTarget* pFB, IVertexBuffer*, IIndexBuffer*, ICanvas::WidgetHierarchy*, std::optional<cbgui::cbIntBounds>, const sViewport&, const eZOrderMode&)> fDraw;
 	fDraw = [&](IRenderTarget* pFB, IVertexBuffer* VertexBuffer, IIndexBuffer* IndexBuffer, ICanvas::WidgetHierarchy* Node, std::optional<cbgui::cbIntBounds> ScissorsRect, const sViewport& VP, const eZOrderMode& Mode) -> void
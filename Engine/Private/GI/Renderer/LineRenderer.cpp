@@ -85,7 +85,6 @@ void sLineRenderer::BeginPlay()
 
 void sLineRenderer::Tick(const double DeltaTime)
 {
-	bool bReorder = false;
 	std::vector<sLines::LinesVertexData>::iterator it = Lines.VertexData.begin();
 	while (it != Lines.VertexData.end())
 	{
@@ -97,7 +96,7 @@ void sLineRenderer::Tick(const double DeltaTime)
 				auto LineType = (*it).LineType;
 				it = Lines.VertexData.erase(it);
 
-				bReorder = true;
+				bIsVertexBufferDirty = true;
 
 				if (LineType == sLines::ELineType::eLine)
 				{
@@ -120,17 +119,21 @@ void sLineRenderer::Tick(const double DeltaTime)
 			it++;
 		}
 	}
+}
 
-	if (bReorder)
-	{
-		auto Data = Lines.GetVertices();
-		BufferSubresource Subresource;
-		Subresource.pSysMem = Data.data();
-		Subresource.Size = ((Lines.BoundCount * 8) + (Lines.LineCount * 2)) * sizeof(sLineVertexBufferEntry);
-		Subresource.Location = 0;
+void sLineRenderer::UpdateVertexBuffer()
+{
+	if (!bIsVertexBufferDirty)
+		return;
+	bIsVertexBufferDirty = false;
 
-		VertexBuffer->UpdateSubresource(&Subresource);
-	}
+	auto Data = Lines.GetVertices();
+	BufferSubresource Subresource;
+	Subresource.pSysMem = Data.data();
+	Subresource.Size = ((Lines.BoundCount * 8) + (Lines.LineCount * 2)) * sizeof(sLineVertexBufferEntry);
+	Subresource.Location = 0;
+
+	VertexBuffer->UpdateSubresource(&Subresource);
 }
 
 void sLineRenderer::DrawLine(const FVector& Start, const FVector& End, const FColor& Color, std::optional<float> Time)
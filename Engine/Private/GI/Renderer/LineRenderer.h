@@ -92,6 +92,11 @@ public:
 	void DrawLine(const FVector& Start, const FVector& End, const FColor& Color, std::optional<float> Time);
 	void DrawBound(const FBoundingBox& Box, const FColor& Color, std::optional<float> Time);
 
+	/*
+	* Uploads the lines again if Tick removed expired ones, called before drawing.
+	*/
+	void UpdateVertexBuffer();
+
 private:
 	sScreenDimension ScreenDimension;
 
@@ -102,4 +107,5 @@ private:
 	IVertexBuffer::SharedPtr VertexBuffer;
 
 	sLines Lines;
+	bool bIsVertexBufferDirty = false;
 };
@@ -26,6 +26,7 @@
 
 #include "pch.h"
 #include "Renderer.h"
+#include "Core/Profiler.h"
 #include <ranges>
 #include "Gameplay/GameInstance.h"
 #include "Gameplay/StaticMesh.h"
@@ -123,6 +124,10 @@ public:
 	void Tick(double DeltaTime)
 	{
 		TimeBuffer.Time += DeltaTime;
+	}
+
+	void UpdateTimeBuffer()
+	{
 		TimeCB->Map(&TimeBuffer);
 	}
 
@@ -132,11 +137,10 @@ public:
 		//std::size_t MeshHashCode = IMesh::GetStaticHashCode();
 
 		sMaterial* LastMaterial = nullptr;
-		std::vector<IMesh*> BlendedMeshes;
-		std::vector<IMesh*> LatestMeshes;
+		sFrameVector<IMesh*> BlendedMeshes;
+		sFrameVector<IMesh*> LatestMeshes;
 
-		std::function<void(EMaterialBlendMode, IMesh*, IGraphicsCommandContext*)> Draw;
-		Draw = [&](EMaterialBlendMode BlendMode, IMesh* Mesh, IGraphicsCommandContext* CMD)
+		auto Draw = [&](EMaterialBlendMode BlendMode, IMesh* Mesh, IGraphicsCommandContext* CMD)
 			{
 				if (Mesh->GeMeshRenderPriority() == EMeshRenderPriority::Latest)
 				{
@@ -487,9 +491,13 @@ void sRenderer::BeginFrame()
 
 void sRenderer::Render()
 {
+	sProfileFunction;
 	if (!World)
 		return;
 
+	GBuffer->UpdateTimeBuffer();
+	LineRenderer->UpdateVertexBuffer();
+
 	if (GBufferClearMode == EGBufferClear::Driver/* || GBufferClearMode == EGBufferClear::Sky*/)
 	{
 		GBuffer->ClearGBuffer();
@@ -41,6 +41,9 @@ public:
 	~sRenderer();
 
 	void BeginPlay();
+	/*
+	* Only updates the CPU side lists, runs on a worker. Render uploads what changed.
+	*/
 	void Tick(const double DeltaTime);
 
 	void BeginFrame();
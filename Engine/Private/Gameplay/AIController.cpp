@@ -27,7 +27,6 @@
 #include "pch.h"
 #include "Gameplay/AIController.h"
 #include "Gameplay/GameInstance.h"
-#include <Windows.h>
 
 sAIController::sAIController(sGameInstance* InOwner)
 	: Super()
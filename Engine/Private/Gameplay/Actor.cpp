@@ -28,6 +28,7 @@
 #include "Gameplay/Actor.h"
 #include "Gameplay/PlayerController.h"
 #include "Gameplay/AIController.h"
+#include "Gameplay/PhysicalComponent.h"
 #include "Engine/IMetaWorld.h"
 
 sActor::sActor(std::string InName, sController* InController)
@@ -39,9 +40,15 @@ sActor::sActor(std::string InName, sController* InController)
 	, bIsEnabled(true)
 	, LayerIndex(0)
 	, bIsReplicated(false)
+	, bWasHidden(false)
+	, bWasEnabled(true)
 {
 	sPrimitiveComponent::SharedPtr pPrimitiveComponent = sPrimitiveComponent::Create("DefaultPrimitiveComponent");
 	SetRootComponent(pPrimitiveComponent);
+
+	ReplicatedProperties.OnReplicated = [this](std::uint64_t ChangedMask) { OnReplicated(ChangedMask); };
+	ReplicatedProperties.OnRelevancyChanged = [this](bool bIsRelevant) { OnRelevancyChanged(bIsRelevant); };
+	ReplicatedProperties.GetRelevancyBounds = [this]() { return GetRelevancyBounds(); };
 }
 
 sActor::~sActor()
@@ -88,9 +95,12 @@ void sActor::Replicate(bool bReplicate)
 	if (bIsReplicated)
 	{
 		//RegisterRPCfn(GetClassNetworkAddress(), GetName(), "AddToActiveLevel_Server", eRPCType::Client, true, std::bind(&sActor::AddToActiveLevel_Server, this, std::placeholders::_1, std::placeholders::_2), FVector, std::size_t);
+		// Registered even without properties, relevancy hides and disables the proxy.
+		ReplicatedProperties.Register(GetClassNetworkAddress(), GetName());
 	}
 	else
 	{
+		ReplicatedProperties.Unregister();
 		Network::UnregisterRPC(GetClassNetworkAddress(), GetName());
 	}
 }
@@ -100,6 +110,48 @@ eNetworkRole sActor::GetNetworkRole() const
 	return Controller ? Controller->GetNetworkRole() : eNetworkRole::None;
 }
 
+std::optional<FBoundingBox> sActor::GetRelevancyBounds() const
+{
+	if (!Level)
+		return std::nullopt;
+	return GetBounds();
+}
+
+void sActor::OnRelevancyChanged(bool bIsRelevant)
+{
+	if (!bIsRelevant)
+	{
+		bWasHidden = bIsHidden;
+		bWasEnabled = bIsEnabled;
+		Hide(true);
+		SetEnabled(false);
+
+		// Collision is turned off so the proxy neither blocks nor is pushed by local bodies while its state is stale.
+		std::vector<sPhysicalComponent*> Components = RootComponent->FindComponents<sPhysicalComponent>();
+		if (auto Root = dynamic_cast<sPhysicalComponent*>(RootComponent.get()))
+			Components.push_back(Root);
+		for (const auto& Component : Components)
+		{
+			if (!Component->IsCollisionEnabled())
+				continue;
+			Component->SetCollisionEnabled(false);
+			CollisionDisabledComponents.push_back(Component->weak_from_this());
+		}
+	}
+	else
+	{
+		for (const auto& Component : CollisionDisabledComponents)
+		{
+			if (auto Physical = std::dynamic_pointer_cast<sPhysicalComponent>(Component.lock()))
+				Physical->SetCollisionEnabled(true);
+		}
+		CollisionDisabledComponents.clear();
+
+		Hide(bWasHidden);
+		SetEnabled(bWasEnabled);
+	}
+}
+
 std::string sActor::GetClassNetworkAddress() const
 {
 	return Controller ? Controller->GetClassNetworkAddress() : "-1";
@@ -29,7 +29,6 @@
 #include "Gameplay/PlayerController.h"
 #include "Gameplay/GameInstance.h"
 #include "Gameplay/CameraComponent.h"
-#include <Windows.h>
 #include "Gameplay/ICanvas.h"
 
 sCameraManager::sCameraManager(sPlayerController* InOwner)
@@ -410,6 +409,19 @@ void sCameraManager::UpdateVelocity(float fElapsedTime)
 	}
 }
 
+std::optional<FBoundingBox> sCameraManager::GetViewBounds() const
+{
+	if (!bIsCameraEnabled || !IsOrthographic())
+		return std::nullopt;
+
+	const sScreenDimension ViewportDimension = ViewportInstance && ViewportInstance->Viewport.has_value() ?
+		sScreenDimension(ViewportInstance->Viewport->Width, ViewportInstance->Viewport->Height) : GPU::GetBackBufferDimension();
+
+	// Orthographic cameras sit on the top left corner of the view, see UpdateCamera.
+	const FVector Position = GetPosition();
+	return FBoundingBox(FVector(Position.X, Position.Y, 0.0f), FVector(Position.X + (float)ViewportDimension.Width, Position.Y + (float)ViewportDimension.Height, 0.0f));
+}
+
 void sCameraManager::SetPerspective(float AspectRatio)
 {
 	ViewportInstance->Viewport = std::nullopt;
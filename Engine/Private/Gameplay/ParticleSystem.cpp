@@ -155,7 +155,11 @@ MeshParticle::MeshParticle(sMeshParticleDesc InDesc, sEmitter* InOwner)
 		Layout.Stride = sizeof(std::uint32_t);
 		IndexBuffer = IIndexBuffer::CreateUnique("MeshParticle_IB", Layout);
 	}
+	/*
+	* Buffers are null without a GI device (headless server, benchmarks), the simulation still runs.
+	*/
 	{
+		if (VertexBuffer)
 		{
 			BufferSubresource VertexResource;
 			VertexResource.pSysMem = Desc.Shape.Shape.data();
@@ -163,6 +167,7 @@ MeshParticle::MeshParticle(sMeshParticleDesc InDesc, sEmitter* InOwner)
 			VertexResource.Location = 0;
 			VertexBuffer->UpdateSubresource(&VertexResource);
 		}
+		if (IndexBuffer)
 		{
 			BufferSubresource IndexResource;
 			IndexResource.pSysMem = Desc.Shape.ShapeIndexes.data();
@@ -200,6 +205,54 @@ void MeshParticle::Begin()
 {
 }
 
+void MeshParticle::Spawn(Particle& particle)
+{
+	particle.Active = true;
+	//particle.Shape = Desc.Shapes[0];
+	particle.Shape = Desc.Shape;
+	auto Owner = GetOwner();
+	particle.Position = Owner ? Owner->GetLocation() : FVector::Zero();
+
+	particle.Velocity = Lerp(Desc.MinVelocity, Desc.MaxVelocity, FVector(Engine::RandomValueInRange(0.0f, 1.0f)));
+	particle.Color = Desc.StartColor;
+	{
+		const float Roll = Lerp(Desc.MinAngle.Roll, Desc.MaxAngle.Roll, (Engine::RandomValueInRange(0.0f, 1.0f)));
+		const float Yaw = Lerp(Desc.MinAngle.Yaw, Desc.MaxAngle.Yaw, (Engine::RandomValueInRange(0.0f, 1.0f)));
+		const float Pitch = Lerp(Desc.MinAngle.Pitch, Desc.MaxAngle.Pitch, (Engine::RandomValueInRange(0.0f, 1.0f)));
+		particle.Rotation = FAngles(Pitch, Yaw, Roll);
+	}
+	particle.Scale = Lerp(Desc.MinScale, Desc.MaxScale, FVector(Engine::RandomValueInRange(0.0f, 1.0f)));
+
+	particle.LifeTime = Lerp(Desc.MinLifeTime, Desc.MaxLifeTime, (Engine::RandomValueInRange(0.0f, 1.0f)));
+	particle.LifeRemaining = particle.LifeTime;
+}
+
+std::size_t MeshParticle::SpawnBurst(std::size_t Count)
+{
+	std::size_t Spawned = 0;
+	for (auto& particle : ParticlePool)
+	{
+		if (Spawned >= Count)
+			break;
+		if (particle.Active)
+			continue;
+		Spawn(particle);
+		Spawned++;
+	}
+	return Spawned;
+}
+
+std::size_t MeshParticle::GetActiveParticleCount() const
+{
+	std::size_t Count = 0;
+	for (const auto& particle : ParticlePool)
+	{
+		if (particle.Active)
+			Count++;
+	}
+	return Count;
+}
+
 void MeshParticle::Update(float DT)
 {
 	bIsUpdated = false;
@@ -213,29 +266,8 @@ void MeshParticle::Update(float DT)
 
 		{
 			auto& particle = ParticlePool[SpawnCounter];
-			{
-				if (!particle.Active)
-				{
-					particle.Active = true;
-					//particle.Shape = Desc.Shapes[0];
-					particle.Shape = Desc.Shape;
-					auto Owner = GetOwner();
-					particle.Position = Owner ? Owner->GetLocation() : FVector::Zero();
-
-					particle.Velocity = Lerp(Desc.MinVelocity, Desc.MaxVelocity, FVector(Engine::RandomValueInRange(0.0f, 1.0f)));
-					particle.Color = Desc.StartColor;
-					{
-						const float Roll = Lerp(Desc.MinAngle.Roll, Desc.MaxAngle.Roll, (Engine::RandomValueInRange(0.0f, 1.0f)));
-						const float Yaw = Lerp(Desc.MinAngle.Yaw, Desc.MaxAngle.Yaw, (Engine::RandomValueInRange(0.0f, 1.0f)));
-						const float Pitch = Lerp(Desc.MinAngle.Pitch, Desc.MaxAngle.Pitch, (Engine::RandomValueInRange(0.0f, 1.0f)));
-						particle.Rotation = FAngles(Pitch, Yaw, Roll);
-					}
-					particle.Scale = Lerp(Desc.MinScale, Desc.MaxScale, FVector(Engine::RandomValueInRange(0.0f, 1.0f)));
-
-					particle.LifeTime = Lerp(Desc.MinLifeTime, Desc.MaxLifeTime, (Engine::RandomValueInRange(0.0f, 1.0f)));
-					particle.LifeRemaining = particle.LifeTime;
-				}
-			}
+			if (!particle.Active)
+				Spawn(particle);
 			if ((SpawnCounter + 1) >= ParticlePool.size())
 				SpawnCounter = 0;
 			else
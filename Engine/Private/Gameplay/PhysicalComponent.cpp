@@ -32,7 +32,9 @@
 sPhysicalComponent::sPhysicalComponent(std::string InName, sActor* pActor)
 	: Super(InName, pActor)
 	, bEnablePhysics(true)
+	, NetLinearVelocity(FVector::Zero())
 {
+	GetReplicatedProperties().Add("LinearVelocity", NetLinearVelocity);
 }
 
 sPhysicalComponent::~sPhysicalComponent()
@@ -46,16 +48,24 @@ void sPhysicalComponent::Replicate(bool bReplicate)
 	if (IsReplicated() == bReplicate)
 		return;
 
+	if (bReplicate)
+		NetLinearVelocity.Set(GetVelocity());
+
 	Super::Replicate(bReplicate);
+}
 
-	if (IsReplicated())
-	{
-		RegisterRPCfn(GetClassNetworkAddress(), GetName(), "SetLinearVelocity_Client", eRPCType::Client, false, false, std::bind(&sPhysicalComponent::SetLinearVelocity_Client, this, std::placeholders::_1), FVector);
-	}
-	else
-	{
-		Network::UnregisterRPC(GetClassNetworkAddress(), GetName());
-	}
+void sPhysicalComponent::OnReplicated(std::uint64_t ChangedMask)
+{
+	Super::OnReplicated(ChangedMask);
+
+	if (Network::IsHost())
+		return;
+
+	if (!IsReplicated())
+		return;
+
+	if (NetLinearVelocity.IsChanged(ChangedMask) && HasRigidBody())
+		GetRigidBody()->SetLinearVelocity(NetLinearVelocity);
 }
 
 void sPhysicalComponent::UpdatePhysics()
@@ -108,7 +118,7 @@ void sPhysicalComponent::SetLinearVelocity(const FVector& V)
 		if (HasRigidBody())
 			GetRigidBody()->SetLinearVelocity(V);
 
-		Network::CallRPC(GetClassNetworkAddress(), GetName(), "SetLinearVelocity_Client", sArchive(V), false);
+		NetLinearVelocity.Set(V);
 	}
 	else if (IsReplicated() && Network::IsConnected())
 	{
@@ -129,20 +139,6 @@ void sPhysicalComponent::SetLinearVelocity(const FVector& V)
 	}
 }
 
-void sPhysicalComponent::SetLinearVelocity_Client(const FVector& V)
-{
-	if (Network::IsHost())
-		return;
-
-	if (!IsReplicated())
-		return;
-
-	if (HasRigidBody())
-		GetRigidBody()->SetLinearVelocity(V);
-
-	//Network::CallRPC(GetClassNetworkAddress(), "SetRelativeLocation_Server", sArchive(GetRelativeLocation()), false);
-}
-
 FVector sPhysicalComponent::GetVelocity() const
 {
 	return HasRigidBody() ? GetRigidBody()->GetLinearVelocity() : FVector::Zero();
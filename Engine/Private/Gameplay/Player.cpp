@@ -93,6 +93,10 @@ void sPlayer::Tick(const double DeltaTime)
 
 	Controller->Tick(DeltaTime);
 	OnTick(DeltaTime);
+
+	// The server keeps what this player sees relevant to the client.
+	if (IsReplicated() && Network::IsConnected() && !Network::IsHost())
+		Network::SetViewBounds(PlayerIndex, Controller->GetCameraManager()->GetViewBounds());
 }
 
 void sPlayer::FixedUpdate(const double DeltaTime)
@@ -116,6 +120,7 @@ void sPlayer::Replicate(bool bReplicate)
 	else
 	{
 		Network::UnregisterRPC(GetClassNetworkAddress());
+		Network::SetViewBounds(PlayerIndex, std::nullopt);
 	}
 }
 
@@ -320,6 +325,8 @@ void sPlayer::PlayerRemoved()
 
 void sPlayer::SetPlayerIndex(std::size_t Index)
 {
+	if (IsReplicated())
+		Network::SetViewBounds(PlayerIndex, std::nullopt);
 	PlayerIndex = Index;
 }
 
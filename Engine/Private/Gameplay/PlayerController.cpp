@@ -27,9 +27,7 @@
 #include "pch.h"
 #include "Gameplay/PlayerController.h"
 #include "Gameplay/GameInstance.h"
-#include "Engine/InputController.h"
 #include "Gameplay/CameraComponent.h"
-#include <Windows.h>
 
 sPlayerController::sPlayerController(sPlayer* InOwner, const sPlayerState::SharedPtr& InPlayerState)
 	: Super()
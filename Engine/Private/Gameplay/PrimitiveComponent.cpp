@@ -39,7 +39,19 @@ sPrimitiveComponent::sPrimitiveComponent(std::string InName, sActor* pActor)
 	, Rotation(FVector4(0.0f, 0.0f, 0.0f, 1.0f))
 	, Scale(FVector(1.0f, 1.0f, 1.0f))
 	, bIsReplicated(false)
-{
+	, NetLocation(FVector::Zero())
+	, NetScale(FVector(1.0f, 1.0f, 1.0f))
+{
+	ReplicatedProperties.Add("Location", NetLocation);
+	ReplicatedProperties.Add("Rotation", NetRotation);
+	ReplicatedProperties.Add("Scale", NetScale);
+	ReplicatedProperties.OnReplicated = [this](std::uint64_t ChangedMask) { OnReplicated(ChangedMask); };
+	// Relevant where its actor is, the actor hides and disables the proxy.
+	ReplicatedProperties.GetRelevancyBounds = [this]() -> std::optional<FBoundingBox>
+	{
+		const sActor* Actor = GetOwner();
+		return Actor ? Actor->GetRelevancyBounds() : std::nullopt;
+	};
 }
 
 sPrimitiveComponent::~sPrimitiveComponent()
@@ -149,15 +161,42 @@ void sPrimitiveComponent::Replicate(bool bReplicate)
 
 	if (bIsReplicated)
 	{
-		RegisterRPCfn(GetClassNetworkAddress(), GetName(), "SetRelativeLocation_Client", eRPCType::Client, false, false, std::bind(&sPrimitiveComponent::SetRelativeLocation_Client, this, std::placeholders::_1), FVector);
-		RegisterRPCfn(GetClassNetworkAddress(), GetName(), "SetTransform_Client", eRPCType::Client, false, false, std::bind(&sPrimitiveComponent::SetTransform_Client, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), FVector, FVector4, FVector);
+		NetLocation.Set(Location);
+		NetRotation.Set(sQuantizedRotation(Rotation));
+		NetScale.Set(Scale);
+		ReplicatedProperties.Register(GetClassNetworkAddress(), GetName());
 	}
 	else
 	{
+		ReplicatedProperties.Unregister();
 		Network::UnregisterRPC(GetClassNetworkAddress(), GetName());
 	}
 }
 
+void sPrimitiveComponent::OnReplicated(std::uint64_t ChangedMask)
+{
+	if (Network::IsHost())
+		return;
+
+	if (!IsReplicated())
+		return;
+
+	if (NetLocation.IsChanged(ChangedMask) || NetRotation.IsChanged(ChangedMask) || NetScale.IsChanged(ChangedMask))
+		OnReplicatedTransform(NetLocation, NetRotation.Get(), NetScale);
+}
+
+void sPrimitiveComponent::OnReplicatedTransform(const FVector& InLocation, const FVector4& InRotation, const FVector& InScale)
+{
+	if (Location != InLocation || Rotation != InRotation || Scale != InScale)
+	{
+		Location = InLocation;
+		Rotation = InRotation;
+		Scale = InScale;
+
+		UpdateTransform();
+	}
+}
+
 void sPrimitiveComponent::Enable()
 {
 	bIsEnabled = true;
@@ -258,35 +297,11 @@ void sPrimitiveComponent::Serialize(sArchive& archive)
 
 void sPrimitiveComponent::SetRelativeLocation(const FVector& V)
 {
-	if (IsReplicated() && Network::IsHost())
-	{
-		Location = V;
-		UpdateTransform();
-
-		Network::CallRPC(GetClassNetworkAddress(), GetName(), "SetRelativeLocation_Client", sArchive(V), false);
-	}
-	else if (IsReplicated() && Network::IsConnected())
-	{
-		Location = V;
-		UpdateTransform();
-	}
-	else
-	{
-		Location = V;
-		UpdateTransform();
-	}
-}
-
-void sPrimitiveComponent::SetRelativeLocation_Client(const FVector& V)
-{
-	if (Network::IsHost())
-		return;
-
-	if (!IsReplicated())
-		return;
-
 	Location = V;
 	UpdateTransform();
+
+	if (IsReplicated() && Network::IsHost())
+		NetLocation.Set(V);
 }
 
 FVector sPrimitiveComponent::GetRelativeLocation() const
@@ -301,6 +316,9 @@ void sPrimitiveComponent::SetRelativeRotation(const FVector4& V)
 {
 	Rotation = V; 
 	UpdateTransform();
+
+	if (IsReplicated() && Network::IsHost())
+		NetRotation.Set(sQuantizedRotation(V));
 }
 
 void sPrimitiveComponent::SetRollPitchYaw(FAngles RPY)
@@ -325,6 +343,9 @@ void sPrimitiveComponent::SetRelativeScale(const FVector& V)
 {
 	Scale = V; 
 	UpdateTransform();
+
+	if (IsReplicated() && Network::IsHost())
+		NetScale.Set(V);
 }
 
 FVector sPrimitiveComponent::GetRelativeScale() const
@@ -345,51 +366,6 @@ FVector sPrimitiveComponent::GetVelocity() const
 
 void sPrimitiveComponent::SetTransform(const FVector& InLocation, const FVector4& InRotation, const FVector InScale)
 {
-	if (IsReplicated() && Network::IsHost())
-	{
-		if (Location != InLocation || Rotation != InRotation || Scale != InScale)
-		{
-			Location = InLocation;
-			Rotation = InRotation;
-			Scale = InScale;
-
-			UpdateTransform();
-		}
-
-		Network::CallRPC(GetClassNetworkAddress(), GetName(), "SetTransform_Client", sArchive(InLocation, InRotation, InScale), false);
-	}
-	else if (IsReplicated() && Network::IsConnected())
-	{
-		if (Location != InLocation || Rotation != InRotation || Scale != InScale)
-		{
-			Location = InLocation;
-			Rotation = InRotation;
-			Scale = InScale;
-
-			UpdateTransform();
-		}
-	}
-	else
-	{
-		if (Location != InLocation || Rotation != InRotation || Scale != InScale)
-		{
-			Location = InLocation;
-			Rotation = InRotation;
-			Scale = InScale;
-
-			UpdateTransform();
-		}
-	}
-}
-
-void sPrimitiveComponent::SetTransform_Client(const FVector& InLocation, const FVector4& InRotation, const FVector InScale)
-{
-	if (Network::IsHost())
-		return;
-
-	if (!IsReplicated())
-		return;
-
 	if (Location != InLocation || Rotation != InRotation || Scale != InScale)
 	{
 		Location = InLocation;
@@ -398,6 +374,14 @@ void sPrimitiveComponent::SetTransform_Client(const FVector& InLocation, const F
 
 		UpdateTransform();
 	}
+
+	// Only changes are marked, a physics step that doesn't move the component sends nothing.
+	if (IsReplicated() && Network::IsHost())
+	{
+		NetLocation.Set(InLocation);
+		NetRotation.Set(sQuantizedRotation(InRotation));
+		NetScale.Set(InScale);
+	}
 }
 
 void sPrimitiveComponent::UpdateTransform()
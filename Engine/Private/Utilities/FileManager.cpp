@@ -26,16 +26,23 @@
 
 #include "pch.h"
 #include "Utilities/FileManager.h"
+#include "Core/ArchiveFile.h"
 #include <filesystem>
 #include <regex>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <cwchar>
+#include <assert.h>
+#if defined(_WIN32)
 #include <Windows.h>
 #include <cderr.h>
-#include <assert.h>
 #include <shellapi.h>
-#include "Engine/AbstractEngine.h"
 #include <wrl/wrappers/corewrappers.h>
+#else
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+#endif
+#include "Engine/AbstractEngine.h"
 
 using namespace std::filesystem;
 
@@ -43,6 +50,7 @@ namespace FileManager
 {
 	std::string ContentDirectory = "..//Content//";
 
+#if defined(_WIN32)
 	static int enumerateNativeFiles(const char* pattern, bool directories)
 	{
 		WIN32_FIND_DATAA findData;
@@ -74,6 +82,29 @@ namespace FileManager
 
 		return numEntries;
 	}
+#else
+	static int enumerateNativeFiles(const char* pattern, bool directories)
+	{
+		// Same "dir/*" or "dir/*.ext" patterns as FindFirstFileA.
+		const std::filesystem::path Pattern(pattern);
+		const std::string Suffix = Pattern.filename().string().substr(1);
+
+		std::error_code Error;
+		std::filesystem::directory_iterator It(Pattern.parent_path(), Error);
+		if (Error)
+			return Error == std::errc::no_such_file_or_directory ? 0 : -1;
+
+		int numEntries = 0;
+		for (const auto& Entry : It)
+		{
+			const std::string Name = Entry.path().filename().string();
+			if (Entry.is_directory(Error) == directories && (Suffix.empty() || Name.ends_with(Suffix)))
+				++numEntries;
+		}
+
+		return numEntries;
+	}
+#endif
 
 	void SetContentDirectory(const std::string Path)
 	{
@@ -201,13 +232,25 @@ namespace FileManager
 
 	bool FileExists(const std::wstring& file)
 	{
+#if defined(_WIN32)
 		// Exist ?
 		DWORD dwAttrib = GetFileAttributes(file.c_str());
 		return (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
+#else
+		std::error_code Error;
+		return std::filesystem::is_regular_file(file, Error);
+#endif
 	}
 
 	bool FileIsNewer(const std::wstring& file1, const std::wstring& file2)
 	{
+#if !defined(_WIN32)
+		std::error_code Error1;
+		std::error_code Error2;
+		const auto Time1 = std::filesystem::last_write_time(file1, Error1);
+		const auto Time2 = std::filesystem::last_write_time(file2, Error2);
+		return !Error1 && !Error2 && Time1 > Time2;
+#else
 		HANDLE handle1 = INVALID_HANDLE_VALUE;
 		HANDLE handle2 = INVALID_HANDLE_VALUE;
 
@@ -232,6 +275,7 @@ namespace FileManager
 		}
 
 		return false;
+#endif
 	}
 
 	bool fsCreateFile(const std::string& InPath, const std::string InName)
@@ -298,9 +342,12 @@ namespace FileManager
 
 	void OpenDirectoryWindow(const std::string& directory)
 	{
+#if defined(_WIN32)
 		ShellExecute(nullptr, nullptr, StringToWstring(directory).c_str(), nullptr, nullptr, SW_SHOW);
+#endif
 	}
 
+#if defined(_WIN32)
 	bool OpenFile(OPENFILENAMEW& FILE)
 	{
 		if (GetOpenFileName(&FILE))
@@ -333,6 +380,7 @@ namespace FileManager
 		}
 		return false;
 	}
+#endif
 
 	bool FileExists(const std::string& file_path)
 	{
@@ -697,6 +745,12 @@ namespace FileManager
 
 	std::wstring StringToWstring(const std::string& str)
 	{
+#if !defined(_WIN32)
+		std::wstring result(str.size(), L'\0');
+		const std::size_t len = std::mbstowcs(result.data(), str.c_str(), result.size());
+		result.resize(len == static_cast<std::size_t>(-1) ? 0 : len);
+		return result;
+#else
 		const auto slength = static_cast<int>(str.length()) + 1;
 		const auto len = MultiByteToWideChar(CP_ACP, 0, str.c_str(), slength, nullptr, 0);
 		const auto buf = new wchar_t[len];
@@ -704,6 +758,7 @@ namespace FileManager
 		std::wstring result(buf);
 		delete[] buf;
 		return result;
+#endif
 	}
 
 	std::string ResolveIncludeDirectives(const std::string& source, const std::string& directory)
@@ -748,6 +803,7 @@ namespace FileManager
 		return result;
 	}
 
+#if defined(_WIN32)
 	HRESULT ReadDataFromFile(LPCWSTR filename, byte* data, UINT* size)
 	{
 		using namespace Microsoft::WRL;
@@ -791,7 +847,17 @@ namespace FileManager
 
 		return S_OK;
 	}
+#endif
+
+	std::vector<std::uint8_t> ReadDataFromFile(const std::filesystem::path& Path)
+	{
+		sMappedFile File(Path);
+		if (!File.IsOpen())
+			return std::vector<std::uint8_t>();
+		return std::vector<std::uint8_t>(File.GetData(), File.GetData() + File.GetSize());
+	}
 
+#if defined(_WIN32)
 	HRESULT ReadDataFromDDSFile(LPCWSTR filename, byte* data, UINT* offset, UINT* size)
 	{
 		if (FAILED(ReadDataFromFile(filename, data, size)))
@@ -870,15 +936,23 @@ namespace FileManager
 			*(lastSlash + 1) = L'\0';
 		}
 	}
+#endif
 
 	std::string WideStringToString(const std::wstring& s)
 	{
+#if !defined(_WIN32)
+		std::string r(s.size() * MB_CUR_MAX, '\0');
+		const std::size_t len = std::wcstombs(r.data(), s.c_str(), r.size());
+		r.resize(len == static_cast<std::size_t>(-1) ? 0 : len);
+		return r;
+#else
 		int len;
 		int slength = (int)s.length() + 1;
 		len = WideCharToMultiByte(0, 0, s.c_str(), slength, 0, 0, 0, 0);
 		std::string r(len, '\0');
 		WideCharToMultiByte(0, 0, s.c_str(), slength, &r[0], len, 0, 0);
 		return r;
+#endif
 	}
 
 	std::u16string StringtoU16(const std::string& str)
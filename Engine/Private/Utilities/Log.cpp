@@ -37,7 +37,11 @@ std::wstring Log::CreateLogFile() const
 {
 	time_t t = std::time(nullptr);
 	struct tm buf;
+#if defined(_WIN32)
 	errno_t m_tm = localtime_s(&buf, &t);
+#else
+	localtime_r(&t, &buf);
+#endif
 
 	std::ostringstream oss;
 	oss << std::put_time(&buf, "%d-%m-%Y_%H-%M-%S");
@@ -53,7 +57,7 @@ bool Log::Open() const
 	if(!opened)
 	{
 		std::wstring filename = CreateLogFile();
-		Logging.open(filename.c_str(), std::ofstream::out | std::ofstream::app);
+		Logging.open(std::filesystem::path(filename), std::ofstream::out | std::ofstream::app);
 		opened = Logging.is_open();
 		if(!opened)
 			return false;
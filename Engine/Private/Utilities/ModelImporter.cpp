@@ -1,6 +1,7 @@
 
 #include "pch.h"
 #include "Utilities/ModelImporter.h"
+#include "Engine/MemoryManager.h"
 
 #include <assimp/material.h>
 #include <assimp/cimport.h>
@@ -35,6 +36,7 @@ void ModelImporter::Release()
 
 std::vector<ModelImporter::ModelImportAttributes> ModelImporter::ImportOBJ(const char * Path, const char * FileName, EImportType InImportType, bool MakeLeftHanded, std::uint32_t flags)
 {
+	MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eContent);
 	flags |= aiProcess_Triangulate;
 	flags |= aiProcess_CalcTangentSpace;
 	flags |= aiProcess_FindDegenerates;
@@ -88,6 +90,7 @@ std::vector<ModelImporter::ModelImportAttributes> ModelImporter::ImportOBJ(const
 
 std::vector<ModelImporter::ModelImportAttributes> ModelImporter::ImportGLTF(const char* Path, const char* FileName, EImportType InImportType, bool MakeLeftHanded, std::uint32_t flags)
 {
+	MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eContent);
 
 	flags |= aiProcess_Triangulate;
 	flags |= aiProcess_CalcTangentSpace;
@@ -214,6 +217,7 @@ std::vector<ModelImporter::ModelImportAttributes> ModelImporter::ImportGLTF(cons
 
 std::vector<ModelImporter::ModelImportAttributes> ModelImporter::ImportFBX(const char * Path, const char * FileName, EImportType InImportType, bool MakeLeftHanded, std::uint32_t flags)
 {
+	MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eContent);
 	flags |= aiProcess_Triangulate;
 	flags |= aiProcess_CalcTangentSpace;
 	flags |= aiProcess_FindDegenerates;
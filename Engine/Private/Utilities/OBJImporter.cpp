@@ -28,6 +28,7 @@
 #include "Utilities/OBJImporter.h"
 #include "Utilities/FileManager.h"
 #include "Core/Archive.h"
+#include "Engine/MemoryManager.h"
 
 OBJImporter::OBJImporter()
 {
@@ -39,6 +40,8 @@ OBJImporter::~OBJImporter()
 
 bool OBJImporter::Import(const std::string& path, bool bFlipTextCoordY)
 {
+	MemoryManager::sScopedMemoryTag MemoryTag(EMemoryTag::eContent);
+
 	std::vector<std::string> Lines;
 
 	bool NameOrPartFound = false;
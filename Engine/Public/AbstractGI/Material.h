@@ -45,8 +45,7 @@ enum class EMaterialUsage
 	AfterPostProcess,
 };
 
-__declspec(align(16))
-struct sMaterialAttributes
+struct alignas(16) sMaterialAttributes
 {
 	FVector4 DiffuseColor;
 	std::uint32_t Masked;
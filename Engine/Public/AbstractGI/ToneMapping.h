@@ -33,7 +33,7 @@ class sToneMapping : public sPostProcess
 {
     sClassBody(sClassConstructor, sToneMapping, sPostProcess)
 public:
-    __declspec(align(256)) struct sToneMappingConstants
+    struct alignas(256) sToneMappingConstants
     {
         float exposure; 
         int toneMapper;
@@ -29,9 +29,40 @@
 #include <vector>
 #include "Math/CoreMath.h"
 #include <string>
+#include <span>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 #include "Engine/ClassBody.h"
 #include "Engine/AbstractEngineUtilities.h"
 
+/*
+* Types whose archive format is their memory layout, vectors and spans of them are written and read with one memcpy.
+* Specialize it for trivially copyable types whose operator<< writes every byte in order.
+* bool is left out, it is written as one byte but std::vector<bool> has no contiguous storage.
+*/
+template <typename T>
+struct sArchiveBitwise : std::false_type {};
+template <> struct sArchiveBitwise<char> : std::true_type {};
+template <> struct sArchiveBitwise<unsigned char> : std::true_type {};
+template <> struct sArchiveBitwise<int> : std::true_type {};
+template <> struct sArchiveBitwise<unsigned int> : std::true_type {};
+template <> struct sArchiveBitwise<long> : std::true_type {};
+template <> struct sArchiveBitwise<unsigned long> : std::true_type {};
+template <> struct sArchiveBitwise<long long> : std::true_type {};
+template <> struct sArchiveBitwise<unsigned long long> : std::true_type {};
+template <> struct sArchiveBitwise<float> : std::true_type {};
+template <> struct sArchiveBitwise<double> : std::true_type {};
+template <> struct sArchiveBitwise<FVector> : std::true_type {};
+template <> struct sArchiveBitwise<FVector2> : std::true_type {};
+template <> struct sArchiveBitwise<FVector4> : std::true_type {};
+template <> struct sArchiveBitwise<DirectX::XMFLOAT2> : std::true_type {};
+template <> struct sArchiveBitwise<DirectX::XMFLOAT3> : std::true_type {};
+template <> struct sArchiveBitwise<DirectX::XMFLOAT4> : std::true_type {};
+template <> struct sArchiveBitwise<DirectX::XMFLOAT3X3> : std::true_type {};
+template <> struct sArchiveBitwise<DirectX::XMFLOAT4X3> : std::true_type {};
+template <> struct sArchiveBitwise<FMatrix> : std::true_type {};
+
 class sArchive
 {
 	sBaseClassBody(sClassConstructor, sArchive)
@@ -78,7 +109,31 @@ public:
 
 	constexpr inline std::size_t GetPosition() const { return pos; }
 	constexpr inline std::size_t GetSize() const { return Data.size(); }
-	constexpr inline std::vector<std::uint8_t> GetData() const { return Data; }
+	constexpr inline const std::vector<std::uint8_t>& GetData() const { return Data; }
+
+	/*
+	* Makes room for Size more bytes from the current position, a known packet size is written without reallocating.
+	*/
+	constexpr inline void Reserve(std::size_t Size)
+	{
+		if (pos + Size > Data.capacity())
+			Data.reserve(pos + Size);
+	}
+
+	/*
+	* Raw bytes at the current position, no size prefix.
+	*/
+	constexpr inline void WriteBytes(const void* Bytes, std::size_t Size)
+	{
+		if (Size == 0)
+			return;
+
+		const std::size_t reqSize = pos + Size;
+		if (reqSize > Data.size())
+			Grow(reqSize);
+		memcpy(&Data[pos], Bytes, Size);
+		pos = reqSize;
+	}
 
 	constexpr inline void AppendData(const std::vector<std::uint8_t>& InData)
 	{
@@ -145,17 +200,42 @@ public:
 
 	template <typename T>
 	constexpr inline sArchive& operator<<(const std::vector<T>& data)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			std::size_t Size = data.size();
+			(*this) << Size;
+			for (std::size_t i = 0; i < Size; i++)
+				(*this) << (bool)data.at(i);
+			return *this;
+		}
+		else
+		{
+			return (*this) << std::span<const T>(data);
+		}
+	}
+	/*
+	* Same layout as std::vector, a span can be read back into one.
+	*/
+	template <typename T, std::size_t Extent>
+	constexpr inline sArchive& operator<<(std::span<T, Extent> data)
 	{
 		std::size_t Size = data.size();
 		(*this) << Size;
-		for (std::size_t i = 0; i < Size; i++)
-			(*this) << data.at(i);
+		if constexpr (sArchiveBitwise<std::remove_cv_t<T>>::value)
+		{
+			WriteBytes(data.data(), data.size_bytes());
+		}
+		else
+		{
+			for (const auto& Element : data)
+				(*this) << Element;
+		}
 		return *this;
 	}
 	constexpr inline sArchive& operator<<(const std::string& STR)
 	{
-		for (const auto& pchar : STR)
-			(*this) << pchar;
+		WriteBytes(STR.data(), STR.size());
 
 		std::size_t found = STR.find('\0');
 		if (found == std::string::npos)
@@ -164,9 +244,12 @@ public:
 		return *this;
 	}
 
+	/*
+	* One byte, the same size operator>> reads back.
+	*/
 	constexpr inline sArchive& operator<<(bool data)
 	{
-		Serialize((data ? 1 : 0));
+		Serialize((std::uint8_t)(data ? 1 : 0));
 		return *this;
 	}
 	constexpr inline sArchive& operator<<(char data)
@@ -268,15 +351,7 @@ public:
 	template <typename T>
 	constexpr inline sArchive& operator>>(std::vector<T>& data)
 	{
-		std::size_t Size = 0;
-		(*this) >> Size;
-		for (std::size_t i = 0; i < Size; i++)
-		{
-			T t;
-			(*this) >> t;
-
-			data.push_back(t);
-		}
+		std::as_const(*this) >> data;
 		return *this;
 	}
 	template <typename T>
@@ -284,41 +359,44 @@ public:
 	{
 		std::size_t Size = 0;
 		(*this) >> Size;
-		for (std::size_t i = 0; i < Size; i++)
+		if constexpr (sArchiveBitwise<T>::value)
 		{
-			T t;
-			(*this) >> t;
+			// A corrupt size can't read past the end.
+			const std::size_t Count = Size < GetRemainingSize() / sizeof(T) ? Size : GetRemainingSize() / sizeof(T);
+			const std::size_t Offset = data.size();
+			data.resize(Offset + Count);
+			if (Count > 0)
+				memcpy(data.data() + Offset, &Data[pos], Count * sizeof(T));
+			pos += Count * sizeof(T);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < Size; i++)
+			{
+				T t;
+				(*this) >> t;
 
-			data.push_back(t);
+				data.push_back(t);
+			}
 		}
 	}
 	constexpr inline sArchive& operator >> (std::string& STR)
 	{
-		for (std::size_t i = pos; i < Data.size(); i++)
-		{
-			char pChar = 0;
-			(*this) >> pChar;
-
-			if (pChar == 0 || pChar == '\0' || pChar == std::string::npos)
-				break;
-
-			STR.push_back(pChar);
-		}
-
+		std::as_const(*this) >> STR;
 		return *this;
 	}
 	constexpr inline void operator >> (std::string& STR) const
 	{
-		for (std::size_t i = pos; i < Data.size(); i++)
-		{
-			char pChar = 0;
-			(*this) >> pChar;
-
-			if (pChar == 0 || pChar == '\0' || pChar == std::string::npos)
-				break;
+		const std::size_t Remaining = GetRemainingSize();
+		if (Remaining == 0)
+			return;
 
-			STR.push_back(pChar);
-		}
+		const char* Begin = reinterpret_cast<const char*>(&Data[pos]);
+		const char* End = static_cast<const char*>(memchr(Begin, '\0', Remaining));
+		const std::size_t Length = End ? (std::size_t)(End - Begin) : Remaining;
+		STR.append(Begin, Length);
+		// The terminator is consumed as well.
+		pos += End ? Length + 1 : Length;
 	}
 	constexpr inline sArchive& operator >> (bool& data)
 	{
@@ -506,21 +584,33 @@ public:
 	}
 
 private:
+	/*
+	* Kept apart from WriteBytes so the size is a constant and the copy stays a single store.
+	*/
 	template<typename T>
 	constexpr inline void Serialize(const T& data)
 	{
 		const std::size_t dataSize = sizeof(data);
 		const std::size_t reqSize = pos + dataSize;
-		if (reqSize > Data.size()) 
-		{
-			ResizeData(Data.size() + dataSize /** 2*/);
-		}
+		if (reqSize > Data.size())
+			Grow(reqSize);
+		memcpy(&Data[pos], &data, dataSize);
+		pos = reqSize;
+	}
 
-		if (reqSize <= Data.size())
-		{
-			memcpy(&Data[pos], &data, dataSize);
-			pos = reqSize;
-		}
+	/*
+	* Geometric growth, building an archive write by write stays linear.
+	*/
+	constexpr inline void Grow(std::size_t reqSize)
+	{
+		if (reqSize > Data.capacity())
+			Data.reserve(reqSize > Data.capacity() * 2 ? reqSize : Data.capacity() * 2);
+		Data.resize(reqSize);
+	}
+
+	constexpr inline std::size_t GetRemainingSize() const
+	{
+		return pos < Data.size() ? Data.size() - pos : 0;
 	}
 
 	template<typename T>
@@ -0,0 +1,160 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+#include "Engine/ClassBody.h"
+#include "Core/Archive.h"
+#include "Core/ArchiveView.h"
+
+/*
+* Read-only memory mapping of a whole file, MapViewOfFile on Windows and mmap elsewhere.
+* Pages are loaded on first access, the file is read straight from the page cache without a copy.
+* Views handed out by GetView are valid until the file is closed.
+*/
+class sMappedFile
+{
+	sBaseClassBody(sClassConstructor, sMappedFile)
+public:
+	sMappedFile();
+	sMappedFile(const std::filesystem::path& Path);
+	~sMappedFile();
+
+	sMappedFile(sMappedFile&& Other) noexcept;
+	sMappedFile& operator=(sMappedFile&& Other) noexcept;
+
+	/*
+	* Closes the current file first. An empty file opens with no data.
+	*/
+	bool Open(const std::filesystem::path& Path);
+	void Close();
+
+	inline bool IsOpen() const { return bIsOpen; }
+	inline const std::uint8_t* GetData() const { return Bytes; }
+	inline std::size_t GetSize() const { return Size; }
+	inline sArchiveView GetView() const { return sArchiveView(Bytes, Size); }
+
+private:
+	sMappedFile(const sMappedFile&) = delete;
+	sMappedFile& operator=(const sMappedFile&) = delete;
+
+	const std::uint8_t* Bytes;
+	std::size_t Size;
+	bool bIsOpen;
+#ifdef _WIN32
+	void* FileHandle;
+	void* MappingHandle;
+#else
+	int FileDescriptor;
+#endif
+};
+
+/*
+* Writes an archive to disk in fixed size chunks, large saves never live in memory as a whole.
+* Accepts everything sArchive does and writes the same layout, a file written here reads back through sMappedFile or sArchive::OpenFile.
+* Data goes to "<Path>.tmp" and replaces Path on Close, a failed or aborted save leaves the old file untouched.
+*/
+class sArchiveFileWriter
+{
+	sBaseClassBody(sClassConstructor, sArchiveFileWriter)
+public:
+	static constexpr std::size_t DefaultChunkSize = 1024 * 1024;
+
+	sArchiveFileWriter(std::size_t InChunkSize = DefaultChunkSize);
+	~sArchiveFileWriter();
+
+	bool Open(const std::filesystem::path& InPath);
+	/*
+	* Flushes the last chunk and moves the file into place, false if any write failed.
+	*/
+	bool Close();
+	/*
+	* Drops everything written since Open.
+	*/
+	void Abort();
+
+	inline bool IsOpen() const { return File.is_open(); }
+	inline bool IsFailed() const { return bFailed; }
+	inline std::uint64_t GetBytesWritten() const { return BytesWritten + Chunk.GetPosition(); }
+
+	/*
+	* Raw bytes, no size prefix. Blocks larger than a chunk are written straight to the file.
+	*/
+	void WriteBytes(const void* Bytes, std::size_t Size);
+	void Flush();
+
+	template <typename T>
+	inline sArchiveFileWriter& operator<<(const T& data)
+	{
+		Chunk << data;
+		if (Chunk.GetPosition() >= ChunkSize)
+			Flush();
+		return *this;
+	}
+
+	/*
+	* Element by element, a large vector is split over chunks instead of growing one.
+	*/
+	template <typename T>
+	inline sArchiveFileWriter& operator<<(const std::vector<T>& data)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			Chunk << data;
+		}
+		else if constexpr (sArchiveBitwise<T>::value)
+		{
+			Chunk << data.size();
+			WriteBytes(data.data(), data.size() * sizeof(T));
+		}
+		else
+		{
+			(*this) << data.size();
+			for (const auto& Element : data)
+				(*this) << Element;
+		}
+		if (Chunk.GetPosition() >= ChunkSize)
+			Flush();
+		return *this;
+	}
+
+private:
+	sArchiveFileWriter(const sArchiveFileWriter&) = delete;
+	sArchiveFileWriter& operator=(const sArchiveFileWriter&) = delete;
+
+	std::size_t ChunkSize;
+	sArchive Chunk;
+	std::ofstream File;
+	std::filesystem::path Path;
+	std::filesystem::path TempPath;
+	std::uint64_t BytesWritten;
+	bool bFailed;
+};
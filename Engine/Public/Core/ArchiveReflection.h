@@ -0,0 +1,265 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <tuple>
+#include <cstdint>
+#include <type_traits>
+#include "Core/Archive.h"
+#include "Core/ArchiveView.h"
+
+/*
+* Field list reflection for archive serialization.
+* A type lists its fields once and gets operator<< / operator>> for sArchive and sArchiveView from sArchiveFieldsBody:
+*
+*	struct sExample
+*	{
+*		std::int32_t A;
+*		std::int32_t B;
+*		std::string Name;
+*
+*		static constexpr auto GetArchiveFields()
+*		{
+*			return MakeArchiveFields(&sExample::A, &sExample::B, &sExample::Name);
+*		}
+*		sArchiveFieldsBody(sExample)
+*	};
+*
+* Fields are written in list order with the same layout as hand written operators.
+* Neighbouring sArchiveBitwise fields (enums by their underlying type) that are also neighbours in memory are copied with one memcpy.
+*
+* MakeVersionedArchiveFields<Version> prefixes the fields with the version and their size in bytes.
+* Fields added later are wrapped in sArchiveSince(Version, &T::Field), data of an older version leaves them at their defaults,
+* data of a newer version skips the fields this build doesn't know.
+*/
+template <typename TClass, typename TMember>
+struct sArchiveField
+{
+	TMember TClass::* Member;
+	std::uint32_t SinceVersion;
+};
+
+template <typename TClass, typename TMember>
+constexpr sArchiveField<TClass, TMember> sArchiveSince(std::uint32_t Version, TMember TClass::* Member)
+{
+	return sArchiveField<TClass, TMember>{ Member, Version };
+}
+
+template <std::uint32_t Version, typename... TFields>
+struct sArchiveFieldList
+{
+	static constexpr std::uint32_t CurrentVersion = Version;
+	std::tuple<TFields...> Fields;
+};
+
+namespace ArchiveReflection
+{
+	template <typename TClass, typename TMember>
+	constexpr sArchiveField<TClass, TMember> ToField(TMember TClass::* Member) { return sArchiveField<TClass, TMember>{ Member, 0 }; }
+	template <typename TClass, typename TMember>
+	constexpr sArchiveField<TClass, TMember> ToField(sArchiveField<TClass, TMember> Field) { return Field; }
+
+	template <typename T, typename = void>
+	struct sIsBitwise : sArchiveBitwise<T> {};
+	template <typename T>
+	struct sIsBitwise<T, std::enable_if_t<std::is_enum_v<T>>> : sArchiveBitwise<std::underlying_type_t<T>> {};
+
+	template <typename TMember>
+	using sMemberType = std::remove_cv_t<std::remove_reference_t<TMember>>;
+
+	/*
+	* Bytes waiting to go out (or come in) as one block.
+	*/
+	template <typename TByte>
+	struct sSpan
+	{
+		TByte* Begin = nullptr;
+		std::size_t Size = 0;
+
+		inline bool Extend(TByte* Bytes, std::size_t InSize)
+		{
+			if (Begin && Begin + Size == Bytes)
+			{
+				Size += InSize;
+				return true;
+			}
+			return false;
+		}
+	};
+
+	template <typename T>
+	inline void Write(sArchive& Archive, const T& data)
+	{
+		constexpr auto List = T::GetArchiveFields();
+		constexpr bool bIsVersioned = decltype(List)::CurrentVersion > 0;
+
+		std::size_t SizePos = 0;
+		if constexpr (bIsVersioned)
+		{
+			Archive << (std::uint32_t)decltype(List)::CurrentVersion;
+			SizePos = Archive.GetPosition();
+			Archive << (std::uint32_t)0;
+		}
+
+		sSpan<const std::uint8_t> Pending;
+		auto Flush = [&]()
+		{
+			Archive.WriteBytes(Pending.Begin, Pending.Size);
+			Pending = sSpan<const std::uint8_t>();
+		};
+
+		std::apply([&](const auto&... Fields)
+		{
+			([&](const auto& Field)
+			{
+				const auto& Value = data.*(Field.Member);
+				using MemberType = sMemberType<decltype(Value)>;
+				if constexpr (sIsBitwise<MemberType>::value)
+				{
+					const std::uint8_t* Bytes = reinterpret_cast<const std::uint8_t*>(&Value);
+					if (!Pending.Extend(Bytes, sizeof(MemberType)))
+					{
+						Flush();
+						Pending.Begin = Bytes;
+						Pending.Size = sizeof(MemberType);
+					}
+				}
+				else
+				{
+					Flush();
+					Archive << Value;
+				}
+			}(ToField(Fields)), ...);
+		}, List.Fields);
+		Flush();
+
+		if constexpr (bIsVersioned)
+		{
+			const std::size_t EndPos = Archive.GetPosition();
+			Archive.ResetPos(SizePos);
+			Archive << (std::uint32_t)(EndPos - SizePos - sizeof(std::uint32_t));
+			Archive.ResetPos(EndPos);
+		}
+	}
+
+	template <typename T>
+	inline void Read(const sArchiveView& Archive, T& data)
+	{
+		constexpr auto List = T::GetArchiveFields();
+		constexpr bool bIsVersioned = decltype(List)::CurrentVersion > 0;
+
+		std::uint32_t Version = decltype(List)::CurrentVersion;
+		std::uint32_t Size = 0;
+		sArchiveView Fields = Archive;
+		if constexpr (bIsVersioned)
+		{
+			Archive >> Version;
+			Archive >> Size;
+			Fields = Archive.Consume(Size);
+		}
+
+		sSpan<std::uint8_t> Pending;
+		auto Flush = [&]()
+		{
+			Fields.ReadBytes(Pending.Begin, Pending.Size);
+			Pending = sSpan<std::uint8_t>();
+		};
+
+		std::apply([&](const auto&... FieldList)
+		{
+			([&](const auto& Field)
+			{
+				auto& Value = data.*(Field.Member);
+				using MemberType = sMemberType<decltype(Value)>;
+				if (Field.SinceVersion > Version)
+				{
+					Flush();
+					return;
+				}
+
+				if constexpr (sIsBitwise<MemberType>::value)
+				{
+					std::uint8_t* Bytes = reinterpret_cast<std::uint8_t*>(&Value);
+					if (!Pending.Extend(Bytes, sizeof(MemberType)))
+					{
+						Flush();
+						Pending.Begin = Bytes;
+						Pending.Size = sizeof(MemberType);
+					}
+				}
+				else
+				{
+					Flush();
+					Fields >> Value;
+				}
+			}(ToField(FieldList)), ...);
+		}, List.Fields);
+		Flush();
+
+		if constexpr (bIsVersioned)
+		{
+			if (Fields.IsFailed())
+				Archive.SetFailed();
+		}
+		else
+		{
+			Archive.ResetPos(Fields.GetPosition());
+			if (Fields.IsFailed())
+				Archive.SetFailed();
+		}
+	}
+}
+
+template <typename... TFields>
+constexpr auto MakeArchiveFields(TFields... Fields)
+{
+	return sArchiveFieldList<0, decltype(ArchiveReflection::ToField(Fields))...>{ std::make_tuple(ArchiveReflection::ToField(Fields)...) };
+}
+
+template <std::uint32_t Version, typename... TFields>
+constexpr auto MakeVersionedArchiveFields(TFields... Fields)
+{
+	static_assert(Version > 0, "Version 0 is the unversioned layout");
+	return sArchiveFieldList<Version, decltype(ArchiveReflection::ToField(Fields))...>{ std::make_tuple(ArchiveReflection::ToField(Fields)...) };
+}
+
+#ifndef sArchiveFieldsBody
+/* Archive operators generated from GetArchiveFields. */
+#define sArchiveFieldsBody(Type)																											\
+	friend void operator<<(sArchive& Archive, const Type& data)																				\
+	{																																		\
+		ArchiveReflection::Write(Archive, data);																							\
+	}																																		\
+	friend void operator>>(const sArchive& Archive, Type& data)																				\
+	{																																		\
+		sArchiveView::Read(Archive, data);																									\
+	}																																		\
+	friend void operator>>(const sArchiveView& Archive, Type& data)																			\
+	{																																		\
+		ArchiveReflection::Read(Archive, data);																								\
+	}
+#endif
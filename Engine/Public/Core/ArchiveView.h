@@ -0,0 +1,220 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <type_traits>
+#include "Core/Archive.h"
+
+/*
+* Read-only archive over borrowed bytes, nothing is copied until a value is read out.
+* Reads the same layout sArchive writes. A read past the end leaves the value untouched and marks the view as failed.
+* The bytes must outlive the view.
+*/
+class sArchiveView
+{
+	sBaseClassBody(sClassConstructor, sArchiveView)
+public:
+	constexpr sArchiveView()
+		: Bytes(nullptr)
+		, Size(0)
+		, pos(0)
+		, bFailed(false)
+	{}
+	constexpr sArchiveView(const std::uint8_t* InBytes, std::size_t InSize)
+		: Bytes(InBytes)
+		, Size(InBytes ? InSize : 0)
+		, pos(0)
+		, bFailed(false)
+	{}
+	explicit inline sArchiveView(const std::string& STR)
+		: sArchiveView(reinterpret_cast<const std::uint8_t*>(STR.data()), STR.size())
+	{}
+	explicit inline sArchiveView(const std::vector<std::uint8_t>& InData)
+		: sArchiveView(InData.data(), InData.size())
+	{}
+	/*
+	* Continues from the archive's current position.
+	*/
+	inline sArchiveView(const sArchive& Archive)
+		: sArchiveView(Archive.GetData().data(), Archive.GetSize())
+	{
+		pos = Archive.GetPosition();
+	}
+
+	~sArchiveView() = default;
+
+	/*
+	* Decodes a type through its sArchiveView operator and moves the archive past what was read,
+	* lets a type keep a single decoder for both.
+	*/
+	template <typename T>
+	static inline void Read(const sArchive& Archive, T& data)
+	{
+		sArchiveView View(Archive);
+		View >> data;
+		Archive.ResetPos(View.GetPosition());
+	}
+
+	constexpr inline void ResetPos(std::size_t inPos = 0) const { pos = inPos; }
+	constexpr inline std::size_t GetPosition() const { return pos; }
+	constexpr inline std::size_t GetSize() const { return Size; }
+	constexpr inline const std::uint8_t* GetData() const { return Bytes; }
+	constexpr inline std::size_t GetRemainingSize() const { return pos < Size ? Size - pos : 0; }
+	constexpr inline bool IsEmpty() const { return Size == 0; }
+
+	/*
+	* Set by the first out of bounds read, stays set until ClearFailed.
+	*/
+	constexpr inline bool IsFailed() const { return bFailed; }
+	constexpr inline void ClearFailed() const { bFailed = false; }
+	constexpr inline void SetFailed() const { bFailed = true; }
+
+	/*
+	* Sub-view of Count bytes from Offset, clamped to the end. An offset past the end gives an empty, failed view.
+	*/
+	constexpr inline sArchiveView Slice(std::size_t Offset, std::size_t Count = std::size_t(-1)) const
+	{
+		if (Offset > Size)
+		{
+			sArchiveView Result;
+			Result.bFailed = true;
+			return Result;
+		}
+		return sArchiveView(Bytes + Offset, Count < Size - Offset ? Count : Size - Offset);
+	}
+
+	/*
+	* Everything from the current position to the end.
+	*/
+	constexpr inline sArchiveView GetRemaining() const
+	{
+		return Slice(pos);
+	}
+
+	/*
+	* Sub-view of the next Count bytes, the position moves past them.
+	*/
+	constexpr inline sArchiveView Consume(std::size_t Count) const
+	{
+		if (Count > GetRemainingSize())
+		{
+			bFailed = true;
+			Count = GetRemainingSize();
+		}
+		sArchiveView Result = Slice(pos, Count);
+		pos += Count;
+		return Result;
+	}
+
+	/*
+	* Raw bytes at the current position, no size prefix.
+	*/
+	constexpr inline bool ReadBytes(void* Out, std::size_t Count) const
+	{
+		if (Count > GetRemainingSize())
+		{
+			bFailed = true;
+			return false;
+		}
+		if (Count > 0)
+			memcpy(Out, Bytes + pos, Count);
+		pos += Count;
+		return true;
+	}
+
+	template <typename T>
+	constexpr inline const sArchiveView& operator>>(std::vector<T>& data) const
+	{
+		std::size_t Count = 0;
+		(*this) >> Count;
+		if constexpr (sArchiveBitwise<T>::value)
+		{
+			if (Count > GetRemainingSize() / sizeof(T))
+			{
+				bFailed = true;
+				Count = GetRemainingSize() / sizeof(T);
+			}
+			const std::size_t Offset = data.size();
+			data.resize(Offset + Count);
+			ReadBytes(data.data() + Offset, Count * sizeof(T));
+		}
+		else
+		{
+			for (std::size_t i = 0; i < Count && !bFailed; i++)
+			{
+				T t;
+				(*this) >> t;
+				data.push_back(t);
+			}
+		}
+		return *this;
+	}
+	/*
+	* Up to the terminator, or to the end when there is none.
+	*/
+	constexpr inline const sArchiveView& operator>>(std::string& STR) const
+	{
+		const std::size_t Remaining = GetRemainingSize();
+		if (Remaining == 0)
+		{
+			bFailed = true;
+			return *this;
+		}
+
+		const char* Begin = reinterpret_cast<const char*>(Bytes + pos);
+		const char* End = static_cast<const char*>(memchr(Begin, '\0', Remaining));
+		const std::size_t Length = End ? (std::size_t)(End - Begin) : Remaining;
+		STR.append(Begin, Length);
+		pos += End ? Length + 1 : Length;
+		return *this;
+	}
+	constexpr inline const sArchiveView& operator>>(bool& data) const
+	{
+		std::uint8_t temp = 0;
+		if (ReadBytes(&temp, sizeof(temp)))
+			data = (temp == 1);
+		return *this;
+	}
+	/*
+	* Every sArchiveBitwise type, the same set sArchive reads with a plain copy.
+	*/
+	template <typename T>
+	constexpr inline std::enable_if_t<sArchiveBitwise<T>::value, const sArchiveView&> operator>>(T& data) const
+	{
+		ReadBytes(&data, sizeof(T));
+		return *this;
+	}
+
+private:
+	const std::uint8_t* Bytes;
+	std::size_t Size;
+	mutable std::size_t pos;
+	mutable bool bFailed;
+};
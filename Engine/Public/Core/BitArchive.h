@@ -0,0 +1,432 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+#include "Math/CoreMath.h"
+#include "Engine/ClassBody.h"
+#include "Core/Archive.h"
+#include "Core/ArchiveView.h"
+
+/*
+* Bit level writer/reader, values take only the bits they are given.
+* Bits are packed LSB first, the last byte is zero padded.
+* A read past the end returns 0 and marks the archive as failed.
+*/
+class sBitArchive
+{
+	sBaseClassBody(sClassConstructor, sBitArchive)
+public:
+	sBitArchive()
+		: Source(nullptr)
+		, SourceSize(0)
+		, BitPos(0)
+		, BitSize(0)
+		, bFailed(false)
+	{}
+	/*
+	* Reads from the view's current position without copying, the bytes must outlive the archive.
+	*/
+	explicit sBitArchive(const sArchiveView& View)
+		: Source(View.GetData() ? View.GetData() + View.GetPosition() : nullptr)
+		, SourceSize(View.GetRemainingSize())
+		, BitPos(0)
+		, BitSize(View.GetRemainingSize() * 8)
+		, bFailed(false)
+	{}
+
+	~sBitArchive() = default;
+
+	inline void Clean()
+	{
+		Data.clear();
+		Source = nullptr;
+		SourceSize = 0;
+		BitPos = 0;
+		BitSize = 0;
+		bFailed = false;
+	}
+
+	inline void ResetPos(std::size_t InBitPos = 0) const { BitPos = InBitPos; }
+	inline std::size_t GetBitPosition() const { return BitPos; }
+	inline std::size_t GetBitSize() const { return BitSize; }
+	inline std::size_t GetByteSize() const { return (BitSize + 7) / 8; }
+	/*
+	* Whole bytes the reader has touched, what to skip in the byte archive it was read from.
+	*/
+	inline std::size_t GetBytesRead() const { return (BitPos + 7) / 8; }
+	inline const std::uint8_t* GetData() const { return Source ? Source : Data.data(); }
+	inline bool IsFailed() const { return bFailed; }
+
+	inline void WriteBits(std::uint64_t Value, std::uint32_t NumBits)
+	{
+		if (NumBits < 64)
+			Value &= (1ull << NumBits) - 1;
+
+		Data.resize((BitSize + NumBits + 7) / 8);
+		while (NumBits > 0)
+		{
+			const std::uint32_t Offset = (std::uint32_t)(BitSize & 7);
+			const std::uint32_t Count = NumBits < 8 - Offset ? NumBits : 8 - Offset;
+			Data[BitSize >> 3] |= (std::uint8_t)((Value & ((1u << Count) - 1)) << Offset);
+			Value >>= Count;
+			NumBits -= Count;
+			BitSize += Count;
+		}
+	}
+
+	inline std::uint64_t ReadBits(std::uint32_t NumBits) const
+	{
+		if (NumBits > 64 || BitPos + NumBits > BitSize)
+		{
+			bFailed = true;
+			BitPos = BitSize;
+			return 0;
+		}
+
+		const std::uint8_t* Bytes = GetData();
+		std::uint64_t Value = 0;
+		std::uint32_t Shift = 0;
+		while (NumBits > 0)
+		{
+			const std::uint32_t Offset = (std::uint32_t)(BitPos & 7);
+			const std::uint32_t Count = NumBits < 8 - Offset ? NumBits : 8 - Offset;
+			Value |= (std::uint64_t)((Bytes[BitPos >> 3] >> Offset) & ((1u << Count) - 1)) << Shift;
+			Shift += Count;
+			NumBits -= Count;
+			BitPos += Count;
+		}
+		return Value;
+	}
+
+	inline void WriteBool(bool Value) { WriteBits(Value ? 1 : 0, 1); }
+	inline bool ReadBool() const { return ReadBits(1) != 0; }
+
+	/*
+	* 7 bits per group with a continuation bit, small values take a byte.
+	*/
+	inline void WriteVarUInt(std::uint64_t Value)
+	{
+		while (Value >= 0x80)
+		{
+			WriteBits((Value & 0x7F) | 0x80, 8);
+			Value >>= 7;
+		}
+		WriteBits(Value, 8);
+	}
+	inline std::uint64_t ReadVarUInt() const
+	{
+		std::uint64_t Value = 0;
+		for (std::uint32_t Shift = 0; Shift < 64; Shift += 7)
+		{
+			const std::uint64_t Group = ReadBits(8);
+			Value |= (Group & 0x7F) << Shift;
+			if ((Group & 0x80) == 0 || bFailed)
+				return Value;
+		}
+		bFailed = true;
+		return Value;
+	}
+
+	/*
+	* ZigZag, small negative values stay small.
+	*/
+	static constexpr std::uint64_t ZigZagEncode(std::int64_t Value) { return ((std::uint64_t)Value << 1) ^ (std::uint64_t)(Value >> 63); }
+	static constexpr std::int64_t ZigZagDecode(std::uint64_t Value) { return (std::int64_t)(Value >> 1) ^ -(std::int64_t)(Value & 1); }
+
+	inline void WriteVarInt(std::int64_t Value) { WriteVarUInt(ZigZagEncode(Value)); }
+	inline std::int64_t ReadVarInt() const { return ZigZagDecode(ReadVarUInt()); }
+
+	/*
+	* Clamped to [Min, Max] and stored in NumBits, the error is at most half a step of (Max - Min) / (2^NumBits - 1).
+	*/
+	inline void WriteQuantizedFloat(float Value, float Min, float Max, std::uint32_t NumBits)
+	{
+		const std::uint64_t Steps = (NumBits >= 32 ? 0xFFFFFFFFull : (1ull << NumBits) - 1);
+		float Normalized = Max > Min ? (Value - Min) / (Max - Min) : 0.0f;
+		Normalized = Normalized < 0.0f ? 0.0f : Normalized > 1.0f ? 1.0f : Normalized;
+		WriteBits((std::uint64_t)std::llround((double)Normalized * (double)Steps), NumBits);
+	}
+	inline float ReadQuantizedFloat(float Min, float Max, std::uint32_t NumBits) const
+	{
+		const std::uint64_t Steps = (NumBits >= 32 ? 0xFFFFFFFFull : (1ull << NumBits) - 1);
+		const std::uint64_t Value = ReadBits(NumBits);
+		return Min + (float)((double)Value / (double)Steps * (double)(Max - Min));
+	}
+
+	/*
+	* Bits needed to cover [Min, Max] at the given resolution.
+	*/
+	static inline std::uint32_t GetBitsForRange(float Min, float Max, float Resolution)
+	{
+		const double Steps = Resolution > 0.0f ? std::ceil((double)(Max - Min) / (double)Resolution) : 0.0;
+		std::uint32_t Bits = 1;
+		while (Bits < 32 && (double)((1ull << Bits) - 1) < Steps)
+			Bits++;
+		return Bits;
+	}
+
+	/*
+	* Position inside the level bounds at the given resolution in world units.
+	* A 4096 unit wide level at 1/64 unit takes 18 bits per axis instead of 32.
+	*/
+	inline void WritePosition2D(const FVector2& Position, const FBounds2D& Bounds, float Resolution)
+	{
+		WriteQuantizedFloat(Position.X, Bounds.Min.X, Bounds.Max.X, GetBitsForRange(Bounds.Min.X, Bounds.Max.X, Resolution));
+		WriteQuantizedFloat(Position.Y, Bounds.Min.Y, Bounds.Max.Y, GetBitsForRange(Bounds.Min.Y, Bounds.Max.Y, Resolution));
+	}
+	inline FVector2 ReadPosition2D(const FBounds2D& Bounds, float Resolution) const
+	{
+		const float X = ReadQuantizedFloat(Bounds.Min.X, Bounds.Max.X, GetBitsForRange(Bounds.Min.X, Bounds.Max.X, Resolution));
+		const float Y = ReadQuantizedFloat(Bounds.Min.Y, Bounds.Max.Y, GetBitsForRange(Bounds.Min.Y, Bounds.Max.Y, Resolution));
+		return FVector2(X, Y);
+	}
+
+	/*
+	* Smallest three: the index of the largest component in 2 bits and the other three in BitsPerComponent each.
+	* q and -q are the same rotation, the largest component is made positive and left out.
+	* 32 bits at the default instead of 128, zero components stay exact.
+	*/
+	inline void WriteQuaternion(const FVector4& Quaternion, std::uint32_t BitsPerComponent = 10)
+	{
+		const float Components[4] = { Quaternion.X, Quaternion.Y, Quaternion.Z, Quaternion.W };
+		std::uint32_t Largest = 0;
+		for (std::uint32_t i = 1; i < 4; i++)
+		{
+			if (std::fabs(Components[i]) > std::fabs(Components[Largest]))
+				Largest = i;
+		}
+
+		const float Sign = Components[Largest] < 0.0f ? -1.0f : 1.0f;
+		WriteBits(Largest, 2);
+		for (std::uint32_t i = 0; i < 4; i++)
+		{
+			if (i != Largest)
+				WriteSignedUnit(Components[i] * Sign * QuaternionComponentScale, BitsPerComponent);
+		}
+	}
+	inline FVector4 ReadQuaternion(std::uint32_t BitsPerComponent = 10) const
+	{
+		const std::uint32_t Largest = (std::uint32_t)ReadBits(2);
+		float Components[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float SquaredSum = 0.0f;
+		for (std::uint32_t i = 0; i < 4; i++)
+		{
+			if (i == Largest)
+				continue;
+			Components[i] = ReadSignedUnit(BitsPerComponent) / QuaternionComponentScale;
+			SquaredSum += Components[i] * Components[i];
+		}
+		Components[Largest] = SquaredSum < 1.0f ? std::sqrt(1.0f - SquaredSum) : 0.0f;
+		return FVector4(Components[0], Components[1], Components[2], Components[3]);
+	}
+
+	/*
+	* Raw bytes into a byte archive, no size prefix.
+	*/
+	inline void WriteTo(sArchive& Archive) const
+	{
+		Archive.WriteBytes(GetData(), GetByteSize());
+	}
+
+private:
+	/*
+	* The three smaller components of a unit quaternion are within +-1/sqrt(2).
+	*/
+	static constexpr float QuaternionComponentScale = 1.41421356f;
+
+	/*
+	* [-1, 1] over an even number of steps, 0 falls on a step.
+	*/
+	inline void WriteSignedUnit(float Value, std::uint32_t NumBits)
+	{
+		const std::int64_t HalfSteps = (1ll << (NumBits - 1)) - 1;
+		Value = Value < -1.0f ? -1.0f : Value > 1.0f ? 1.0f : Value;
+		WriteBits((std::uint64_t)(std::llround((double)Value * (double)HalfSteps) + HalfSteps), NumBits);
+	}
+	inline float ReadSignedUnit(std::uint32_t NumBits) const
+	{
+		const std::int64_t HalfSteps = (1ll << (NumBits - 1)) - 1;
+		const std::int64_t Value = (std::int64_t)ReadBits(NumBits) - HalfSteps;
+		return (float)((double)Value / (double)HalfSteps);
+	}
+
+	std::vector<std::uint8_t> Data;
+	const std::uint8_t* Source;
+	std::size_t SourceSize;
+	mutable std::size_t BitPos;
+	std::size_t BitSize;
+	mutable bool bFailed;
+};
+
+/*
+* Opt-in bit packing for archive and RPC parameter types.
+* A specialization provides
+*	static void Write(sBitArchive& Archive, const T& data);
+*	static void Read(const sBitArchive& Archive, T& data);
+* and the type is then written to sArchive as its packed bytes and read back from sArchive/sArchiveView,
+* RemoteProcedureCall parameters included. Each value is padded to a whole byte, pack related fields in one type.
+*/
+template <typename T>
+struct sBitPacked : std::false_type {};
+
+template <typename T>
+inline std::enable_if_t<sBitPacked<T>::value, sArchive&> operator<<(sArchive& Archive, const T& data)
+{
+	sBitArchive Bits;
+	sBitPacked<T>::Write(Bits, data);
+	Bits.WriteTo(Archive);
+	return Archive;
+}
+
+template <typename T>
+inline std::enable_if_t<sBitPacked<T>::value, const sArchiveView&> operator>>(const sArchiveView& Archive, T& data)
+{
+	const sBitArchive Bits(Archive);
+	sBitPacked<T>::Read(Bits, data);
+	Archive.Consume(Bits.GetBytesRead());
+	if (Bits.IsFailed())
+		Archive.SetFailed();
+	return Archive;
+}
+
+template <typename T>
+inline std::enable_if_t<sBitPacked<T>::value> operator>>(const sArchive& Archive, T& data)
+{
+	sArchiveView::Read(Archive, data);
+}
+
+/*
+* Unit quaternion in smallest-three form, 4 bytes instead of 16.
+*/
+struct sQuantizedRotation
+{
+	FVector4 Value = FVector4(0.0f, 0.0f, 0.0f, 1.0f);
+
+	sQuantizedRotation() = default;
+	sQuantizedRotation(const FVector4& InValue)
+		: Value(InValue)
+	{}
+	inline operator FVector4() const { return Value; }
+
+	friend bool operator==(const sQuantizedRotation& v1, const sQuantizedRotation& v2) { return v1.Value == v2.Value; }
+	friend bool operator!=(const sQuantizedRotation& v1, const sQuantizedRotation& v2) { return v1.Value != v2.Value; }
+};
+
+template <>
+struct sBitPacked<sQuantizedRotation> : std::true_type
+{
+	static inline void Write(sBitArchive& Archive, const sQuantizedRotation& data) { Archive.WriteQuaternion(data.Value); }
+	static inline void Read(const sBitArchive& Archive, sQuantizedRotation& data) { data.Value = Archive.ReadQuaternion(); }
+};
+
+/*
+* ZigZag varint, counters and IDs that are usually small take one or two bytes.
+*/
+template <typename T>
+struct sVarInt
+{
+	static_assert(std::is_integral_v<T>, "sVarInt is for integers");
+	T Value = 0;
+
+	sVarInt() = default;
+	sVarInt(T InValue)
+		: Value(InValue)
+	{}
+	inline operator T() const { return Value; }
+};
+
+template <typename T>
+struct sBitPacked<sVarInt<T>> : std::true_type
+{
+	static inline void Write(sBitArchive& Archive, const sVarInt<T>& data)
+	{
+		if constexpr (std::is_signed_v<T>)
+			Archive.WriteVarInt((std::int64_t)data.Value);
+		else
+			Archive.WriteVarUInt((std::uint64_t)data.Value);
+	}
+	static inline void Read(const sBitArchive& Archive, sVarInt<T>& data)
+	{
+		if constexpr (std::is_signed_v<T>)
+			data.Value = (T)Archive.ReadVarInt();
+		else
+			data.Value = (T)Archive.ReadVarUInt();
+	}
+};
+
+/*
+* Float in a fixed range, the range type provides
+*	static constexpr float Min, Max;
+*	static constexpr std::uint32_t Bits;
+*/
+template <typename TRange>
+struct sQuantizedFloat
+{
+	float Value = 0.0f;
+
+	sQuantizedFloat() = default;
+	sQuantizedFloat(float InValue)
+		: Value(InValue)
+	{}
+	inline operator float() const { return Value; }
+};
+
+template <typename TRange>
+struct sBitPacked<sQuantizedFloat<TRange>> : std::true_type
+{
+	static inline void Write(sBitArchive& Archive, const sQuantizedFloat<TRange>& data) { Archive.WriteQuantizedFloat(data.Value, TRange::Min, TRange::Max, TRange::Bits); }
+	static inline void Read(const sBitArchive& Archive, sQuantizedFloat<TRange>& data) { data.Value = Archive.ReadQuantizedFloat(TRange::Min, TRange::Max, TRange::Bits); }
+};
+
+/*
+* 2D position inside fixed level bounds, the bounds type provides
+*	static constexpr float MinX, MinY, MaxX, MaxY, Resolution;
+*/
+template <typename TBounds>
+struct sQuantizedPosition2D
+{
+	FVector2 Value = FVector2(0.0f, 0.0f);
+
+	sQuantizedPosition2D() = default;
+	sQuantizedPosition2D(const FVector2& InValue)
+		: Value(InValue)
+	{}
+	inline operator FVector2() const { return Value; }
+
+	static inline FBounds2D GetBounds() { return FBounds2D(FVector2(TBounds::MinX, TBounds::MinY), FVector2(TBounds::MaxX, TBounds::MaxY)); }
+};
+
+template <typename TBounds>
+struct sBitPacked<sQuantizedPosition2D<TBounds>> : std::true_type
+{
+	static inline void Write(sBitArchive& Archive, const sQuantizedPosition2D<TBounds>& data) { Archive.WritePosition2D(data.Value, sQuantizedPosition2D<TBounds>::GetBounds(), TBounds::Resolution); }
+	static inline void Read(const sBitArchive& Archive, sQuantizedPosition2D<TBounds>& data) { data.Value = Archive.ReadPosition2D(sQuantizedPosition2D<TBounds>::GetBounds(), TBounds::Resolution); }
+};
@@ -123,7 +123,7 @@ private:
         if (bIsOrthographic)
             return;
 
-        float Y = 1.0f / std::tanf(m_VerticalFOV * 0.5f);
+        float Y = 1.0f / std::tan(m_VerticalFOV * 0.5f);
         float X = Y * m_AspectRatio;
 
         float Q1, Q2;
@@ -0,0 +1,167 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <filesystem>
+#include <cstdint>
+#include "Engine/ClassBody.h"
+#include "Core/Archive.h"
+#include "Core/ArchiveView.h"
+
+enum class eCompressionCodec : std::uint8_t
+{
+	None,
+	LZ,
+	Max = 16,
+};
+
+/*
+* Bytes both sides know before the first message, matches can point into it.
+* Small messages have little history of their own, a dictionary of common headers and names gives them some.
+*/
+class sCompressionDictionary
+{
+	sBaseClassBody(sClassConstructor, sCompressionDictionary)
+public:
+	sCompressionDictionary() = default;
+	sCompressionDictionary(std::vector<std::uint8_t> InBytes);
+	sCompressionDictionary(const std::vector<std::string>& Strings);
+
+	inline const std::uint8_t* GetData() const { return Bytes.data(); }
+	inline std::size_t GetSize() const { return Bytes.size(); }
+	/*
+	* Hash of the bytes, stored in the frame so a mismatched dictionary fails instead of decoding garbage.
+	*/
+	inline std::uint32_t GetID() const { return ID; }
+
+private:
+	std::vector<std::uint8_t> Bytes;
+	std::uint32_t ID = 0;
+};
+
+/*
+* Counters for one compression user, ratio is BytesOut / BytesIn of the compressed messages only.
+*/
+struct sCompressionStats
+{
+	std::uint64_t CompressedCount = 0;
+	std::uint64_t SkippedCount = 0;
+	std::uint64_t DecompressedCount = 0;
+	std::uint64_t FailedCount = 0;
+	std::uint64_t BytesIn = 0;
+	std::uint64_t BytesOut = 0;
+	double CompressTimeMS = 0.0;
+	double DecompressTimeMS = 0.0;
+
+	inline double GetRatio() const { return BytesIn > 0 ? (double)BytesOut / (double)BytesIn : 1.0; }
+};
+
+class ICompressionCodec
+{
+	sBaseClassBody(sClassDefaultProtectedConstructor, ICompressionCodec)
+public:
+	/*
+	* Worst case output size for Size input bytes.
+	*/
+	virtual std::size_t GetMaxCompressedSize(std::size_t Size) const = 0;
+	/*
+	* Largest output Size input bytes can decode to, frames claiming more are rejected before allocating.
+	*/
+	virtual std::size_t GetMaxDecompressedSize(std::size_t Size) const = 0;
+	/*
+	* Returns the compressed size, 0 if it doesn't fit into Capacity.
+	*/
+	virtual std::size_t Compress(const void* Source, std::size_t Size, void* Dest, std::size_t Capacity, const sCompressionDictionary* Dictionary = nullptr) const = 0;
+	/*
+	* Dest must hold exactly RawSize bytes, fails on malformed input instead of reading or writing out of bounds.
+	*/
+	virtual bool Decompress(const void* Source, std::size_t Size, void* Dest, std::size_t RawSize, const sCompressionDictionary* Dictionary = nullptr) const = 0;
+};
+
+/*
+* Byte oriented LZ77, literal runs and (offset, length) copies from a 64 KB window.
+* Single probe hash table, no entropy stage, speed is close to memcpy on decode.
+*/
+class sLZCodec : public ICompressionCodec
+{
+	sClassBody(sClassConstructor, sLZCodec, ICompressionCodec)
+public:
+	sLZCodec() = default;
+	virtual ~sLZCodec() = default;
+
+	virtual std::size_t GetMaxCompressedSize(std::size_t Size) const override;
+	virtual std::size_t GetMaxDecompressedSize(std::size_t Size) const override;
+	virtual std::size_t Compress(const void* Source, std::size_t Size, void* Dest, std::size_t Capacity, const sCompressionDictionary* Dictionary = nullptr) const override;
+	virtual bool Decompress(const void* Source, std::size_t Size, void* Dest, std::size_t RawSize, const sCompressionDictionary* Dictionary = nullptr) const override;
+};
+
+/*
+* Framed compression: codec, dictionary ID, raw size and payload size ahead of the codec output, so the reader needs nothing else.
+* Frames are written only when they come out smaller than the input.
+*/
+namespace Compression
+{
+	constexpr std::size_t FrameHeaderSize = sizeof(std::uint8_t) + sizeof(std::uint32_t) * 3;
+	/*
+	* Frames claiming more than this are rejected before anything is allocated.
+	*/
+	constexpr std::size_t MaxRawSize = 256ull * 1024ull * 1024ull;
+
+	/*
+	* LZ is registered by default, a custom codec takes a free ID below eCompressionCodec::Max.
+	*/
+	void RegisterCodec(eCompressionCodec ID, std::shared_ptr<ICompressionCodec> Codec);
+	ICompressionCodec* GetCodec(eCompressionCodec ID);
+
+	/*
+	* Appends a frame to Out, false (and Out untouched) if the codec is unknown or the frame isn't smaller.
+	*/
+	bool Compress(const void* Source, std::size_t Size, std::vector<std::uint8_t>& Out, eCompressionCodec Codec = eCompressionCodec::LZ,
+		const sCompressionDictionary* Dictionary = nullptr, sCompressionStats* Stats = nullptr);
+	/*
+	* Reads one frame from the view position, the view moves past it. Bytes after the frame are left alone.
+	* MaxSize caps the raw size, untrusted input like network packets passes its own limit.
+	*/
+	bool Decompress(const sArchiveView& Frame, std::vector<std::uint8_t>& Out, const sCompressionDictionary* Dictionary = nullptr, sCompressionStats* Stats = nullptr,
+		std::size_t MaxSize = MaxRawSize);
+
+	/*
+	* Whole archive in and out. Archives that don't get smaller are stored as a frame with codec None.
+	* Out is rewound after decompression, ready to read.
+	*/
+	void CompressArchive(const sArchive& Archive, sArchive& Out, eCompressionCodec Codec = eCompressionCodec::LZ, sCompressionStats* Stats = nullptr);
+	bool DecompressArchive(const sArchiveView& Archive, sArchive& Out, sCompressionStats* Stats = nullptr);
+
+	/*
+	* Save games and cooked assets, written through sArchiveFileWriter and read from a mapping.
+	*/
+	bool SaveCompressedFile(const std::filesystem::path& Path, const sArchive& Archive, eCompressionCodec Codec = eCompressionCodec::LZ, sCompressionStats* Stats = nullptr);
+	bool LoadCompressedFile(const std::filesystem::path& Path, sArchive& Out, sCompressionStats* Stats = nullptr);
+}
@@ -0,0 +1,435 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <coroutine>
+#include <optional>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include "Engine/ClassBody.h"
+#include "Core/ThreadPool.h"
+
+namespace CoroutineDetail
+{
+	/*
+	* 0 = running, 1 = completed, 2 = detached, 3 = cancelled, anything else is the awaiting coroutine.
+	*/
+	enum : std::uintptr_t
+	{
+		eRunning = 0,
+		eCompleted = 1,
+		eDetached = 2,
+		eCancelled = 3,
+	};
+
+	struct sPromiseBase
+	{
+		std::atomic<std::uintptr_t> State = eRunning;
+		/*
+		* Promise of the awaiting coroutine when it is an sTask, set before State publishes it.
+		*/
+		sPromiseBase* AwaitingPromise = nullptr;
+
+		std::suspend_never initial_suspend() noexcept { return {}; }
+
+		struct sFinalAwaiter
+		{
+			bool await_ready() const noexcept { return false; }
+
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> Handle) noexcept
+			{
+				const std::uintptr_t Previous = Handle.promise().State.exchange(eCompleted, std::memory_order_acq_rel);
+				if (Previous == eDetached)
+				{
+					Handle.destroy();
+					return std::noop_coroutine();
+				}
+				if (Previous != eRunning)
+					return std::coroutine_handle<>::from_address(reinterpret_cast<void*>(Previous));
+				return std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		sFinalAwaiter final_suspend() noexcept { return {}; }
+		void unhandled_exception() noexcept { std::terminate(); }
+	};
+
+	template<typename Promise>
+	inline sPromiseBase* GetPromise(std::coroutine_handle<Promise> Handle)
+	{
+		if constexpr (std::is_base_of_v<sPromiseBase, Promise>)
+			return &Handle.promise();
+		else
+			return nullptr;
+	}
+}
+
+/*
+* Resumes suspended coroutines on the game thread.
+* Tick is called by the engine once per frame before the world is ticked.
+*/
+class sCoroutineScheduler
+{
+	sBaseClassBody(sClassNoDefaults, sCoroutineScheduler);
+private:
+	sCoroutineScheduler()
+		: Pool(nullptr)
+		, BlockingPool(nullptr)
+		, GameThreadID(std::this_thread::get_id())
+	{}
+	sCoroutineScheduler(const sCoroutineScheduler& Other) = delete;
+	sCoroutineScheduler& operator=(const sCoroutineScheduler&) = delete;
+
+public:
+	static sCoroutineScheduler& Get()
+	{
+		static sCoroutineScheduler instance;
+		return instance;
+	}
+
+	~sCoroutineScheduler() = default;
+
+	/*
+	* The calling thread becomes the game thread.
+	* Background work goes to InBlockingPool, the game thread never helps running it.
+	*/
+	void Initialize(ThreadPool* InPool, ThreadPool* InBlockingPool);
+	/*
+	* Drops every pending coroutine without resuming it.
+	* Frames of dropped sTasks are destroyed, the ones still owned by an sTask are destroyed when the task is dropped.
+	*/
+	void Destroy();
+
+	void Tick();
+
+	/*
+	* Promise is the sTask promise of the coroutine, nullptr for other coroutine types.
+	*/
+	void PostToGameThread(std::coroutine_handle<> Handle, CoroutineDetail::sPromiseBase* Promise = nullptr);
+	void PostNextFrame(std::coroutine_handle<> Handle, CoroutineDetail::sPromiseBase* Promise = nullptr);
+	void PostDelayed(std::coroutine_handle<> Handle, double Seconds, CoroutineDetail::sPromiseBase* Promise = nullptr);
+	void PostOnJobCompleted(std::coroutine_handle<> Handle, const sJobHandle& Job, CoroutineDetail::sPromiseBase* Promise = nullptr);
+	/*
+	* Resumes the coroutine on a blocking pool thread.
+	*/
+	void PostToBackground(std::coroutine_handle<> Handle);
+	sJobHandle Schedule(const std::function<void()>& Function);
+	/*
+	* For work that may block, runs on the blocking pool.
+	*/
+	sJobHandle ScheduleBlocking(const std::function<void()>& Function);
+
+	inline bool IsGameThread() const { return std::this_thread::get_id() == GameThreadID; }
+	std::size_t GetPendingCount();
+
+private:
+	struct sSuspended
+	{
+		std::coroutine_handle<> Handle;
+		CoroutineDetail::sPromiseBase* Promise = nullptr;
+	};
+
+	struct sDelayed
+	{
+		std::chrono::steady_clock::time_point Deadline;
+		sSuspended Coroutine;
+	};
+
+	struct sWaitingForJob
+	{
+		sJobHandle Job;
+		sSuspended Coroutine;
+	};
+
+	static void Cancel(std::coroutine_handle<> Handle, CoroutineDetail::sPromiseBase* Promise);
+
+	ThreadPool* Pool;
+	ThreadPool* BlockingPool;
+	std::thread::id GameThreadID;
+
+	std::mutex Mutex;
+	std::vector<sSuspended> GameThreadQueue;
+	std::vector<sSuspended> NextFrameQueue;
+	std::vector<sDelayed> DelayedQueue;
+	std::vector<sWaitingForJob> JobQueue;
+};
+
+/*
+* Eagerly started coroutine task.
+* Dropping the task detaches the coroutine, it keeps running and frees itself when it is finished.
+* A coroutine cancelled by sCoroutineScheduler::Destroy is freed by the task when it is dropped.
+* co_await on the task resumes the awaiting coroutine on the thread that finishes the task.
+*
+*	sTask<> LoadLevel()
+*	{
+*		auto Data = co_await Engine::RunAsync([]() { return FileManager::ReadDataFromFile(Path); });
+*		co_await Engine::NextFrame();
+*		...
+*	}
+*/
+template<typename T = void>
+class sTask
+{
+public:
+	struct promise_type : public CoroutineDetail::sPromiseBase
+	{
+		std::optional<T> Value;
+
+		sTask get_return_object() { return sTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		template<typename U>
+		void return_value(U&& InValue) { Value.emplace(std::forward<U>(InValue)); }
+	};
+
+	sTask() = default;
+	explicit sTask(std::coroutine_handle<promise_type> InHandle)
+		: Handle(InHandle)
+	{}
+	sTask(const sTask&) = delete;
+	sTask& operator=(const sTask&) = delete;
+	sTask(sTask&& Other) noexcept
+		: Handle(std::exchange(Other.Handle, nullptr))
+	{}
+	sTask& operator=(sTask&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Detach();
+			Handle = std::exchange(Other.Handle, nullptr);
+		}
+		return *this;
+	}
+	~sTask()
+	{
+		Detach();
+	}
+
+	inline bool IsValid() const { return (bool)Handle; }
+	inline bool IsReady() const { return Handle && Handle.promise().State.load(std::memory_order_acquire) == CoroutineDetail::eCompleted; }
+	/*
+	* Valid only when IsReady returns true.
+	*/
+	inline T& Get() { return *Handle.promise().Value; }
+
+	bool await_ready() const noexcept { return IsReady(); }
+	template<typename Promise>
+	bool await_suspend(std::coroutine_handle<Promise> Awaiting) noexcept
+	{
+		Handle.promise().AwaitingPromise = CoroutineDetail::GetPromise(Awaiting);
+		std::uintptr_t Expected = CoroutineDetail::eRunning;
+		return Handle.promise().State.compare_exchange_strong(Expected, reinterpret_cast<std::uintptr_t>(Awaiting.address()), std::memory_order_acq_rel);
+	}
+	T await_resume() { return std::move(*Handle.promise().Value); }
+
+private:
+	void Detach()
+	{
+		if (!Handle)
+			return;
+		const std::uintptr_t Previous = Handle.promise().State.exchange(CoroutineDetail::eDetached, std::memory_order_acq_rel);
+		if (Previous == CoroutineDetail::eCompleted || Previous == CoroutineDetail::eCancelled)
+			Handle.destroy();
+		Handle = nullptr;
+	}
+
+	std::coroutine_handle<promise_type> Handle;
+};
+
+template<>
+class sTask<void>
+{
+public:
+	struct promise_type : public CoroutineDetail::sPromiseBase
+	{
+		sTask get_return_object() { return sTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		void return_void() {}
+	};
+
+	sTask() = default;
+	explicit sTask(std::coroutine_handle<promise_type> InHandle)
+		: Handle(InHandle)
+	{}
+	sTask(const sTask&) = delete;
+	sTask& operator=(const sTask&) = delete;
+	sTask(sTask&& Other) noexcept
+		: Handle(std::exchange(Other.Handle, nullptr))
+	{}
+	sTask& operator=(sTask&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Detach();
+			Handle = std::exchange(Other.Handle, nullptr);
+		}
+		return *this;
+	}
+	~sTask()
+	{
+		Detach();
+	}
+
+	inline bool IsValid() const { return (bool)Handle; }
+	inline bool IsReady() const { return Handle && Handle.promise().State.load(std::memory_order_acquire) == CoroutineDetail::eCompleted; }
+
+	bool await_ready() const noexcept { return IsReady(); }
+	template<typename Promise>
+	bool await_suspend(std::coroutine_handle<Promise> Awaiting) noexcept
+	{
+		Handle.promise().AwaitingPromise = CoroutineDetail::GetPromise(Awaiting);
+		std::uintptr_t Expected = CoroutineDetail::eRunning;
+		return Handle.promise().State.compare_exchange_strong(Expected, reinterpret_cast<std::uintptr_t>(Awaiting.address()), std::memory_order_acq_rel);
+	}
+	void await_resume() noexcept {}
+
+private:
+	void Detach()
+	{
+		if (!Handle)
+			return;
+		const std::uintptr_t Previous = Handle.promise().State.exchange(CoroutineDetail::eDetached, std::memory_order_acq_rel);
+		if (Previous == CoroutineDetail::eCompleted || Previous == CoroutineDetail::eCancelled)
+			Handle.destroy();
+		Handle = nullptr;
+	}
+
+	std::coroutine_handle<promise_type> Handle;
+};
+
+struct sResumeOnGameThread
+{
+	bool await_ready() const noexcept { return sCoroutineScheduler::Get().IsGameThread(); }
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> Handle) const { sCoroutineScheduler::Get().PostToGameThread(Handle, CoroutineDetail::GetPromise(Handle)); }
+	void await_resume() const noexcept {}
+};
+
+struct sResumeOnBackground
+{
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> Handle) const { sCoroutineScheduler::Get().PostToBackground(Handle); }
+	void await_resume() const noexcept {}
+};
+
+struct sNextFrame
+{
+	bool await_ready() const noexcept { return false; }
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> Handle) const { sCoroutineScheduler::Get().PostNextFrame(Handle, CoroutineDetail::GetPromise(Handle)); }
+	void await_resume() const noexcept {}
+};
+
+struct sDelay
+{
+	double Seconds = 0.0;
+
+	bool await_ready() const noexcept { return Seconds <= 0.0; }
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> Handle) const { sCoroutineScheduler::Get().PostDelayed(Handle, Seconds, CoroutineDetail::GetPromise(Handle)); }
+	void await_resume() const noexcept {}
+};
+
+/*
+* Runs Function on a blocking pool thread, resumes the awaiting coroutine on the game thread with the result.
+*/
+template<typename T>
+struct sAsyncAwaiter
+{
+	std::function<T()> Function;
+	std::optional<T> Result;
+
+	bool await_ready() const noexcept { return false; }
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> Handle)
+	{
+		sCoroutineScheduler::Get().ScheduleBlocking([this, Handle]()
+			{
+				Result.emplace(Function());
+				sCoroutineScheduler::Get().PostToGameThread(Handle, CoroutineDetail::GetPromise(Handle));
+			});
+	}
+	T await_resume() { return std::move(*Result); }
+};
+
+template<>
+struct sAsyncAwaiter<void>
+{
+	std::function<void()> Function;
+
+	bool await_ready() const noexcept { return false; }
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> Handle)
+	{
+		sCoroutineScheduler::Get().ScheduleBlocking([this, Handle]()
+			{
+				Function();
+				sCoroutineScheduler::Get().PostToGameThread(Handle, CoroutineDetail::GetPromise(Handle));
+			});
+	}
+	void await_resume() const noexcept {}
+};
+
+/*
+* co_await on a job handle resumes on the game thread once the job tree is completed.
+*/
+struct sJobAwaiter
+{
+	sJobHandle Job;
+
+	bool await_ready() const noexcept { return Job.IsCompleted(); }
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> Handle) const { sCoroutineScheduler::Get().PostOnJobCompleted(Handle, Job, CoroutineDetail::GetPromise(Handle)); }
+	void await_resume() const noexcept {}
+};
+
+inline sJobAwaiter operator co_await(const sJobHandle& Job)
+{
+	return sJobAwaiter{ Job };
+}
+
+namespace Engine
+{
+	inline sResumeOnGameThread ResumeOnGameThread() { return sResumeOnGameThread(); }
+	inline sResumeOnBackground ResumeOnBackground() { return sResumeOnBackground(); }
+	inline sNextFrame NextFrame() { return sNextFrame(); }
+	inline sDelay Delay(double Seconds) { return sDelay{ Seconds }; }
+
+	template<typename Func>
+	inline auto RunAsync(Func&& Function)
+	{
+		using ResultType = std::invoke_result_t<Func>;
+		return sAsyncAwaiter<ResultType>{ std::function<ResultType()>(std::forward<Func>(Function)) };
+	}
+}
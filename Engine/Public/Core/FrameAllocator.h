@@ -0,0 +1,152 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "Engine/ClassBody.h"
+
+struct sFrameMemoryStats
+{
+	std::uint64_t FrameIndex = 0;
+	/*
+	* Global operator new calls during the frame, 0 if Enable_MemoryTracking is off (Engine/MemoryManager.h).
+	*/
+	std::uint64_t HeapAllocations = 0;
+	std::uint64_t HeapAllocatedBytes = 0;
+	/*
+	* Bytes handed out by the frame arenas of every thread.
+	*/
+	std::uint64_t FrameArenaBytes = 0;
+	/*
+	* Arena blocks that had to be allocated because the arena ran out, 0 in steady state.
+	*/
+	std::uint64_t FrameArenaBlockAllocations = 0;
+};
+
+/*
+* Per-thread, per-frame linear arena.
+* Allocations bump a pointer and are never freed one by one, the arena rewinds when the thread allocates
+* in a new frame. Every thread keeps two arenas and alternates them by frame, so memory is valid until the
+* end of the frame after the one it was allocated in, overlapped tasks can still read it.
+* Blocks that were added during a frame are merged into one block on rewind, steady-state frames don't malloc.
+*/
+class sFrameAllocator
+{
+	sBaseClassBody(sClassNoDefaults, sFrameAllocator)
+public:
+	static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+	/*
+	* Arena of the calling thread.
+	*/
+	static sFrameAllocator& Get();
+
+	/*
+	* Called once per frame by the game thread, starts a new frame for every thread.
+	*/
+	static void BeginFrame();
+	static std::uint64_t GetFrameIndex();
+	/*
+	* Stats of the last completed frame.
+	*/
+	static sFrameMemoryStats GetLastFrameStats();
+	static sFrameMemoryStats GetCurrentFrameStats();
+
+	void* Allocate(std::size_t Size, std::size_t Alignment = alignof(std::max_align_t));
+	/*
+	* Only gives the memory back if it was the last allocation of this thread, vector growth reuses it.
+	*/
+	void Deallocate(void* Ptr, std::size_t Size);
+
+	~sFrameAllocator();
+
+private:
+	sFrameAllocator();
+
+	sFrameAllocator(const sFrameAllocator&) = delete;
+	sFrameAllocator& operator=(const sFrameAllocator&) = delete;
+
+	struct sBlock
+	{
+		std::uint8_t* Memory = nullptr;
+		std::size_t Size = 0;
+	};
+
+	struct sArena
+	{
+		std::vector<sBlock> Blocks;
+		std::size_t BlockIndex = 0;
+		std::size_t Offset = 0;
+		std::uint64_t FrameIndex = ~0ull;
+		std::uint8_t* LastAllocation = nullptr;
+	};
+
+	sArena& GetArena();
+	void Rewind(sArena& Arena);
+	void AddBlock(sArena& Arena, std::size_t MinSize);
+
+	sArena Arenas[2];
+};
+
+/*
+* STL allocator on top of the calling thread's frame arena.
+*/
+template<typename T>
+class sFrameAllocatorAdapter
+{
+public:
+	using value_type = T;
+
+	sFrameAllocatorAdapter() noexcept = default;
+	template<typename U>
+	sFrameAllocatorAdapter(const sFrameAllocatorAdapter<U>&) noexcept
+	{}
+
+	T* allocate(std::size_t Count)
+	{
+		return static_cast<T*>(sFrameAllocator::Get().Allocate(Count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* Ptr, std::size_t Count) noexcept
+	{
+		sFrameAllocator::Get().Deallocate(Ptr, Count * sizeof(T));
+	}
+
+	template<typename U>
+	bool operator==(const sFrameAllocatorAdapter<U>&) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const sFrameAllocatorAdapter<U>&) const noexcept { return false; }
+};
+
+/*
+* Transient vector, valid until the end of the next frame. Don't store it in objects that outlive that.
+*/
+template<typename T>
+using sFrameVector = std::vector<T, sFrameAllocatorAdapter<T>>;
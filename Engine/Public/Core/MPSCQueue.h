@@ -0,0 +1,263 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <optional>
+#include <new>
+#include <algorithm>
+
+struct sMPSCQueueStats
+{
+	std::size_t Capacity = 0;
+	std::size_t Size = 0;
+	std::size_t PeakSize = 0;
+	std::uint64_t PushedCount = 0;
+	std::uint64_t PoppedCount = 0;
+	/*
+	* TryPush calls that found the queue full, the item was not queued.
+	*/
+	std::uint64_t RejectedCount = 0;
+	/*
+	* Push calls that found the queue full and waited for the consumer.
+	*/
+	std::uint64_t BackpressureCount = 0;
+};
+
+/*
+* Bounded lock-free multi-producer/single-consumer ring queue.
+* Every cell carries a sequence number, producers claim a cell with a CAS on the tail
+* and publish it by bumping the sequence, the consumer never writes the tail.
+* Capacity is rounded up to a power of two.
+*/
+template<typename T>
+class sMPSCQueue
+{
+public:
+	explicit sMPSCQueue(std::size_t InCapacity = 1024)
+		: Mask(RoundUpToPowerOfTwo(InCapacity) - 1)
+		, Cells(std::make_unique<sCell[]>(Mask + 1))
+		, Head(0)
+		, Tail(0)
+		, PeakSize(0)
+		, PushedCount(0)
+		, PoppedCount(0)
+		, RejectedCount(0)
+		, BackpressureCount(0)
+	{
+		for (std::size_t i = 0; i <= Mask; i++)
+			Cells[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~sMPSCQueue()
+	{
+		Clear();
+	}
+
+	sMPSCQueue(const sMPSCQueue&) = delete;
+	sMPSCQueue& operator=(const sMPSCQueue&) = delete;
+
+	/*
+	* Any thread. Returns false if the queue is full.
+	*/
+	bool TryPush(T&& Value)
+	{
+		if (!Enqueue(std::move(Value)))
+		{
+			RejectedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	bool TryPush(const T& Value)
+	{
+		return TryPush(T(Value));
+	}
+
+	/*
+	* Any thread. Waits for the consumer while the queue is full, a slow consumer throttles the producers.
+	* Returns false if bKeepWaiting turns false before there was room.
+	*/
+	bool Push(T&& Value, const std::atomic<bool>* bKeepWaiting = nullptr)
+	{
+		if (Enqueue(std::move(Value)))
+			return true;
+
+		BackpressureCount.fetch_add(1, std::memory_order_relaxed);
+		while (!bKeepWaiting || bKeepWaiting->load(std::memory_order_acquire))
+		{
+			std::this_thread::yield();
+			if (Enqueue(std::move(Value)))
+				return true;
+		}
+		RejectedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	bool Push(const T& Value, const std::atomic<bool>* bKeepWaiting = nullptr)
+	{
+		return Push(T(Value), bKeepWaiting);
+	}
+
+	/*
+	* Consumer thread only.
+	*/
+	bool TryPop(T& Out)
+	{
+		const std::size_t Pos = Head.load(std::memory_order_relaxed);
+		sCell& Cell = Cells[Pos & Mask];
+		if (Cell.Sequence.load(std::memory_order_acquire) != Pos + 1)
+			return false;
+
+		Out = std::move(*Cell.Ptr());
+		Cell.Ptr()->~T();
+		Cell.Sequence.store(Pos + Mask + 1, std::memory_order_release);
+		Head.store(Pos + 1, std::memory_order_relaxed);
+		PoppedCount.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	std::optional<T> TryPop()
+	{
+		T Value;
+		if (TryPop(Value))
+			return std::optional<T>(std::move(Value));
+		return std::nullopt;
+	}
+
+	/*
+	* Consumer thread only.
+	*/
+	void Clear()
+	{
+		T Value;
+		while (TryPop(Value)) {}
+	}
+
+	/*
+	* Approximate while producers are running.
+	*/
+	inline std::size_t Size() const
+	{
+		const std::size_t T0 = Tail.load(std::memory_order_relaxed);
+		const std::size_t H0 = Head.load(std::memory_order_relaxed);
+		return T0 > H0 ? T0 - H0 : 0;
+	}
+	inline bool IsEmpty() const { return Size() == 0; }
+	inline std::size_t Capacity() const { return Mask + 1; }
+
+	sMPSCQueueStats GetStats() const
+	{
+		sMPSCQueueStats Stats;
+		Stats.Capacity = Capacity();
+		Stats.Size = Size();
+		Stats.PeakSize = PeakSize.load(std::memory_order_relaxed);
+		Stats.PushedCount = PushedCount.load(std::memory_order_relaxed);
+		Stats.PoppedCount = PoppedCount.load(std::memory_order_relaxed);
+		Stats.RejectedCount = RejectedCount.load(std::memory_order_relaxed);
+		Stats.BackpressureCount = BackpressureCount.load(std::memory_order_relaxed);
+		return Stats;
+	}
+
+	void ResetStats()
+	{
+		PeakSize = Size();
+		PushedCount = 0;
+		PoppedCount = 0;
+		RejectedCount = 0;
+		BackpressureCount = 0;
+	}
+
+private:
+	struct sCell
+	{
+		std::atomic<std::size_t> Sequence;
+		alignas(T) unsigned char Storage[sizeof(T)];
+
+		inline T* Ptr() { return reinterpret_cast<T*>(Storage); }
+	};
+
+	static std::size_t RoundUpToPowerOfTwo(std::size_t Value)
+	{
+		std::size_t Result = 2;
+		while (Result < Value)
+			Result <<= 1;
+		return Result;
+	}
+
+	bool Enqueue(T&& Value)
+	{
+		std::size_t Pos = Tail.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			sCell& Cell = Cells[Pos & Mask];
+			const std::size_t Sequence = Cell.Sequence.load(std::memory_order_acquire);
+			const std::intptr_t Diff = (std::intptr_t)Sequence - (std::intptr_t)Pos;
+			if (Diff == 0)
+			{
+				if (Tail.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+				{
+					new (Cell.Storage) T(std::move(Value));
+					Cell.Sequence.store(Pos + 1, std::memory_order_release);
+
+					PushedCount.fetch_add(1, std::memory_order_relaxed);
+					// The consumer can already be past this cell, a negative depth counts as empty.
+					const std::intptr_t Signed = (std::intptr_t)(Pos + 1 - Head.load(std::memory_order_relaxed));
+					const std::size_t Depth = Signed <= 0 ? 0 : std::min<std::size_t>((std::size_t)Signed, Mask + 1);
+					std::size_t Peak = PeakSize.load(std::memory_order_relaxed);
+					while (Peak < Depth && !PeakSize.compare_exchange_weak(Peak, Depth, std::memory_order_relaxed)) {}
+					return true;
+				}
+			}
+			else if (Diff < 0)
+			{
+				// Full, the consumer hasn't released this cell yet.
+				return false;
+			}
+			else
+			{
+				Pos = Tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	const std::size_t Mask;
+	std::unique_ptr<sCell[]> Cells;
+
+	alignas(64) std::atomic<std::size_t> Head;
+	alignas(64) std::atomic<std::size_t> Tail;
+
+	alignas(64) std::atomic<std::size_t> PeakSize;
+	std::atomic<std::uint64_t> PushedCount;
+	std::atomic<std::uint64_t> PoppedCount;
+	std::atomic<std::uint64_t> RejectedCount;
+	std::atomic<std::uint64_t> BackpressureCount;
+};
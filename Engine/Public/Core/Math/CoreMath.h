@@ -53,6 +53,20 @@
 #define FORCEINLINE __forceinline
 #endif
 
+#if Enable_DirectX_Math
+/*
+* __m128 is a union on MSVC and a builtin vector type on GCC/Clang.
+*/
+FORCEINLINE constexpr float XMVectorLane(const DirectX::XMVECTOR& Value, const std::size_t Index)
+{
+#if defined(_MSC_VER)
+	return Value.m128_f32[Index];
+#else
+	return Value[Index];
+#endif
+}
+#endif
+
 //namespace /*CoreMath*/
 //{
 class FQuaternion;
@@ -140,10 +154,18 @@ __forceinline uint8_t Log2(uint64_t value)
 
 	// If perfect power of two (only one set bit), return index of bit.  Otherwise round up
 	// fractional log by adding 1 to most signicant set bit's index.
+#if defined(_MSC_VER)
 	if (_BitScanReverse64(&mssb, value) > 0 && _BitScanForward64(&lssb, value) > 0)
 		return uint8_t(mssb + (mssb == lssb ? 0 : 1));
 	else
 		return 0;
+#else
+	if (value == 0)
+		return 0;
+	mssb = 63 - __builtin_clzll(value);
+	lssb = __builtin_ctzll(value);
+	return uint8_t(mssb + (mssb == lssb ? 0 : 1));
+#endif
 }
 
 template <typename T> __forceinline constexpr T AlignPowerOfTwo(T value)
@@ -270,8 +292,8 @@ public:
 	{}
 
 	FORCEINLINE constexpr TVector2(const DirectX::XMVECTOR& value)
-		: X(static_cast<T>(value.m128_f32[0]))
-		, Y(static_cast<T>(value.m128_f32[1]))
+		: X(static_cast<T>(XMVectorLane(value, 0)))
+		, Y(static_cast<T>(XMVectorLane(value, 1)))
 	{}
 #endif
 	~TVector2() = default;
@@ -316,7 +338,7 @@ public:
 	}
 
 public:
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ X: " + std::to_string(X) + " Y: " + std::to_string(Y) + " };");
 	};
@@ -396,12 +418,12 @@ public:
 		Y /= divider;
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const TVector2&) const = default;
 #endif
 };
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 template<typename T>
 FORCEINLINE bool constexpr operator ==(const TVector2<T>& value1, const TVector2<T>& value2)
 {
@@ -533,6 +555,7 @@ FORCEINLINE constexpr TVector2<T> operator *(const DirectX::XMVECTOR& value1, co
 {
 	return DirectX::XMVectorMultiply(value1, DirectX::XMVectorSet(value2.X, value2.Y, 0.0f, 0.0f));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 template<typename T>
 FORCEINLINE constexpr TVector2<T> operator *(const DirectX::XMVECTOR& value1, const float& scaleFactor)
 {
@@ -543,6 +566,7 @@ FORCEINLINE constexpr TVector2<T> operator *(const float& scaleFactor, const Dir
 {
 	return DirectX::XMVectorMultiply(DirectX::XMVectorSet(scaleFactor, scaleFactor, scaleFactor, scaleFactor), value1);
 };
+#endif
 
 template<typename T>
 FORCEINLINE constexpr TVector2<T> operator /(const TVector2<T>& value1, const DirectX::XMFLOAT2& value2)
@@ -570,12 +594,14 @@ FORCEINLINE constexpr TVector2<T> operator /(const DirectX::XMVECTOR& value1, co
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(value2.X, value2.Y, 0.0f, 0.0f));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 template<typename T>
 FORCEINLINE constexpr TVector2<T> operator /(const DirectX::XMVECTOR& value1, const float& divider)
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(divider, divider, divider, divider));
 };
 #endif
+#endif
 
 typedef TVector2<float> FVector2;
 typedef FVector2 FVector2f;
@@ -669,9 +695,9 @@ public:
 	{}
 
 	FORCEINLINE constexpr TVector3(const DirectX::XMVECTOR& value)
-		: X(static_cast<T>(value.m128_f32[0]))
-		, Y(static_cast<T>(value.m128_f32[1]))
-		, Z(static_cast<T>(value.m128_f32[2]))
+		: X(static_cast<T>(XMVectorLane(value, 0)))
+		, Y(static_cast<T>(XMVectorLane(value, 1)))
+		, Z(static_cast<T>(XMVectorLane(value, 2)))
 	{}
 #endif
 
@@ -773,7 +799,7 @@ public:
 	};
 
 public:
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ X: " + std::to_string(X) + " Y: " + std::to_string(Y) + " Z: " + std::to_string(Z) + " };");
 	};
@@ -860,12 +886,12 @@ public:
 		Z /= divider;
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const TVector3&) const = default;
 #endif
 };
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 template<typename T>
 FORCEINLINE constexpr bool operator ==(const TVector3<T>& value1, const TVector3<T>& value2)
 {
@@ -999,6 +1025,7 @@ FORCEINLINE constexpr TVector3<T> operator *(const DirectX::XMVECTOR& value1, co
 {
 	return DirectX::XMVectorMultiply(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, 0.0f));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 template<typename T>
 FORCEINLINE constexpr TVector3<T> operator *(const DirectX::XMVECTOR& value1, const float& scaleFactor)
 {
@@ -1009,6 +1036,7 @@ FORCEINLINE constexpr TVector3<T> operator *(const float& scaleFactor, const Dir
 {
 	return DirectX::XMVectorMultiply(DirectX::XMVectorSet(scaleFactor, scaleFactor, scaleFactor, scaleFactor), value1);
 };
+#endif
 
 template<typename T>
 FORCEINLINE constexpr TVector3<T> operator /(const TVector3<T>& value1, const DirectX::XMFLOAT3& value2)
@@ -1036,12 +1064,14 @@ FORCEINLINE constexpr TVector3<T> operator /(const DirectX::XMVECTOR& value1, co
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, 0.0f));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 template<typename T>
 FORCEINLINE constexpr TVector3<T> operator /(const DirectX::XMVECTOR& value1, const float& divider)
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(divider, divider, divider, divider));
 };
 #endif
+#endif
 
 typedef TVector3<float> FVector;
 typedef FVector FVector3f;
@@ -1156,10 +1186,10 @@ public:
 	{}
 
 	FORCEINLINE constexpr TVector4(const DirectX::XMVECTOR& value)
-		: X(value.m128_f32[0])
-		, Y(value.m128_f32[1])
-		, Z(value.m128_f32[2])
-		, W(value.m128_f32[3])
+		: X(XMVectorLane(value, 0))
+		, Y(XMVectorLane(value, 1))
+		, Z(XMVectorLane(value, 2))
+		, W(XMVectorLane(value, 3))
 	{}
 #endif
 
@@ -1222,7 +1252,7 @@ public:
 	};
 
 public:
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ X: " + std::to_string(X) + " Y: " + std::to_string(Y) + " Z: " + std::to_string(Z) + " W: " + std::to_string(W) + " };");
 	};
@@ -1311,12 +1341,12 @@ public:
 		W /= divider;
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const TVector4&) const = default;
 #endif
 };
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 FORCEINLINE constexpr bool operator ==(const TVector4& value1, const TVector4& value2)
 {
 	return (value1.X == value2.X
@@ -1479,6 +1509,7 @@ FORCEINLINE constexpr TVector4<T> operator *(const DirectX::XMVECTOR& value1, co
 {
 	return DirectX::XMVectorMultiply(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, value2.W));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 template<typename T>
 FORCEINLINE constexpr TVector4<T> operator *(const DirectX::XMVECTOR& value1, const float& scaleFactor)
 {
@@ -1489,6 +1520,7 @@ FORCEINLINE constexpr TVector4<T> operator *(const float& scaleFactor, const Dir
 {
 	return DirectX::XMVectorMultiply(DirectX::XMVectorSet(scaleFactor, scaleFactor, scaleFactor, scaleFactor), value1);
 };
+#endif
 
 template<typename T>
 FORCEINLINE constexpr TVector4<T> operator /(const TVector4<T>& value1, const DirectX::XMFLOAT4& value2)
@@ -1516,18 +1548,20 @@ FORCEINLINE constexpr TVector4<T> operator /(const DirectX::XMVECTOR& value1, co
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, value2.W));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 template<typename T>
 FORCEINLINE constexpr TVector4<T> operator /(const DirectX::XMVECTOR& value1, const float& divider)
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(divider, divider, divider, divider));
 };
 #endif
+#endif
 
 //typedef TVector4<float> FVector4f;
 typedef TVector4<double> FVector4D;
 typedef TVector4<std::int32_t> cbIntVector4;
 
-__declspec(align(16)) class FVector4A
+class alignas(16) FVector4A
 {
 	typedef FVector4A Class;
 	sStaticClassBody(Class)
@@ -1634,10 +1668,10 @@ public:
 	{}
 
 	FORCEINLINE constexpr FVector4A(const DirectX::XMVECTOR& value)
-		: X(value.m128_f32[0])
-		, Y(value.m128_f32[1])
-		, Z(value.m128_f32[2])
-		, W(value.m128_f32[3])
+		: X(XMVectorLane(value, 0))
+		, Y(XMVectorLane(value, 1))
+		, Z(XMVectorLane(value, 2))
+		, W(XMVectorLane(value, 3))
 	{}
 #endif
 
@@ -1659,7 +1693,7 @@ public:
 	}
 
 public:
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ X: " + std::to_string(X) + " Y: " + std::to_string(Y) + " Z: " + std::to_string(Z) + " W: " + std::to_string(W) + " };");
 	};
@@ -1698,7 +1732,7 @@ public:
 	}
 #endif
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const FVector4A&) const = default;
 #endif
 };
@@ -1714,7 +1748,7 @@ FORCEINLINE constexpr TVector4<T>::operator FVector4A()
 	return TVector4<T>(X, Y, Z, W);
 }
 
-__declspec(align(16)) class FVector4
+class alignas(16) FVector4
 {
 	typedef FVector4 Class;
 	sStaticClassBody(Class)
@@ -1821,10 +1855,10 @@ public:
 	{}
 
 	FORCEINLINE constexpr FVector4(const DirectX::XMVECTOR& value)
-		: X(value.m128_f32[0])
-		, Y(value.m128_f32[1])
-		, Z(value.m128_f32[2])
-		, W(value.m128_f32[3])
+		: X(XMVectorLane(value, 0))
+		, Y(XMVectorLane(value, 1))
+		, Z(XMVectorLane(value, 2))
+		, W(XMVectorLane(value, 3))
 	{}
 #endif
 
@@ -1887,7 +1921,7 @@ public:
 	};
 
 public:
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ X: " + std::to_string(X) + " Y: " + std::to_string(Y) + " Z: " + std::to_string(Z) + " W: " + std::to_string(W) + " };");
 	};
@@ -1973,12 +2007,12 @@ public:
 		W /= divider;
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const FVector4&) const = default;
 #endif
 };
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 FORCEINLINE constexpr bool operator ==(const FVector4& value1, const FVector4& value2)
 {
 	return (value1.X == value2.X
@@ -2063,11 +2097,11 @@ FORCEINLINE constexpr FVector4 operator +(const DirectX::XMFLOAT4& value1, const
 	return FVector4(value1.x + value2.X, value1.y + value2.Y, value1.z + value2.Z, value1.w + value2.W);
 };
 
-FORCEINLINE constexpr FVector4 operator +(const FVector4& value1, const DirectX::XMVECTOR& value2)
+FORCEINLINE FVector4 operator +(const FVector4& value1, const DirectX::XMVECTOR& value2)
 {
 	return DirectX::XMVectorAdd(DirectX::XMVectorSet(value1.X, value1.Y, value1.Z, value1.W), value2);
 };
-FORCEINLINE constexpr FVector4 operator +(const DirectX::XMVECTOR& value1, const FVector4& value2)
+FORCEINLINE FVector4 operator +(const DirectX::XMVECTOR& value1, const FVector4& value2)
 {
 	return DirectX::XMVectorAdd(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, value2.W));
 };
@@ -2081,11 +2115,11 @@ FORCEINLINE constexpr FVector4 operator -(const DirectX::XMFLOAT4& value1, const
 	return FVector4(value1.x - value2.X, value1.y - value2.Y, value1.z - value2.Z, value1.w - value2.W);
 };
 
-FORCEINLINE constexpr FVector4 operator -(const FVector4& value1, const DirectX::XMVECTOR& value2)
+FORCEINLINE FVector4 operator -(const FVector4& value1, const DirectX::XMVECTOR& value2)
 {
 	return DirectX::XMVectorSubtract(DirectX::XMVectorSet(value1.X, value1.Y, value1.Z, value1.W), value2);
 };
-FORCEINLINE constexpr FVector4 operator -(const DirectX::XMVECTOR& value1, const FVector4& value2)
+FORCEINLINE FVector4 operator -(const DirectX::XMVECTOR& value1, const FVector4& value2)
 {
 	return DirectX::XMVectorSubtract(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, value2.W));
 };
@@ -2107,14 +2141,15 @@ FORCEINLINE constexpr FVector4 operator *(const float& scaleFactor, const Direct
 	return FVector4(scaleFactor * value1.x, scaleFactor * value1.y, scaleFactor * value1.z, scaleFactor * value1.w);
 };
 
-FORCEINLINE constexpr FVector4 operator *(const FVector4& value1, const DirectX::XMVECTOR& value2)
+FORCEINLINE FVector4 operator *(const FVector4& value1, const DirectX::XMVECTOR& value2)
 {
 	return DirectX::XMVectorMultiply(DirectX::XMVectorSet(value1.X, value1.Y, value1.Z, value1.W), value2);
 };
-FORCEINLINE constexpr FVector4 operator *(const DirectX::XMVECTOR& value1, const FVector4& value2)
+FORCEINLINE FVector4 operator *(const DirectX::XMVECTOR& value1, const FVector4& value2)
 {
 	return DirectX::XMVectorMultiply(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, value2.W));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 FORCEINLINE constexpr FVector4 operator *(const DirectX::XMVECTOR& value1, const float& scaleFactor)
 {
 	return DirectX::XMVectorMultiply(value1, DirectX::XMVectorSet(scaleFactor, scaleFactor, scaleFactor, scaleFactor));
@@ -2123,6 +2158,7 @@ FORCEINLINE constexpr FVector4 operator *(const float& scaleFactor, const Direct
 {
 	return DirectX::XMVectorMultiply(DirectX::XMVectorSet(scaleFactor, scaleFactor, scaleFactor, scaleFactor), value1);
 };
+#endif
 
 FORCEINLINE constexpr FVector4 operator /(const FVector4& value1, const DirectX::XMFLOAT4& value2)
 {
@@ -2137,21 +2173,23 @@ FORCEINLINE constexpr FVector4 operator /(const DirectX::XMFLOAT4& value1, const
 	return FVector4(value1.x / divider, value1.y / divider, value1.z / divider, value1.w / divider);
 };
 
-FORCEINLINE constexpr FVector4 operator /(const FVector4& value1, const DirectX::XMVECTOR& value2)
+FORCEINLINE FVector4 operator /(const FVector4& value1, const DirectX::XMVECTOR& value2)
 {
 	return DirectX::XMVectorDivide(DirectX::XMVectorSet(value1.X, value1.Y, value1.Z, value1.W), value2);
 };
-FORCEINLINE constexpr FVector4 operator /(const DirectX::XMVECTOR& value1, const FVector4& value2)
+FORCEINLINE FVector4 operator /(const DirectX::XMVECTOR& value1, const FVector4& value2)
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(value2.X, value2.Y, value2.Z, value2.W));
 };
+#if !defined(_XM_NO_XMVECTOR_OVERLOADS_)
 FORCEINLINE constexpr FVector4 operator /(const DirectX::XMVECTOR& value1, const float& divider)
 {
 	return DirectX::XMVectorDivide(value1, DirectX::XMVectorSet(divider, divider, divider, divider));
 };
 #endif
+#endif
 
-__declspec(align(16)) class FColor
+class alignas(16) FColor
 {
 	typedef FColor Class;
 	sStaticClassBody(Class)
@@ -2312,10 +2350,10 @@ public:
 	{}
 
 	FORCEINLINE constexpr FColor(const DirectX::XMVECTOR& value)
-		: R(value.m128_f32[0])
-		, G(value.m128_f32[1])
-		, B(value.m128_f32[2])
-		, A(value.m128_f32[3])
+		: R(XMVectorLane(value, 0))
+		, G(XMVectorLane(value, 1))
+		, B(XMVectorLane(value, 2))
+		, A(XMVectorLane(value, 3))
 	{}
 #endif
 
@@ -2437,7 +2475,7 @@ public:
 		return R * 0.3f + G * 0.59f + B * 0.11f;
 	}
 
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ R: " + std::to_string(R) + " G: " + std::to_string(G) + " B: " + std::to_string(B) + " Alpha: " + std::to_string(A) + " };");
 	};
@@ -2469,11 +2507,11 @@ public:
 	}
 #endif
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const FColor&) const = default;
 #endif
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 	inline constexpr bool operator ==(const FColor& b)
 	{
 		return (A == b.A &&
@@ -2646,7 +2684,6 @@ struct TMatrix3x3
 		return reinterpret_cast<const TVector3<T>&>(r[i * 3]);
 	}
 
-	template <typename T>
 	TMatrix3x3<T> operator * (const TMatrix3x3<T>& b) const
 	{
 		TMatrix3x3<T> result = TMatrix3x3<T>::Zero();
@@ -2658,7 +2695,7 @@ struct TMatrix3x3
 	}
 };
 
-__declspec(align(64)) class FMatrix
+class alignas(64) FMatrix
 {
 	typedef FMatrix Class;
 	sStaticClassBody(Class)
@@ -3208,11 +3245,11 @@ public:
 			_41 * fInv, _42 * fInv, _43 * fInv, _44 * fInv);
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	auto operator<=>(const FMatrix&) const = default;
 #endif
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 	inline constexpr bool operator == (const FMatrix& mat) const
 	{
 		return 0 == memcmp(this, &mat, sizeof(FMatrix));
@@ -3241,7 +3278,7 @@ FORCEINLINE constexpr FMatrix operator *(const DirectX::XMMATRIX& value1, const
 {
 	return DirectX::XMMatrixMultiply(value1, value2);
 }*/
-FORCEINLINE constexpr FMatrix operator *(const FMatrix& value1, const FMatrix& value2)
+FORCEINLINE FMatrix operator *(const FMatrix& value1, const FMatrix& value2)
 {
 	return DirectX::XMMatrixMultiply(value1, value2);
 }
@@ -3371,9 +3408,9 @@ public:
 #if Enable_DirectX_Math
 	FORCEINLINE constexpr FRotationMatrix(const DirectX::XMMATRIX& Matrix) noexcept
 	{
-		r[0] = FVector(Matrix.r[0].m128_f32[0], Matrix.r[0].m128_f32[1], Matrix.r[0].m128_f32[2]);
-		r[1] = FVector(Matrix.r[1].m128_f32[0], Matrix.r[1].m128_f32[1], Matrix.r[1].m128_f32[2]);
-		r[2] = FVector(Matrix.r[2].m128_f32[0], Matrix.r[2].m128_f32[1], Matrix.r[2].m128_f32[2]);
+		r[0] = FVector(XMVectorLane(Matrix.r[0], 0), XMVectorLane(Matrix.r[0], 1), XMVectorLane(Matrix.r[0], 2));
+		r[1] = FVector(XMVectorLane(Matrix.r[1], 0), XMVectorLane(Matrix.r[1], 1), XMVectorLane(Matrix.r[1], 2));
+		r[2] = FVector(XMVectorLane(Matrix.r[2], 0), XMVectorLane(Matrix.r[2], 1), XMVectorLane(Matrix.r[2], 2));
 	}
 #endif
 
@@ -3428,7 +3465,7 @@ public:
 		//r[3].W = 1.f;
 	}
 
-	FORCEINLINE constexpr FRotationMatrix(const FQuaternion& q);
+	FORCEINLINE FRotationMatrix(const FQuaternion& q);
 
 	~FRotationMatrix() = default;
 
@@ -3575,7 +3612,7 @@ public:
 	FORCEINLINE operator FQuaternion() const;
 	FORCEINLINE operator FQuaternion();
 
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ Pitch: " + std::to_string(Pitch) + " Yaw: " + std::to_string(Yaw) + " Roll: " + std::to_string(Roll) + " };");
 	};
@@ -3640,25 +3677,25 @@ public:
 	FORCEINLINE constexpr float GetAngle() const { return Angle; }
 	FORCEINLINE constexpr FVector GetAxis() const { return Axis; }
 
-	FORCEINLINE constexpr FRotationMatrix ToRotationMatrix() const
+	FORCEINLINE FRotationMatrix ToRotationMatrix() const
 	{
 		return DirectX::XMMatrixRotationAxis(Axis, Angle);
 	}
-	FORCEINLINE constexpr FVector4 ToQuaternion() const
+	FORCEINLINE FVector4 ToQuaternion() const
 	{
 		return DirectX::XMQuaternionRotationAxis(Axis, Angle);
 	}
 
-	FORCEINLINE constexpr operator FRotationMatrix() const
+	FORCEINLINE operator FRotationMatrix() const
 	{
 		return DirectX::XMMatrixRotationAxis(Axis, Angle);
 	}
-	FORCEINLINE constexpr operator FRotationMatrix()
+	FORCEINLINE operator FRotationMatrix()
 	{
 		return DirectX::XMMatrixRotationAxis(Axis, Angle);
 	}
 
-	FORCEINLINE constexpr operator FQuaternion() const;
+	FORCEINLINE operator FQuaternion() const;
 	FORCEINLINE constexpr operator FQuaternion();
 };
 
@@ -3667,7 +3704,7 @@ class FQuaternion
 	typedef FQuaternion Class;
 	sStaticClassBody(Class)
 public:
-	FORCEINLINE static constexpr FQuaternion Identity()
+	FORCEINLINE static FQuaternion Identity()
 	{
 		return FQuaternion(DirectX::XMQuaternionIdentity());
 	}
@@ -3708,22 +3745,22 @@ public:
 	}
 
 public:
-	FORCEINLINE constexpr FQuaternion()
+	FORCEINLINE FQuaternion()
 		: m_vec(DirectX::XMQuaternionIdentity())
 	{}
 	FORCEINLINE constexpr FQuaternion(const FQuaternion& Other)
 		: m_vec(Other.m_vec)
 	{}
-	FORCEINLINE constexpr FQuaternion(const FRotatedVector& RotatedVector)
+	FORCEINLINE FQuaternion(const FRotatedVector& RotatedVector)
 		: m_vec(DirectX::XMQuaternionRotationAxis(RotatedVector.GetAxis(), RotatedVector.GetAngle()))
 	{}
 	FORCEINLINE FQuaternion(const FAngles& Angle)
 		: m_vec(QuaternionRotationRollPitchYaw(Angle.Pitch, Angle.Yaw, Angle.Roll))
 	{}
-	FORCEINLINE constexpr FQuaternion(const FMatrix& matrix)
+	FORCEINLINE FQuaternion(const FMatrix& matrix)
 		: m_vec(DirectX::XMQuaternionRotationMatrix(matrix))
 	{}
-	FORCEINLINE constexpr FQuaternion(const FRotationMatrix& matrix)
+	FORCEINLINE FQuaternion(const FRotationMatrix& matrix)
 		: m_vec(DirectX::XMQuaternionRotationMatrix(matrix))
 	{}
 	FORCEINLINE constexpr FQuaternion(const float InX, const float InY, const float InZ, const float InW)
@@ -3753,7 +3790,7 @@ public:
 		return ToRotationMatrix().GetAngles();
 	}
 
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return "FQuaternion::" + m_vec.ToString();
 	};
@@ -3796,16 +3833,16 @@ public:
 	}
 #endif
 
-	FORCEINLINE constexpr FQuaternion Conjugate() const
+	FORCEINLINE FQuaternion Conjugate() const
 	{
 		return FQuaternion(DirectX::XMQuaternionConjugate(m_vec));
 	}
-	FORCEINLINE constexpr FQuaternion GetNegate() const
+	FORCEINLINE FQuaternion GetNegate() const
 	{
 		return FQuaternion(DirectX::XMVectorNegate(m_vec));
 	}
 
-	FORCEINLINE constexpr FRotationMatrix ToRotationMatrix() const
+	FORCEINLINE FRotationMatrix ToRotationMatrix() const
 	{
 		return DirectX::XMMatrixRotationQuaternion(m_vec);
 	}
@@ -3883,12 +3920,12 @@ public:
 		return FQuaternion(X * fInv, Y * fInv, Z * fInv, W * fInv);
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	//auto operator<=>(const FQuaternion&) const = default;
 #endif
 };
 
-//#if _MSVC_LANG < 202002L
+//#if sCPP_LANG < 202002L
 FORCEINLINE bool constexpr operator ==(const FQuaternion& value1, const FQuaternion& value2)
 {
 	return (value1.X == value2.X && value1.Y == value2.Y && value1.Z == value2.Z && value1.W == value2.W);
@@ -3900,7 +3937,7 @@ FORCEINLINE bool constexpr operator !=(const FQuaternion& value1, const FQuatern
 };
 //#endif
 
-FORCEINLINE constexpr FRotationMatrix::FRotationMatrix(const FQuaternion& q)
+FORCEINLINE FRotationMatrix::FRotationMatrix(const FQuaternion& q)
 {
 	const FRotationMatrix& RotationMatrix = FRotationMatrix(DirectX::XMMatrixRotationQuaternion(q));
 	r[0] = RotationMatrix.r[0];
@@ -3908,17 +3945,17 @@ FORCEINLINE constexpr FRotationMatrix::FRotationMatrix(const FQuaternion& q)
 	r[2] = RotationMatrix.r[2];
 }
 
-FORCEINLINE constexpr FQuaternion Normalize(const FQuaternion& q)
+FORCEINLINE FQuaternion Normalize(const FQuaternion& q)
 {
 	return FQuaternion(DirectX::XMQuaternionNormalize(q));
 }
 
-FORCEINLINE constexpr FQuaternion Slerp(const FQuaternion& a, const FQuaternion& b, const float t)
+FORCEINLINE FQuaternion Slerp(const FQuaternion& a, const FQuaternion& b, const float t)
 {
 	return Normalize(FQuaternion(DirectX::XMQuaternionSlerp(a, b, t)));
 }
 
-FORCEINLINE constexpr FQuaternion Lerp(const FQuaternion& a, const FQuaternion& b, const float t)
+FORCEINLINE FQuaternion Lerp(const FQuaternion& a, const FQuaternion& b, const float t)
 {
 	return Normalize(FQuaternion(DirectX::XMVectorLerp(a, b, t)));
 }
@@ -3928,16 +3965,16 @@ FORCEINLINE constexpr FQuaternion operator * (const float f, const FQuaternion&
 	return FQuaternion(f * q.X, f * q.Y, f * q.Z, f * q.W);
 }
 
-FORCEINLINE constexpr FQuaternion operator* (const FQuaternion& var1, const FQuaternion& var2)
+FORCEINLINE FQuaternion operator* (const FQuaternion& var1, const FQuaternion& var2)
 {
 	return FQuaternion(DirectX::XMQuaternionMultiply(var1, var2));
 }
 
-FORCEINLINE constexpr FVector operator* (const FVector& var1, const FQuaternion& var2)
+FORCEINLINE FVector operator* (const FVector& var1, const FQuaternion& var2)
 {
 	return FVector(DirectX::XMVector3Rotate(var1, var2));
 }
-FORCEINLINE constexpr FVector operator* (const FQuaternion& var1, const FVector& var2)
+FORCEINLINE FVector operator* (const FQuaternion& var1, const FVector& var2)
 {
 	return FVector(DirectX::XMVector3Rotate(var2, var1));
 }
@@ -3952,7 +3989,7 @@ FORCEINLINE FAngles::operator FQuaternion()
 	return FQuaternion(*this);
 }
 
-FORCEINLINE constexpr FRotatedVector::operator FQuaternion() const
+FORCEINLINE FRotatedVector::operator FQuaternion() const
 {
 	return FQuaternion(*this);
 }
@@ -4133,7 +4170,7 @@ public:
 		return (GetWidth() == Other.GetWidth()) && (GetHeight() == Other.GetHeight()) && (GetDepth() == Other.GetDepth());
 	}
 
-	inline constexpr std::string ToString() const
+	inline std::string ToString() const
 	{
 		return std::string("{ Width: " + std::to_string(Width) + " Height: " + std::to_string(Height) + " Depth: " + std::to_string(Depth) + " };");
 	};
@@ -4366,7 +4403,7 @@ public:
 		return true;
 	}
 
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("{ Min: " + Min.ToString() + " Max: " + Max.ToString() + " };");
 	};
@@ -4424,7 +4461,7 @@ FORCEINLINE constexpr FBoundingBox operator -(const FBoundingBox& Rect, const FV
 	return FBoundingBox(Rect.Min - V, Rect.Max - V);
 }
 
-FORCEINLINE constexpr FVector Normalize(const FVector& v)
+FORCEINLINE FVector Normalize(const FVector& v)
 {
 	return FVector(DirectX::XMVector3Normalize(v));
 }
@@ -4469,12 +4506,12 @@ public:
 		return (GetWidth()) == (Other.GetWidth()) && (GetHeight()) == (Other.GetHeight());
 	}
 
-	constexpr std::string ToString() const
+	std::string ToString() const
 	{
 		return std::string("{ Width: " + std::to_string(Width) + " Height: " + std::to_string(Height) + " };");
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	auto operator<=>(const TDimension2D&) const = default;
 #endif
 };
@@ -4737,12 +4774,12 @@ public:
 		return true;
 	}
 
-	constexpr std::string ToString() const
+	std::string ToString() const
 	{
 		return std::string("{ Min: " + Min.ToString() + " Max: " + Max.ToString() + " };");
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	auto operator<=>(const FBounds2D&) const = default;
 #endif
 };
@@ -4843,12 +4880,12 @@ public:
 		return *this;
 	}
 
-	constexpr std::string ToString() const
+	std::string ToString() const
 	{
 		return std::string("{ Min: " + Min.ToString() + " Max: " + Max.ToString() + " };");
 	}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	auto operator<=>(const IntBounds2D&) const = default;
 #endif
 };
@@ -4966,7 +5003,7 @@ FORCEINLINE FMatrix Invert(const FMatrix& mat)
 
 FORCEINLINE float RecipSqrt(const float s)
 {
-	return (DirectX::XMVectorReciprocalSqrt(FVector4(s, s, s, s))).m128_f32[0];
+	return XMVectorLane(DirectX::XMVectorReciprocalSqrt(FVector4(s, s, s, s)), 0);
 }
 
 template<typename T>
@@ -0,0 +1,169 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
+struct sObjectPoolStats
+{
+	std::string Name;
+	std::size_t SlotSize = 0;
+	std::size_t SlotsPerChunk = 0;
+	std::size_t ChunkCount = 0;
+	std::size_t Capacity = 0;
+	std::size_t LiveCount = 0;
+	std::size_t PeakLiveCount = 0;
+	std::uint64_t TotalAllocations = 0;
+};
+
+/*
+* Fixed-size slot pool. Slots live in contiguous chunks that are never given back,
+* freed slots go on a free list and are handed out again first.
+*/
+class sObjectPool
+{
+public:
+	static constexpr std::size_t DefaultSlotsPerChunk = 64;
+
+	sObjectPool(const std::string& InName, std::size_t InSlotSize, std::size_t InAlignment, std::size_t InSlotsPerChunk = DefaultSlotsPerChunk);
+	~sObjectPool();
+
+	sObjectPool(const sObjectPool&) = delete;
+	sObjectPool& operator=(const sObjectPool&) = delete;
+
+	void* Allocate();
+	void Deallocate(void* Ptr);
+	/*
+	* Makes sure Count slots can be handed out without adding a chunk.
+	*/
+	void Reserve(std::size_t Count);
+
+	sObjectPoolStats GetStats() const;
+	inline const std::string& GetName() const { return Name; }
+
+private:
+	struct sFreeSlot
+	{
+		sFreeSlot* Next;
+	};
+
+	void AddChunk();
+
+	std::string Name;
+	std::size_t SlotSize;
+	std::size_t Alignment;
+	std::size_t SlotsPerChunk;
+
+	mutable std::mutex Mutex;
+	std::vector<std::uint8_t*> Chunks;
+	sFreeSlot* FreeList;
+	std::size_t LiveCount;
+	std::size_t PeakLiveCount;
+	std::uint64_t TotalAllocations;
+};
+
+/*
+* Every pool registers itself, used for occupancy stats.
+*/
+class sObjectPoolRegistry
+{
+public:
+	static sObjectPoolRegistry& Get();
+
+	void Register(sObjectPool* Pool);
+	void Unregister(sObjectPool* Pool);
+	std::vector<sObjectPoolStats> GetStats() const;
+
+private:
+	sObjectPoolRegistry() = default;
+	sObjectPoolRegistry(const sObjectPoolRegistry&) = delete;
+	sObjectPoolRegistry& operator=(const sObjectPoolRegistry&) = delete;
+
+	mutable std::mutex Mutex;
+	std::vector<sObjectPool*> Pools;
+};
+
+/*
+* Pool of T slots owned by class Owner. T is Owner itself for new/CreateUnique,
+* or the shared_ptr control block with Owner inside it for Create.
+* Pools are intentionally leaked, objects may be released after static destruction started.
+*/
+template<typename T, typename Owner = T>
+struct sClassPool
+{
+	static sObjectPool& Get()
+	{
+		static sObjectPool* Pool = new sObjectPool(std::is_same_v<T, Owner> ? Owner::GetStaticClassID() : Owner::GetStaticClassID() + " (Shared)", sizeof(T), alignof(T));
+		return *Pool;
+	}
+};
+
+/*
+* STL allocator over sClassPool, std::allocate_shared puts the control block and the object in one slot.
+*/
+template<typename T, typename Owner = T>
+class sPoolAllocator
+{
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = sPoolAllocator<U, Owner>;
+	};
+
+	sPoolAllocator() noexcept = default;
+	template<typename U>
+	sPoolAllocator(const sPoolAllocator<U, Owner>&) noexcept
+	{}
+
+	T* allocate(std::size_t Count)
+	{
+		if (Count == 1)
+			return static_cast<T*>(sClassPool<T, Owner>::Get().Allocate());
+		return static_cast<T*>(::operator new(Count * sizeof(T)));
+	}
+
+	void deallocate(T* Ptr, std::size_t Count) noexcept
+	{
+		if (Count == 1)
+			sClassPool<T, Owner>::Get().Deallocate(Ptr);
+		else
+			::operator delete(Ptr);
+	}
+
+	template<typename U>
+	bool operator==(const sPoolAllocator<U, Owner>&) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const sPoolAllocator<U, Owner>&) const noexcept { return false; }
+};
@@ -0,0 +1,275 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include "Engine/ClassBody.h"
+
+#define Enable_Profiler 1
+
+struct sProfileEvent
+{
+	const char* Name = nullptr;
+	std::uint64_t StartNS = 0;
+	std::uint64_t EndNS = 0;
+	std::uint64_t FrameIndex = 0;
+	/*
+	* Nesting level on the recording thread, 0 is the outermost zone.
+	*/
+	std::uint32_t Depth = 0;
+};
+
+struct sProfileZoneStats
+{
+	std::string Name;
+	std::uint64_t CallCount = 0;
+	double MinMS = 0.0;
+	double AvgMS = 0.0;
+	double MaxMS = 0.0;
+	/*
+	* Time spent in the zone by every thread during the last completed frame.
+	*/
+	double LastFrameMS = 0.0;
+	std::uint32_t LastFrameCalls = 0;
+};
+
+struct sProfileThreadInfo
+{
+	std::uint32_t ThreadIndex = 0;
+	std::uint64_t ThreadID = 0;
+	std::string Name;
+	std::uint64_t RecordedEvents = 0;
+	/*
+	* Events that were overwritten before the stats aggregation could read them.
+	*/
+	std::uint64_t DroppedEvents = 0;
+};
+
+/*
+* Buffered events and frame markers copied out of the profiler, turned into JSON later on any thread.
+*/
+struct sProfileTrace
+{
+	struct sThread
+	{
+		std::uint32_t ThreadIndex = 0;
+		std::string Name;
+		std::vector<sProfileEvent> Events;
+	};
+
+	struct sFrame
+	{
+		std::uint64_t FrameIndex = 0;
+		std::uint64_t TimeNS = 0;
+	};
+
+	std::vector<sThread> Threads;
+	std::vector<sFrame> Frames;
+};
+
+/*
+* Hierarchical scoped CPU profiler.
+* Every thread records finished zones into its own ring buffer, recording is lock-free and never allocates
+* after the first zone of the thread. The game thread calls BeginFrame once per frame, it places a frame
+* marker and folds the new events of every thread into the per-zone stats.
+* The ring buffers keep the last EventsPerThread zones of each thread, ExportChromeTrace writes them
+* as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+* Zone names are not copied, they have to outlive the profiler (literals, __FUNCTION__ or InternName).
+*/
+class sProfiler
+{
+	sBaseClassBody(sClassNoDefaults, sProfiler)
+public:
+	static constexpr std::size_t EventsPerThread = 32768;
+	static constexpr std::size_t FrameMarkerCount = 1024;
+
+	static sProfiler& Get();
+
+	void SetEnabled(bool bEnable);
+	static inline bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+	/*
+	* Names the calling thread in the trace.
+	*/
+	void SetThreadName(const std::string& Name);
+	/*
+	* Returns a stable pointer for a runtime string, equal strings share the pointer.
+	*/
+	const char* InternName(const std::string& Name);
+
+	/*
+	* Called once per frame by the game thread.
+	*/
+	void BeginFrame();
+	std::uint64_t GetFrameIndex() const { return FrameIndex.load(std::memory_order_relaxed); }
+
+	/*
+	* Sorted by total time, highest first.
+	*/
+	std::vector<sProfileZoneStats> GetZoneStats() const;
+	void ResetZoneStats();
+	std::vector<sProfileThreadInfo> GetThreadInfo() const;
+	/*
+	* Writes the zone stats table to the console every Frames frames, 0 disables it.
+	*/
+	void SetStatsReportInterval(std::uint32_t Frames);
+	void WriteZoneStatsToConsole() const;
+
+	/*
+	* LastFrames limits the trace to the most recent frames, 0 writes every event that is still buffered.
+	* CaptureTrace only copies the ring buffers, GetChromeTrace of the copy builds the JSON.
+	*/
+	sProfileTrace CaptureTrace(std::uint64_t LastFrames = 0) const;
+	static std::string GetChromeTrace(const sProfileTrace& Trace);
+	std::string GetChromeTrace(std::uint64_t LastFrames = 0) const;
+	bool ExportChromeTrace(const std::string& Path, std::uint64_t LastFrames = 0) const;
+
+	static std::uint64_t Now();
+	void BeginZone();
+	void EndZone(const char* Name, std::uint64_t StartNS, std::uint64_t EndNS);
+
+private:
+	sProfiler();
+	~sProfiler() = default;
+
+	sProfiler(const sProfiler&) = delete;
+	sProfiler& operator=(const sProfiler&) = delete;
+
+	/*
+	* Written only by the owning thread, readers copy a range and drop the slots the writer lapped in the meantime.
+	*/
+	struct sEventSlot
+	{
+		std::atomic<const char*> Name = nullptr;
+		std::atomic<std::uint64_t> StartNS = 0;
+		std::atomic<std::uint64_t> EndNS = 0;
+		std::atomic<std::uint64_t> FrameIndex = 0;
+		std::atomic<std::uint32_t> Depth = 0;
+	};
+
+	struct sThreadBuffer
+	{
+		std::uint32_t ThreadIndex = 0;
+		std::uint64_t ThreadID = 0;
+		std::string Name;
+		std::uint32_t Depth = 0;
+		std::atomic<std::uint64_t> WriteIndex = 0;
+		std::unique_ptr<sEventSlot[]> Events;
+
+		/*
+		* Owned by the stats aggregation.
+		*/
+		std::uint64_t ReadIndex = 0;
+		std::uint64_t DroppedEvents = 0;
+	};
+
+	struct sZoneAccumulator
+	{
+		std::uint64_t CallCount = 0;
+		std::uint64_t TotalNS = 0;
+		std::uint64_t MinNS = ~0ull;
+		std::uint64_t MaxNS = 0;
+		std::uint64_t FrameNS = 0;
+		std::uint32_t FrameCalls = 0;
+	};
+
+	struct sFrameMarker
+	{
+		std::uint64_t FrameIndex = 0;
+		std::uint64_t TimeNS = 0;
+	};
+
+	sThreadBuffer& GetThreadBuffer();
+	std::vector<sProfileEvent> ReadEvents(const sThreadBuffer& Buffer, std::uint64_t From, std::uint64_t& Next, std::uint64_t& Dropped) const;
+
+	static std::atomic<bool> bEnabled;
+	std::atomic<std::uint64_t> FrameIndex;
+	std::atomic<std::uint32_t> StatsReportInterval;
+
+	mutable std::mutex ThreadMutex;
+	std::vector<std::unique_ptr<sThreadBuffer>> Threads;
+
+	std::mutex NameMutex;
+	std::unordered_set<std::string> Names;
+
+	mutable std::mutex StatsMutex;
+	std::unordered_map<std::string_view, sZoneAccumulator> Zones;
+	std::vector<sFrameMarker> FrameMarkers;
+};
+
+/*
+* Records the enclosing scope as a zone.
+*/
+class sProfileZone
+{
+public:
+	inline sProfileZone(const char* InName)
+		: Name(sProfiler::IsEnabled() ? InName : nullptr)
+		, StartNS(0)
+	{
+		if (Name)
+		{
+			sProfiler::Get().BeginZone();
+			StartNS = sProfiler::Now();
+		}
+	}
+
+	inline ~sProfileZone()
+	{
+		if (Name)
+		{
+			const std::uint64_t EndNS = sProfiler::Now();
+			sProfiler::Get().EndZone(Name, StartNS, EndNS);
+		}
+	}
+
+	sProfileZone(const sProfileZone&) = delete;
+	sProfileZone& operator=(const sProfileZone&) = delete;
+
+private:
+	const char* Name;
+	std::uint64_t StartNS;
+};
+
+#define sProfileConcatInner(A, B) A##B
+#define sProfileConcat(A, B) sProfileConcatInner(A, B)
+
+#if Enable_Profiler
+#define sProfileScope(Name) sProfileZone sProfileConcat(ProfileZone, __LINE__)(Name)
+#define sProfileFunction sProfileScope(__FUNCTION__)
+#else
+#define sProfileScope(Name)
+#define sProfileFunction
+#endif
@@ -0,0 +1,110 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "Engine/ClassBody.h"
+#include "Core/ThreadPool.h"
+
+enum class ETaskThread
+{
+	/*
+	* Runs inline on the thread that calls Execute.
+	*/
+	eGameThread,
+	eWorker,
+};
+
+/*
+* Declarative per-frame task graph.
+* Every task declares the resources it reads and writes as bit masks. Dependencies follow the
+* declaration order: a task waits for every earlier task it has a read/write or write/write hazard with.
+* Tasks marked bOverlapNextFrame are not joined at the end of Execute, the next Execute only waits for them
+* before starting a task that conflicts with them.
+* Tasks get the DeltaTime passed to the Execute that started them, overlapped tasks keep their own frame's value.
+*/
+class sTaskGraph
+{
+	sBaseClassBody(sClassConstructor, sTaskGraph)
+public:
+	sTaskGraph(ThreadPool* InPool);
+	~sTaskGraph();
+
+	std::size_t AddTask(const std::string& Name, std::uint32_t Reads, std::uint32_t Writes, ETaskThread Thread, const std::function<void(double DeltaTime)>& Function, bool bOverlapNextFrame = false);
+	void Clear();
+
+	/*
+	* Must be called from the game thread.
+	*/
+	void Execute(double DeltaTime);
+	/*
+	* Waits for overlapped tasks of the previous frames that conflict with Resources.
+	*/
+	void Join(std::uint32_t Resources = ~0u);
+
+	inline std::size_t TaskCount() const { return Tasks.size(); }
+	inline const std::string& GetTaskName(std::size_t Index) const { return Tasks[Index].Name; }
+	inline const std::vector<std::size_t>& GetDependencies(std::size_t Index) const { return Tasks[Index].Dependencies; }
+
+private:
+	struct sTask
+	{
+		std::string Name;
+		/*
+		* Interned copy of Name, profiler zones keep the pointer.
+		*/
+		const char* ProfileName = nullptr;
+		std::uint32_t Reads = 0;
+		std::uint32_t Writes = 0;
+		ETaskThread Thread = ETaskThread::eGameThread;
+		std::function<void(double)> Function;
+		bool bOverlapNextFrame = false;
+
+		std::vector<std::size_t> Dependencies;
+		std::vector<std::size_t> Dependents;
+	};
+
+	struct sInFlightTask
+	{
+		std::uint32_t Reads = 0;
+		std::uint32_t Writes = 0;
+		sJobHandle Handle;
+	};
+
+	struct sFrameState;
+
+	static bool Conflicts(std::uint32_t ReadsA, std::uint32_t WritesA, std::uint32_t ReadsB, std::uint32_t WritesB);
+	void Compile();
+
+	ThreadPool* Pool;
+	std::vector<sTask> Tasks;
+	bool bCompiled;
+	std::vector<sInFlightTask> InFlight;
+};
@@ -27,6 +27,12 @@
 #pragma once
 
 #include <functional>
+#include <array>
+#include <deque>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <chrono>
 #include <thread>
 #include <list>
 #include <future>
@@ -272,10 +278,163 @@ private:
 
 #endif
 
+/*
+* Work-stealing job system.
+* Every worker owns a Chase-Lev deque per priority lane. The owner pushes and pops at the bottom without locking,
+* idle workers steal from the top of other deques. The thread that calls Start (the game thread)
+* owns deque 0, so jobs queued from the game thread never touch a lock either.
+* QueueJob jobs may block, they go to a second set of deques that only the pool threads take from.
+* Threads that are not part of the pool submit through a small injection queue.
+*/
+enum class EJobPriority : std::uint8_t
+{
+	eHigh,
+	eNormal,
+	eLow,
+};
+
+struct sJob
+{
+	std::function<void()> Function;
+	sJob* Parent = nullptr;
+	EJobPriority Priority = EJobPriority::eNormal;
+	std::chrono::steady_clock::time_point QueuedTime;
+	/*
+	* Self + children that are not finished yet.
+	*/
+	std::atomic<std::int32_t> UnfinishedJobs = 1;
+	/*
+	* Scheduler reference + one per sJobHandle.
+	*/
+	std::atomic<std::int32_t> RefCount = 1;
+};
+
+class sJobHandle
+{
+public:
+	sJobHandle()
+		: Job(nullptr)
+	{}
+	explicit sJobHandle(sJob* InJob)
+		: Job(InJob)
+	{
+		if (Job)
+			Job->RefCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	sJobHandle(const sJobHandle& Other)
+		: sJobHandle(Other.Job)
+	{}
+	sJobHandle(sJobHandle&& Other) noexcept
+		: Job(Other.Job)
+	{
+		Other.Job = nullptr;
+	}
+	sJobHandle& operator=(const sJobHandle& Other)
+	{
+		if (this != &Other)
+		{
+			Reset();
+			Job = Other.Job;
+			if (Job)
+				Job->RefCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		return *this;
+	}
+	sJobHandle& operator=(sJobHandle&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Reset();
+			Job = Other.Job;
+			Other.Job = nullptr;
+		}
+		return *this;
+	}
+	~sJobHandle()
+	{
+		Reset();
+	}
+
+	void Reset();
+
+	inline bool IsValid() const { return Job != nullptr; }
+	inline bool IsCompleted() const { return !Job || Job->UnfinishedJobs.load(std::memory_order_acquire) <= 0; }
+	inline sJob* Get() const { return Job; }
+
+private:
+	sJob* Job;
+};
+
+class sJobDeque
+{
+public:
+	static constexpr std::int64_t Capacity = 4096;
+
+	sJobDeque()
+		: Top(0)
+		, Bottom(0)
+	{
+		for (auto& Slot : Buffer)
+			Slot.store(nullptr, std::memory_order_relaxed);
+	}
+
+	/*
+	* Owner thread only. Returns false if the deque is full.
+	*/
+	bool Push(sJob* Job);
+	/*
+	* Owner thread only. LIFO.
+	*/
+	sJob* Pop();
+	/*
+	* Any thread. FIFO.
+	*/
+	sJob* Steal();
+
+	inline bool IsEmpty() const { return Bottom.load(std::memory_order_relaxed) <= Top.load(std::memory_order_relaxed); }
+
+private:
+	alignas(64) std::atomic<std::int64_t> Top;
+	alignas(64) std::atomic<std::int64_t> Bottom;
+	alignas(64) std::array<std::atomic<sJob*>, Capacity> Buffer;
+};
+
+struct sThreadPoolDesc
+{
+	std::string Name = "Compute";
+	/*
+	* Default is hardware_concurrency() - 1.
+	*/
+	std::optional<std::size_t> ThreadCount = std::nullopt;
+	/*
+	* Bit per logical processor, each worker is pinned to one of them in order. 0 leaves the workers to the OS scheduler.
+	*/
+	std::uint64_t AffinityMask = 0;
+};
+
+struct sThreadPoolStats
+{
+	std::string Name;
+	std::size_t ThreadCount = 0;
+	/*
+	* Jobs waiting per lane, indexed by EJobPriority.
+	*/
+	std::array<std::size_t, 3> QueueDepth = { 0, 0, 0 };
+	std::size_t PeakQueueDepth = 0;
+	std::uint64_t ExecutedJobs = 0;
+	/*
+	* Time between submitting a job and a thread picking it up.
+	*/
+	double AverageLatencyMS = 0.0;
+	double MaxLatencyMS = 0.0;
+};
+
 class ThreadPool
 {
 	sBaseClassBody(sClassConstructor, ThreadPool)
 public:
+	static constexpr std::size_t LaneCount = 3;
+
 	ThreadPool()
 	{}
 
@@ -284,23 +443,119 @@ public:
 		Stop();
 	}
 
-	void Start();
-	void QueueJob(const std::function<void()>& job);
+	/*
+	* The calling thread takes part as queue 0. Jobs can only be submitted after Start.
+	*/
+	void Start(const sThreadPoolDesc& Desc);
+	void Start(std::optional<std::size_t> ThreadCount = std::nullopt);
 	void Stop();
 	bool busy();
 
 	/*
-	* to do
-	* return stand-by only Thread Count 
+	* Fire and forget. Jobs may block, they only run on the pool threads
+	* and are never picked up by a thread that is helping inside Wait.
+	* Long-lived service loops belong to a sServiceThread instead.
+	*/
+	void QueueJob(const std::function<void()>& job, EJobPriority Priority = EJobPriority::eNormal);
+	/*
+	* Parent is not completed until every child is completed.
+	* Children must be scheduled before the parent finishes, e.g. from inside the parent job.
+	*/
+	sJobHandle Schedule(const std::function<void()>& job, const sJobHandle& Parent = sJobHandle(), EJobPriority Priority = EJobPriority::eNormal);
+	/*
+	* Executes pending jobs on the calling thread until the handle is completed.
+	*/
+	void Wait(const sJobHandle& Handle);
+	/*
+	* Executes one pending job on the calling thread, returns false if there was nothing to run.
+	*/
+	bool TryExecuteJob();
+
+	/*
+	* Splits [0, Count) into batches of BatchSize and runs Function(Index) for every index.
+	* Returned handle is completed when every batch is completed.
+	*/
+	sJobHandle ParallelFor(std::size_t Count, std::size_t BatchSize, const std::function<void(std::size_t)>& Function);
+
+	inline std::size_t AvailableThreadCount() const { return threads.size(); }
+	inline const std::string& GetName() const { return Name; }
+	/*
+	* Index of the deque owned by the calling thread, -1 for threads outside the pool.
 	*/
-	inline std::size_t AvailableThreadCount() { return threads.size(); }
+	std::int32_t GetCurrentThreadQueueIndex() const;
+
+	sThreadPoolStats GetStats() const;
+	void ResetStats();
 
 private:
-	void ThreadLoop();
+	void ThreadLoop(std::size_t QueueIndex);
+	void Submit(sJob* Job, bool bMayBlock = false);
+	/*
+	* Jobs that may block are only taken when bIncludeBlocking is set, threads helping inside Wait leave them.
+	*/
+	sJob* FindJob(std::int32_t QueueIndex, bool bIncludeBlocking);
+	sJob* PickUp(sJob* Job);
+	void Execute(sJob* Job);
+	void Finish(sJob* Job);
+	void WakeWorkers();
+	void ScheduleRange(const sJobHandle& Root, std::size_t Begin, std::size_t End, std::size_t BatchSize, const std::shared_ptr<const std::function<void(std::size_t)>>& Function);
+
+	/*
+	* Every thread owns a deque per lane for scheduled jobs, then one per lane for jobs that may block.
+	*/
+	static constexpr std::size_t QueuesPerThread = LaneCount * 2;
+
+	inline std::size_t GetQueueCount() const { return Queues.size() / QueuesPerThread; }
+	inline sJobDeque* GetQueue(std::size_t QueueIndex, std::size_t Lane, bool bMayBlock = false) const { return Queues[QueueIndex * QueuesPerThread + (bMayBlock ? LaneCount : 0) + Lane].get(); }
+
+	std::string Name;
+	std::uint64_t AffinityMask = 0;
+	std::thread::id OwnerThreadID;
+	std::atomic<bool> should_terminate = false;
 
-	std::atomic<bool> should_terminate = false;           // Tells threads to stop looking for jobs
-	std::mutex queue_mutex;                  // Prevents data races to the job queue
-	std::condition_variable mutex_condition; // Allows threads to wait on new jobs or termination 
 	std::vector<std::thread> threads;
-	std::queue<std::function<void()>> jobs;
+	std::vector<std::unique_ptr<sJobDeque>> Queues;
+
+	std::mutex InjectionMutex;
+	std::array<std::deque<sJob*>, LaneCount> InjectionQueue;
+	std::atomic<std::size_t> InjectionSize = 0;
+
+	std::mutex SleepMutex;
+	std::condition_variable SleepCondition;
+	std::atomic<std::uint32_t> SleepingWorkers = 0;
+	/*
+	* Jobs that are pushed but not picked up by any thread yet.
+	*/
+	std::atomic<std::size_t> QueuedJobs = 0;
+	std::array<std::atomic<std::size_t>, LaneCount> QueuedJobsPerLane = {};
+
+	std::atomic<std::size_t> PeakQueueDepth = 0;
+	std::atomic<std::uint64_t> ExecutedJobs = 0;
+	std::atomic<std::uint64_t> TotalLatencyNS = 0;
+	std::atomic<std::uint64_t> MaxLatencyNS = 0;
+};
+
+/*
+* Dedicated thread for long-lived service loops (socket accept/recv etc.), keeps them off the job pools.
+* Function runs once, destroying the object joins the thread.
+*/
+class sServiceThread
+{
+	sBaseClassBody(sClassConstructor, sServiceThread)
+public:
+	sServiceThread(const std::string& InName, const std::function<void()>& Function, std::uint64_t AffinityMask = 0);
+	~sServiceThread();
+
+	/*
+	* The loop has to be told to exit before joining.
+	*/
+	void Join();
+
+	inline bool IsRunning() const { return bRunning->load(std::memory_order_acquire); }
+	inline const std::string& GetName() const { return Name; }
+
+private:
+	std::string Name;
+	std::thread Thread;
+	std::shared_ptr<std::atomic<bool>> bRunning;
 };
@@ -30,12 +30,39 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <mutex>
+#include <atomic>
+#include <functional>
+#include <concepts>
+#include <cfloat>
 #include "Core/Math/CoreMath.h"
 #include "Engine/ClassBody.h"
 #include "AbstractEngineUtilities.h"
 #include "Core/Archive.h"
+#include "Core/ArchiveView.h"
+#include "Core/BitArchive.h"
+#include "Core/ArchiveReflection.h"
+#include "Core/Compression.h"
+#include "Core/ThreadPool.h"
+#include "Core/Coroutine.h"
+#include "Core/MPSCQueue.h"
+#include "Core/FrameAllocator.h"
+#include "Engine/FrameStats.h"
+
+	// SAL annotations come from the Windows SDK, they are only hints for the analyzer
+#if !defined(_WIN32)
+#ifndef _In_opt_
+#define _In_opt_
+#endif
+#ifndef _Inout_
+#define _Inout_
+#endif
+#ifndef _Outptr_result_maybenull_
+#define _Outptr_result_maybenull_
+#endif
+#endif
 
 class IFrameBuffer;
 class IGraphicsCommandContext;
@@ -57,6 +84,11 @@ enum class EGITypes
 	* WIP
 	*/
 	eVulkan,
+	/*
+	* CPU-only recording backend, no GPU work is submitted.
+	* Used to benchmark the renderers on build machines and servers.
+	*/
+	eNull,
 	/* Unsuported */
 	//eOpenGL46,
 };
@@ -219,7 +251,7 @@ public:
 		: ptr_(nullptr)
 	{}
 
-	RefCountPtr(decltype(__nullptr)) throw() 
+	RefCountPtr(decltype(nullptr)) throw() 
 		: ptr_(nullptr)
 	{}
 
@@ -271,7 +303,7 @@ public:
 		return Ptr;
 	}
 
-	RefCountPtr& operator=(decltype(__nullptr)) throw()
+	RefCountPtr& operator=(decltype(nullptr)) throw()
 	{
 		InternalRelease();
 		return *this;
@@ -464,12 +496,12 @@ struct sScreenDimension
 		, Height(InHeight)
 	{}
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const sScreenDimension&) const = default;
 #endif
 };
 
-#if _MSVC_LANG < 202002L
+#if sCPP_LANG < 202002L
 FORCEINLINE bool constexpr operator ==(const sScreenDimension& value1, const sScreenDimension& value2)
 {
 	return (value1.Width == value2.Width && value1.Height == value2.Height);
@@ -732,7 +764,7 @@ struct TextureSubresource
 	}
 };
 
-_declspec(align(256)) struct sMeshConstantBufferAttributes
+struct alignas(256) sMeshConstantBufferAttributes
 {
 	FMatrix modelMatrix;
 	FMatrix PrevModelMatrix;
@@ -1203,8 +1235,8 @@ struct sDepthStencilAttributeDesc
 	EStencilOp BackFaceStencilFailStencilOp;
 	EStencilOp BackFaceDepthFailStencilOp;
 	EStencilOp BackFacePassStencilOp;
-	unsigned __int8 StencilReadMask;
-	unsigned __int8 StencilWriteMask;
+	std::uint8_t StencilReadMask;
+	std::uint8_t StencilWriteMask;
 
 	sDepthStencilAttributeDesc(bool DepthWrite = true, bool StencilEnable = false)
 		: bEnableDepthWrite(DepthWrite)
@@ -1776,29 +1808,11 @@ struct sDateTime
 		, Millisecond(InMillisecond)
 	{}
 
-	friend void operator<<(sArchive& Archive, const sDateTime& data)
+	static constexpr auto GetArchiveFields()
 	{
-		Archive << data.Year;
-		Archive << data.Month;
-		Archive << data.Day;
-		Archive << data.DayOfWeek;
-		Archive << data.Hour;
-		Archive << data.Minute;
-		Archive << data.Second;
-		Archive << data.Millisecond;
-	}
-
-	friend void operator>>(const sArchive& Archive, sDateTime& data)
-	{
-		Archive >> data.Year;
-		Archive >> data.Month;
-		Archive >> data.Day;
-		Archive >> data.DayOfWeek;
-		Archive >> data.Hour;
-		Archive >> data.Minute;
-		Archive >> data.Second;
-		Archive >> data.Millisecond;
+		return MakeArchiveFields(&sDateTime::Year, &sDateTime::Month, &sDateTime::Day, &sDateTime::DayOfWeek, &sDateTime::Hour, &sDateTime::Minute, &sDateTime::Second, &sDateTime::Millisecond);
 	}
+	sArchiveFieldsBody(sDateTime)
 
 	constexpr std::uint64_t GetCurrentDayTimeInSeconds() const
 	{
@@ -1827,12 +1841,12 @@ struct sDateTime
 		return Second + (Minute * 60.0) + (Hour * 3600.0) + (Millisecond / 1000.0);
 	}
 
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string("Year : " + std::to_string(Year) + " | Month: " + std::to_string(Month) + " | Day : " + std::to_string(Day) + " | DayOfWeek : " + std::to_string(DayOfWeek) + " | Hour : " + std::to_string(Hour) + " | Minute : " + std::to_string(Minute) + " | Second : " + std::to_string(Second) + " | Millisecond : " + std::to_string(Millisecond));
 	};
 
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 	constexpr auto operator<=>(const sDateTime&) const = default;
 #endif
 };
@@ -1910,10 +1924,10 @@ struct sGPUInfo
 
 	FORCEINLINE constexpr std::string SupportedAPIToString() const
 	{
-		return SupportedAPI == EGITypes::eD3D11 ? "D3D11" : SupportedAPI == EGITypes::eD3D12 ? "D3D12" : SupportedAPI == EGITypes::eVulkan ? "Vulkan" : "Unknown";
+		return SupportedAPI == EGITypes::eD3D11 ? "D3D11" : SupportedAPI == EGITypes::eD3D12 ? "D3D12" : SupportedAPI == EGITypes::eVulkan ? "Vulkan" : SupportedAPI == EGITypes::eNull ? "Null" : "Unknown";
 	}
 
-	FORCEINLINE constexpr std::string ToString() const
+	FORCEINLINE std::string ToString() const
 	{
 		return std::string(GPUName + "\n" + std::to_string(VendorId) + " : " + VendorIDToString() + "\n" + "DeviceID : " + std::to_string(DeviceId) + "\n" + "SubSysId : " + std::to_string(SubSysId) + "\n" + "Revision : " + std::to_string(Revision) + "\n" + "SupportedAPI : " + SupportedAPIToString() + "\n" + "SupportedFeatureLevel : " + std::to_string(SupportedFeatureLevel) + " " + SupportedFeatureLevelString + "\n" + "SharedSystemMemory : " + std::to_string(SharedSystemMemory) + "\n" + "DedicatedVideoMemory : " + std::to_string(DedicatedVideoMemory) + "\n" + "DedicatedSystemMemory : " + std::to_string(DedicatedSystemMemory) + "\n" + "MaxVideoMemory : " + std::to_string(MaxVideoMemory));
 	}
@@ -1924,6 +1938,70 @@ struct sGPUInfo
 	}
 };
 
+/*
+* Command counters gathered by the null GI backend (EGITypes::eNull).
+* Binds to the resource that is already bound are counted once in the bind counter and once in RedundantBinds.
+*/
+struct sGICommandStats
+{
+	std::uint64_t Presents = 0;
+	std::uint64_t CommandListsExecuted = 0;
+	std::uint64_t CommandBytesRecorded = 0;
+
+	std::uint64_t DrawCalls = 0;
+	std::uint64_t VerticesDrawn = 0;
+	std::uint64_t InstancesDrawn = 0;
+	std::uint64_t Dispatches = 0;
+
+	std::uint64_t PipelineSwitches = 0;
+	std::uint64_t VertexBufferBinds = 0;
+	std::uint64_t IndexBufferBinds = 0;
+	std::uint64_t ConstantBufferBinds = 0;
+	std::uint64_t TextureBinds = 0;
+	std::uint64_t RenderTargetBinds = 0;
+	std::uint64_t RedundantBinds = 0;
+	std::uint64_t Clears = 0;
+	std::uint64_t Copies = 0;
+
+	std::uint64_t BytesUploaded = 0;
+
+	void Reset()
+	{
+		*this = sGICommandStats();
+	}
+
+	sGICommandStats& operator+=(const sGICommandStats& Other)
+	{
+		Presents += Other.Presents;
+		CommandListsExecuted += Other.CommandListsExecuted;
+		CommandBytesRecorded += Other.CommandBytesRecorded;
+		DrawCalls += Other.DrawCalls;
+		VerticesDrawn += Other.VerticesDrawn;
+		InstancesDrawn += Other.InstancesDrawn;
+		Dispatches += Other.Dispatches;
+		PipelineSwitches += Other.PipelineSwitches;
+		VertexBufferBinds += Other.VertexBufferBinds;
+		IndexBufferBinds += Other.IndexBufferBinds;
+		ConstantBufferBinds += Other.ConstantBufferBinds;
+		TextureBinds += Other.TextureBinds;
+		RenderTargetBinds += Other.RenderTargetBinds;
+		RedundantBinds += Other.RedundantBinds;
+		Clears += Other.Clears;
+		Copies += Other.Copies;
+		BytesUploaded += Other.BytesUploaded;
+		return *this;
+	}
+
+	std::string ToString() const
+	{
+		return std::string("Presents : " + std::to_string(Presents) + "\n" + "CommandListsExecuted : " + std::to_string(CommandListsExecuted) + "\n" + "CommandBytesRecorded : " + std::to_string(CommandBytesRecorded) + "\n"
+			+ "DrawCalls : " + std::to_string(DrawCalls) + "\n" + "VerticesDrawn : " + std::to_string(VerticesDrawn) + "\n" + "InstancesDrawn : " + std::to_string(InstancesDrawn) + "\n" + "Dispatches : " + std::to_string(Dispatches) + "\n"
+			+ "PipelineSwitches : " + std::to_string(PipelineSwitches) + "\n" + "VertexBufferBinds : " + std::to_string(VertexBufferBinds) + "\n" + "IndexBufferBinds : " + std::to_string(IndexBufferBinds) + "\n"
+			+ "ConstantBufferBinds : " + std::to_string(ConstantBufferBinds) + "\n" + "TextureBinds : " + std::to_string(TextureBinds) + "\n" + "RenderTargetBinds : " + std::to_string(RenderTargetBinds) + "\n"
+			+ "RedundantBinds : " + std::to_string(RedundantBinds) + "\n" + "Clears : " + std::to_string(Clears) + "\n" + "Copies : " + std::to_string(Copies) + "\n" + "BytesUploaded : " + std::to_string(BytesUploaded));
+	}
+};
+
 enum class EParticleType
 {
 	eCPU,
@@ -1975,40 +2053,219 @@ enum class eRPCType
 	ServerAndClient
 };
 
+class sReplicatedProperties;
+
 /*
-* WIP
+* Host side value of a replicated property, Set marks it dirty only when the value changes.
+* Clients get it written by the replication update before the owner's OnReplicated is called.
 */
 template<typename T>
 class ReplicatedVariable
 {
-protected:
-	ReplicatedVariable(const std::string& InName, bool bReliable, bool IsReqTimeStamp)
-		: Name(InName)
-		, bIsReliable(bReliable)
-		, ReqTimeStamp(IsReqTimeStamp)
+	friend class sReplicatedProperties;
+public:
+	ReplicatedVariable(const T& InValue = T())
+		: Variable(InValue)
+		, Owner(nullptr)
+		, Index(0)
 	{}
 
+	ReplicatedVariable(const ReplicatedVariable&) = delete;
+	ReplicatedVariable& operator=(const ReplicatedVariable&) = delete;
+
+	inline const T& Get() const { return Variable; }
+	inline operator const T&() const { return Variable; }
+
+	inline void Set(const T& InValue)
+	{
+		if constexpr (std::equality_comparable<T>)
+		{
+			if (Variable == InValue)
+				return;
+		}
+		Variable = InValue;
+		MarkDirty();
+	}
+
+	inline void MarkDirty();
+	/*
+	* True if the bit of this property is set in the mask OnReplicated was called with.
+	*/
+	inline bool IsChanged(std::uint64_t ChangedMask) const { return Owner && (ChangedMask & (1ull << Index)) != 0; }
+
+private:
+	T Variable;
+	sReplicatedProperties* Owner;
+	std::size_t Index;
+};
+
+/*
+* Replicated properties of an actor or component, registered under the address and class name of its RPCs.
+* The host keeps a dirty bit per property, the network tick merges them at the replication rate and sends
+* each client the properties it hasn't acknowledged. Clients apply a whole update, then OnReplicated is called
+* with a bit per changed property.
+* With relevancy bounds an object is only sent to the clients that see it or own an actor near it.
+*/
+class sReplicatedProperties
+{
+	sBaseClassBody(sClassNoDefaults, sReplicatedProperties)
 public:
-	virtual ~ReplicatedVariable()
+	static constexpr std::size_t MaxProperties = 64;
+
+	sReplicatedProperties()
+		: DirtyMask(0)
+		, bIsRegistered(false)
+	{}
+
+	virtual ~sReplicatedProperties()
 	{
-		Name = "";
+		Unregister();
+		OnReplicated = nullptr;
+		OnRelevancyChanged = nullptr;
+		GetRelevancyBounds = nullptr;
 	}
 
-	inline bool IsReqTimeStamp() const { return ReqTimeStamp; }
-	inline std::string GetName() const { return Name; }
-	inline bool IsReliable() const { return bIsReliable; }
+	sReplicatedProperties(const sReplicatedProperties&) = delete;
+	sReplicatedProperties& operator=(const sReplicatedProperties&) = delete;
 
-	void Sync()
+	/*
+	* Properties go out in the order they are added, both ends have to add the same ones before Register.
+	*/
+	template<typename T>
+	inline bool Add(const std::string& Name, ReplicatedVariable<T>& Variable)
 	{
+		if (bIsRegistered || Properties.size() >= MaxProperties)
+			return false;
+
+		Variable.Owner = this;
+		Variable.Index = Properties.size();
+		sProperty Property;
+		Property.Name = Name;
+		Property.Write = [&Variable](sArchive& Archive) { Archive << Variable.Variable; };
+		Property.Read = [&Variable](const sArchiveView& Archive) { Archive >> Variable.Variable; };
+		Properties.push_back(std::move(Property));
+		return true;
+	}
 
+	inline void MarkDirty(std::size_t Index)
+	{
+		if (Index < Properties.size())
+			DirtyMask.fetch_or(1ull << Index);
 	}
+	/*
+	* Dirty bits since the last call, the replication tick takes them.
+	*/
+	inline std::uint64_t ConsumeDirtyMask() { return DirtyMask.exchange(0); }
 
-	T Variable;
+	inline std::size_t GetPropertyCount() const { return Properties.size(); }
+	inline std::string GetPropertyName(std::size_t Index) const { return Properties.at(Index).Name; }
+	inline void WriteProperty(std::size_t Index, sArchive& Archive) const { Properties.at(Index).Write(Archive); }
+	inline void ReadProperty(std::size_t Index, const sArchiveView& Archive) { Properties.at(Index).Read(Archive); }
+
+	/*
+	* False if another object is registered under the same address and class name.
+	*/
+	bool Register(const std::string& Address, const std::string& ClassName);
+	void Unregister();
+	inline bool IsRegistered() const { return bIsRegistered; }
+
+	std::function<void(std::uint64_t ChangedMask)> OnReplicated;
+	/*
+	* Client, the object entered or left the relevant set of this client. A left object gets no updates until it is back.
+	*/
+	std::function<void(bool bIsRelevant)> OnRelevancyChanged;
+	/*
+	* Host, where the object is for interest management. Without bounds it is relevant to every client.
+	*/
+	std::function<std::optional<FBoundingBox>()> GetRelevancyBounds;
 
 private:
-	std::string Name;
-	bool bIsReliable;
-	bool ReqTimeStamp;
+	struct sProperty
+	{
+		std::string Name;
+		std::function<void(sArchive&)> Write;
+		std::function<void(const sArchiveView&)> Read;
+	};
+	std::vector<sProperty> Properties;
+	std::atomic<std::uint64_t> DirtyMask;
+	bool bIsRegistered;
+};
+
+template<typename T>
+inline void ReplicatedVariable<T>::MarkDirty()
+{
+	if (Owner)
+		Owner->MarkDirty(Index);
+}
+
+/*
+* Compact wire name of an RPC, FNV-1a of the address and of the class and function names.
+* Both ends hash the names they register, so no table has to be exchanged at connect.
+* The address is kept apart so a client can swap its local player address for the server one.
+*/
+struct sRPCHandle
+{
+	std::uint32_t Address = 0;
+	std::uint32_t Member = 0;
+
+	static constexpr std::uint32_t Hash(std::string_view Text, std::uint32_t Seed = 2166136261u)
+	{
+		for (const char C : Text)
+		{
+			Seed ^= (std::uint8_t)C;
+			Seed *= 16777619u;
+		}
+		return Seed;
+	}
+
+	/*
+	* A zero byte between the names keeps "AB" + "C" apart from "A" + "BC", zero is reserved for invalid.
+	*/
+	static constexpr std::uint32_t Hash(std::string_view ClassName, std::string_view Name)
+	{
+		const std::uint32_t Value = Hash(Name, Hash(ClassName) * 16777619u);
+		return Value != 0 ? Value : 1;
+	}
+
+	constexpr sRPCHandle() = default;
+	constexpr sRPCHandle(std::uint32_t InAddress, std::uint32_t InMember)
+		: Address(InAddress)
+		, Member(InMember)
+	{}
+	constexpr sRPCHandle(std::string_view InAddress, std::string_view ClassName, std::string_view Name)
+		: Address(Hash(InAddress))
+		, Member(Hash(ClassName, Name))
+	{}
+
+	constexpr bool IsValid() const { return Member != 0; }
+
+	inline std::string ToString() const
+	{
+		return std::to_string(Address) + ":" + std::to_string(Member);
+	}
+
+	friend constexpr bool operator==(const sRPCHandle& v1, const sRPCHandle& v2)
+	{
+		return v1.Address == v2.Address && v1.Member == v2.Member;
+	}
+	friend constexpr bool operator!=(const sRPCHandle& v1, const sRPCHandle& v2)
+	{
+		return !(v1 == v2);
+	}
+
+	static constexpr auto GetArchiveFields()
+	{
+		return MakeArchiveFields(&sRPCHandle::Address, &sRPCHandle::Member);
+	}
+	sArchiveFieldsBody(sRPCHandle)
+};
+
+struct sRPCHandleHasher
+{
+	inline std::size_t operator()(const sRPCHandle& Handle) const
+	{
+		return (std::size_t)(((std::uint64_t)Handle.Address << 32) | Handle.Member);
+	}
 };
 
 class RemoteProcedureCallBase
@@ -2032,10 +2289,18 @@ public:
 	inline eRPCType GetType() const { return Type; }
 	inline bool IsReliable() const { return bIsReliable; }
 	//inline virtual std::vector<eParamType> GetParamTypes() const = 0;
-	inline virtual bool SetParams(const sArchive& sArchive) = 0;
+	/*
+	* The whole view is the parameter block, an sArchive converts to one.
+	*/
+	inline virtual bool SetParams(const sArchiveView& pArchive) = 0;
 
 	virtual void Call() = 0;
-	virtual void Call(const sArchive& pArchive) = 0;
+	virtual void Call(const sArchiveView& pArchive) = 0;
+	/*
+	* The first parameter is taken from TimeStamp or ID, the rest are read from pArchive.
+	*/
+	virtual void Call(const sDateTime& TimeStamp, const sArchiveView& pArchive) = 0;
+	virtual void Call(std::uint32_t ID, const sArchiveView& pArchive) = 0;
 
 private:
 	std::string Name;
@@ -2073,22 +2338,40 @@ public:
 		Params = std::tuple<Args...>();
 	}
 
-	virtual void Call(const sArchive& pArchive) override
+	virtual void Call(const sArchiveView& pArchive) override
 	{
 		std::lock_guard<std::mutex> lock(mutex);
 
 		if (ParamCount > 0)
 		{
 			pArchive.ResetPos();
+			pArchive.ClearFailed();
 			for_each_tuple(Params, [&](auto& x) {
 				pArchive >> x;
 				});
+
+			if (pArchive.IsFailed())
+			{
+				std::cerr << "RPC '" << GetName() << "' dropped, parameters are truncated." << std::endl;
+				Params = std::tuple<Args...>();
+				return;
+			}
 		}
 
 		std::apply([&](auto...xs) { function(std::forward<decltype(xs)>(xs)...); }, Params);
 		Params = std::tuple<Args...>();
 	}
 
+	virtual void Call(const sDateTime& TimeStamp, const sArchiveView& pArchive) override
+	{
+		CallWithFirstParam(TimeStamp, pArchive);
+	}
+
+	virtual void Call(std::uint32_t ID, const sArchiveView& pArchive) override
+	{
+		CallWithFirstParam(ID, pArchive);
+	}
+
 	//inline virtual std::vector<eParamType> GetParamTypes() const override { return ParamTypes; }
 
 	inline virtual void SetParamsAsTuple(std::tuple<Args...>& t)
@@ -2097,7 +2380,7 @@ public:
 		Params = t;
 	}
 
-	inline virtual bool SetParams(const sArchive& pArchive)
+	inline virtual bool SetParams(const sArchiveView& pArchive)
 	{
 		std::lock_guard<std::mutex> lock(mutex);
 		if (ParamCount == 0)
@@ -2107,10 +2390,11 @@ public:
 		//	return false;
 
 		pArchive.ResetPos();
+		pArchive.ClearFailed();
 		for_each_tuple(Params, [&](auto& x) {
 			pArchive >> x;
 			});
-		return true;
+		return !pArchive.IsFailed();
 	}
 
 	/*template<ParamType p>
@@ -2123,6 +2407,42 @@ public:
 	}*/
 
 private:
+	/*
+	* Same as Call(pArchive) with the first parameter given directly, the payload is read where it is.
+	*/
+	template <typename T>
+	inline void CallWithFirstParam(const T& First, const sArchiveView& pArchive)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		pArchive.ResetPos();
+		pArchive.ClearFailed();
+		bool bIsFirst = true;
+		bool bTypeMismatch = false;
+		for_each_tuple(Params, [&](auto& x) {
+			if (bIsFirst)
+			{
+				bIsFirst = false;
+				if constexpr (std::is_same_v<std::decay_t<decltype(x)>, T>)
+					x = First;
+				else
+					bTypeMismatch = true;
+				return;
+			}
+			pArchive >> x;
+			});
+
+		if (bTypeMismatch || pArchive.IsFailed())
+		{
+			std::cerr << "RPC '" << GetName() << "' dropped, parameters do not match." << std::endl;
+			Params = std::tuple<Args...>();
+			return;
+		}
+
+		std::apply([&](auto...xs) { function(std::forward<decltype(xs)>(xs)...); }, Params);
+		Params = std::tuple<Args...>();
+	}
+
 	std::mutex mutex;
 	std::function<void(Args...)> function;
 	//std::vector<eParamType> ParamTypes;
@@ -2174,6 +2494,13 @@ namespace GPU
 
 	// WIP
 	bool IsBindlessRendererEnabled();
+
+	/*
+	* Counters of the null GI backend, accumulated since the last reset.
+	* Always zero for the hardware backends.
+	*/
+	sGICommandStats GetCommandStats();
+	void ResetCommandStats();
 }
 
 sViewportInstance::~sViewportInstance()
@@ -2203,7 +2530,10 @@ namespace Physics
 	{
 		return dynamic_cast<T*>(LineTraceToViewPort(InOrigin, InDirection));
 	}
-	std::vector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds);
+	/*
+	* Result lives on the frame arena, valid until the end of the next frame.
+	*/
+	sFrameVector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds);
 
 	float GetPhysicalWorldScale();
 }
@@ -2243,6 +2573,28 @@ namespace Audio
 	void BindFunctionOnVoiceStop(std::function<void(std::string)> fOnVoiceStop);
 }
 
+/*
+* Server side traffic counters since the session was created.
+* Tick times cover the network tick only (poll, dispatch and send), the engine tick is in Engine::GetFrameStats.
+*/
+struct sNetworkTrafficStats
+{
+	std::uint64_t BytesReceived = 0;
+	std::uint64_t BytesSent = 0;
+	std::uint64_t PacketsReceived = 0;
+	std::uint64_t PacketsSent = 0;
+	std::uint64_t RPCsHandled = 0;
+	std::uint64_t TickCount = 0;
+	double TickTimeTotalMS = 0.0;
+	double TickTimeMaxMS = 0.0;
+
+	static constexpr auto GetArchiveFields()
+	{
+		return MakeArchiveFields(&sNetworkTrafficStats::BytesReceived, &sNetworkTrafficStats::BytesSent, &sNetworkTrafficStats::PacketsReceived, &sNetworkTrafficStats::PacketsSent, &sNetworkTrafficStats::RPCsHandled, &sNetworkTrafficStats::TickCount, &sNetworkTrafficStats::TickTimeTotalMS, &sNetworkTrafficStats::TickTimeMaxMS);
+	}
+	sArchiveFieldsBody(sNetworkTrafficStats)
+};
+
 class sGameInstance;
 class sPlayer;
 namespace Network
@@ -2268,13 +2620,29 @@ namespace Network
 	void SetClientMaximumMessagePerTick(std::size_t Size);
 	std::size_t GetClientMaximumMessagePerTick();
 
+	/*
+	* Receive thread to game thread message queue, full/backpressure counters included.
+	*/
+	sMPSCQueueStats GetServerIncomingQueueStats();
+	sMPSCQueueStats GetClientIncomingQueueStats();
+	sNetworkTrafficStats GetServerTrafficStats();
+
+	/*
+	* Packets larger than Bytes once encoded are sent LZ compressed, 0 sends everything raw.
+	*/
+	void SetServerCompressionThreshold(std::size_t Bytes);
+	void SetClientCompressionThreshold(std::size_t Bytes);
+	sCompressionStats GetServerCompressionStats();
+	sCompressionStats GetClientCompressionStats();
+
 	void CallRPC(std::string Address, std::string ClassName, std::string Name, std::optional<bool> reliable = std::nullopt);
 	void CallRPC(std::string Address, std::string ClassName, std::string Name, const sArchive& Params, std::optional<bool> reliable = std::nullopt);
 
 	template <typename... Args>
 	bool CallRPCEx(std::string Address, std::string ClassName, std::string Name, bool reliable, Args&&... args)
 	{
-		return CallRPC(Address, ClassName, Name, sArchive(args...), reliable);
+		CallRPC(Address, ClassName, Name, sArchive(args...), reliable);
+		return true;
 	}
 
 	void RegisterRPC(std::string Address, std::string ClassName, RemoteProcedureCallBase* RPC);
@@ -2284,9 +2652,40 @@ namespace Network
 	void UnregisterRPC(std::string Address);
 	void UnregisterRPC(std::string Address, std::string ClassName);
 	void UnregisterRPC(std::string Address, std::string ClassName, const std::string& rpcName);
+	/*
+	* Debug fallback, outgoing packets carry RPC names instead of handles. Both ends read either.
+	*/
+	void SetSendRPCNames(bool bEnable);
+
+	/*
+	* Replication updates the host sends per second, property changes in between are merged.
+	*/
+	void SetReplicationRate(std::uint32_t UpdatesPerSecond);
+	std::uint32_t GetReplicationRate();
+	/*
+	* Objects this close to an actor a client possesses are relevant to it, on top of what its cameras see.
+	*/
+	void SetRelevancyDistance(float Distance);
+	float GetRelevancyDistance();
+	/*
+	* Client, world bounds a local player sees. Sent to the server for interest management, nullopt removes it.
+	*/
+	void SetViewBounds(std::size_t PlayerIndex, std::optional<FBoundingBox> Bounds);
 }
 
 class sInputController;
+
+/*
+* Compute runs the frame graph and short jobs, BlockingIO is for jobs that wait on disk or sockets,
+* Streaming is for background asset loading.
+*/
+enum class EThreadPoolType : std::uint8_t
+{
+	eCompute,
+	eBlockingIO,
+	eStreaming,
+};
+
 namespace Engine
 {
 	void WriteToConsole(const std::string& STR);
@@ -2304,7 +2703,32 @@ namespace Engine
 	sInputController* GetInputController();
 
 	void QueueJob(const std::function<void()>& job);
+	void QueueJob(EThreadPoolType Pool, const std::function<void()>& job, EJobPriority Priority = EJobPriority::eNormal);
+	sJobHandle ScheduleJob(const std::function<void()>& job, const sJobHandle& Parent = sJobHandle());
+	void WaitForJob(const sJobHandle& Handle);
+	sJobHandle ParallelFor(std::size_t Count, std::size_t BatchSize, const std::function<void(std::size_t)>& Function);
 	std::size_t AvailableThreadCount();
+	/*
+	* Restarts the pool, jobs that are still queued are dropped.
+	* Compute pool changes only apply when set before the engine is created.
+	*/
+	void SetThreadPoolDesc(EThreadPoolType Pool, const sThreadPoolDesc& Desc);
+	sThreadPoolStats GetThreadPoolStats(EThreadPoolType Pool);
+	/*
+	* Long-lived loops (socket accept/recv) get their own thread instead of blocking a pool worker.
+	*/
+	sServiceThread::UniquePtr StartServiceThread(const std::string& Name, const std::function<void()>& Function);
+
+	/*
+	* Percentiles over the last Desc.WindowSize frames, times in ms.
+	* Frames over Desc.HitchBudgetMS write the last Desc.HitchDumpFrames profiler frames to Desc.HitchDumpDirectory.
+	*/
+	void SetFrameStatsDesc(const sFrameStatsDesc& Desc);
+	sFrameStatsDesc GetFrameStatsDesc();
+	sFrameStatSummary GetFrameStats(EFrameStat Stat);
+	std::vector<sFrameStatSummary> GetAllFrameStats();
+	std::optional<sHitchRecord> GetLastHitch();
+	void ResetFrameStats();
 
 	bool IsInputPaused();
 	void PauseInput(bool value);
@@ -2312,6 +2736,11 @@ namespace Engine
 	void PauseTick(bool value);
 
 	sScreenDimension GetScreenDimension();
+	/*
+	* True for a dedicated server engine without device, renderer, audio and input.
+	* Gameplay can skip canvases and visual-only components, GPU resource factories return nullptr.
+	*/
+	bool IsHeadless();
 
 	template<typename T>
 	inline T RandomValueInRange(T Min, T Max)
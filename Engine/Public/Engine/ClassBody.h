@@ -31,13 +31,23 @@
 #include <set>
 #include <memory>
 #include <functional>
+#include "Core/ObjectPool.h"
 
 #ifndef sFORCEINLINE
 #define sFORCEINLINE __forceinline
+#endif
+
+	// MSVC keeps __cplusplus at 199711L unless /Zc:__cplusplus is set
+#ifndef sCPP_LANG
+#if defined(_MSVC_LANG)
+#define sCPP_LANG _MSVC_LANG
+#else
+#define sCPP_LANG __cplusplus
+#endif
 #endif
 
 	// Functions that became constexpr in C++20
-#if _MSVC_LANG >= 202002L
+#if sCPP_LANG >= 202002L
 #ifndef sCONSTEXPR20
 #define sCONSTEXPR20 constexpr
 #endif
@@ -73,6 +83,43 @@
 		}															
 #endif
 
+#ifndef sPooledClassConstructor
+/* Helper macro to create class from a per-class object pool (Core/ObjectPool.h). */
+#define sPooledClassConstructor(Class)																										\
+	public:																																	\
+		static void* operator new(std::size_t Size)																							\
+		{																																	\
+			return Size == sizeof(Class) ? sClassPool<Class>::Get().Allocate() : ::operator new(Size);										\
+		}																																	\
+		static void operator delete(void* Ptr, std::size_t Size)																			\
+		{																																	\
+			if (Size == sizeof(Class))																										\
+				sClassPool<Class>::Get().Deallocate(Ptr);																					\
+			else																															\
+				::operator delete(Ptr);																										\
+		}																																	\
+		static void* operator new(std::size_t, void* Where) noexcept { return Where; }														\
+		static void operator delete(void*, void*) noexcept {}																				\
+		template <typename... Args>																											\
+		static inline Class* CreateNew(Args&&... other)																						\
+		{																																	\
+			auto pClass = new Class(std::forward<Args>(other)...);																			\
+			return pClass;																													\
+		}																																	\
+		template <typename... Args>																											\
+		static inline Class::SharedPtr Create(Args&&... other)																				\
+		{																																	\
+			auto pClass = std::allocate_shared<Class>(sPoolAllocator<Class>(), std::forward<Args>(other)...);								\
+			return pClass;																													\
+		}																																	\
+		template <typename... Args>																											\
+		static inline Class::UniquePtr CreateUnique(Args&&... other)																		\
+		{																																	\
+			auto pClass = Class::UniquePtr(new Class(std::forward<Args>(other)...));														\
+			return pClass;																													\
+		}
+#endif
+
 #ifndef sClassDefaultProtectedConstructor
 /* Helper macro to Default Protected Constructor. */
 #define sClassDefaultProtectedConstructor(Class)		\
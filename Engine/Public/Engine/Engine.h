@@ -30,29 +30,53 @@
 #include "Utilities/Input.h"
 #include "Engine/AbstractEngine.h"
 #include "Engine/StepTimer.h"
+#include "Core/TaskGraph.h"
 #include "IMetaWorld.h"
 #include "Engine/IPhysicalWorld.h"
 
+/*
+* Dedicated server setup, the engine runs without a GPU device, renderer, canvas, audio or input.
+*/
+struct sHeadlessCreateInfo
+{
+	/*
+	* Engine ticks per second, EngineInternalTick sleeps until the next tick is due.
+	*/
+	double TickRate = 30.0;
+	/*
+	* PhysicsTick and FixedTick rate.
+	*/
+	double FixedTickRate = 60.0;
+};
+
 class sEngine final
 {
 	sBaseClassBody(sClassConstructor, sEngine);
 public:
 	sEngine(const GPUDeviceCreateInfo& CreateInfo, const IPhysicalWorld::SharedPtr& PhysicalWorld);
+	/*
+	* Headless mode: only the coroutine, network and world stages run, GPU resource factories return nullptr.
+	*/
+	sEngine(const sHeadlessCreateInfo& CreateInfo, const IPhysicalWorld::SharedPtr& PhysicalWorld);
 	//sEngine(const EGITypes GIType, const IPhysicalWorld::SharedPtr& PhysicalWorld, std::optional<short> GPUIndex = std::nullopt, void* InHWND = nullptr);
 	~sEngine();
 
 	//bool InitWindow(void* HWND, std::uint32_t InWidth, std::uint32_t InHeight, bool bFullscreen);
 
+	/*
+	* Runs the frame graph:
+	* FixedStep -> Coroutines -> Network -> World -> BeginFrame -> Render -> Present
+	* FixedStep runs the physics and fixed updates due since the last frame.
+	* Workers run Audio, Input polling before FixedStep, NetworkReceive before Network and Renderer Tick next to BeginFrame.
+	* Headless: NetworkReceive, FixedStep -> Coroutines -> Network -> World, then sleeps until the next tick.
+	*/
 	void EngineInternalTick();
+	bool IsHeadless() const;
 
 	void BeginPlay();
 	void PhysicsTick(const double DeltaTime);
 	void FixedTick(const double DeltaTime);
-	/*
-	* With Renderer Tick
-	*/
 	void BeginFrame();
-	void Tick(const double DeltaTime);
 	void Render();
 	void Present();
 
@@ -94,11 +118,28 @@ public:
 
 	void InputProcess(const GMouseInput& MouseInput, const GKeyboardChar& KeyboardChar);
 
+	/*
+	* Present of frame N runs on a worker and overlaps the gameplay stages of frame N+1.
+	* Off by default, gameplay updates GPU buffers on the immediate context (debug lines, spawned meshes)
+	* and must not do that outside of the render stages while enabled.
+	*/
+	void SetFrameOverlap(bool Enable);
+	bool IsFrameOverlapEnabled() const;
+
 private:
+	/*
+	* Shared by the windowed and headless constructors: thread pools, coroutines and the fixed step timer.
+	*/
+	void InitializeCore();
+	void BuildFrameGraph();
+
 	bool bWindowInitialized;
 	StepTimer mStepTimer;
 	StepTimer FixedStepTimer;
 	sScreenDimension ScreenDimension;
 
 	std::shared_ptr<IMetaWorld> MetaWorld;
+
+	sTaskGraph::UniquePtr FrameGraph;
+	bool bFrameOverlap;
 };
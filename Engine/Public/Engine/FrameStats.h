@@ -0,0 +1,178 @@
+/* ---------------------------------------------------------------------------------------
+* MIT License
+*
+* Copyright (c) 2023 Davut Cokun.
+* All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+* ---------------------------------------------------------------------------------------
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Engine/ClassBody.h"
+
+enum class EFrameStat : std::uint8_t
+{
+	/*
+	* Wall time between two frames, including vsync and fixed steps.
+	*/
+	eFrame,
+	/*
+	* Number of fixed steps that ran since the previous frame, not a time.
+	*/
+	eFixedSteps,
+	ePhysics,
+	/*
+	* Coroutines, network, world, input and fixed tick.
+	*/
+	eTick,
+	/*
+	* BeginFrame, renderer tick and render.
+	*/
+	eRender,
+	ePresent,
+	eCount,
+};
+
+struct sFrameStatSummary
+{
+	EFrameStat Stat = EFrameStat::eFrame;
+	std::string Name;
+	std::uint32_t SampleCount = 0;
+	double Avg = 0.0;
+	double P50 = 0.0;
+	double P95 = 0.0;
+	double P99 = 0.0;
+	double Max = 0.0;
+};
+
+struct sFrameStatsDesc
+{
+	/*
+	* Frames kept in the rolling window the percentiles are computed from.
+	*/
+	std::uint32_t WindowSize = 600;
+	/*
+	* Frames longer than the budget dump the profiler, disabled when not set.
+	*/
+	std::optional<double> HitchBudgetMS = std::nullopt;
+	/*
+	* Profiler frames written per hitch, the hitch frame included.
+	*/
+	std::uint32_t HitchDumpFrames = 120;
+	/*
+	* Minimum frames between two dumps, a long stall doesn't write one trace per frame.
+	*/
+	std::uint32_t HitchCooldownFrames = 300;
+	std::string HitchDumpDirectory = "Saved/Hitches";
+};
+
+struct sHitchRecord
+{
+	std::uint64_t FrameIndex = 0;
+	double FrameMS = 0.0;
+	/*
+	* Empty if the dump was skipped by the cooldown.
+	*/
+	std::string DumpPath;
+};
+
+/*
+* Rolling frame-time statistics.
+* Stage times are accumulated during the frame from any thread, EndFrame is called by the game thread once
+* the frame graph finished and moves them into the window. Present of an overlapped frame lands in the next frame.
+*/
+class sFrameStats
+{
+	sBaseClassBody(sClassConstructor, sFrameStats)
+public:
+	sFrameStats();
+	~sFrameStats() = default;
+
+	void SetDesc(const sFrameStatsDesc& Desc);
+	sFrameStatsDesc GetDesc() const;
+
+	void AddTime(EFrameStat Stat, std::uint64_t NS);
+	void AddFixedSteps(std::uint32_t Count);
+	void EndFrame();
+
+	sFrameStatSummary GetSummary(EFrameStat Stat) const;
+	std::vector<sFrameStatSummary> GetSummaries() const;
+	std::uint64_t GetHitchCount() const;
+	std::optional<sHitchRecord> GetLastHitch() const;
+	void Reset();
+
+	static const char* GetStatName(EFrameStat Stat);
+
+	/*
+	* Adds the lifetime of the scope to a stage of the current frame.
+	*/
+	class sScopedTime
+	{
+	public:
+		sScopedTime(sFrameStats& InStats, EFrameStat InStat)
+			: Stats(InStats)
+			, Stat(InStat)
+			, Start(std::chrono::steady_clock::now())
+		{}
+
+		~sScopedTime()
+		{
+			Stats.AddTime(Stat, (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count());
+		}
+
+		sScopedTime(const sScopedTime&) = delete;
+		sScopedTime& operator=(const sScopedTime&) = delete;
+
+	private:
+		sFrameStats& Stats;
+		EFrameStat Stat;
+		std::chrono::steady_clock::time_point Start;
+	};
+
+private:
+	static constexpr std::size_t StatCount = (std::size_t)EFrameStat::eCount;
+
+	void DumpHitch(double FrameMS);
+
+	std::array<std::atomic<std::uint64_t>, StatCount> CurrentFrame;
+
+	mutable std::mutex Mutex;
+	sFrameStatsDesc Desc;
+	/*
+	* Ring buffers of WindowSize samples, in ms except eFixedSteps.
+	*/
+	std::array<std::vector<double>, StatCount> Samples;
+	std::size_t WriteIndex;
+	std::size_t SampleCount;
+	std::optional<std::chrono::steady_clock::time_point> LastFrameEnd;
+	std::uint64_t FrameCount;
+	std::uint64_t LastDumpFrame;
+	std::uint64_t HitchCount;
+	std::optional<sHitchRecord> LastHitch;
+};
@@ -44,7 +44,7 @@ public:
 	virtual void SetWorldOrigin(const FVector& newOrigin) = 0;
 
 	virtual sPhysicalComponent* LineTraceToViewPort(const FVector& InOrigin, const FVector& InDirection) const = 0;
-	virtual std::vector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds) const = 0;
+	virtual sFrameVector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds) const = 0;
 
 	virtual std::size_t GetBodyCount() const = 0;
 	virtual sPhysicalComponent* GetPhysicalBody(std::size_t Index) const = 0;
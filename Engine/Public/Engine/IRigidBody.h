@@ -121,7 +121,7 @@ public:
 	virtual FVector GetLocation() const = 0;
 	virtual FQuaternion GetRotation() const = 0;
 
-	virtual void GetAabb(FVector& InMn, FVector& InMax) const = 0;
+	virtual void GetAabb(FVector& InMin, FVector& InMax) const = 0;
 
 	virtual void SetCollisionChannel(ECollisionChannel Type) = 0;
 	virtual void SetCollisionChannel(ECollisionChannel Type, std::uint16_t CollideTo) = 0;
@@ -31,6 +31,7 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <bitset>
 #include "Engine/ClassBody.h"
 #include "Utilities/Input.h"
 #include "Gamepad.h"
@@ -280,6 +281,13 @@ public:
 	void Tick(const double DeltaTime);
 	void FixedUpdate(const double DeltaTime);
 
+	/*
+	* Reads the window focus, mouse, keyboard and gamepad state without firing callbacks, safe to call from a worker.
+	*/
+	void Poll();
+	/*
+	* Fires the callbacks from the state read by the last Poll.
+	*/
 	void Update();
 
 	void BindInput(std::string Name, const sKMButtonInputDesc Desc);
@@ -326,6 +334,15 @@ private:
 	std::map<eGamepadPlayer, sGamepadButtonInputDesc> GamePadInputMap;
 	std::unique_ptr<DirectX::GamePad> pGamePad;
 
+	struct sPolledState
+	{
+		bool bIsForeground = false;
+		FVector2 MouseLocation = FVector2::Zero();
+		std::bitset<256> Keys;
+		std::array<DirectX::GamePad::State, DirectX::GamePad::MAX_PLAYER_COUNT> GamePads = {};
+	};
+	sPolledState Polled;
+
 	bool bIsKeyboardEnabled;
 	bool bIsMouseEnabled;
 	bool bIsGamepadEnabled;
@@ -29,58 +29,96 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <iostream>
 
-#include <windows.h>
-#include <psapi.h>
+/*
+* Replaces global operator new/delete with a tagged tracking layer.
+* Every allocation carries a 16 byte header with its size and tag, counters are gathered per thread and added to the shared ones in batches.
+*/
+#ifndef Enable_MemoryTracking
+#define Enable_MemoryTracking 1
+#endif
+
+enum class EMemoryTag : std::uint8_t
+{
+	eUntagged,
+	eRender,
+	ePhysics,
+	eNetwork,
+	eAudio,
+	eContent,
+	eGameplay,
+	eCount,
+};
+
+struct sMemoryTagStats
+{
+	EMemoryTag Tag = EMemoryTag::eUntagged;
+	std::int64_t LiveBytes = 0;
+	std::int64_t PeakBytes = 0;
+	std::int64_t LiveAllocations = 0;
+	std::uint64_t TotalAllocations = 0;
+	/*
+	* Change during the last completed frame.
+	*/
+	std::int64_t FrameDeltaBytes = 0;
+	std::uint64_t FrameAllocations = 0;
+};
+
+struct sProcessMemoryStats
+{
+	std::uint64_t ResidentBytes = 0;
+	std::uint64_t PeakResidentBytes = 0;
+	std::uint64_t PrivateBytes = 0;
+	std::uint64_t TotalPhysicalBytes = 0;
+	std::uint64_t UsedPhysicalBytes = 0;
+};
 
 namespace MemoryManager
 {
-	inline DWORDLONG GetTotalVirtualMem()
+	/*
+	* Allocations on this thread are counted under Tag until the scope ends.
+	*/
+	class sScopedMemoryTag
 	{
-		MEMORYSTATUSEX memInfo;
-		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-		GlobalMemoryStatusEx(&memInfo);
-		return memInfo.ullTotalPageFile;
-	};
+	public:
+		explicit sScopedMemoryTag(EMemoryTag Tag);
+		~sScopedMemoryTag();
 
-	inline DWORDLONG GetVirtualMemUsed()
-	{
-		MEMORYSTATUSEX memInfo;
-		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-		GlobalMemoryStatusEx(&memInfo);
-		DWORDLONG virtualMemUsed = memInfo.ullTotalPageFile - memInfo.ullAvailPageFile;
-		return virtualMemUsed;
-	};
+		sScopedMemoryTag(const sScopedMemoryTag&) = delete;
+		sScopedMemoryTag& operator=(const sScopedMemoryTag&) = delete;
 
-	inline SIZE_T GetVirtualMemUsedByEngine()
-	{
-		PROCESS_MEMORY_COUNTERS_EX pmc;
-		GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc));
-		return pmc.PrivateUsage;
+	private:
+		EMemoryTag PreviousTag;
 	};
 
-	inline DWORDLONG GetTotalPhysicalMemory()
-	{
-		MEMORYSTATUSEX memInfo;
-		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-		GlobalMemoryStatusEx(&memInfo);
-		return memInfo.ullTotalPhys;
-	};
+	EMemoryTag GetCurrentTag();
+	const char* GetTagName(EMemoryTag Tag);
 
-	inline DWORDLONG GetTotalPhysicalMemoryUsed()
-	{
-		MEMORYSTATUSEX memInfo;
-		memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-		GlobalMemoryStatusEx(&memInfo);
-		DWORDLONG physMemUsed = memInfo.ullTotalPhys - memInfo.ullAvailPhys;
-		return physMemUsed;
-	};
+	sMemoryTagStats GetTagStats(EMemoryTag Tag);
+	std::vector<sMemoryTagStats> GetAllTagStats();
+	/*
+	* Sum of every tag, 0 if Enable_MemoryTracking is off.
+	*/
+	std::uint64_t GetTotalAllocationCount();
+	std::uint64_t GetTotalAllocatedBytes();
+	std::int64_t GetLiveBytes();
 
-	inline SIZE_T GetTotalPhysicalMemoryUsedByEngine()
-	{
-		PROCESS_MEMORY_COUNTERS_EX pmc;
-		GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc));
-		return pmc.WorkingSetSize;
-	};
+	/*
+	* Closes the per-frame deltas, called once per frame by the game thread.
+	*/
+	void BeginFrame();
+
+	/*
+	* Windows reads the process counters, Linux reads /proc/self/status and /proc/meminfo.
+	*/
+	sProcessMemoryStats GetProcessMemoryStats();
+
+	std::uint64_t GetTotalVirtualMem();
+	std::uint64_t GetVirtualMemUsed();
+	std::uint64_t GetVirtualMemUsedByEngine();
+	std::uint64_t GetTotalPhysicalMemory();
+	std::uint64_t GetTotalPhysicalMemoryUsed();
+	std::uint64_t GetTotalPhysicalMemoryUsedByEngine();
 };
@@ -13,8 +13,12 @@
 
 #include <cmath>
 #include <exception>
+#include <stdexcept>
 #include <stdint.h>
+#include <chrono>
+#if defined(_WIN32)
 #include <wrl.h>
+#endif
 
 // Helper class for animation and simulation timing.
 class StepTimer
@@ -31,18 +35,18 @@ public:
 		m_isFixedTimeStep(false),
 		m_targetElapsedTicks(TicksPerSecond / 60)
 	{
-		if (!QueryPerformanceFrequency(&m_qpcFrequency))
+		if (!QueryFrequency(m_qpcFrequency))
 		{
-			throw std::exception("QueryPerformanceFrequency");
+			throw std::runtime_error("QueryPerformanceFrequency");
 		}
 
-		if (!QueryPerformanceCounter(&m_qpcLastTime))
+		if (!QueryCounter(m_qpcLastTime))
 		{
-			throw std::exception("QueryPerformanceCounter");
+			throw std::runtime_error("QueryPerformanceCounter");
 		}
 
 		// Initialize max delta to 1/10 of a second.
-		m_qpcMaxDelta = m_qpcFrequency.QuadPart / 10;
+		m_qpcMaxDelta = m_qpcFrequency / 10;
 	}
 
 	// Get elapsed time since the previous Update call.
@@ -67,6 +71,29 @@ public:
 	void SetTargetElapsedTicks(uint64_t targetElapsed) { m_targetElapsedTicks = targetElapsed; }
 	void SetTargetElapsedSeconds(double targetElapsed) { m_targetElapsedTicks = SecondsToTicks(targetElapsed); }
 
+	// Time left until the next Update call of a fixed timestep timer, 0 if it is due or the timestep is variable.
+	// Lets a loop without a window (dedicated server) sleep instead of spinning on Tick.
+	double GetSecondsUntilNextUpdate() const
+	{
+		if (!m_isFixedTimeStep)
+			return 0.0;
+
+		uint64_t currentTime = 0;
+		if (!QueryCounter(currentTime))
+			return 0.0;
+
+		uint64_t timeDelta = currentTime - m_qpcLastTime;
+		if (timeDelta > m_qpcMaxDelta)
+			timeDelta = m_qpcMaxDelta;
+		timeDelta *= TicksPerSecond;
+		timeDelta /= m_qpcFrequency;
+
+		const uint64_t pendingTicks = m_leftOverTicks + timeDelta;
+		if (pendingTicks >= m_targetElapsedTicks)
+			return 0.0;
+		return TicksToSeconds(m_targetElapsedTicks - pendingTicks);
+	}
+
 	// Integer format represents time using 10,000,000 ticks per second.
 	static const uint64_t TicksPerSecond = 10000000;
 
@@ -79,9 +106,9 @@ public:
 
 	void ResetElapsedTime()
 	{
-		if (!QueryPerformanceCounter(&m_qpcLastTime))
+		if (!QueryCounter(m_qpcLastTime))
 		{
-			throw std::exception("QueryPerformanceCounter");
+			throw std::runtime_error("QueryPerformanceCounter");
 		}
 
 		m_leftOverTicks = 0;
@@ -95,14 +122,14 @@ public:
 	void Tick(const TUpdate& update)
 	{
 		// Query the current time.
-		LARGE_INTEGER currentTime;
+		uint64_t currentTime = 0;
 
-		if (!QueryPerformanceCounter(&currentTime))
+		if (!QueryCounter(currentTime))
 		{
-			throw std::exception("QueryPerformanceCounter");
+			throw std::runtime_error("QueryPerformanceCounter");
 		}
 
-		uint64_t timeDelta = currentTime.QuadPart - m_qpcLastTime.QuadPart;
+		uint64_t timeDelta = currentTime - m_qpcLastTime;
 
 		m_qpcLastTime = currentTime;
 		m_qpcSecondCounter += timeDelta;
@@ -115,7 +142,7 @@ public:
 
 		// Convert QPC units into a canonical tick format. This cannot overflow due to the previous clamp.
 		timeDelta *= TicksPerSecond;
-		timeDelta /= m_qpcFrequency.QuadPart;
+		timeDelta /= m_qpcFrequency;
 
 		uint32_t lastFrameCount = m_frameCount;
 
@@ -164,18 +191,46 @@ public:
 			m_framesThisSecond++;
 		}
 
-		if (m_qpcSecondCounter >= static_cast<uint64_t>(m_qpcFrequency.QuadPart))
+		if (m_qpcSecondCounter >= m_qpcFrequency)
 		{
 			m_framesPerSecond = m_framesThisSecond;
 			m_framesThisSecond = 0;
-			m_qpcSecondCounter %= m_qpcFrequency.QuadPart;
+			m_qpcSecondCounter %= m_qpcFrequency;
 		}
 	}
 
 private:
+	// QPC on Windows, steady_clock elsewhere.
+	static bool QueryFrequency(uint64_t& frequency)
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER value;
+		if (!QueryPerformanceFrequency(&value))
+			return false;
+		frequency = static_cast<uint64_t>(value.QuadPart);
+#else
+		frequency = TicksPerSecond;
+#endif
+		return true;
+	}
+
+	static bool QueryCounter(uint64_t& counter)
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER value;
+		if (!QueryPerformanceCounter(&value))
+			return false;
+		counter = static_cast<uint64_t>(value.QuadPart);
+#else
+		// Counted in canonical ticks, converting the small per-call deltas from nanoseconds would truncate.
+		counter = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()) / (1000000000ull / TicksPerSecond);
+#endif
+		return true;
+	}
+
 	// Source timing data uses QPC units.
-	LARGE_INTEGER m_qpcFrequency;
-	LARGE_INTEGER m_qpcLastTime;
+	uint64_t m_qpcFrequency;
+	uint64_t m_qpcLastTime;
 	uint64_t m_qpcMaxDelta;
 
 	// Derived timing data uses a canonical tick format.
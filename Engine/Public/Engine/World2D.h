@@ -90,7 +90,7 @@ public:
 	void SetPositionIterations(int32 PositionIterations) { m_positionIterations = PositionIterations; }
 
 	virtual sPhysicalComponent* LineTraceToViewPort(const FVector& InOrigin, const FVector& InDirection) const override final;
-	virtual std::vector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds) const override final;
+	virtual sFrameVector<sPhysicalComponent*> QueryAABB(const FBoundingBox& Bounds) const override final;
 
 	virtual std::size_t GetBodyCount() const override final;
 	virtual sPhysicalComponent* GetPhysicalBody(std::size_t Index) const override final;
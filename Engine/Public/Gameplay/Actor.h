@@ -72,6 +72,10 @@ public:
 	virtual void Replicate(bool bReplicate);
 	inline bool IsReplicated() const { return bIsReplicated; }
 	virtual eNetworkRole GetNetworkRole() const;
+	/*
+	* Host side, where interest management places the actor and its replicated components. nullopt is relevant to every client.
+	*/
+	virtual std::optional<FBoundingBox> GetRelevancyBounds() const;
 
 	void Hide(bool value);
 	void SetEnabled(bool value);
@@ -137,6 +141,22 @@ private:
 	void AddToActiveLevel_Server(FVector SpawnLocation, std::size_t LayerIndex);
 	void AddToNamedLevel_Server(std::string Level, FVector SpawnLocation, std::size_t LayerIndex);
 
+protected:
+	/*
+	* Subclasses add their replicated properties in their constructor, registered by Replicate.
+	*/
+	inline sReplicatedProperties& GetReplicatedProperties() { return ReplicatedProperties; }
+	/*
+	* Client side, called once per replication update with a bit per changed property.
+	*/
+	virtual void OnReplicated(std::uint64_t ChangedMask) {}
+	/*
+	* Client side, the actor left or entered what this client is sent.
+	* Out of it the proxy is hidden and disabled, and the collision of its physical components is turned off.
+	* The proxy stays in its level, proxies are spawned by the level and replication cannot spawn them back.
+	*/
+	virtual void OnRelevancyChanged(bool bIsRelevant);
+
 private:
 	sPrimitiveComponent::SharedPtr RootComponent;
 	std::string Name;
@@ -156,4 +176,11 @@ private:
 	bool bIsEnabled;
 
 	bool bIsReplicated;
+	sReplicatedProperties ReplicatedProperties;
+	bool bWasHidden;
+	bool bWasEnabled;
+	/*
+	* Physical components whose collision was turned off while the proxy is not relevant.
+	*/
+	std::vector<std::weak_ptr<sPrimitiveComponent>> CollisionDisabledComponents;
 };
@@ -30,7 +30,7 @@
 
 class sBoxCollision2DComponent : public sPhysicalComponent
 {
-	sClassBody(sClassConstructor, sBoxCollision2DComponent, sPhysicalComponent)
+	sClassBody(sPooledClassConstructor, sBoxCollision2DComponent, sPhysicalComponent)
 public:
 	sBoxCollision2DComponent(std::string InName, const sRigidBodyDesc& Desc, const FDimension2D& Dimension, sActor* pActor = nullptr);
 	virtual ~sBoxCollision2DComponent();
@@ -25,7 +25,6 @@
 */
 #pragma once
 
-#include <DirectXMath.h>
 #include "Actor.h"
 #include "Engine/ClassBody.h"
 #include "Utilities/Input.h"
@@ -77,6 +76,11 @@ public:
 	FVector2 ConvertScreenToWorld(const FVector2& ps) const;
 	FVector2 ConvertWorldToScreen(const FVector2& pw) const;
 
+	/*
+	* World area the orthographic camera shows, nullopt for a perspective or disabled camera.
+	*/
+	std::optional<FBoundingBox> GetViewBounds() const;
+
 	//const sCameraSceneBuffer* GetCameraSceneBuffer() const { return CameraSceneBuffer; }
 
 	bool AddCanvasToViewport(ICanvas* Canvas);
@@ -30,7 +30,7 @@
 
 class sCircleCollision2DComponent : public sPhysicalComponent
 {
-	sClassBody(sClassConstructor, sCircleCollision2DComponent, sPhysicalComponent)
+	sClassBody(sPooledClassConstructor, sCircleCollision2DComponent, sPhysicalComponent)
 public:
 	sCircleCollision2DComponent(std::string InName, const sRigidBodyDesc& Desc, const FVector2& Origin, float InRadius, sActor* pActor = nullptr);
 	virtual ~sCircleCollision2DComponent();
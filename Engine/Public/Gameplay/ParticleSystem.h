@@ -143,6 +143,12 @@ public:
 	virtual void Begin() override;
 	virtual void Update(float DT) override;
 
+	/*
+	* Spawns up to Count particles at once into free pool slots, returns how many were spawned.
+	*/
+	std::size_t SpawnBurst(std::size_t Count);
+	std::size_t GetActiveParticleCount() const;
+
 	//bool IsInstanced() const { return bIsInstanced; }
 
 	std::vector<sParticleVertexLayout::sParticleInstanceLayout> ParticleBufferVertexes;
@@ -158,6 +164,7 @@ public:
 
 private:
 	virtual void OnUpdateTransform() override;
+	void Spawn(Particle& particle);
 
 private:
 	sMeshParticleDesc Desc;
@@ -89,11 +89,12 @@ private:
 	virtual void OnCollisionStart(sPhysicalComponent* Component) {}
 	virtual void OnCollisionEnd(sPhysicalComponent* Component) {}
 
-private:
-	void SetLinearVelocity_Client(const FVector& v);
+protected:
+	virtual void OnReplicated(std::uint64_t ChangedMask) override;
 
 private:
 	bool bEnablePhysics;
+	ReplicatedVariable<FVector> NetLinearVelocity;
 	std::function<void(sPhysicalComponent*)> fCollisionStart;
 	std::function<void(sPhysicalComponent*)> fCollisionEnd;
 };
@@ -28,6 +28,7 @@
 #include <vector>
 #include "Core/Math/CoreMath.h"
 #include "Core/Archive.h"
+#include "Engine/AbstractEngine.h"
 
 class sActor;
 
@@ -109,7 +110,7 @@ public:
 			if (auto Component = dynamic_cast<T*>(Child.get()))
 			{
 				Components.push_back(Component);
-				std::vector<T*> Temp = Component->FindComponents<T>();
+				std::vector<T*> Temp = Component->template FindComponents<T>();
 				if (Temp.size() > 0)
 					Components.insert(Components.end(), Temp.begin(), Temp.end());
 			}
@@ -176,6 +177,20 @@ protected:
 private:
 	virtual void OnUpdateTransform() {};
 
+protected:
+	/*
+	* Subclasses add their replicated properties in their constructor, before Replicate is called.
+	*/
+	inline sReplicatedProperties& GetReplicatedProperties() { return ReplicatedProperties; }
+	/*
+	* Client side, called once per replication update with a bit per changed property.
+	*/
+	virtual void OnReplicated(std::uint64_t ChangedMask);
+	/*
+	* Client side, the replicated transform arrived. Applied as is, net components can smooth it.
+	*/
+	virtual void OnReplicatedTransform(const FVector& InLocation, const FVector4& InRotation, const FVector& InScale);
+
 private:
 	virtual void OnBeginPlay() {}
 	virtual void OnTick(const double DeltaTime) {}
@@ -195,10 +210,6 @@ private:
 	virtual void OnChildAttached(sPrimitiveComponent* ChildComponent) {}
 	virtual void OnChildDetached() {}
 
-private:
-	void SetRelativeLocation_Client(const FVector& V);
-	void SetTransform_Client(const FVector& Location, const FVector4& Rotation, const FVector Scale);
-
 private:
 	sActor* Owner;
 	std::string Name;
@@ -214,4 +225,9 @@ private:
 	FVector Scale;
 
 	std::vector<sPrimitiveComponent::SharedPtr> Children;
+
+	ReplicatedVariable<FVector> NetLocation;
+	ReplicatedVariable<sQuantizedRotation> NetRotation;
+	ReplicatedVariable<FVector> NetScale;
+	sReplicatedProperties ReplicatedProperties;
 };
@@ -25,18 +25,21 @@
 */
 #pragma once
 
-#include <shlobj.h>
 #include <ctime>
 #include <iomanip>
-#include <commdlg.h>
 #include <sstream>
 #include <vector>
 #include <cuchar>
 #include <iostream>
 #include <filesystem>
+#include <memory>
+#if defined(_WIN32)
+#include <shlobj.h>
+#include <commdlg.h>
 #include <Windows.h>
 
 #pragma comment(lib, "Shell32.lib")
+#endif
 
 struct UntypedData;
 
@@ -74,7 +77,9 @@ namespace FileManager
 	bool DirectoryExists(const std::string& directory);
 	bool IsDirectory(const std::string& directory);
 	void OpenDirectoryWindow(const std::string& directory);
+#if defined(_WIN32)
 	bool OpenFile(OPENFILENAMEW& FILE);
+#endif
 
 	bool FileExists(const std::string& filePath);
 	bool DeleteFile_(const std::string& filePath);
@@ -111,9 +116,14 @@ namespace FileManager
 	std::string ReplaceExpression(const std::string& str, const std::string& from, const std::string& to);
 	std::string ResolveIncludeDirectives(const std::string& source, const std::string& directory);
 
+#if defined(_WIN32)
 	HRESULT ReadDataFromFile(LPCWSTR filename, byte* data, UINT* size);
+#endif
+	std::vector<std::uint8_t> ReadDataFromFile(const std::filesystem::path& Path); // Memory mapped, empty on failure, not tied to Win32.
+#if defined(_WIN32)
 	HRESULT ReadDataFromDDSFile(LPCWSTR filename, byte* data, UINT* offset, UINT* size);
 	void GetAssetsPath(_Out_writes_(pathSize) WCHAR* path, UINT pathSize);
+#endif
 
 	std::wstring StringToWstring(const std::string& str);
 	std::string WideStringToString(const std::wstring& s);
@@ -83,7 +83,7 @@ namespace
 	{
 		auto Dimension3D = Bound.GetDimension();
 		auto Center = Bound.GetCenter();
-		std::vector<sPhysicalComponent*> Result;
+		sFrameVector<sPhysicalComponent*> Result;
 
 		switch (Type)
 		{
@@ -34,7 +34,7 @@
 
 class GItem : public sActor
 {
-	sClassBody(sClassConstructor, GItem, sActor)
+	sClassBody(sPooledClassConstructor, GItem, sActor)
 public:
 	GItem(std::string Name, std::string Fruit);
 	virtual ~GItem();
@@ -40,34 +40,12 @@ public:
 	virtual ~sNet_BoxCollision2DComponent()
 	{}
 
-	virtual void Replicate(bool bReplicate) override
-	{
-		if (IsReplicated() == bReplicate)
-			return;
-
-		Super::Replicate(bReplicate);
-
-		if (IsReplicated())
-		{
-			RegisterRPCfn(GetClassNetworkAddress(), GetName(), "SetTransform_Client", eRPCType::Client, false, false, std::bind(&sNet_BoxCollision2DComponent::Net_SetTransform_Smoothing_Client, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3/*, std::placeholders::_4*/),/* sDateTime,*/ FVector, FVector4, FVector);
-		}
-		else
-		{
-			Network::UnregisterRPC(GetClassNetworkAddress(), GetName());
-		}
-	}
-
+protected:
 	/*
 	* Time is half of ping in ms
 	*/
-	void Net_SetTransform_Smoothing_Client(/*const sDateTime& Time,*/ const FVector& InLocation, const FVector4& InRotation, const FVector InScale)
+	virtual void OnReplicatedTransform(/*const sDateTime& Time,*/ const FVector& InLocation, const FVector4& InRotation, const FVector& InScale) override
 	{
-		if (Network::IsHost())
-			return;
-
-		if (!IsReplicated())
-			return;
-
 		auto Location = GetRelativeLocation();
 
 		if (Location != InLocation)
@@ -107,34 +85,12 @@ public:
 	virtual ~sNet_CircleCollision2DComponent()
 	{}
 
-	virtual void Replicate(bool bReplicate) override
-	{
-		if (IsReplicated() == bReplicate)
-			return;
-
-		Super::Replicate(bReplicate);
-
-		if (IsReplicated())
-		{
-			RegisterRPCfn(GetClassNetworkAddress(), GetName(), "SetTransform_Client", eRPCType::Client, false, false, std::bind(&sNet_CircleCollision2DComponent::Net_SetTransform_Smoothing_Client, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3/*, std::placeholders::_4*/),/* sDateTime,*/ FVector, FVector4, FVector);
-		}
-		else
-		{
-			Network::UnregisterRPC(GetClassNetworkAddress(), GetName());
-		}
-	}
-
+protected:
 	/*
 	* Time is half of ping in ms
 	*/
-	void Net_SetTransform_Smoothing_Client(/*const sDateTime& Time,*/ const FVector& InLocation, const FVector4& InRotation, const FVector InScale)
+	virtual void OnReplicatedTransform(/*const sDateTime& Time,*/ const FVector& InLocation, const FVector4& InRotation, const FVector& InScale) override
 	{
-		if (Network::IsHost())
-			return;
-
-		if (!IsReplicated())
-			return;
-
 		auto Location = GetRelativeLocation();
 
 		if (Location != InLocation)
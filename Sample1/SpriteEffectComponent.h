@@ -30,7 +30,7 @@
 
 class sSpriteEffectComponent : public sPrimitiveComponent
 {
-	sClassBody(sClassConstructor, sSpriteEffectComponent, sPrimitiveComponent)
+	sClassBody(sPooledClassConstructor, sSpriteEffectComponent, sPrimitiveComponent)
 private:
 	struct sSpriteEffect
 	{
@@ -63,7 +63,7 @@ private:
 
 class GSawTrapActor : public GTrapActorBase
 {
-	sClassBody(sClassConstructor, GSawTrapActor, GTrapActorBase)
+	sClassBody(sPooledClassConstructor, GSawTrapActor, GTrapActorBase)
 public:
 	GSawTrapActor(std::string InName = "", sController* InController = nullptr);
 	virtual ~GSawTrapActor();
@@ -89,7 +89,7 @@ private:
 
 class GRockHeadActor : public GTrapActorBase
 {
-	sClassBody(sClassConstructor, GRockHeadActor, GTrapActorBase)
+	sClassBody(sPooledClassConstructor, GRockHeadActor, GTrapActorBase)
 public:
 	GRockHeadActor(std::string InName = "", sController* InController = nullptr);
 	virtual ~GRockHeadActor();
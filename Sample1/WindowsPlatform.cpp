@@ -281,11 +281,6 @@ void WindowsPlatform::BeginPlay()
 	Engine->BeginPlay();
 }
 
-void WindowsPlatform::Tick(const double fElapsedTimeSeconds)
-{
-	Engine->Tick((float)fElapsedTimeSeconds);
-}
-
 void WindowsPlatform::Render()
 {
 	Engine->Render();
@@ -47,7 +47,6 @@ public:
 
 	void BeginPlay();
 	void Render();
-	void Tick(const double DeltaTime);
 	void MessageLoop();
 
 	HWND GetHWND() { return m_hWnd; }